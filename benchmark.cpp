@@ -0,0 +1,239 @@
+/**************************************************************************************************
+ * File: benchmark.cpp
+ * Author: Nolan Davenport
+ * Procedures:
+ * 
+ * time_strategy    - Times one experiment function over a set of workloads. 
+ * 
+ * run_benchmarks   - Compares the speed of the reference experiments against the specialized 
+ *                    engines on the same workloads. 
+ *************************************************************************************************/
+
+#include<iostream>
+#include<random>
+#include<queue>
+#include<list>
+#include<vector>
+#include<chrono>
+#include<cstring>
+
+#include"main.h"
+#include"equal.h"
+#include"one_queue_unequal.h"
+#include"multiple_queues_unequal.h"
+#include"dynamic.h"
+#include"static_layouts.h"
+#include"bitmap_memory.h"
+#include"lockstep.h"
+#include"benchmark.h"
+
+using namespace std;
+
+/**************************************************************************************************
+ * double time_strategy(void (*strategy)(Data*, int, Results*), vector<Data> &workloads, 
+ *                      Results* results)
+ * 
+ * Author: Nolan Davenport
+ * Description: Times one experiment function over a set of workloads. 
+ * 
+ * Parameters:
+ *  strategy        I/P     void (*)(Data*, int, Results*)  The experiment function to time.
+ *  workloads       I/P     vector<Data> (&)                BENCHMARK_EXPERIMENTS workloads of 
+ *                                                          NUMBER_OF_SAMPLES each, back to back.
+ *  results         O/P     Results*                        The accumulated results.
+ *  time_strategy   O/P     double                          Microseconds per experiment.
+ *************************************************************************************************/
+double time_strategy(void (*strategy)(Data*, int, Results*), vector<Data> &workloads, Results* results){
+    auto start = chrono::steady_clock::now();                                   // Start the timer.
+    for(int experiment = 0; experiment < BENCHMARK_EXPERIMENTS; experiment++){  // Loop through the experiments.
+        strategy(&workloads[experiment * NUMBER_OF_SAMPLES],                    // Run the experiment.
+            NUMBER_OF_SAMPLES, results);
+    }
+    auto end = chrono::steady_clock::now();                                     // Stop the timer.
+
+    return chrono::duration<double, micro>(end - start).count() /               // Return the time taken
+        BENCHMARK_EXPERIMENTS;                                                  // per experiment.
+}
+
+/**************************************************************************************************
+ * void run_benchmarks()
+ * 
+ * Author: Nolan Davenport
+ * Description: Compares the speed of the reference experiments against the specialized engines 
+ *              on the same workloads. Also checks that both produce the same results. 
+ *************************************************************************************************/
+void run_benchmarks(){
+    default_random_engine gen;                          // The random engine to generate random numbers.
+    gen.seed(BENCHMARK_SEED);                           // Use a fixed seed so runs can be compared.
+    poisson_distribution<int> poisson_dist(8);          // Same size distribution as main.
+    uniform_int_distribution<int> uniform_dist(1,10);   // Same time distribution as main.
+
+    vector<Data> workloads(BENCHMARK_EXPERIMENTS * NUMBER_OF_SAMPLES);          // All the workloads, back to back.
+    for(int experiment = 0; experiment < BENCHMARK_EXPERIMENTS; experiment++){  // Loop through experiments.
+        generate_experiment_data(&workloads[experiment * NUMBER_OF_SAMPLES],    // Generate the workload.
+            gen, poisson_dist, uniform_dist);
+    }
+
+    // The pairs of reference and specialized engines to compare.
+    struct{
+        const char* name;                                   // The name printed in the report.
+        void (*reference)(Data*, int, Results*);            // The reference experiment.
+        void (*specialized)(Data*, int, Results*);          // The specialized engine.
+    } pairs[] = {
+        {"equal", equal_partitioning, equal_partitioning_fixed<EqualLayout>},
+        {"one_queue", one_queue_unequal_partitioning, one_queue_partitioning_fixed<UnequalLayout>},
+        {"multiple_queue", multiple_queues_unequal_partitioning, multiple_queues_partitioning_fixed<UnequalLayout>},
+    };
+
+    const int style_count = sizeof(pairs) / sizeof(pairs[0]);                       // One pair per style.
+    double reference_times[style_count];                                            // Kept for the lockstep engine.
+    double specialized_times[style_count];
+    for(int i = 0; i < style_count; i++){                                           // Loop through the pairs.
+        auto &pair = pairs[i];
+        Results reference_results;                                                  // Results of the reference.
+        Results specialized_results;                                                // Results of the specialized engine.
+        double reference_time = time_strategy(pair.reference, workloads, &reference_results);
+        double specialized_time = time_strategy(pair.specialized, workloads, &specialized_results);
+        reference_times[i] = reference_time;
+        specialized_times[i] = specialized_time;
+
+        bool same = reference_results.turn_around_time == specialized_results.turn_around_time &&
+            reference_results.relative_turn_around_time == specialized_results.relative_turn_around_time &&
+            reference_results.number_of_failures == specialized_results.number_of_failures &&
+            reference_results.average_num_data_members_in_partition_table ==
+                specialized_results.average_num_data_members_in_partition_table;
+
+        cout << pair.name << " reference: " << reference_time << " us/experiment, specialized: " <<
+            specialized_time << " us/experiment, speedup: " << reference_time / specialized_time <<
+            (same ? "" : " (RESULTS DIFFER)") << endl;
+    }
+
+    // The generic engines run the same layouts through the runtime path for comparison.
+    Results equal_generic;                                                              // Results of the generic equal engine.
+    Results one_queue_generic;                                                          // Results of the generic one queue engine.
+    auto start = chrono::steady_clock::now();                                           // Start the timer.
+    for(int experiment = 0; experiment < BENCHMARK_EXPERIMENTS; experiment++){          // Loop through the experiments.
+        equal_partitioning_generic(&workloads[experiment * NUMBER_OF_SAMPLES],          // Run the generic equal engine.
+            NUMBER_OF_SAMPLES, EqualLayout::sizes[0], EqualLayout::count, &equal_generic);
+    }
+    auto middle = chrono::steady_clock::now();                                          // Split the timer.
+    for(int experiment = 0; experiment < BENCHMARK_EXPERIMENTS; experiment++){          // Loop through the experiments.
+        one_queue_partitioning_generic(&workloads[experiment * NUMBER_OF_SAMPLES],      // Run the generic one queue engine.
+            NUMBER_OF_SAMPLES, UnequalLayout::sizes, UnequalLayout::count, &one_queue_generic);
+    }
+    auto end = chrono::steady_clock::now();                                             // Stop the timer.
+
+    cout << "equal generic: " << chrono::duration<double, micro>(middle - start).count() /
+        BENCHMARK_EXPERIMENTS << " us/experiment" << endl;
+    cout << "one_queue generic: " << chrono::duration<double, micro>(end - middle).count() /
+        BENCHMARK_EXPERIMENTS << " us/experiment" << endl;
+
+    // The lockstep engine runs every workload of a style as one batch, eight experiments at a
+    // time. Sums over many experiments are added in another order, so only the failures and the
+    // histograms are compared with the generic engines. It is timed against every other engine
+    // for the layout. Nothing runs on it by default, it is only measured here.
+    vector<const Data*> batch(BENCHMARK_EXPERIMENTS);                                   // The workloads of the batch.
+    vector<int> sample_counts(BENCHMARK_EXPERIMENTS, NUMBER_OF_SAMPLES);                // Their sizes.
+    for(int experiment = 0; experiment < BENCHMARK_EXPERIMENTS; experiment++){          // Loop through the experiments.
+        batch[experiment] = &workloads[experiment * NUMBER_OF_SAMPLES];
+    }
+    struct{
+        const char* name;                                   // The name printed in the report.
+        StaticStyle style;                                  // The partitioning style.
+        const int* sizes;                                   // The layout.
+        int count;                                          // The number of partitions in the layout.
+        void (*generic)(Data*, int, Results*);              // The engine the results are checked against.
+    } lockstep_styles[] = {
+        {"equal", EQUAL_STYLE, EqualLayout::sizes, EqualLayout::count, [](Data* data, int number_of_samples, Results* results){
+            equal_partitioning_generic(data, number_of_samples, EqualLayout::sizes[0], EqualLayout::count, results);
+        }},
+        {"one_queue", ONE_QUEUE_STYLE, UnequalLayout::sizes, UnequalLayout::count, [](Data* data, int number_of_samples, Results* results){
+            one_queue_partitioning_generic(data, number_of_samples, UnequalLayout::sizes, UnequalLayout::count, results);
+        }},
+        {"multiple_queue", MULTIPLE_QUEUES_STYLE, UnequalLayout::sizes, UnequalLayout::count, [](Data* data, int number_of_samples, Results* results){
+            multiple_queues_partitioning_generic(data, number_of_samples, UnequalLayout::sizes, UnequalLayout::count, results);
+        }},
+    };
+    for(int i = 0; i < style_count; i++){                                               // Loop through the styles, in
+                                                                                        // the same order as the pairs.
+        auto &lockstep = lockstep_styles[i];
+        vector<Data> copy(workloads);                                                   // The generic engines change the data.
+        Results* generic_results = new Results();                                       // Results of the generic engine.
+        double generic_time = time_strategy(lockstep.generic, copy, generic_results);
+
+        for(int simd = lockstep_simd_supported() ? 1 : 0; simd >= 0; simd--){          // The vector engine, then the scalar one.
+            Results* lockstep_results = new Results();                                  // Results of the lockstep engine.
+            auto lockstep_start = chrono::steady_clock::now();                          // Start the timer.
+            lockstep_static_partitioning(batch.data(), sample_counts.data(), BENCHMARK_EXPERIMENTS,
+                lockstep.style, lockstep.sizes, lockstep.count, lockstep_results, simd);
+            auto lockstep_end = chrono::steady_clock::now();                            // Stop the timer.
+            double lockstep_time = chrono::duration<double, micro>(lockstep_end - lockstep_start).count() /
+                BENCHMARK_EXPERIMENTS;
+            bool same = lockstep_results->number_of_failures == generic_results->number_of_failures &&
+                memcmp(&lockstep_results->turn_around_histogram, &generic_results->turn_around_histogram,
+                    sizeof(Histogram)) == 0;
+            cout << lockstep.name << " lockstep " << (simd ? "avx2" : "scalar") << ": " << lockstep_time <<
+                " us/experiment, speedup over reference: " << reference_times[i] / lockstep_time <<
+                ", over specialized: " << specialized_times[i] / lockstep_time <<
+                ", over generic: " << generic_time / lockstep_time <<
+                (same ? "" : " (RESULTS DIFFER)") << endl;
+            delete lockstep_results;
+        }
+        delete generic_results;
+    }
+
+    // The dynamic partitioning style has no specialized engine, but its allocations are reported.
+    Results dynamic_results;                                                            // Results of the dynamic style.
+    long long node_allocations = dynamic_partition_node_allocations();                  // Counts before the run.
+    long long heap_allocations = dynamic_partition_heap_allocations();
+    double dynamic_time = time_strategy(dynamic_partitioning, workloads, &dynamic_results);
+    node_allocations = dynamic_partition_node_allocations() - node_allocations;         // Counts for the run.
+    heap_allocations = dynamic_partition_heap_allocations() - heap_allocations;
+
+    cout << "dynamic: " << dynamic_time << " us/experiment, partition nodes allocated: " <<
+        (double)node_allocations / BENCHMARK_EXPERIMENTS << "/experiment, heap allocations: " <<
+        heap_allocations << endl;
+
+    // The bitmap memory model runs the same experiment on a bitmap. With one block per MB of the
+    // usual memory it must agree with the partition list; the large memory shows how it scales.
+    Results bitmap_results;                                                             // Results of the bitmap model.
+    double bitmap_time = time_strategy([](Data* data, int number_of_samples, Results* results){
+        dynamic_bitmap_partitioning(data, number_of_samples, results, MEMORY_END+1, 1);
+    }, workloads, &bitmap_results);
+    bool same = dynamic_results.turn_around_time == bitmap_results.turn_around_time &&
+        dynamic_results.relative_turn_around_time == bitmap_results.relative_turn_around_time &&
+        dynamic_results.number_of_failures == bitmap_results.number_of_failures &&
+        dynamic_results.average_num_data_members_in_partition_table ==
+            bitmap_results.average_num_data_members_in_partition_table;
+    cout << "dynamic bitmap (" << MEMORY_END+1 << " MB x 1 block): " << bitmap_time << " us/experiment" <<
+        (same ? "" : " (RESULTS DIFFER)") << endl;
+
+    // At a large memory the partition list walks its partitions to place and compact, while the
+    // bitmap model keeps an index of its holes. With one block per MB they must still agree.
+    Results large_list_results;                                                         // Results of the large list.
+    double large_list_time = time_strategy([](Data* data, int number_of_samples, Results* results){
+        dynamic_partitioning_in_memory(data, number_of_samples, results, BENCHMARK_BITMAP_MEMORY_UNITS);
+    }, workloads, &large_list_results);
+    cout << "dynamic (" << BENCHMARK_BITMAP_MEMORY_UNITS << " MB): " << large_list_time << " us/experiment" << endl;
+
+    Results large_unit_results;                                                         // Results of the large bitmap
+    double large_unit_time = time_strategy([](Data* data, int number_of_samples, Results* results){  // with one block per MB.
+        dynamic_bitmap_partitioning(data, number_of_samples, results, BENCHMARK_BITMAP_MEMORY_UNITS, 1);
+    }, workloads, &large_unit_results);
+    same = large_list_results.turn_around_time == large_unit_results.turn_around_time &&
+        large_list_results.relative_turn_around_time == large_unit_results.relative_turn_around_time &&
+        large_list_results.number_of_failures == large_unit_results.number_of_failures &&
+        large_list_results.average_num_data_members_in_partition_table ==
+            large_unit_results.average_num_data_members_in_partition_table;
+    cout << "dynamic bitmap (" << BENCHMARK_BITMAP_MEMORY_UNITS << " MB x 1 block): " << large_unit_time <<
+        " us/experiment, " << large_list_time / large_unit_time << "x the list" <<
+        (same ? "" : " (RESULTS DIFFER)") << endl;
+
+    Results large_bitmap_results;                                                       // Results of the large bitmap.
+    double large_bitmap_time = time_strategy([](Data* data, int number_of_samples, Results* results){
+        dynamic_bitmap_partitioning(data, number_of_samples, results,
+            BENCHMARK_BITMAP_MEMORY_UNITS, BENCHMARK_BITMAP_BLOCKS_PER_UNIT);
+    }, workloads, &large_bitmap_results);
+    cout << "dynamic bitmap (" << BENCHMARK_BITMAP_MEMORY_UNITS << " MB x " << BENCHMARK_BITMAP_BLOCKS_PER_UNIT <<
+        " blocks): " << large_bitmap_time << " us/experiment" << endl;
+}
\ No newline at end of file
@@ -0,0 +1,31 @@
+/**************************************************************************************************
+ * File: benchmark.h
+ * Author: Nolan Davenport
+ * Procedures:
+ * 
+ * time_strategy    - Times one experiment function over a set of workloads. 
+ * 
+ * run_benchmarks   - Compares the speed of the reference experiments against the specialized 
+ *                    engines on the same workloads. 
+ *************************************************************************************************/
+
+#pragma once
+
+#include<iostream>
+#include<random>
+#include<queue>
+#include<list>
+#include<vector>
+
+#include"main.h"
+
+using namespace std;
+
+#define BENCHMARK_EXPERIMENTS 200
+#define BENCHMARK_SEED 1
+#define BENCHMARK_BITMAP_MEMORY_UNITS 16384   // A 16 GB memory for the bitmap model and the list.
+#define BENCHMARK_BITMAP_BLOCKS_PER_UNIT 256  // 4 KB pages.
+
+// Function prototypes
+double time_strategy(void (*strategy)(Data*, int, Results*), vector<Data> &workloads, Results* results);
+void run_benchmarks();
\ No newline at end of file
@@ -0,0 +1,557 @@
+/**************************************************************************************************
+ * File: bitmap_memory.cpp
+ * Author: Nolan Davenport
+ * Procedures:
+ *
+ * bitmap_init                      - Sets up a bitmap memory with every block free.
+ *
+ * bitmap_set_range                 - Marks a range of blocks as used.
+ *
+ * bitmap_clear_range               - Marks a range of blocks as free.
+ *
+ * bitmap_next_free                 - Finds the first free block at or after a position.
+ *
+ * bitmap_next_used                 - Finds the first used block at or after a position.
+ *
+ * bitmap_add_hole                  - Records a hole in the hole index and the hole metrics.
+ *
+ * bitmap_find_hole                 - Finds the first hole that the first fit placement algorithm
+ *                                    would use.
+ *
+ * bitmap_compact                   - Performs the compaction algorithm on a bitmap memory.
+ *
+ * bitmap_fill_hole                 - Updates the hole metrics when data is placed at the start of
+ *                                    a hole.
+ *
+ * bitmap_merge_holes               - Updates the hole metrics when data leaves memory and the
+ *                                    holes on either side of it merge.
+ *
+ * bitmap_first_fit_algorithm       - Performs the first fit placement algorithm on a bitmap memory.
+ *
+ * dynamic_bitmap_partitioning      - Performs the dynamic partitioning experiment on a bitmap
+ *                                    memory of any size.
+ *************************************************************************************************/
+
+#include<iostream>
+#include<random>
+#include<queue>
+#include<list>
+#include<vector>
+#include<map>
+#include<set>
+#include<memory_resource>
+#include<cstdint>
+
+#include"main.h"
+#include"histogram.h"
+#include"metrics.h"
+#include"partition_pool.h"
+#include"bitmap_memory.h"
+
+using namespace std;
+
+/**************************************************************************************************
+ * void bitmap_init(BitmapMemory &memory, int number_of_blocks)
+ *
+ * Author: Nolan Davenport
+ * Description: Sets up a bitmap memory with every block free.
+ *
+ * Parameters:
+ *  memory              O/P     BitmapMemory (&)    The memory to set up.
+ *  number_of_blocks    I/P     int                 The number of blocks in memory.
+ *************************************************************************************************/
+void bitmap_init(BitmapMemory &memory, int number_of_blocks){
+    memory.number_of_blocks = number_of_blocks;             // Remember the size.
+    memory.words.assign(number_of_blocks / 64 + 1, 0);      // Every block starts free. There is always a
+                                                            // last word holding the bits past the end.
+    memory.words.back() = ~0ULL << (number_of_blocks % 64); // The bits past the last block are used, so
+                                                            // searches stop there.
+}
+
+/**************************************************************************************************
+ * void bitmap_set_range(BitmapMemory &memory, int start, int length)
+ *
+ * Author: Nolan Davenport
+ * Description: Marks a range of blocks as used. The partial words at either end are masked and
+ *              the whole words between them are filled at once.
+ *
+ * Parameters:
+ *  memory      I/O     BitmapMemory (&)    The memory.
+ *  start       I/P     int                 The first block of the range.
+ *  length      I/P     int                 The number of blocks in the range.
+ *************************************************************************************************/
+void bitmap_set_range(BitmapMemory &memory, int start, int length){
+    if(length <= 0){                                            // If the range is empty:
+        return;                                                 // There is nothing to mark.
+    }
+    int first_word = start / 64;                                // The words the range starts and ends in.
+    int last_word = (start + length - 1) / 64;
+    uint64_t first_mask = ~0ULL << (start % 64);                // The blocks of the range in those words.
+    uint64_t last_mask = ~0ULL >> (63 - (start + length - 1) % 64);
+    if(first_word == last_word){                                // If the range is inside one word:
+        memory.words[first_word] |= first_mask & last_mask;     // Set its bits.
+        return;
+    }
+    memory.words[first_word] |= first_mask;                     // Set the partial words at either end
+    memory.words[last_word] |= last_mask;                       // and fill the whole words between them.
+    fill(memory.words.begin() + first_word + 1, memory.words.begin() + last_word, ~0ULL);
+}
+
+/**************************************************************************************************
+ * void bitmap_clear_range(BitmapMemory &memory, int start, int length)
+ *
+ * Author: Nolan Davenport
+ * Description: Marks a range of blocks as free. The partial words at either end are masked and
+ *              the whole words between them are cleared at once.
+ *
+ * Parameters:
+ *  memory      I/O     BitmapMemory (&)    The memory.
+ *  start       I/P     int                 The first block of the range.
+ *  length      I/P     int                 The number of blocks in the range.
+ *************************************************************************************************/
+void bitmap_clear_range(BitmapMemory &memory, int start, int length){
+    if(length <= 0){                                            // If the range is empty:
+        return;                                                 // There is nothing to mark.
+    }
+    int first_word = start / 64;                                // The words the range starts and ends in.
+    int last_word = (start + length - 1) / 64;
+    uint64_t first_mask = ~0ULL << (start % 64);                // The blocks of the range in those words.
+    uint64_t last_mask = ~0ULL >> (63 - (start + length - 1) % 64);
+    if(first_word == last_word){                                // If the range is inside one word:
+        memory.words[first_word] &= ~(first_mask & last_mask);  // Clear its bits.
+        return;
+    }
+    memory.words[first_word] &= ~first_mask;                    // Clear the partial words at either end
+    memory.words[last_word] &= ~last_mask;                      // and the whole words between them.
+    fill(memory.words.begin() + first_word + 1, memory.words.begin() + last_word, 0);
+}
+
+/**************************************************************************************************
+ * int bitmap_next_free(const BitmapMemory &memory, int from)
+ *
+ * Author: Nolan Davenport
+ * Description: Finds the first free block at or after a position. Full words are skipped with a
+ *              single compare and the block inside a word is found with a count of trailing zeros.
+ *
+ * Parameters:
+ *  memory              I/P     const BitmapMemory (&)  The memory.
+ *  from                I/P     int                     The block to start searching at.
+ *  bitmap_next_free    O/P     int                     The first free block, or number_of_blocks if
+ *                                                      there is none.
+ *************************************************************************************************/
+int bitmap_next_free(const BitmapMemory &memory, int from){
+    if(from >= memory.number_of_blocks){                        // If the search starts past the end:
+        return memory.number_of_blocks;                         // There is nothing to find.
+    }
+
+    size_t word_index = from / 64;                              // The word to start in.
+    uint64_t free_bits = ~memory.words[word_index] &            // The free blocks in that word, ignoring
+        (~0ULL << (from % 64));                                 // the ones before the start.
+    while(free_bits == 0){                                      // Skip words with no free blocks.
+        if(++word_index == memory.words.size()){                // If there are no more words:
+            return memory.number_of_blocks;                     // There is no free block.
+        }
+        free_bits = ~memory.words[word_index];
+    }
+
+    return min((int)(word_index * 64) + __builtin_ctzll(free_bits), memory.number_of_blocks);
+}
+
+/**************************************************************************************************
+ * int bitmap_next_used(const BitmapMemory &memory, int from)
+ *
+ * Author: Nolan Davenport
+ * Description: Finds the first used block at or after a position. Empty words are skipped with a
+ *              single compare and the block inside a word is found with a count of trailing zeros.
+ *
+ * Parameters:
+ *  memory              I/P     const BitmapMemory (&)  The memory.
+ *  from                I/P     int                     The block to start searching at.
+ *  bitmap_next_used    O/P     int                     The first used block, or number_of_blocks if
+ *                                                      there is none.
+ *************************************************************************************************/
+int bitmap_next_used(const BitmapMemory &memory, int from){
+    if(from >= memory.number_of_blocks){                        // If the search starts past the end:
+        return memory.number_of_blocks;                         // There is nothing to find.
+    }
+
+    size_t word_index = from / 64;                              // The word to start in.
+    uint64_t used_bits = memory.words[word_index] &             // The used blocks in that word, ignoring
+        (~0ULL << (from % 64));                                 // the ones before the start.
+    while(used_bits == 0){                                      // Skip words with no used blocks. The bits
+        used_bits = memory.words[++word_index];                 // past the end are set, so this stops.
+    }
+
+    return min((int)(word_index * 64) + __builtin_ctzll(used_bits), memory.number_of_blocks);
+}
+
+/**************************************************************************************************
+ * void bitmap_add_hole(BitmapPartitions &partitions, int start, int length, MemoryMetrics &metrics)
+ *
+ * Author: Nolan Davenport
+ * Description: Records a new hole in the hole index and the hole metrics. The index keeps blocks
+ *              and the metrics keep MB, the same as dynamic_partitioning.
+ *
+ * Parameters:
+ *  partitions  I/O     BitmapPartitions (&)    The memory.
+ *  start       I/P     int                     The first block of the hole.
+ *  length      I/P     int                     The number of blocks in the hole.
+ *  metrics     I/O     MemoryMetrics (&)       The memory metrics.
+ *************************************************************************************************/
+void bitmap_add_hole(BitmapPartitions &partitions, int start, int length, MemoryMetrics &metrics){
+    if(length > 0){                                             // Only holes with blocks are indexed.
+        partitions.holes.emplace(start, length);
+        partitions.longest_hole = max(partitions.longest_hole, length);
+    }
+    metrics_add_hole(metrics, length / partitions.blocks_per_unit);
+}
+
+/**************************************************************************************************
+ * int bitmap_find_hole(BitmapPartitions &partitions, int length)
+ *
+ * Author: Nolan Davenport
+ * Description: Finds the first hole that the first fit placement algorithm would use. Like
+ *              perform_first_fit_algorithm, a hole between partitions must be larger than the
+ *              data while the hole at the end of memory only has to be as large. The holes are
+ *              walked in address order, without reading the bitmap. A search that fails records
+ *              the longest hole it saw, so a blocked queue head costs no search until a hole
+ *              grows.
+ *
+ * Parameters:
+ *  partitions          I/O     BitmapPartitions (&)    The memory.
+ *  length              I/P     int                     The number of blocks needed.
+ *  bitmap_find_hole    O/P     int                     The first block of the hole, or -1 if no
+ *                                                      hole is large enough.
+ *************************************************************************************************/
+int bitmap_find_hole(BitmapPartitions &partitions, int length){
+    int end = partitions.memory.number_of_blocks;               // The end of memory.
+    if(partitions.longest_hole >= length){                      // If some hole could hold the data:
+        int longest = 0;                                        // The longest hole seen.
+        for(const HoleEntry &hole : partitions.holes){          // Take the first that does.
+            if(hole.length > length ||                          // The hole at the end of memory only needs
+                (hole.start + hole.length == end && hole.length == length)){   // to be as large.
+                return hole.start;
+            }
+            longest = max(longest, hole.length);
+        }
+        partitions.longest_hole = longest;                      // None did, so this is exact now.
+    }
+
+    if(length == 0 && partitions.holes.empty()){                // If memory is full, data of size zero still
+        return end;                                             // fits in the empty hole at the end.
+    }
+    return -1;                                                  // No hole is large enough.
+}
+
+/**************************************************************************************************
+ * int bitmap_compact(BitmapPartitions &partitions, MemoryMetrics &metrics)
+ *
+ * Author: Nolan Davenport
+ * Description: Performs the compaction algorithm on a bitmap memory. Every data item is moved
+ *              down to the end of the one before it, keeping their order. Data below the first
+ *              hole is already in place, so only the data above it is moved: its start block is
+ *              rewritten in place, which keeps the order and every iterator, and only the blocks
+ *              from the first hole to the old end of the data are rewritten. Only the holes of
+ *              this memory are replaced in the hole metrics, so memories that share their
+ *              metrics keep their own holes.
+ *
+ * Parameters:
+ *  partitions      I/O     BitmapPartitions (&)    The memory to compact.
+ *  metrics         I/O     MemoryMetrics (&)       The memory metrics.
+ *  bitmap_compact  O/P     int                     The number of free blocks at the end of memory
+ *                                                  after compaction.
+ *************************************************************************************************/
+int bitmap_compact(BitmapPartitions &partitions, MemoryMetrics &metrics){
+    if(partitions.holes.empty()){                               // Memory is full, so nothing can move.
+        return 0;
+    }
+    int first_hole = partitions.holes.begin()->start;           // Everything below it stays.
+    int used_end = first_hole;                                  // Where the data above it ends now.
+    if(!partitions.resident.empty()){
+        const ResidentEntry &last = *partitions.resident.rbegin();
+        used_end = max(used_end, last.start + partitions.block_count[last.index]);
+    }
+
+    int next_start = first_hole;                                // Where the next data item goes.
+    for(ResidentMap::iterator entry = partitions.resident.lower_bound(first_hole);  // Loop through the data
+        entry != partitions.resident.end(); entry++){                               // above the hole.
+        entry->start = next_start;                              // Move it down.
+        partitions.start_block[entry->index] = next_start;      // Remember where it went.
+        next_start += partitions.block_count[entry->index];     // The next one goes right after it.
+    }
+
+    bitmap_set_range(partitions.memory, first_hole, next_start - first_hole);   // Rewrite only the blocks
+    bitmap_clear_range(partitions.memory, next_start, used_end - next_start);   // that changed.
+
+    int free_blocks = partitions.memory.number_of_blocks - next_start;  // The free blocks left at the end.
+    metrics_add_hole(metrics, free_blocks / partitions.blocks_per_unit);    // They are counted before the old
+    for(const HoleEntry &hole : partitions.holes){                          // holes go, so the largest hole is
+        metrics_remove_hole(metrics, hole.length / partitions.blocks_per_unit); // not searched for.
+    }
+    partitions.holes.clear();                                   // They are now the only hole.
+    partitions.longest_hole = 0;
+    if(free_blocks > 0){
+        partitions.holes.emplace(next_start, free_blocks);
+        partitions.longest_hole = free_blocks;
+    }
+    return free_blocks;
+}
+
+/**************************************************************************************************
+ * void bitmap_fill_hole(BitmapPartitions &partitions, ResidentMap::const_iterator entry,
+ *                       MemoryMetrics &metrics)
+ *
+ * Author: Nolan Davenport
+ * Description: Updates the holes when data is placed at the start of a hole. The hole ran from
+ *              the data to the next data in memory, or to the end of memory, and what is left of
+ *              it stays a hole, so its start moves up in place.
+ *
+ * Parameters:
+ *  partitions  I/O     BitmapPartitions (&)            The memory, with the data already in it.
+ *  entry       I/P     ResidentMap::const_iterator     The data that was placed.
+ *  metrics     I/O     MemoryMetrics (&)               The memory metrics.
+ *************************************************************************************************/
+void bitmap_fill_hole(BitmapPartitions &partitions, ResidentMap::const_iterator entry,
+                      MemoryMetrics &metrics){
+    int hole_end = partitions.memory.number_of_blocks;         // The hole ends at the end of memory
+    if(next(entry) != partitions.resident.end()){               // unless there is data after it.
+        hole_end = next(entry)->start;
+    }
+    int hole = hole_end - entry->start;                         // The blocks in the hole.
+    int blocks = partitions.block_count[entry->index];          // The blocks the data fills.
+
+    if(hole > 0){                                               // If the data went into a real hole:
+        HoleSet::iterator filled = partitions.holes.find(entry->start);
+        if(hole > blocks){                                      // The data fills the start of the hole,
+            filled->start += blocks;                            // leaving the rest.
+            filled->length -= blocks;
+        }else{                                                  // Or all of it.
+            partitions.holes.erase(filled);
+        }
+    }
+    // The rest of the hole is counted before the hole goes, so the largest hole is not searched for.
+    metrics_add_hole(metrics, (hole - blocks) / partitions.blocks_per_unit);
+    metrics_remove_hole(metrics, hole / partitions.blocks_per_unit);
+}
+
+/**************************************************************************************************
+ * void bitmap_merge_holes(BitmapPartitions &partitions, ResidentMap::const_iterator entry,
+ *                         MemoryMetrics &metrics)
+ *
+ * Author: Nolan Davenport
+ * Description: Updates the holes when data leaves memory. The holes on either side of it merge
+ *              with its blocks into a single hole, which reuses the entry of one of them. Must be
+ *              called before the data is erased from the resident map.
+ *
+ * Parameters:
+ *  partitions  I/O     BitmapPartitions (&)            The memory, with the data still in it.
+ *  entry       I/P     ResidentMap::const_iterator     The data that is leaving.
+ *  metrics     I/O     MemoryMetrics (&)               The memory metrics.
+ *************************************************************************************************/
+void bitmap_merge_holes(BitmapPartitions &partitions, ResidentMap::const_iterator entry,
+                        MemoryMetrics &metrics){
+    int hole_start = 0;                                         // Where the hole before the data starts.
+    if(entry != partitions.resident.begin()){                   // If there's data before it:
+        ResidentMap::const_iterator before = prev(entry);       // The hole starts after that data.
+        hole_start = before->start + partitions.block_count[before->index];
+    }
+    int hole_end = partitions.memory.number_of_blocks;         // Where the hole after the data ends.
+    if(next(entry) != partitions.resident.end()){               // If there's data after it:
+        hole_end = next(entry)->start;                          // The hole ends at its start.
+    }
+    int end = entry->start + partitions.block_count[entry->index];      // Where the data ends.
+    int hole_before = entry->start - hole_start;                // The blocks in the holes on either side.
+    int hole_after = hole_end - end;
+    int merged = hole_end - hole_start;                         // The blocks in the merged hole.
+
+    HoleSet::iterator hole = partitions.holes.lower_bound(hole_start);     // The first hole on either side.
+    if(hole_before > 0){                                        // If there is a hole before the data:
+        hole->length = merged;                                  // It grows over the data and the hole after.
+        if(hole_after > 0){
+            partitions.holes.erase(next(hole));
+        }
+    }else if(hole_after > 0){                                   // If there is only a hole after it:
+        hole->start = hole_start;                               // It grows down over the data.
+        hole->length = merged;
+    }else if(merged > 0){                                       // Otherwise the data's blocks are a new hole.
+        partitions.holes.emplace_hint(hole, hole_start, merged);
+    }
+    partitions.longest_hole = max(partitions.longest_hole, merged);
+
+    // The merged hole is counted before the holes it replaces go, so the largest hole is not searched for.
+    metrics_add_hole(metrics, merged / partitions.blocks_per_unit);
+    metrics_remove_hole(metrics, hole_before / partitions.blocks_per_unit);
+    metrics_remove_hole(metrics, hole_after / partitions.blocks_per_unit);
+}
+
+/**************************************************************************************************
+ * void bitmap_first_fit_algorithm(Data data[], int number_of_samples, BitmapPartitions &partitions,
+ *                                 int &next_data, int &num_data_members_in_partition_table,
+ *                                 int &number_of_failures, MemoryMetrics &metrics)
+ *
+ * Author: Nolan Davenport
+ * Description: Performs the first fit placement algorithm on a bitmap memory. Follows the same
+ *              rules as perform_first_fit_algorithm, including compacting when there is enough
+ *              free memory but no hole is large enough.
+ *
+ * Parameters:
+ *  data                                I/P     Data[]                      The data used in this
+ *                                                                          experiment.
+ *  number_of_samples                   I/P     int                         The number of samples.
+ *  partitions                          I/O     BitmapPartitions (&)        The memory to place into.
+ *  next_data                           I/O     int (&)                     The head of the queue.
+ *  num_data_members_in_partition_table O/P     int (&)                     The number of data members
+ *                                                                          in memory.
+ *  number_of_failures                  O/P     int (&)                     The number of failures.
+ *  metrics                             I/O     MemoryMetrics (&)           The memory metrics.
+ *************************************************************************************************/
+void bitmap_first_fit_algorithm(Data data[], int number_of_samples, BitmapPartitions &partitions,
+                                int &next_data, int &num_data_members_in_partition_table,
+                                int &number_of_failures, MemoryMetrics &metrics){
+    while(next_data != number_of_samples){                      // Place as much of the queue as possible.
+        int size = data[next_data].size;                        // The size of the item at the head of the queue.
+        int start;                                              // The block it gets placed at.
+
+        if(partitions.resident.empty()){                        // If memory is empty:
+            start = 0;                                          // It goes at the start, even if it is too large.
+            if(size > partitions.memory_units){                 // If it is larger than all of memory:
+                number_of_failures++;                           // Count it as a failure.
+            }
+        }else{
+            if(partitions.used_units > partitions.memory_units){    // Data larger than memory leaves no
+                break;                                          // hole at all until it finishes.
+            }
+            start = bitmap_find_hole(partitions,                // Find the first hole it fits in.
+                size * partitions.blocks_per_unit);
+            if(start == -1){                                    // If there isn't one:
+                if(partitions.memory_units - partitions.used_units >= size){    // If there is enough free memory
+                    bitmap_compact(partitions, metrics);            // in total, compact it into one hole
+                    continue;                                   // and try again.
+                }
+                break;                                          // Otherwise the queue is blocked.
+            }
+        }
+
+        int blocks = min(size, partitions.memory_units) * partitions.blocks_per_unit;  // Blocks it occupies.
+        bitmap_set_range(partitions.memory, start, blocks);     // Mark them as used.
+        ResidentMap::iterator entry =                           // Add it to memory in address order, after
+            partitions.resident.emplace(start, next_data);      // any data of size zero at the same block.
+        partitions.start_block[next_data] = start;              // Remember where it is
+        partitions.block_count[next_data] = blocks;             // and how much of it there is.
+        partitions.used_units += size;                          // Count the memory it holds.
+        bitmap_fill_hole(partitions, entry, metrics);
+        metrics_admit(metrics, min(size, partitions.memory_units), size);
+
+        num_data_members_in_partition_table++;                  // One more data member in memory.
+        next_data++;                                            // Move to the next item in the queue.
+    }
+}
+
+/**************************************************************************************************
+ * void dynamic_bitmap_partitioning(Data data[], int number_of_samples, Results* first_fit,
+ *                                  int memory_units, int blocks_per_unit)
+ *
+ * Author: Nolan Davenport
+ * Description: Performs the dynamic partitioning experiment on a bitmap memory of any size. With
+ *              memory_units of MEMORY_END+1 and one block per unit it gives exactly the same
+ *              results as dynamic_partitioning, including the hole metrics.
+ *
+ * Parameters:
+ *  data                I/P     Data[]          The data to be used in this experiment.
+ *  number_of_samples   I/P     int             The number of samples in this experiment.
+ *  first_fit           O/P     Results*        Pointer to the structure that holds the results of
+ *                                              this experiment.
+ *  memory_units        I/P     int             The size of memory in MB.
+ *  blocks_per_unit     I/P     int             The number of blocks (pages) in one MB.
+ *************************************************************************************************/
+void dynamic_bitmap_partitioning(Data data[], int number_of_samples, Results* first_fit,
+                                 int memory_units, int blocks_per_unit){
+    vector<int> left(number_of_samples);            // Only the time left changes during the experiment.
+    for(int i = 0; i < number_of_samples; i++){     // Loop through each sample.
+        left[i] = data[i].left;                     // Copy the time left.
+    }
+
+    reset_dynamic_partition_pool();                 // Start this experiment with a fresh pool of nodes.
+
+    BitmapPartitions partitions{                    // Set up an empty memory.
+        BitmapMemory(), ResidentMap(dynamic_partition_resource()), vector<int>(number_of_samples),
+        vector<int>(number_of_samples), memory_units, blocks_per_unit, 0};
+    bitmap_init(partitions.memory, memory_units * blocks_per_unit);
+
+    MemoryMetrics metrics;                          // The memory metrics for this experiment.
+    metrics.memory_size = memory_units;             // Utilization is relative to this memory.
+    bitmap_add_hole(partitions, 0, memory_units * blocks_per_unit, metrics);   // Memory starts as a single hole.
+
+    int next_data = 0;                              // The head of the queue.
+    int number_of_failures = 0;                     // Initialize the number of failures to zero.
+    int num_data_members_in_partition_table = 0;    // The number of data members in memory.
+    int clock = 0;                                  // Initialize the clock to zero.
+
+    ResidentMap::iterator it = partitions.resident.end();   // The data the processor works on.
+    bitmap_first_fit_algorithm(data, number_of_samples,     // Place the initial data.
+        partitions, next_data, num_data_members_in_partition_table, number_of_failures, metrics);
+    it = partitions.resident.begin();                       // Start at the lowest address.
+
+    float average_num_data_members_in_partition_table = 0;  // Cumulative value used for the average.
+
+    for(;;){                                                // Clock loop.
+        int index = it->index;                              // The data the processor is on.
+        bool just_erased_a_partition = false;               // Whether the iterator has already moved on.
+
+        if(--left[index] == 0){                             // Work for one quantum. If the data is finished:
+            int turn_around_time = clock - data[index].time_start;  // Calculate the turnaround time.
+
+            first_fit->turn_around_time += turn_around_time;        // Add it to the cumulative turnaround time.
+            float relative_turn_around_time =                           // Calculate the relative turnaround time.
+                (float)turn_around_time / data[index].time;
+            first_fit->relative_turn_around_time += relative_turn_around_time;    // Add it to the cumulative value.
+            record_completion(index, clock);                                         // Record when it finished.
+            histogram_record(first_fit->turn_around_histogram, turn_around_time);    // Record both for the percentiles.
+            record_relative_turn_around(first_fit->relative_turn_around_histogram,
+                turn_around_time, data[index].time);
+
+            int size = data[index].size;                            // Free its memory.
+            bitmap_clear_range(partitions.memory, it->start, partitions.block_count[index]);
+            partitions.used_units -= size;
+            bitmap_merge_holes(partitions, it, metrics);
+            metrics_release(metrics, min(size, memory_units), size);
+
+            it = partitions.resident.erase(it);             // Remove it from memory and move on.
+            just_erased_a_partition = true;
+
+            bool was_empty = partitions.resident.empty();   // Whether memory was empty before placing more.
+            num_data_members_in_partition_table--;          // Decrement the number of data members.
+
+            bitmap_first_fit_algorithm(data, number_of_samples, partitions, next_data,
+                num_data_members_in_partition_table, number_of_failures, metrics);
+
+            if(num_data_members_in_partition_table == 0){   // If memory is empty:
+                break;                                      // The experiment is done.
+            }else if(was_empty){                            // If memory was empty, start from the beginning.
+                it = partitions.resident.begin();
+            }
+        }
+
+        if(!just_erased_a_partition){                       // If nothing was erased, move on.
+            it++;
+        }
+
+        if(it == partitions.resident.end()){                // If the end of memory was reached:
+            it = partitions.resident.begin();               // Go back to the start.
+        }
+
+        clock++;                                            // Increment the clock.
+        average_num_data_members_in_partition_table +=      // Add to the cumulative average variable.
+            num_data_members_in_partition_table;
+
+        metrics_tick(metrics, first_fit);                   // Add the memory metrics for this tick.
+    }
+
+    average_num_data_members_in_partition_table /= clock;   // Calculate the average for this experiment.
+
+    first_fit->average_num_data_members_in_partition_table +=   // Add it to the cumulative variable.
+        average_num_data_members_in_partition_table;
+    first_fit->number_of_failures += number_of_failures;        // Add the failures to the cumulative variable.
+
+    metrics_finish_experiment(metrics, first_fit, clock);       // Add the memory metrics to the cumulative values.
+}
\ No newline at end of file
@@ -0,0 +1,127 @@
+/**************************************************************************************************
+ * File: bitmap_memory.h
+ * Author: Nolan Davenport
+ * Procedures:
+ *
+ * bitmap_init                      - Sets up a bitmap memory with every block free.
+ *
+ * bitmap_set_range                 - Marks a range of blocks as used.
+ *
+ * bitmap_clear_range               - Marks a range of blocks as free.
+ *
+ * bitmap_next_free                 - Finds the first free block at or after a position.
+ *
+ * bitmap_next_used                 - Finds the first used block at or after a position.
+ *
+ * bitmap_add_hole                  - Records a hole in the hole index and the hole metrics.
+ *
+ * bitmap_find_hole                 - Finds the first hole that the first fit placement algorithm
+ *                                    would use.
+ *
+ * bitmap_compact                   - Performs the compaction algorithm on a bitmap memory.
+ *
+ * bitmap_fill_hole                 - Updates the hole metrics when data is placed at the start of
+ *                                    a hole.
+ *
+ * bitmap_merge_holes               - Updates the hole metrics when data leaves memory and the
+ *                                    holes on either side of it merge.
+ *
+ * bitmap_first_fit_algorithm       - Performs the first fit placement algorithm on a bitmap memory.
+ *
+ * dynamic_bitmap_partitioning      - Performs the dynamic partitioning experiment on a bitmap
+ *                                    memory of any size.
+ *************************************************************************************************/
+
+#pragma once
+
+#include<iostream>
+#include<random>
+#include<queue>
+#include<list>
+#include<vector>
+#include<map>
+#include<set>
+#include<memory_resource>
+#include<cstdint>
+
+#include"main.h"
+#include"metrics.h"
+#include"partition_pool.h"
+
+using namespace std;
+
+// Structure that holds the allocation map of a memory divided into blocks. Each bit is one block
+// and is set while the block is in use. Bits past the last block are always set.
+typedef struct {
+    vector<uint64_t> words;     // The bits, 64 blocks per word.
+    int number_of_blocks;       // The number of blocks in memory.
+} BitmapMemory;
+
+// One data item in memory. Compaction moves data down without changing its order, so the start
+// block is updated in place.
+struct ResidentEntry{
+    mutable int start;          // The first block of the data.
+    int index;                  // The data index.
+    ResidentEntry(int start, int index) : start(start), index(index){}
+};
+
+// Orders the data in memory by the block it starts at, so they can be looked up by a block.
+struct ResidentOrder{
+    using is_transparent = void;
+    bool operator()(const ResidentEntry &a, const ResidentEntry &b) const { return a.start < b.start; }
+    bool operator()(const ResidentEntry &a, int block) const { return a.start < block; }
+    bool operator()(int block, const ResidentEntry &b) const { return block < b.start; }
+};
+
+// The data in memory, ordered by the block it starts at. This is the same order as the
+// DynamicPartition list, so the processor visits data in the same order. Data of size zero takes
+// no blocks, so more than one item can start at the same block.
+typedef pmr::multiset<ResidentEntry, ResidentOrder> ResidentMap;
+
+// One hole in memory. A hole runs from the end of one data item to the start of the next, or to
+// the end of memory, so data of size zero splits a run of free blocks the same way it does in the
+// DynamicPartition list. Placing or freeing data only moves the edges of a hole between its
+// neighbours, so they are updated in place.
+struct HoleEntry{
+    mutable int start;          // The first block of the hole.
+    mutable int length;         // The number of blocks in the hole.
+    HoleEntry(int start, int length) : start(start), length(length){}
+};
+
+// Orders the holes by the block they start at, so they can be looked up by a block.
+struct HoleOrder{
+    using is_transparent = void;
+    bool operator()(const HoleEntry &a, const HoleEntry &b) const { return a.start < b.start; }
+    bool operator()(const HoleEntry &a, int block) const { return a.start < block; }
+    bool operator()(int block, const HoleEntry &b) const { return block < b.start; }
+};
+
+// The holes in memory, in address order. Holes of no blocks are not kept.
+typedef pmr::set<HoleEntry, HoleOrder> HoleSet;
+
+// Structure that holds the state of the dynamic partitioning experiment on a bitmap memory.
+typedef struct {
+    BitmapMemory memory;            // The allocation map.
+    ResidentMap resident;           // Start block to data index, in address order.
+    vector<int> start_block;        // The start block of each data item in memory.
+    vector<int> block_count;        // The number of blocks each data item in memory occupies.
+    int memory_units;               // The size of memory in MB.
+    int blocks_per_unit;            // The number of blocks in one MB.
+    int used_units;                 // The memory held by data, in MB.
+    HoleSet holes = HoleSet(dynamic_partition_resource());  // The holes, in address order.
+    int longest_hole = 0;           // No hole is longer than this. A failed search makes it exact.
+} BitmapPartitions;
+
+// Function prototypes
+void bitmap_init(BitmapMemory &memory, int number_of_blocks);
+void bitmap_set_range(BitmapMemory &memory, int start, int length);
+void bitmap_clear_range(BitmapMemory &memory, int start, int length);
+int bitmap_next_free(const BitmapMemory &memory, int from);
+int bitmap_next_used(const BitmapMemory &memory, int from);
+void bitmap_add_hole(BitmapPartitions &partitions, int start, int length, MemoryMetrics &metrics);
+int bitmap_find_hole(BitmapPartitions &partitions, int length);
+int bitmap_compact(BitmapPartitions &partitions, MemoryMetrics &metrics);
+void bitmap_fill_hole(BitmapPartitions &partitions, ResidentMap::const_iterator entry, MemoryMetrics &metrics);
+void bitmap_merge_holes(BitmapPartitions &partitions, ResidentMap::const_iterator entry, MemoryMetrics &metrics);
+void bitmap_first_fit_algorithm(Data data[], int number_of_samples, BitmapPartitions &partitions, int &next_data, int &num_data_members_in_partition_table, int &number_of_failures, MemoryMetrics &metrics);
+void dynamic_bitmap_partitioning(Data data[], int number_of_samples, Results* first_fit, int memory_units, int blocks_per_unit);
\ No newline at end of file
@@ -1,2 +1,2 @@
-g++ -o main main.cpp equal.cpp one_queue_unequal.cpp multiple_queues_unequal.cpp dynamic.cpp
+g++ -O2 -pthread -o main main.cpp equal.cpp one_queue_unequal.cpp multiple_queues_unequal.cpp dynamic.cpp static_layouts.cpp benchmark.cpp metrics.cpp partition_pool.cpp bitmap_memory.cpp streaming.cpp pipeline.cpp histogram.cpp differential.cpp scheduling.cpp swapping.cpp lookahead.cpp resizing.cpp numa.cpp optimizer.cpp importance.cpp lockstep.cpp checkpoint.cpp paging.cpp slab.cpp telemetry.cpp scenario.cpp experiment_data.cpp memsim.cpp
 
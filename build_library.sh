@@ -0,0 +1,11 @@
+# Builds the simulator as libmemsim.a and libmemsim.so for the C interface in memsim.h, then builds
+# and runs the C smoke test against the shared library. Only the sources the C interface needs go
+# into the library, and memsim.map keeps every symbol but the memsim_ functions local to
+# libmemsim.so. Programs that link the static library also need the C++ runtime and pthreads (link
+# with g++ -pthread).
+SOURCES="memsim.cpp static_layouts.cpp bitmap_memory.cpp metrics.cpp histogram.cpp partition_pool.cpp experiment_data.cpp"
+OBJECTS=$(echo $SOURCES | sed 's/\.cpp/.o/g')
+g++ -O2 -pthread -fPIC -fvisibility=hidden -fvisibility-inlines-hidden -c $SOURCES && ar rcs libmemsim.a $OBJECTS && g++ -shared -pthread -Wl,--version-script=memsim.map -Wl,--no-undefined -o libmemsim.so $OBJECTS && gcc -std=c99 -pedantic -Wall -Wextra -Werror -o memsim_smoke memsim_smoke.c ./libmemsim.so -Wl,-rpath,'$ORIGIN' && ./memsim_smoke
+STATUS=$?
+rm -f $OBJECTS memsim_smoke
+exit $STATUS
\ No newline at end of file
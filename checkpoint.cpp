@@ -0,0 +1,745 @@
+/**************************************************************************************************
+ * File: checkpoint.cpp
+ * Author: Nolan Davenport
+ * Procedures:
+ *
+ * put_u32                      - Appends a 32 bit value in little endian order.
+ *
+ * put_u64                      - Appends a 64 bit value in little endian order.
+ *
+ * put_string                   - Appends a string with its length.
+ *
+ * get_u32                      - Reads a 32 bit value in little endian order.
+ *
+ * get_u64                      - Reads a 64 bit value in little endian order.
+ *
+ * get_string                   - Reads a string with its length.
+ *
+ * checkpoint_checksum          - Gets the FNV-1a hash of a range of bytes.
+ *
+ * encode_results               - Appends the accumulators of a style, with only the histogram
+ *                                buckets that hold values.
+ *
+ * decode_results               - Reads the accumulators of a style.
+ *
+ * save_random_state            - Writes the random engine and distributions to a string.
+ *
+ * restore_random_state         - Reads the random engine and distributions from a string.
+ *
+ * encode_checkpoint            - Writes a snapshot in the compact binary checkpoint format.
+ *
+ * decode_checkpoint            - Reads a snapshot from the binary checkpoint format.
+ *
+ * write_checkpoint_file        - Replaces a checkpoint file atomically.
+ *
+ * load_checkpoint              - Reads and checks a checkpoint file.
+ *
+ * apply_checkpoint             - Copies the accumulators of a snapshot into the running styles.
+ *
+ * checkpoint_writer            - Writes the newest whole snapshot in the background.
+ *
+ * start_checkpoints            - Starts the checkpoint writer thread.
+ *
+ * capture_random_state         - Adds the state of the generator to the snapshot of an experiment.
+ *
+ * capture_style                - Adds the accumulators of one style to the snapshot of an
+ *                                experiment.
+ *
+ * finish_checkpoints           - Writes the last snapshot and stops the writer thread.
+ *************************************************************************************************/
+
+#include<iostream>
+#include<random>
+#include<queue>
+#include<list>
+#include<vector>
+#include<map>
+#include<string>
+#include<sstream>
+#include<fstream>
+#include<iterator>
+#include<cstring>
+#include<cstdio>
+#include<fcntl.h>
+#include<unistd.h>
+
+#include"main.h"
+#include"checkpoint.h"
+
+using namespace std;
+
+// Reads the checkpoint format, failing once it runs past the end.
+typedef struct {
+    const vector<uint8_t>* bytes;   // The file.
+    size_t position;                // The next byte to read.
+    bool failed;                    // Whether a read ran past the end.
+} CheckpointReader;
+
+/**************************************************************************************************
+ * static void put_u32(vector<uint8_t> &bytes, uint32_t value)
+ *
+ * Author: Nolan Davenport
+ * Description: Appends a 32 bit value in little endian order, so files move between machines.
+ *
+ * Parameters:
+ *  bytes   I/O     vector<uint8_t> (&)     The file being written.
+ *  value   I/P     uint32_t                The value.
+ *************************************************************************************************/
+static void put_u32(vector<uint8_t> &bytes, uint32_t value){
+    for(int i = 0; i < 4; i++){
+        bytes.push_back((value >> (8 * i)) & 0xff);
+    }
+}
+
+/**************************************************************************************************
+ * static void put_u64(vector<uint8_t> &bytes, uint64_t value)
+ *
+ * Author: Nolan Davenport
+ * Description: Appends a 64 bit value in little endian order.
+ *
+ * Parameters:
+ *  bytes   I/O     vector<uint8_t> (&)     The file being written.
+ *  value   I/P     uint64_t                The value.
+ *************************************************************************************************/
+static void put_u64(vector<uint8_t> &bytes, uint64_t value){
+    put_u32(bytes, value & 0xffffffffu);
+    put_u32(bytes, value >> 32);
+}
+
+/**************************************************************************************************
+ * static void put_float(vector<uint8_t> &bytes, float value)
+ *
+ * Author: Nolan Davenport
+ * Description: Appends the bits of a float, so it is restored exactly.
+ *
+ * Parameters:
+ *  bytes   I/O     vector<uint8_t> (&)     The file being written.
+ *  value   I/P     float                   The value.
+ *************************************************************************************************/
+static void put_float(vector<uint8_t> &bytes, float value){
+    uint32_t bits;
+    memcpy(&bits, &value, sizeof(bits));
+    put_u32(bytes, bits);
+}
+
+/**************************************************************************************************
+ * static void put_string(vector<uint8_t> &bytes, const string &value)
+ *
+ * Author: Nolan Davenport
+ * Description: Appends a string with its length.
+ *
+ * Parameters:
+ *  bytes   I/O     vector<uint8_t> (&)     The file being written.
+ *  value   I/P     const string (&)        The string.
+ *************************************************************************************************/
+static void put_string(vector<uint8_t> &bytes, const string &value){
+    put_u32(bytes, value.size());
+    bytes.insert(bytes.end(), value.begin(), value.end());
+}
+
+/**************************************************************************************************
+ * static uint32_t get_u32(CheckpointReader &reader)
+ *
+ * Author: Nolan Davenport
+ * Description: Reads a 32 bit value in little endian order. Past the end it reads zero and marks
+ *              the reader as failed.
+ *
+ * Parameters:
+ *  reader      I/O     CheckpointReader (&)    The file being read.
+ *  get_u32     O/P     uint32_t                The value.
+ *************************************************************************************************/
+static uint32_t get_u32(CheckpointReader &reader){
+    if(reader.position + 4 > reader.bytes->size()){
+        reader.failed = true;
+        return 0;
+    }
+    uint32_t value = 0;
+    for(int i = 0; i < 4; i++){
+        value |= (uint32_t)(*reader.bytes)[reader.position++] << (8 * i);
+    }
+    return value;
+}
+
+/**************************************************************************************************
+ * static uint64_t get_u64(CheckpointReader &reader)
+ *
+ * Author: Nolan Davenport
+ * Description: Reads a 64 bit value in little endian order.
+ *
+ * Parameters:
+ *  reader      I/O     CheckpointReader (&)    The file being read.
+ *  get_u64     O/P     uint64_t                The value.
+ *************************************************************************************************/
+static uint64_t get_u64(CheckpointReader &reader){
+    uint64_t low = get_u32(reader);
+    uint64_t high = get_u32(reader);
+    return low | (high << 32);
+}
+
+/**************************************************************************************************
+ * static float get_float(CheckpointReader &reader)
+ *
+ * Author: Nolan Davenport
+ * Description: Reads the bits of a float.
+ *
+ * Parameters:
+ *  reader      I/O     CheckpointReader (&)    The file being read.
+ *  get_float   O/P     float                   The value.
+ *************************************************************************************************/
+static float get_float(CheckpointReader &reader){
+    uint32_t bits = get_u32(reader);
+    float value;
+    memcpy(&value, &bits, sizeof(value));
+    return value;
+}
+
+/**************************************************************************************************
+ * static string get_string(CheckpointReader &reader)
+ *
+ * Author: Nolan Davenport
+ * Description: Reads a string with its length.
+ *
+ * Parameters:
+ *  reader      I/O     CheckpointReader (&)    The file being read.
+ *  get_string  O/P     string                  The string.
+ *************************************************************************************************/
+static string get_string(CheckpointReader &reader){
+    uint32_t length = get_u32(reader);
+    if(reader.failed || reader.position + length > reader.bytes->size()){
+        reader.failed = true;
+        return string();
+    }
+    string value(reader.bytes->begin() + reader.position, reader.bytes->begin() + reader.position + length);
+    reader.position += length;
+    return value;
+}
+
+/**************************************************************************************************
+ * static uint64_t checkpoint_checksum(const uint8_t* bytes, size_t length)
+ *
+ * Author: Nolan Davenport
+ * Description: Gets the FNV-1a hash of a range of bytes, which catches a truncated or damaged
+ *              file.
+ *
+ * Parameters:
+ *  bytes                   I/P     const uint8_t*  The bytes.
+ *  length                  I/P     size_t          The number of bytes.
+ *  checkpoint_checksum     O/P     uint64_t        The hash.
+ *************************************************************************************************/
+static uint64_t checkpoint_checksum(const uint8_t* bytes, size_t length){
+    uint64_t hash = 14695981039346656037ull;
+    for(size_t i = 0; i < length; i++){
+        hash = (hash ^ bytes[i]) * 1099511628211ull;
+    }
+    return hash;
+}
+
+/**************************************************************************************************
+ * static void encode_results(vector<uint8_t> &bytes, const Results &results)
+ *
+ * Author: Nolan Davenport
+ * Description: Appends the accumulators of a style. Only the recorded points of the time series
+ *              and the histogram buckets that hold values are written, which keeps the file to a
+ *              few KB instead of the whole structure.
+ *
+ * Parameters:
+ *  bytes       I/O     vector<uint8_t> (&)     The file being written.
+ *  results     I/P     const Results (&)       The accumulators.
+ *************************************************************************************************/
+static void encode_results(vector<uint8_t> &bytes, const Results &results){
+    put_float(bytes, results.turn_around_time);
+    put_float(bytes, results.relative_turn_around_time);
+    put_float(bytes, results.number_of_failures);
+    put_float(bytes, results.average_num_data_members_in_partition_table);
+    put_float(bytes, results.average_memory_utilization);
+    put_float(bytes, results.average_internal_fragmentation);
+    put_float(bytes, results.average_hole_count);
+    put_float(bytes, results.average_largest_hole);
+
+    const TimeSeries &series = results.memory_utilization_over_time;
+    put_u32(bytes, series.count);
+    put_u32(bytes, series.ticks_per_point);
+    put_float(bytes, series.pending_sum);
+    put_u32(bytes, series.pending_ticks);
+    for(int i = 0; i < series.count; i++){
+        put_float(bytes, series.values[i]);
+    }
+
+    for(const Histogram* histogram : {&results.turn_around_histogram, &results.relative_turn_around_histogram}){
+        put_u64(bytes, histogram->max);
+        uint32_t used = 0;                                          // The buckets that hold values.
+        for(int i = 0; i < HISTOGRAM_BUCKETS; i++){
+            used += (histogram->counts[i] != 0);
+        }
+        put_u32(bytes, used);
+        for(int i = 0; i < HISTOGRAM_BUCKETS; i++){
+            if(histogram->counts[i] != 0){
+                put_u32(bytes, i);
+                put_u64(bytes, histogram->counts[i]);
+            }
+        }
+    }
+}
+
+/**************************************************************************************************
+ * static bool decode_results(CheckpointReader &reader, Results &results)
+ *
+ * Author: Nolan Davenport
+ * Description: Reads the accumulators of a style written by encode_results.
+ *
+ * Parameters:
+ *  reader          I/O     CheckpointReader (&)    The file being read.
+ *  results         O/P     Results (&)             The accumulators, starting empty.
+ *  decode_results  O/P     bool                    Whether they were read.
+ *************************************************************************************************/
+static bool decode_results(CheckpointReader &reader, Results &results){
+    results.turn_around_time = get_float(reader);
+    results.relative_turn_around_time = get_float(reader);
+    results.number_of_failures = get_float(reader);
+    results.average_num_data_members_in_partition_table = get_float(reader);
+    results.average_memory_utilization = get_float(reader);
+    results.average_internal_fragmentation = get_float(reader);
+    results.average_hole_count = get_float(reader);
+    results.average_largest_hole = get_float(reader);
+
+    TimeSeries &series = results.memory_utilization_over_time;
+    uint32_t count = get_u32(reader);
+    if(count > TIME_SERIES_CAPACITY){
+        return false;
+    }
+    series.count = count;
+    series.ticks_per_point = get_u32(reader);
+    series.pending_sum = get_float(reader);
+    series.pending_ticks = get_u32(reader);
+    for(uint32_t i = 0; i < count; i++){
+        series.values[i] = get_float(reader);
+    }
+
+    for(Histogram* histogram : {&results.turn_around_histogram, &results.relative_turn_around_histogram}){
+        histogram->max = get_u64(reader);
+        uint32_t used = get_u32(reader);
+        for(uint32_t i = 0; i < used && !reader.failed; i++){
+            uint32_t bucket = get_u32(reader);
+            if(bucket >= HISTOGRAM_BUCKETS){
+                return false;
+            }
+            histogram->counts[bucket] = get_u64(reader);
+        }
+    }
+    return !reader.failed;
+}
+
+/**************************************************************************************************
+ * string save_random_state(const default_random_engine &gen,
+ *                          const poisson_distribution<int> &poisson_dist,
+ *                          const uniform_int_distribution<int> &uniform_dist)
+ *
+ * Author: Nolan Davenport
+ * Description: Writes the random engine and distributions to a string with the standard stream
+ *              operators. The distributions can keep state between draws, so they are saved
+ *              with the engine.
+ *
+ * Parameters:
+ *  gen                 I/P     const default_random_engine (&)         The random engine.
+ *  poisson_dist        I/P     const poisson_distribution<int> (&)     The size distribution.
+ *  uniform_dist        I/P     const uniform_int_distribution<int> (&) The time distribution.
+ *  save_random_state   O/P     string                                  Their state.
+ *************************************************************************************************/
+string save_random_state(const default_random_engine &gen, const poisson_distribution<int> &poisson_dist,
+                         const uniform_int_distribution<int> &uniform_dist){
+    ostringstream state;
+    state.precision(17);                            // The distributions hold doubles.
+    state << gen << ' ' << poisson_dist << ' ' << uniform_dist;
+    return state.str();
+}
+
+/**************************************************************************************************
+ * bool restore_random_state(const string &state, default_random_engine &gen,
+ *                           poisson_distribution<int> &poisson_dist,
+ *                           uniform_int_distribution<int> &uniform_dist)
+ *
+ * Author: Nolan Davenport
+ * Description: Reads the random engine and distributions from a string made by
+ *              save_random_state.
+ *
+ * Parameters:
+ *  state                   I/P     const string (&)                    Their state.
+ *  gen                     O/P     default_random_engine (&)           The random engine.
+ *  poisson_dist            O/P     poisson_distribution<int> (&)       The size distribution.
+ *  uniform_dist            O/P     uniform_int_distribution<int> (&)   The time distribution.
+ *  restore_random_state    O/P     bool                                Whether the state was read.
+ *************************************************************************************************/
+bool restore_random_state(const string &state, default_random_engine &gen, poisson_distribution<int> &poisson_dist,
+                          uniform_int_distribution<int> &uniform_dist){
+    istringstream input(state);
+    input >> gen >> poisson_dist >> uniform_dist;
+    return !input.fail();
+}
+
+/**************************************************************************************************
+ * vector<uint8_t> encode_checkpoint(const CheckpointSnapshot &snapshot,
+ *                                   const vector<CheckpointStyle> &styles)
+ *
+ * Author: Nolan Davenport
+ * Description: Writes a snapshot in the compact binary checkpoint format: the magic and version,
+ *              the experiments done, the seed, the options and the random state, then for each
+ *              style its results and its named statistics, and last a checksum of all of it.
+ *
+ * Parameters:
+ *  snapshot            I/P     const CheckpointSnapshot (&)        The snapshot.
+ *  styles              I/P     const vector<CheckpointStyle> (&)   The styles, for the region names.
+ *  encode_checkpoint   O/P     vector<uint8_t>                     The file.
+ *************************************************************************************************/
+vector<uint8_t> encode_checkpoint(const CheckpointSnapshot &snapshot, const vector<CheckpointStyle> &styles){
+    vector<uint8_t> bytes(CHECKPOINT_MAGIC, CHECKPOINT_MAGIC + sizeof(CHECKPOINT_MAGIC));
+    put_u32(bytes, CHECKPOINT_VERSION);
+    put_u32(bytes, snapshot.experiment);
+    put_u64(bytes, snapshot.seed);
+    put_string(bytes, snapshot.options);
+    put_string(bytes, snapshot.random_state);
+
+    put_u32(bytes, styles.size());
+    for(size_t style = 0; style < styles.size(); style++){
+        encode_results(bytes, snapshot.results[style]);
+        put_u32(bytes, styles[style].regions.size());
+        size_t offset = 0;                                          // The regions are stored back to back.
+        for(const CheckpointRegion &region : styles[style].regions){
+            put_string(bytes, region.name);
+            put_u32(bytes, region.size);
+            bytes.insert(bytes.end(), snapshot.regions[style].begin() + offset,
+                snapshot.regions[style].begin() + offset + region.size);
+            offset += region.size;
+        }
+    }
+
+    put_u64(bytes, checkpoint_checksum(bytes.data(), bytes.size()));
+    return bytes;
+}
+
+/**************************************************************************************************
+ * bool decode_checkpoint(const vector<uint8_t> &bytes, const vector<CheckpointStyle> &styles,
+ *                        const string &options, CheckpointSnapshot &snapshot, string &error)
+ *
+ * Author: Nolan Davenport
+ * Description: Reads a snapshot from the binary checkpoint format. A run can only be resumed
+ *              with the options it was started with, since they decide what the accumulators
+ *              hold, so the styles and their statistics must be the ones the file was written
+ *              with.
+ *
+ * Parameters:
+ *  bytes               I/P     const vector<uint8_t> (&)           The file.
+ *  styles              I/P     const vector<CheckpointStyle> (&)   The styles of this run.
+ *  options             I/P     const string (&)                    The options of this run.
+ *  snapshot            O/P     CheckpointSnapshot (&)              The snapshot.
+ *  error               O/P     string (&)                          Why it couldn't be read.
+ *  decode_checkpoint   O/P     bool                                Whether it was read.
+ *************************************************************************************************/
+bool decode_checkpoint(const vector<uint8_t> &bytes, const vector<CheckpointStyle> &styles,
+                       const string &options, CheckpointSnapshot &snapshot, string &error){
+    size_t magic_size = sizeof(CHECKPOINT_MAGIC);
+    if(bytes.size() < magic_size + 8 || memcmp(bytes.data(), CHECKPOINT_MAGIC, magic_size) != 0){
+        error = "not a checkpoint file";
+        return false;
+    }
+    CheckpointReader checksum_reader{&bytes, bytes.size() - 8, false};
+    if(get_u64(checksum_reader) != checkpoint_checksum(bytes.data(), bytes.size() - 8)){
+        error = "the checkpoint is damaged";
+        return false;
+    }
+
+    CheckpointReader reader{&bytes, magic_size, false};
+    if(get_u32(reader) != CHECKPOINT_VERSION){
+        error = "the checkpoint was written by another version";
+        return false;
+    }
+    snapshot.experiment = get_u32(reader);
+    snapshot.seed = get_u64(reader);
+    snapshot.options = get_string(reader);
+    if(!reader.failed && snapshot.options != options){
+        error = "the checkpoint was written with the options \"" + snapshot.options + "\"";
+        return false;
+    }
+    snapshot.random_state = get_string(reader);
+
+    if(get_u32(reader) != styles.size()){
+        error = "the checkpoint has other partitioning styles";
+        return false;
+    }
+    snapshot.results.assign(styles.size(), Results());
+    snapshot.regions.assign(styles.size(), vector<uint8_t>());
+    for(size_t style = 0; style < styles.size() && !reader.failed; style++){
+        if(!decode_results(reader, snapshot.results[style]) ||
+            get_u32(reader) != styles[style].regions.size()){
+            error = "the checkpoint has other statistics";
+            return false;
+        }
+        for(const CheckpointRegion &region : styles[style].regions){
+            string name = get_string(reader);
+            if(name != region.name || get_u32(reader) != region.size ||
+                reader.position + region.size > bytes.size()){
+                error = "the checkpoint has other statistics";
+                return false;
+            }
+            snapshot.regions[style].insert(snapshot.regions[style].end(), bytes.begin() + reader.position,
+                bytes.begin() + reader.position + region.size);
+            reader.position += region.size;
+        }
+    }
+    if(reader.failed){
+        error = "the checkpoint is truncated";
+        return false;
+    }
+    return true;
+}
+
+/**************************************************************************************************
+ * bool write_checkpoint_file(const string &file_name, const vector<uint8_t> &bytes)
+ *
+ * Author: Nolan Davenport
+ * Description: Replaces a checkpoint file atomically. The bytes go to a temporary file that is
+ *              flushed to disk and then renamed over the old one, so a crash leaves either the
+ *              old checkpoint or the new one, never part of one.
+ *
+ * Parameters:
+ *  file_name               I/P     const string (&)            The checkpoint file.
+ *  bytes                   I/P     const vector<uint8_t> (&)   The file contents.
+ *  write_checkpoint_file   O/P     bool                        Whether it was written.
+ *************************************************************************************************/
+bool write_checkpoint_file(const string &file_name, const vector<uint8_t> &bytes){
+    string temporary = file_name + ".tmp";
+    int file = open(temporary.c_str(), O_WRONLY | O_CREAT | O_TRUNC, 0644);
+    if(file < 0){
+        return false;
+    }
+    size_t written = 0;
+    while(written < bytes.size()){
+        ssize_t count = write(file, bytes.data() + written, bytes.size() - written);
+        if(count <= 0){
+            close(file);
+            unlink(temporary.c_str());
+            return false;
+        }
+        written += count;
+    }
+    bool synced = (fsync(file) == 0);
+    if(close(file) != 0 || !synced || rename(temporary.c_str(), file_name.c_str()) != 0){
+        unlink(temporary.c_str());
+        return false;
+    }
+    return true;
+}
+
+/**************************************************************************************************
+ * bool load_checkpoint(const string &file_name, const vector<CheckpointStyle> &styles,
+ *                      const string &options, CheckpointSnapshot &snapshot, string &error)
+ *
+ * Author: Nolan Davenport
+ * Description: Reads and checks a checkpoint file.
+ *
+ * Parameters:
+ *  file_name           I/P     const string (&)                    The checkpoint file.
+ *  styles              I/P     const vector<CheckpointStyle> (&)   The styles of this run.
+ *  options             I/P     const string (&)                    The options of this run.
+ *  snapshot            O/P     CheckpointSnapshot (&)              The snapshot.
+ *  error               O/P     string (&)                          Why it couldn't be loaded.
+ *  load_checkpoint     O/P     bool                                Whether it was loaded.
+ *************************************************************************************************/
+bool load_checkpoint(const string &file_name, const vector<CheckpointStyle> &styles, const string &options,
+                     CheckpointSnapshot &snapshot, string &error){
+    ifstream file(file_name, ios::binary);
+    if(!file){
+        error = "can't open " + file_name;
+        return false;
+    }
+    vector<uint8_t> bytes((istreambuf_iterator<char>(file)), istreambuf_iterator<char>());
+    return decode_checkpoint(bytes, styles, options, snapshot, error);
+}
+
+/**************************************************************************************************
+ * void apply_checkpoint(const CheckpointSnapshot &snapshot, const vector<CheckpointStyle> &styles)
+ *
+ * Author: Nolan Davenport
+ * Description: Copies the accumulators of a snapshot into the running styles.
+ *
+ * Parameters:
+ *  snapshot    I/P     const CheckpointSnapshot (&)        The snapshot.
+ *  styles      I/P     const vector<CheckpointStyle> (&)   The styles to restore.
+ *************************************************************************************************/
+void apply_checkpoint(const CheckpointSnapshot &snapshot, const vector<CheckpointStyle> &styles){
+    for(size_t style = 0; style < styles.size(); style++){
+        *styles[style].results = snapshot.results[style];
+        size_t offset = 0;
+        for(const CheckpointRegion &region : styles[style].regions){
+            memcpy(region.address, snapshot.regions[style].data() + offset, region.size);
+            offset += region.size;
+        }
+    }
+}
+
+/**************************************************************************************************
+ * void checkpoint_writer(Checkpointer* checkpointer)
+ *
+ * Author: Nolan Davenport
+ * Description: Writes the newest whole snapshot in the background until asked to stop, so the
+ *              experiment threads never wait for the disk.
+ *
+ * Parameters:
+ *  checkpointer    I/O     Checkpointer*   The checkpoints of the run.
+ *************************************************************************************************/
+void checkpoint_writer(Checkpointer* checkpointer){
+    unique_lock<mutex> guard(checkpointer->lock);
+    for(;;){
+        checkpointer->wake.wait(guard, [&]{ return checkpointer->has_ready || checkpointer->stopping; });
+        if(!checkpointer->has_ready){                               // Stopping with nothing left to write.
+            return;
+        }
+        CheckpointSnapshot snapshot = move(checkpointer->ready);    // Take the snapshot and let the
+        checkpointer->has_ready = false;                            // threads go on while it is written.
+        guard.unlock();
+
+        bool written = write_checkpoint_file(checkpointer->file_name,
+            encode_checkpoint(snapshot, checkpointer->styles));
+
+        guard.lock();
+        if(written){
+            checkpointer->written++;
+        }else{
+            checkpointer->failed++;
+        }
+    }
+}
+
+/**************************************************************************************************
+ * void start_checkpoints(Checkpointer* checkpointer)
+ *
+ * Author: Nolan Davenport
+ * Description: Starts the checkpoint writer thread. The file, interval, options, seed and styles
+ *              must be set first.
+ *
+ * Parameters:
+ *  checkpointer    I/O     Checkpointer*   The checkpoints of the run.
+ *************************************************************************************************/
+void start_checkpoints(Checkpointer* checkpointer){
+    checkpointer->writer = thread(checkpoint_writer, checkpointer);
+}
+
+/**************************************************************************************************
+ * static void checkpoint_part_done(Checkpointer* checkpointer, int experiment,
+ *                                  CheckpointSnapshot &snapshot)
+ *
+ * Author: Nolan Davenport
+ * Description: Counts a part copied into a snapshot. Once the generator and every style have
+ *              copied theirs, the snapshot replaces any older one waiting for the writer. The
+ *              lock must be held.
+ *
+ * Parameters:
+ *  checkpointer    I/O     Checkpointer*           The checkpoints of the run.
+ *  experiment      I/P     int                     The experiments done in the snapshot.
+ *  snapshot        I/O     CheckpointSnapshot (&)  The snapshot.
+ *************************************************************************************************/
+static void checkpoint_part_done(Checkpointer* checkpointer, int experiment, CheckpointSnapshot &snapshot){
+    if(++snapshot.captured < (int)checkpointer->styles.size() + 1){     // Still missing parts.
+        return;
+    }
+    if(!checkpointer->has_ready || checkpointer->ready.experiment < experiment){
+        checkpointer->ready = move(snapshot);
+        checkpointer->has_ready = true;
+        checkpointer->wake.notify_one();
+    }
+    checkpointer->assembling.erase(experiment);
+}
+
+/**************************************************************************************************
+ * static CheckpointSnapshot& assembling_snapshot(Checkpointer* checkpointer, int experiment)
+ *
+ * Author: Nolan Davenport
+ * Description: Gets the snapshot being assembled for a number of experiments done, starting it
+ *              if it is the first part. The lock must be held.
+ *
+ * Parameters:
+ *  checkpointer        I/O     Checkpointer*           The checkpoints of the run.
+ *  experiment          I/P     int                     The experiments done.
+ *  assembling_snapshot O/P     CheckpointSnapshot (&)  The snapshot.
+ *************************************************************************************************/
+static CheckpointSnapshot& assembling_snapshot(Checkpointer* checkpointer, int experiment){
+    auto found = checkpointer->assembling.find(experiment);
+    if(found != checkpointer->assembling.end()){
+        return found->second;
+    }
+    CheckpointSnapshot &snapshot = checkpointer->assembling[experiment];
+    snapshot.experiment = experiment;
+    snapshot.seed = checkpointer->seed;
+    snapshot.options = checkpointer->options;
+    snapshot.results.resize(checkpointer->styles.size());
+    snapshot.regions.resize(checkpointer->styles.size());
+    return snapshot;
+}
+
+/**************************************************************************************************
+ * void capture_random_state(Checkpointer* checkpointer, int experiment, const string &random_state)
+ *
+ * Author: Nolan Davenport
+ * Description: Adds the state of the generator to the snapshot of an experiment. It is called by
+ *              the generator once it has made the workloads of that many experiments.
+ *
+ * Parameters:
+ *  checkpointer    I/O     Checkpointer*       The checkpoints of the run.
+ *  experiment      I/P     int                 The experiments done.
+ *  random_state    I/P     const string (&)    The state from save_random_state.
+ *************************************************************************************************/
+void capture_random_state(Checkpointer* checkpointer, int experiment, const string &random_state){
+    lock_guard<mutex> guard(checkpointer->lock);
+    CheckpointSnapshot &snapshot = assembling_snapshot(checkpointer, experiment);
+    snapshot.random_state = random_state;
+    checkpoint_part_done(checkpointer, experiment, snapshot);
+}
+
+/**************************************************************************************************
+ * void capture_style(Checkpointer* checkpointer, int experiment, int style)
+ *
+ * Author: Nolan Davenport
+ * Description: Adds the accumulators of one style to the snapshot of an experiment. It is called
+ *              by the thread that runs the style, right after that many experiments, so nothing
+ *              else writes them meanwhile. Only a copy is made; the thread never waits for the
+ *              other styles or the disk.
+ *
+ * Parameters:
+ *  checkpointer    I/O     Checkpointer*   The checkpoints of the run.
+ *  experiment      I/P     int             The experiments done.
+ *  style           I/P     int             The index of the style.
+ *************************************************************************************************/
+void capture_style(Checkpointer* checkpointer, int experiment, int style){
+    const CheckpointStyle &captured = checkpointer->styles[style];
+    vector<uint8_t> regions;                                        // Copy the statistics before taking the lock.
+    for(const CheckpointRegion &region : captured.regions){
+        const uint8_t* start = (const uint8_t*)region.address;
+        regions.insert(regions.end(), start, start + region.size);
+    }
+
+    lock_guard<mutex> guard(checkpointer->lock);
+    CheckpointSnapshot &snapshot = assembling_snapshot(checkpointer, experiment);
+    snapshot.results[style] = *captured.results;
+    snapshot.regions[style] = move(regions);
+    checkpoint_part_done(checkpointer, experiment, snapshot);
+}
+
+/**************************************************************************************************
+ * void finish_checkpoints(Checkpointer* checkpointer)
+ *
+ * Author: Nolan Davenport
+ * Description: Writes the last snapshot and stops the writer thread.
+ *
+ * Parameters:
+ *  checkpointer    I/O     Checkpointer*   The checkpoints of the run.
+ *************************************************************************************************/
+void finish_checkpoints(Checkpointer* checkpointer){
+    {
+        lock_guard<mutex> guard(checkpointer->lock);
+        checkpointer->stopping = true;
+        checkpointer->wake.notify_one();
+    }
+    checkpointer->writer.join();
+    if(checkpointer->failed > 0){
+        cerr << checkpointer->failed << " checkpoints couldn't be written to " << checkpointer->file_name << endl;
+    }
+}
\ No newline at end of file
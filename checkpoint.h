@@ -0,0 +1,133 @@
+/**************************************************************************************************
+ * File: checkpoint.h
+ * Author: Nolan Davenport
+ * Procedures:
+ *
+ * checkpoint_region            - Describes a statistics structure that is saved byte for byte.
+ *
+ * save_random_state            - Writes the random engine and distributions to a string.
+ *
+ * restore_random_state         - Reads the random engine and distributions from a string.
+ *
+ * encode_checkpoint            - Writes a snapshot in the compact binary checkpoint format.
+ *
+ * decode_checkpoint            - Reads a snapshot from the binary checkpoint format.
+ *
+ * write_checkpoint_file        - Replaces a checkpoint file atomically.
+ *
+ * load_checkpoint              - Reads and checks a checkpoint file.
+ *
+ * apply_checkpoint             - Copies the accumulators of a snapshot into the running styles.
+ *
+ * checkpoint_writer            - Writes the newest whole snapshot in the background.
+ *
+ * start_checkpoints            - Starts the checkpoint writer thread.
+ *
+ * capture_random_state         - Adds the state of the generator to the snapshot of an experiment.
+ *
+ * capture_style                - Adds the accumulators of one style to the snapshot of an
+ *                                experiment.
+ *
+ * finish_checkpoints           - Writes the last snapshot and stops the writer thread.
+ *************************************************************************************************/
+
+#pragma once
+
+#include<iostream>
+#include<random>
+#include<queue>
+#include<list>
+#include<vector>
+#include<map>
+#include<string>
+#include<mutex>
+#include<thread>
+#include<condition_variable>
+#include<type_traits>
+#include<cstdint>
+
+#include"main.h"
+
+using namespace std;
+
+#define CHECKPOINT_MAGIC "MPSCKPT"          // The first bytes of every checkpoint file, with the nul.
+#define CHECKPOINT_VERSION 1                // Changes whenever the format does.
+#define CHECKPOINT_INTERVAL 50              // The experiments between checkpoints by default.
+
+// A statistics structure of a style that is saved and restored byte for byte.
+typedef struct {
+    const char* name;               // Identifies the structure in the file.
+    void* address;                  // The structure.
+    size_t size;                    // Its size in bytes.
+} CheckpointRegion;
+
+// The accumulators of one partitioning style, as written by the thread that runs it.
+typedef struct {
+    Results* results;                       // The results of the style.
+    vector<CheckpointRegion> regions;       // The statistics its strategy keeps.
+} CheckpointStyle;
+
+// Structure that holds everything needed to continue a run after a number of experiments.
+typedef struct {
+    int experiment = 0;                     // The experiments done.
+    long long seed = 0;                     // The seed of the run.
+    string options;                         // The command line options of the run.
+    string random_state;                    // The random engine and distributions.
+    vector<Results> results;                // The results of each style.
+    vector<vector<uint8_t>> regions;        // The statistics of each style, one after another.
+    int captured = 0;                       // The parts copied in so far.
+} CheckpointSnapshot;
+
+// Structure that assembles snapshots from the generator and the style threads and writes them.
+// Each thread copies its part at an experiment boundary and moves on; the last part to arrive
+// hands the snapshot to the writer thread, which does the file I/O. If the writer falls behind,
+// only the newest whole snapshot is kept.
+typedef struct {
+    string file_name;                           // The checkpoint file.
+    int interval = CHECKPOINT_INTERVAL;         // The experiments between checkpoints.
+    string options;                             // The command line options of the run.
+    long long seed = 0;                         // The seed of the run.
+    vector<CheckpointStyle> styles;             // The accumulators of every style.
+    mutex lock;                                 // Guards everything below.
+    condition_variable wake;                    // Signals the writer.
+    map<int, CheckpointSnapshot> assembling;    // Snapshots still missing parts, by experiment.
+    CheckpointSnapshot ready;                   // The newest whole snapshot not yet written.
+    bool has_ready = false;                     // Whether ready holds a snapshot.
+    bool stopping = false;                      // Whether the writer should finish.
+    long long written = 0;                      // The checkpoints written.
+    long long failed = 0;                       // The checkpoints that couldn't be written.
+    thread writer;                              // The writer thread.
+} Checkpointer;
+
+/**************************************************************************************************
+ * template<typename T>
+ * CheckpointRegion checkpoint_region(const char* name, T &statistics)
+ *
+ * Author: Nolan Davenport
+ * Description: Describes a statistics structure that is saved byte for byte. Only structures of
+ *              plain values can be saved this way.
+ *
+ * Parameters:
+ *  name                I/P     const char*         Identifies the structure in the file.
+ *  statistics          I/P     T (&)               The structure.
+ *  checkpoint_region   O/P     CheckpointRegion    The description.
+ *************************************************************************************************/
+template<typename T>
+CheckpointRegion checkpoint_region(const char* name, T &statistics){
+    static_assert(is_trivially_copyable<T>::value, "checkpoint regions are saved byte for byte");
+    return CheckpointRegion{name, &statistics, sizeof(T)};
+}
+
+// Function prototypes
+string save_random_state(const default_random_engine &gen, const poisson_distribution<int> &poisson_dist, const uniform_int_distribution<int> &uniform_dist);
+bool restore_random_state(const string &state, default_random_engine &gen, poisson_distribution<int> &poisson_dist, uniform_int_distribution<int> &uniform_dist);
+vector<uint8_t> encode_checkpoint(const CheckpointSnapshot &snapshot, const vector<CheckpointStyle> &styles);
+bool decode_checkpoint(const vector<uint8_t> &bytes, const vector<CheckpointStyle> &styles, const string &options, CheckpointSnapshot &snapshot, string &error);
+bool write_checkpoint_file(const string &file_name, const vector<uint8_t> &bytes);
+bool load_checkpoint(const string &file_name, const vector<CheckpointStyle> &styles, const string &options, CheckpointSnapshot &snapshot, string &error);
+void apply_checkpoint(const CheckpointSnapshot &snapshot, const vector<CheckpointStyle> &styles);
+void checkpoint_writer(Checkpointer* checkpointer);
+void start_checkpoints(Checkpointer* checkpointer);
+void capture_random_state(Checkpointer* checkpointer, int experiment, const string &random_state);
+void capture_style(Checkpointer* checkpointer, int experiment, int style);
+void finish_checkpoints(Checkpointer* checkpointer);
\ No newline at end of file
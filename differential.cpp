@@ -0,0 +1,553 @@
+/**************************************************************************************************
+ * File: differential.cpp
+ * Author: Nolan Davenport
+ * Procedures:
+ *
+ * set_job                          - Sets up one job of a workload.
+ *
+ * generate_differential_workload   - Makes one random or adversarial workload.
+ *
+ * same_value                       - Checks whether two results are exactly the same.
+ *
+ * compare_engines                  - Runs a reference and a candidate engine on a workload and
+ *                                    describes the first difference.
+ *
+ * shrink_workload                  - Shrinks a workload on which two engines differ.
+ *
+ * run_targeted_checks              - Checks the rules that random workloads rarely reach.
+ *
+ * run_differential_tests           - Checks every fast engine against its reference experiment.
+ *************************************************************************************************/
+
+#include<iostream>
+#include<random>
+#include<queue>
+#include<list>
+#include<vector>
+#include<string>
+#include<cstring>
+#include<functional>
+
+#include"main.h"
+#include"equal.h"
+#include"one_queue_unequal.h"
+#include"multiple_queues_unequal.h"
+#include"dynamic.h"
+#include"static_layouts.h"
+#include"bitmap_memory.h"
+#include"scheduling.h"
+#include"swapping.h"
+#include"lookahead.h"
+#include"resizing.h"
+#include"numa.h"
+#include"lockstep.h"
+#include"slab.h"
+#include"checkpoint.h"
+#include"memsim.h"
+#include"histogram.h"
+#include"differential.h"
+
+using namespace std;
+
+/**************************************************************************************************
+ * static void set_job(Data &job, int index, int size, int time)
+ *
+ * Author: Nolan Davenport
+ * Description: Sets up one job of a workload the same way generate_experiment_data does.
+ *
+ * Parameters:
+ *  job     O/P     Data (&)    The job.
+ *  index   I/P     int         Its position in the workload.
+ *  size    I/P     int         Its size in MB.
+ *  time    I/P     int         The time it needs.
+ *************************************************************************************************/
+static void set_job(Data &job, int index, int size, int time){
+    job.index = index;                  // Its position in the workload.
+    job.size = size;                    // Its size.
+    job.time = time;                    // The time it needs.
+    job.left = time;                    // Initiate the time left to the time.
+    job.time_start = 0;                 // Every job starts at zero.
+    job.time_end = 0;
+    job.turn_around_time = 0;
+    job.failure = false;
+}
+
+/**************************************************************************************************
+ * const char* generate_differential_workload(vector<Data> &workload, unsigned seed)
+ *
+ * Author: Nolan Davenport
+ * Description: Makes one workload. The seed picks both the kind of workload and its jobs, so
+ *              any workload can be made again from its seed. Besides the usual distributions
+ *              there are kinds aimed at the edges of the experiments: jobs larger than the
+ *              largest partition or all of memory, jobs of size 1, a single job, sizes right at
+ *              the partition boundaries, jobs that finish in one quantum and a mix of tiny and
+ *              huge jobs.
+ *
+ * Parameters:
+ *  workload                        O/P     vector<Data> (&)    The workload.
+ *  seed                            I/P     unsigned            The seed of the workload.
+ *  generate_differential_workload  O/P     const char*         The kind of workload.
+ *************************************************************************************************/
+const char* generate_differential_workload(vector<Data> &workload, unsigned seed){
+    static const char* kinds[DIFFERENTIAL_KINDS] = {"random", "huge jobs", "all size 1", "single job",
+        "boundary sizes", "all time 1", "tiny and huge"};
+    static const int boundary_sizes[] = {1, 2, 3, 4, 5, 6, 7, 8, 9, 12, 13, 16, 17, 55, 56, 57};
+
+    mt19937 gen(seed);                                          // The random engine for this workload. Unlike
+                                                                // the default engine, neighbouring seeds give
+                                                                // unrelated first draws.
+    int kind = seed % DIFFERENTIAL_KINDS;                       // The kind of workload.
+
+    poisson_distribution<int> poisson_dist(8);                  // Same size distribution as main.
+    uniform_int_distribution<int> uniform_dist(1,10);           // Same time distribution as main.
+    uniform_int_distribution<int> huge_dist(1,100);             // Sizes past the end of memory.
+    uniform_int_distribution<int> count_dist(1,NUMBER_OF_SAMPLES);  // The number of jobs.
+    uniform_int_distribution<int> boundary_dist(0, sizeof(boundary_sizes) / sizeof(int) - 1);
+
+    int number_of_samples = (kind == 3) ? 1 : count_dist(gen);  // A single job, or any number.
+    workload.resize(number_of_samples);
+    for(int i = 0; i < number_of_samples; i++){                 // Loop through the jobs.
+        int size;                                               // The size of this job.
+        int time = uniform_dist(gen);                           // The time it needs.
+        switch(kind){
+            case 0: size = max(1, poisson_dist(gen)); break;    // The usual workload.
+            case 1: size = huge_dist(gen); break;               // Many jobs over 16 and over 56.
+            case 2: size = 1; break;                            // Every job is as small as possible.
+            case 3: size = huge_dist(gen); break;               // A single job of any size.
+            case 4: size = boundary_sizes[boundary_dist(gen)]; break;   // Right at the boundaries.
+            case 5: size = max(1, poisson_dist(gen)); time = 1; break;  // Everything finishes at once.
+            default: size = (i % 2 == 0) ? 1 : 16 + huge_dist(gen); break;  // Tiny and huge in turn.
+        }
+        set_job(workload[i], i, size, time);                    // Set up the job.
+    }
+
+    return kinds[kind];
+}
+
+/**************************************************************************************************
+ * static bool same_value(float reference, float candidate)
+ *
+ * Author: Nolan Davenport
+ * Description: Checks whether two results are exactly the same. The bits are compared so that
+ *              the averages of experiments that end on the first tick, which are not a number
+ *              in the references, still match.
+ *
+ * Parameters:
+ *  reference   I/P     float   The reference result.
+ *  candidate   I/P     float   The candidate result.
+ *  same_value  O/P     bool    Whether they are the same.
+ *************************************************************************************************/
+static bool same_value(float reference, float candidate){
+    return memcmp(&reference, &candidate, sizeof(float)) == 0;
+}
+
+/**************************************************************************************************
+ * string compare_engines(const DifferentialPair &pair, vector<Data> &workload)
+ *
+ * Author: Nolan Davenport
+ * Description: Runs a reference and a candidate engine on a workload. Compares the clock at
+ *              which every job finished, then the results: turnaround times, failures, the
+ *              average number of data members, the percentile histograms and, if the candidate
+ *              tracks it, memory utilization.
+ *
+ * Parameters:
+ *  pair                I/P     const DifferentialPair (&)  The engines.
+ *  workload            I/P     vector<Data> (&)            The workload.
+ *  compare_engines     O/P     string                      The first difference, or empty if
+ *                                                          there is none.
+ *************************************************************************************************/
+string compare_engines(const DifferentialPair &pair, vector<Data> &workload){
+    int number_of_samples = workload.size();                    // The number of jobs.
+    Results* reference = new Results();                         // The reference results.
+    Results* candidate = new Results();                         // The candidate results.
+    vector<int> reference_completions(number_of_samples, -1);   // When each job finished in the reference
+    vector<int> candidate_completions(number_of_samples, -1);   // and in the candidate.
+
+    completion_times = reference_completions.data();            // Run the reference.
+    pair.reference(workload.data(), number_of_samples, reference);
+    completion_times = candidate_completions.data();            // Run the candidate.
+    pair.candidate(workload.data(), number_of_samples, candidate);
+    completion_times = nullptr;                                 // Stop recording.
+
+    string difference;                                          // The first difference found.
+    for(int i = 0; i < number_of_samples && difference.empty(); i++){   // Loop through the jobs.
+        if(reference_completions[i] != candidate_completions[i]){       // If it finished at another time:
+            difference = "job " + to_string(i) + " finished at " + to_string(candidate_completions[i]) +
+                " instead of " + to_string(reference_completions[i]);
+        }
+    }
+
+    struct{
+        const char* name;               // The name of the result.
+        float reference;                // The reference value.
+        float candidate;                // The candidate value.
+        bool compared;                  // Whether the candidate has it.
+    } values[] = {
+        {"turn_around_time", reference->turn_around_time, candidate->turn_around_time, true},
+        {"relative_turn_around_time", reference->relative_turn_around_time,
+            candidate->relative_turn_around_time, true},
+        {"number_of_failures", reference->number_of_failures, candidate->number_of_failures, true},
+        {"average number of data members", reference->average_num_data_members_in_partition_table,
+            candidate->average_num_data_members_in_partition_table, true},
+        {"average memory utilization", reference->average_memory_utilization,
+            candidate->average_memory_utilization, pair.tracks_memory},
+        {"average internal fragmentation", reference->average_internal_fragmentation,
+            candidate->average_internal_fragmentation, pair.tracks_memory},
+    };
+    for(auto &value : values){                                  // Loop through the results.
+        if(difference.empty() && value.compared && !same_value(value.reference, value.candidate)){
+            difference = string(value.name) + " is " + to_string(value.candidate) +
+                " instead of " + to_string(value.reference);
+        }
+    }
+
+    if(difference.empty() && (memcmp(&reference->turn_around_histogram, &candidate->turn_around_histogram,
+        sizeof(Histogram)) != 0 || memcmp(&reference->relative_turn_around_histogram,
+        &candidate->relative_turn_around_histogram, sizeof(Histogram)) != 0)){
+        difference = "the turnaround time histograms differ";
+    }
+
+    delete reference;                                           // Delete the results.
+    delete candidate;
+    return difference;
+}
+
+/**************************************************************************************************
+ * void shrink_workload(const DifferentialPair &pair, vector<Data> &workload)
+ *
+ * Author: Nolan Davenport
+ * Description: Shrinks a workload on which two engines differ to one that is as small as it can
+ *              find and still shows a difference. First it removes runs of jobs, halving the run
+ *              length each time down to single jobs, then it makes the sizes and times of the
+ *              remaining jobs smaller. This repeats until nothing more can be removed.
+ *
+ * Parameters:
+ *  pair        I/P     const DifferentialPair (&)  The engines.
+ *  workload    I/O     vector<Data> (&)            The failing workload. It is replaced with the
+ *                                                  shrunk one.
+ *************************************************************************************************/
+void shrink_workload(const DifferentialPair &pair, vector<Data> &workload){
+    bool progress = true;                                       // Whether the last pass shrank anything.
+    while(progress){                                            // Keep shrinking while it helps.
+        progress = false;
+
+        for(int run = workload.size() / 2; run >= 1; run /= 2){ // Try removing runs of jobs.
+            for(size_t start = 0; start + run <= workload.size() && workload.size() > 1;){
+                vector<Data> smaller(workload);                 // The workload without this run.
+                smaller.erase(smaller.begin() + start, smaller.begin() + start + run);
+                for(size_t i = 0; i < smaller.size(); i++){     // Number the jobs again.
+                    smaller[i].index = i;
+                }
+
+                if(!compare_engines(pair, smaller).empty()){    // If it still fails:
+                    workload.swap(smaller);                     // Keep it.
+                    progress = true;
+                }else{
+                    start += run;                               // Otherwise try the next run.
+                }
+            }
+        }
+
+        for(size_t i = 0; i < workload.size(); i++){            // Try making each job smaller.
+            for(int field = 0; field < 2; field++){             // First its size, then its time.
+                int value = (field == 0) ? workload[i].size : workload[i].time;
+                int tries[3] = {1, value / 2, value - 1};       // Smaller values to try, smallest first.
+                for(int smaller_value : tries){
+                    if(smaller_value < 1 || smaller_value >= value){    // Only try values that are smaller
+                        continue;                                       // and still valid.
+                    }
+                    vector<Data> smaller(workload);             // The workload with the smaller value.
+                    if(field == 0){
+                        smaller[i].size = smaller_value;
+                    }else{
+                        smaller[i].time = smaller[i].left = smaller_value;
+                    }
+
+                    if(!compare_engines(pair, smaller).empty()){    // If it still fails:
+                        workload.swap(smaller);                     // Keep it.
+                        progress = true;
+                        break;
+                    }
+                }
+            }
+        }
+    }
+}
+
+/**************************************************************************************************
+ * int run_targeted_checks()
+ *
+ * Author: Nolan Davenport
+ * Description: Checks the rules that random workloads rarely reach or that no reference covers:
+ *              the argument checks of the C interface, the swap victim policies, the resize
+ *              limit, the slab size classes and the random state a resumed run restarts from.
+ *
+ * Parameters:
+ *  run_targeted_checks     O/P     int     The number of checks that failed.
+ *************************************************************************************************/
+int run_targeted_checks(){
+    TargetedCheck checks[] = {
+        {"memsim rejects too many jobs per experiment", [](){
+            memsim_config config;
+            memsim_config_init(&config);
+            memsim_simulation* simulation = nullptr;
+            if(memsim_create(&config, &simulation) != MEMSIM_OK){
+                return false;
+            }
+            vector<memsim_job> jobs(MEMSIM_MAX_JOBS_PER_EXPERIMENT + 1, memsim_job{0, 4, 2});
+            bool holds = memsim_set_workloads(simulation, jobs.data(), jobs.size(),
+                    MEMSIM_MAX_JOBS_PER_EXPERIMENT + 1) == MEMSIM_INVALID_ARGUMENT &&
+                memsim_set_workloads(simulation, jobs.data(), jobs.size(),
+                    MEMSIM_MAX_JOBS_PER_EXPERIMENT) == MEMSIM_OK;
+            memsim_destroy(simulation);
+            return holds;
+        }},
+        {"memsim rejects equal partitions of different sizes", [](){
+            int uneven[] = {8, 8, 16};
+            int even[] = {8, 8, 8};
+            memsim_config config;
+            memsim_config_init(&config);
+            config.strategy = MEMSIM_EQUAL;
+            config.partition_count = 3;
+            config.partition_sizes = uneven;
+            memsim_simulation* simulation = nullptr;
+            if(memsim_create(&config, &simulation) != MEMSIM_INVALID_ARGUMENT || simulation != nullptr){
+                return false;
+            }
+            config.partition_sizes = even;
+            if(memsim_create(&config, &simulation) != MEMSIM_OK){
+                return false;
+            }
+            memsim_destroy(simulation);
+            return true;
+        }},
+        {"swap victims follow their policy", [](){
+            return better_swap_victim(SWAP_LONGEST_REMAINING, 9, 1, 5, 3, 8, 0) &&   // More time left wins,
+                !better_swap_victim(SWAP_LONGEST_REMAINING, 3, 8, 0, 9, 1, 5) &&
+                better_swap_victim(SWAP_LARGEST, 3, 8, 5, 9, 1, 0) &&               // more memory wins,
+                !better_swap_victim(SWAP_LARGEST, 9, 1, 0, 3, 8, 5) &&
+                better_swap_victim(SWAP_OLDEST, 3, 1, 0, 9, 8, 5) &&                // an earlier admission wins,
+                !better_swap_victim(SWAP_OLDEST, 9, 8, 5, 3, 1, 0) &&
+                !better_swap_victim(SWAP_LONGEST_REMAINING, 4, 4, 4, 4, 4, 4) &&    // the first of a tie stays,
+                !better_swap_victim(SWAP_NEVER, 9, 9, 0, 1, 1, 9);                  // and nothing is swapped
+        }},                                                                         // when swapping is off.
+        {"resizing never grows data past memory", [](){
+            reset_dynamic_partition_pool();
+            DynamicPartitionList partitions(dynamic_partition_resource());
+            partitions.push_back(DynamicPartition{20, 0, 0});
+            partitions.push_back(DynamicPartition{30, 20, 1});
+            MemoryMetrics metrics;
+            metrics_add_hole(metrics, MEMORY_END+1 - 50);
+            ResizeStats stats;
+            int moved = resize_dynamic_partition(partitions, partitions.begin(), 27, metrics, &stats);
+            return moved == 0 && stats.denied == 1 && partitions.front().size == 20 &&
+                metrics.hole_count == 1 && metrics.largest_hole == MEMORY_END+1 - 50;
+        }},
+        {"slab data goes to the smallest class it fits", [](){
+            SlabConfig config;
+            config.class_count = 3;
+            config.class_sizes[0] = 2;
+            config.class_sizes[1] = 4;
+            config.class_sizes[2] = 8;
+            return slab_class_for_size(config, 1) == 0 && slab_class_for_size(config, 2) == 0 &&
+                slab_class_for_size(config, 3) == 1 && slab_class_for_size(config, 8) == 2 &&
+                slab_class_for_size(config, 9) == config.class_count;           // Larger data is large.
+        }},
+        {"a resumed run draws the same workloads", [](){
+            default_random_engine gen(7);
+            poisson_distribution<int> poisson_dist(8);
+            uniform_int_distribution<int> uniform_dist(1,10);
+            Data skipped[NUMBER_OF_SAMPLES];
+            generate_experiment_data(skipped, gen, poisson_dist, uniform_dist);  // Stop mid run.
+            string state = save_random_state(gen, poisson_dist, uniform_dist);
+
+            default_random_engine resumed_gen;
+            poisson_distribution<int> resumed_poisson_dist(8);
+            uniform_int_distribution<int> resumed_uniform_dist(1,10);
+            if(!restore_random_state(state, resumed_gen, resumed_poisson_dist, resumed_uniform_dist)){
+                return false;
+            }
+            Data original[NUMBER_OF_SAMPLES];
+            Data resumed[NUMBER_OF_SAMPLES];
+            generate_experiment_data(original, gen, poisson_dist, uniform_dist);
+            generate_experiment_data(resumed, resumed_gen, resumed_poisson_dist, resumed_uniform_dist);
+            for(int i = 0; i < NUMBER_OF_SAMPLES; i++){
+                if(original[i].size != resumed[i].size || original[i].time != resumed[i].time){
+                    return false;
+                }
+            }
+            return true;
+        }},
+    };
+
+    int failed_checks = 0;                                      // The number of checks that failed.
+    for(TargetedCheck &check : checks){                         // Run and report every check.
+        bool holds = check.holds();
+        cout << check.name << ": " << (holds ? "holds" : "FAILS") << endl;
+        failed_checks += !holds;
+    }
+    return failed_checks;
+}
+
+/**************************************************************************************************
+ * int run_differential_tests(int number_of_workloads)
+ *
+ * Author: Nolan Davenport
+ * Description: Checks every fast engine against the reference experiment it must match on the
+ *              same seeded workloads. The first failing workload of each engine is shrunk and
+ *              printed so it can be reproduced. The targeted checks run after them.
+ *
+ * Parameters:
+ *  number_of_workloads     I/P     int     The number of workloads to check.
+ *  run_differential_tests  O/P     int     Zero if every engine matched, otherwise one.
+ *************************************************************************************************/
+int run_differential_tests(int number_of_workloads){
+    DifferentialPair pairs[] = {
+        {"equal fixed", equal_partitioning, equal_partitioning_fixed<EqualLayout>, false},
+        {"equal generic", equal_partitioning, [](Data* data, int number_of_samples, Results* results){
+            equal_partitioning_generic(data, number_of_samples, EqualLayout::sizes[0], EqualLayout::count, results);
+        }, false},
+        {"one_queue fixed", one_queue_unequal_partitioning, one_queue_partitioning_fixed<UnequalLayout>, false},
+        {"one_queue generic", one_queue_unequal_partitioning, [](Data* data, int number_of_samples, Results* results){
+            one_queue_partitioning_generic(data, number_of_samples, UnequalLayout::sizes, UnequalLayout::count, results);
+        }, false},
+        {"multiple_queue fixed", multiple_queues_unequal_partitioning,
+            multiple_queues_partitioning_fixed<UnequalLayout>, false},
+        {"multiple_queue generic", multiple_queues_unequal_partitioning, [](Data* data, int number_of_samples, Results* results){
+            multiple_queues_partitioning_generic(data, number_of_samples, UnequalLayout::sizes, UnequalLayout::count, results);
+        }, false},
+        {"equal lockstep", equal_partitioning, [](Data* data, int number_of_samples, Results* results){
+            const Data* workloads[] = {data};
+            lockstep_static_partitioning(workloads, &number_of_samples, 1, EQUAL_STYLE, EqualLayout::sizes,
+                EqualLayout::count, results);
+        }, false},
+        {"one_queue lockstep", one_queue_unequal_partitioning, [](Data* data, int number_of_samples, Results* results){
+            const Data* workloads[] = {data};
+            lockstep_static_partitioning(workloads, &number_of_samples, 1, ONE_QUEUE_STYLE, UnequalLayout::sizes,
+                UnequalLayout::count, results);
+        }, false},
+        {"multiple_queue lockstep", multiple_queues_unequal_partitioning, [](Data* data, int number_of_samples, Results* results){
+            const Data* workloads[] = {data};
+            lockstep_static_partitioning(workloads, &number_of_samples, 1, MULTIPLE_QUEUES_STYLE, UnequalLayout::sizes,
+                UnequalLayout::count, results);
+        }, false},
+        {"one_queue lockstep scalar", one_queue_unequal_partitioning, [](Data* data, int number_of_samples, Results* results){
+            const Data* workloads[] = {data};
+            lockstep_static_partitioning(workloads, &number_of_samples, 1, ONE_QUEUE_STYLE, UnequalLayout::sizes,
+                UnequalLayout::count, results, false);
+        }, false},
+        {"equal round robin", equal_partitioning, [](Data* data, int number_of_samples, Results* results){
+            scheduled_static_partitioning(data, number_of_samples, EQUAL_STYLE, EqualLayout::sizes,
+                EqualLayout::count, SchedulingConfig(), results);
+        }, true},
+        {"one_queue round robin", one_queue_unequal_partitioning, [](Data* data, int number_of_samples, Results* results){
+            scheduled_static_partitioning(data, number_of_samples, ONE_QUEUE_STYLE, UnequalLayout::sizes,
+                UnequalLayout::count, SchedulingConfig(), results);
+        }, true},
+        {"multiple_queue round robin", multiple_queues_unequal_partitioning, [](Data* data, int number_of_samples, Results* results){
+            scheduled_static_partitioning(data, number_of_samples, MULTIPLE_QUEUES_STYLE, UnequalLayout::sizes,
+                UnequalLayout::count, SchedulingConfig(), results);
+        }, true},
+        {"one_queue without swapping", one_queue_unequal_partitioning, [](Data* data, int number_of_samples, Results* results){
+            SwapConfig config;
+            config.victim = SWAP_NEVER;
+            SwapStats stats;
+            one_queue_swapping_partitioning(data, number_of_samples, UnequalLayout::sizes, UnequalLayout::count,
+                config, results, &stats);
+        }, true},
+        {"dynamic without swapping", dynamic_partitioning, [](Data* data, int number_of_samples, Results* results){
+            SwapConfig config;
+            config.victim = SWAP_NEVER;
+            SwapStats stats;
+            dynamic_swapping_partitioning(data, number_of_samples, MEMORY_END+1, 1, config, results, &stats);
+        }, true},
+        {"one_queue without lookahead", one_queue_unequal_partitioning, [](Data* data, int number_of_samples, Results* results){
+            LookaheadConfig config;
+            config.window = 0;
+            LookaheadStats stats;
+            one_queue_lookahead_partitioning(data, number_of_samples, UnequalLayout::sizes, UnequalLayout::count,
+                config, results, &stats);
+        }, true},
+        {"dynamic without lookahead", dynamic_partitioning, [](Data* data, int number_of_samples, Results* results){
+            LookaheadConfig config;
+            config.window = 0;
+            LookaheadStats stats;
+            dynamic_lookahead_partitioning(data, number_of_samples, MEMORY_END+1, 1, config, results, &stats);
+        }, true},
+        {"one_queue lookahead without bypasses", one_queue_unequal_partitioning, [](Data* data, int number_of_samples, Results* results){
+            LookaheadConfig config;                                 // A window, but the head can't be
+            config.max_bypasses = 0;                                // bypassed even once.
+            LookaheadStats stats;
+            one_queue_lookahead_partitioning(data, number_of_samples, UnequalLayout::sizes, UnequalLayout::count,
+                config, results, &stats);
+        }, true},
+        {"dynamic lookahead without bypasses", dynamic_partitioning, [](Data* data, int number_of_samples, Results* results){
+            LookaheadConfig config;
+            config.max_bypasses = 0;
+            LookaheadStats stats;
+            dynamic_lookahead_partitioning(data, number_of_samples, MEMORY_END+1, 1, config, results, &stats);
+        }, true},
+        {"dynamic without resizing", dynamic_partitioning, [](Data* data, int number_of_samples, Results* results){
+            ResizeConfig config;
+            config.probability = 0;
+            ResizeStats stats;
+            dynamic_resizing_partitioning(data, number_of_samples, config, results, &stats);
+        }, true},
+        {"one_queue 1 bank", one_queue_unequal_partitioning, [](Data* data, int number_of_samples, Results* results){
+            NumaConfig config;
+            config.banks = 1;
+            NumaStats stats;
+            one_queue_numa_partitioning(data, number_of_samples, UnequalLayout::sizes, UnequalLayout::count,
+                config, results, &stats);
+        }, true},
+        {"dynamic 1 bank", dynamic_partitioning, [](Data* data, int number_of_samples, Results* results){
+            NumaConfig config;
+            config.banks = 1;
+            NumaStats stats;
+            dynamic_numa_partitioning(data, number_of_samples, MEMORY_END+1, 1, config, results, &stats);
+        }, true},
+        {"dynamic bitmap", dynamic_partitioning, [](Data* data, int number_of_samples, Results* results){
+            dynamic_bitmap_partitioning(data, number_of_samples, results, MEMORY_END+1, 1);
+        }, true},
+        {"dynamic bitmap 3 blocks", dynamic_partitioning, [](Data* data, int number_of_samples, Results* results){
+            dynamic_bitmap_partitioning(data, number_of_samples, results, MEMORY_END+1, 3);
+        }, true},
+    };
+    const int number_of_pairs = sizeof(pairs) / sizeof(pairs[0]);
+
+    vector<int> mismatches(number_of_pairs, 0);                 // The failing workloads of each engine.
+    vector<Data> workload;                                      // The current workload.
+    for(int w = 0; w < number_of_workloads; w++){               // Loop through the workloads.
+        unsigned seed = DIFFERENTIAL_SEED + w;                  // Each workload has its own seed.
+        const char* kind = generate_differential_workload(workload, seed);
+
+        for(int p = 0; p < number_of_pairs; p++){               // Check every engine on it.
+            string difference = compare_engines(pairs[p], workload);
+            if(difference.empty()){                             // If it matched:
+                continue;                                       // Move on.
+            }
+
+            if(mismatches[p]++ == 0){                           // Shrink the first failure of each engine.
+                cout << pairs[p].name << " differs on workload " << seed << " (" << kind << ", " <<
+                    workload.size() << " jobs): " << difference << endl;
+                vector<Data> reproducer(workload);
+                shrink_workload(pairs[p], reproducer);
+                cout << "  shrunk to " << reproducer.size() << " jobs (size, time):";
+                for(Data &job : reproducer){
+                    cout << " (" << job.size << ", " << job.time << ")";
+                }
+                cout << endl << "  " << compare_engines(pairs[p], reproducer) << endl;
+            }
+        }
+    }
+
+    int failed_engines = 0;                                     // The number of engines that failed.
+    for(int p = 0; p < number_of_pairs; p++){                   // Report every engine.
+        cout << pairs[p].name << ": " << number_of_workloads - mismatches[p] << " of " <<
+            number_of_workloads << " workloads match" << endl;
+        failed_engines += (mismatches[p] > 0);
+    }
+
+    int failed_checks = run_targeted_checks();                  // Then the rules they rarely reach.
+    return (failed_engines == 0 && failed_checks == 0) ? 0 : 1;
+}
\ No newline at end of file
@@ -0,0 +1,58 @@
+/**************************************************************************************************
+ * File: differential.h
+ * Author: Nolan Davenport
+ * Procedures:
+ *
+ * generate_differential_workload   - Makes one random or adversarial workload.
+ *
+ * compare_engines                  - Runs a reference and a candidate engine on a workload and
+ *                                    describes the first difference.
+ *
+ * shrink_workload                  - Shrinks a workload on which two engines differ.
+ *
+ * run_targeted_checks              - Checks the rules that random workloads rarely reach.
+ *
+ * run_differential_tests           - Checks every fast engine against its reference experiment.
+ *************************************************************************************************/
+
+#pragma once
+
+#include<iostream>
+#include<random>
+#include<queue>
+#include<list>
+#include<vector>
+#include<string>
+#include<functional>
+
+#include"main.h"
+
+using namespace std;
+
+#define DIFFERENTIAL_WORKLOADS 2000     // The number of workloads checked by default.
+#define DIFFERENTIAL_SEED 20240101      // The seed of the first workload.
+#define DIFFERENTIAL_KINDS 7            // The number of kinds of workload.
+
+// One experiment engine as compared by the differential harness.
+typedef function<void(Data*, int, Results*)> DifferentialEngine;
+
+// Structure that pairs a fast engine with the reference experiment it must match.
+typedef struct {
+    const char* name;                   // The name printed in the report.
+    DifferentialEngine reference;       // The reference experiment.
+    DifferentialEngine candidate;       // The engine being checked.
+    bool tracks_memory;                 // Whether the candidate tracks memory utilization.
+} DifferentialPair;
+
+// Structure that holds a targeted check of one rule the random workloads rarely reach.
+typedef struct {
+    const char* name;                   // The name printed in the report.
+    function<bool()> holds;             // Whether the rule holds.
+} TargetedCheck;
+
+// Function prototypes
+const char* generate_differential_workload(vector<Data> &workload, unsigned seed);
+string compare_engines(const DifferentialPair &pair, vector<Data> &workload);
+void shrink_workload(const DifferentialPair &pair, vector<Data> &workload);
+int run_targeted_checks();
+int run_differential_tests(int number_of_workloads);
\ No newline at end of file
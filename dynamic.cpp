@@ -10,6 +10,9 @@
  * 
  * perform_first_fit_algorithm  - Performs the first fit placement algorithm. 
  * 
+ * dynamic_partitioning_in_memory  - Performs the dynamic partitioning experiment on a memory of
+ *                                   any size.
+ * 
  * dynamic_partitioning         - Performs the experiment for the dynamic partitioning style that 
  *                                uses the first fit placement algorithm.  
  *************************************************************************************************/
@@ -20,12 +23,15 @@
 #include<list>
 
 #include"main.h"
+#include"histogram.h"
 #include"dynamic.h"
+#include"metrics.h"
+#include"partition_pool.h"
 
 using namespace std;
 
 /**************************************************************************************************
- * void print_dynamic_partitions(list<DynamicPartition> partitions, Data data[NUMBER_OF_SAMPLES], 
+ * void print_dynamic_partitions(const DynamicPartitionList &partitions, Data data[NUMBER_OF_SAMPLES], 
  *                               int next_data)
  * 
  * Author: Nolan Davenport
@@ -33,11 +39,11 @@ using namespace std;
  *              Used for debugging purposes.
  * 
  * Parameters:
- *  partitions      I/P     list<DynamicPartition>      The list of dynamic partitions to print.
+ *  partitions      I/P     const DynamicPartitionList (&)  The list of dynamic partitions to print.
  *  data            I/P     Data[NUMBER_OF_SAMPLES]     The data used in this experiment.
  *  next_data       I/P     int                         The index of the next data member in the queue. 
  *************************************************************************************************/
-void print_dynamic_partitions(list<DynamicPartition> partitions, Data data[NUMBER_OF_SAMPLES], int next_data){
+void print_dynamic_partitions(const DynamicPartitionList &partitions, Data data[NUMBER_OF_SAMPLES], int next_data){
     cout << "dynamic partitions: " << endl;         // Print the title. 
 
     if(partitions.size() == 0){                     // If there's no partitions:
@@ -45,7 +51,7 @@ void print_dynamic_partitions(list<DynamicPartition> partitions, Data data[NUMBE
     }
 
     int free_space = 56;                                            // Initialize free_space to the size of memory.
-    list<DynamicPartition>::iterator it;                            // Create an iterator to loop through the list.
+    DynamicPartitionList::const_iterator it;                        // Create an iterator to loop through the list.
     for(it = partitions.begin(); it != partitions.end(); ++it){     // Loop through the list.
         DynamicPartition p = *it;                                   // Create a local copy of the DynamicPartition located
                                                                     // at the iterator.
@@ -65,18 +71,19 @@ void print_dynamic_partitions(list<DynamicPartition> partitions, Data data[NUMBE
 }
 
 /**************************************************************************************************
- * int compact(list<DynamicPartition> &partitions)
+ * int compact(DynamicPartitionList &partitions, int memory_units)
  * 
  * Author: Nolan Davenport
  * Description: Performs the compaction algorithm.
  * 
  * Parameters:
- *  partitions      I/O     list<DynamicPartition> (&)      The partitions to compact. 
+ *  partitions      I/O     DynamicPartitionList (&)        The partitions to compact. 
+ *  memory_units    I/P     int                             The size of memory in MB.
  *  compact         O/P     int                             The amount of free memory at the end
  *                                                          of main memory after compaction.
  *************************************************************************************************/
-int compact(list<DynamicPartition> &partitions){
-    list<DynamicPartition>::iterator it;                            // Get an iterator used to loop through the partitions list.
+int compact(DynamicPartitionList &partitions, int memory_units){
+    DynamicPartitionList::iterator it;                              // Get an iterator used to loop through the partitions list.
 
     int index = 0;                                                  // Initialize the index to zero. Used to keep track of where
                                                                     // in the list we are.
@@ -90,13 +97,14 @@ int compact(list<DynamicPartition> &partitions){
         end_last = it->start_location + it->size - 1;               // Set end_last to the end of this partition for use in the next loop.
     }
 
-    return MEMORY_END - end_last;                                   // Return the amount of free memory left after compaction.
+    return memory_units - 1 - end_last;                             // Return the amount of free memory left after compaction.
 }
 
 /**************************************************************************************************
- * void perform_first_fit_algorithm(Data (&data)[NUMBER_OF_SAMPLES], list<DynamicPartition> &partitions, 
+ * void perform_first_fit_algorithm(Data (&data)[NUMBER_OF_SAMPLES], int number_of_samples,
+                                 DynamicPartitionList &partitions, 
                                  int &next_data, int &num_data_members_in_partition_table, int clock, 
-                                 int &number_of_failures){
+                                 int &number_of_failures, MemoryMetrics &metrics, int memory_units){
 
  * Author: Nolan Davenport
  * Description: Performs the first fit placement algorithm. 
@@ -104,7 +112,8 @@ int compact(list<DynamicPartition> &partitions){
  * Parameters:
  *  data                                I/P     Data (&)[NUMBER_OF_SAMPLES]     The data used in this
  *                                                                              experiment.
- *  partitions                          I/O     list<DynamicPartition> (&)      The partitions to perform
+ *  number_of_samples                   I/P     int                             The number of samples.
+ *  partitions                          I/O     DynamicPartitionList (&)        The partitions to perform
  *                                                                              the first fit placement
  *                                                                              algorithm on. 
  *  next_data                           I/O     int (&)                         The index of the next
@@ -114,14 +123,18 @@ int compact(list<DynamicPartition> &partitions){
  *  clock                               I/P     int                             The clock value.
  *  number_of_failures                  O/P     int (&)                         The number of failures
  *                                                                              in this experiment.
+ *  metrics                             I/O     MemoryMetrics (&)               The memory metrics of
+ *                                                                              this experiment.
+ *  memory_units                        I/P     int                             The size of memory in MB.
  *************************************************************************************************/
-void perform_first_fit_algorithm(Data (&data)[NUMBER_OF_SAMPLES], list<DynamicPartition> &partitions, 
+void perform_first_fit_algorithm(Data (&data)[NUMBER_OF_SAMPLES], int number_of_samples,
+                                 DynamicPartitionList &partitions, 
                                  int &next_data, int &num_data_members_in_partition_table, int clock, 
-                                 int &number_of_failures){
+                                 int &number_of_failures, MemoryMetrics &metrics, int memory_units){
                                      
     bool inserting = true;                                  // Boolean variable to keep track of whether to continue inserting
                                                             // items into the list.
-    while(inserting && next_data != NUMBER_OF_SAMPLES){
+    while(inserting && next_data != number_of_samples){
         if(partitions.size() == 0){                 // case of empty partitions list.
             DynamicPartition p;                     // Create a DynamicPartition.
             p.data_index = next_data;               // Set the data_index to the item at the front of the queue.
@@ -130,23 +143,31 @@ void perform_first_fit_algorithm(Data (&data)[NUMBER_OF_SAMPLES], list<DynamicPa
             partitions.push_back(p);                // Push the DynamicPartition onto the list. 
             num_data_members_in_partition_table++;  // Increment the number of data members in the partition table.
 
+            metrics_remove_hole(metrics, memory_units);             // The partition splits the empty memory,
+            metrics_add_hole(metrics, memory_units - p.size);       // leaving a hole after it.
+            metrics_admit(metrics, min(p.size, memory_units), p.size);  // Count the memory it uses.
+
             // TODO: do something with this.
             //data[next_data].time_start = clock+1;
-            if(p.size > 56){                        // If the size was greater than the entire memory:
+            if(p.size > memory_units){              // If the size was greater than the entire memory:
                 number_of_failures++;               // Increment the number of failures.
                 data[next_data].failure = true;     // Set the failure member to true.
             }
 
             next_data++;                            // Increment next_data to show the new front of the queue.
+
+            if(next_data == number_of_samples){     // If that was the last item in the queue:
+                break;                              // Stop inserting since there is nothing left to place.
+            }
         }
 
         int start = 0;                              // Initialize the start location to zero.
         int end = 0;                                // Initialize the end location to zero.
 
-        list<DynamicPartition>::iterator it;        // Create an iterator to parse through the list.
+        DynamicPartitionList::iterator it;          // Create an iterator to parse through the list.
         int index = 0;                              // Initialize an index to understand where we are in the list.
 
-        int free_space = MEMORY_END+1;              // Create a freespace variable and initialize it to all memory. 
+        int free_space = memory_units;              // Create a freespace variable and initialize it to all memory. 
                                                     // This will be used to calculate the free space as the list is parsed.
 
         for(it = partitions.begin(); it != partitions.end(); ++it){ // Keep looping as long as the iterator isn't at the end.
@@ -169,6 +190,10 @@ void perform_first_fit_algorithm(Data (&data)[NUMBER_OF_SAMPLES], list<DynamicPa
                 partitions.insert(it, new_p);                       // Insert the new partition before the current partition based on the
                                                                     // iterator.
 
+                metrics_remove_hole(metrics, end - start + 1);      // The partition fills the start of the hole,
+                metrics_add_hole(metrics, end - start + 1 - new_p.size);    // leaving the rest of it.
+                metrics_admit(metrics, new_p.size, new_p.size);     // Count the memory it uses.
+
                 num_data_members_in_partition_table++;              // Increment the number of members in the partition table.
 
                 // TODO: do something with this.
@@ -182,7 +207,7 @@ void perform_first_fit_algorithm(Data (&data)[NUMBER_OF_SAMPLES], list<DynamicPa
 
                 if(index == partitions.size() - 1){                 // If this is the last item in the list:
                     // no more partitions after this point. 
-                    end = MEMORY_END;                               // Set the end location to the end of memory.
+                    end = memory_units - 1;                         // Set the end location to the end of memory.
 
                     if(end - start + 1 >= data[next_data].size){    // Check if the new data item at the head of the queue can fit
                                                                     // in the last section of memory.
@@ -197,6 +222,10 @@ void perform_first_fit_algorithm(Data (&data)[NUMBER_OF_SAMPLES], list<DynamicPa
                                                                     // the item needs to be inserted after the current partition of
                                                                     // the loop.
 
+                        metrics_remove_hole(metrics, end - start + 1);      // The partition fills the start of the
+                        metrics_add_hole(metrics, end - start + 1 - new_p.size);    // last hole, leaving the rest of it.
+                        metrics_admit(metrics, new_p.size, new_p.size);     // Count the memory it uses.
+
                         num_data_members_in_partition_table++;      // Increment the number of data members in the partition table.
 
                         // TODO: figure out what to do with this.
@@ -208,8 +237,9 @@ void perform_first_fit_algorithm(Data (&data)[NUMBER_OF_SAMPLES], list<DynamicPa
                     }else{                                          // If this isn't the end of memory:
                         if(free_space >= data[next_data].size &&    // If the freespace is greater than the size of the item at the front
                             end - start + 1 < data[next_data].size){// of the queue, and if the last hole in memory is too small:
-                            compact(partitions);                    // Perform the compaction algorithm on the partition list.
-                            free_space = MEMORY_END+1;              // Set the freespace to full memory to reset the free_space calculation
+                            metrics_reset_holes(metrics,            // Perform the compaction algorithm on the partition list.
+                                compact(partitions, memory_units)); // Every hole is merged into one at the end of memory.
+                            free_space = memory_units;              // Set the freespace to full memory to reset the free_space calculation
                                                                     // used in the encompassing while loop.
                             break;
                         }
@@ -227,21 +257,24 @@ void perform_first_fit_algorithm(Data (&data)[NUMBER_OF_SAMPLES], list<DynamicPa
 }
 
 /**************************************************************************************************
- * void dynamic_partitioning(Data data[NUMBER_OF_SAMPLES], int number_of_samples, Results* first_fit)
+ * void dynamic_partitioning_in_memory(Data data[NUMBER_OF_SAMPLES], int number_of_samples,
+ *                                     Results* first_fit, int memory_units)
 
  * Author: Nolan Davenport
  * Description: Performs the experiment for the dynamic partitioning style that uses the first fit 
- *              placement algorithm. 
+ *              placement algorithm on a memory of any size. 
  * 
  * Parameters:
  *  data                I/P     Data[NUMBER_OF_SAMPLES]     The data to be used in this experiment.
  *  number_of_samples   I/P     int                         The number of samples in this experiment.
  *  first_fit           O/P     Results*                    Pointer to the structure that holds the 
  *                                                          results of this experiment.
+ *  memory_units        I/P     int                         The size of memory in MB.
  *************************************************************************************************/
-void dynamic_partitioning(Data data[NUMBER_OF_SAMPLES], int number_of_samples, Results* first_fit){
+void dynamic_partitioning_in_memory(Data data[NUMBER_OF_SAMPLES], int number_of_samples,
+                                    Results* first_fit, int memory_units){
     Data experiment_data[NUMBER_OF_SAMPLES];        // Create an array to copy the experiment data.
-    for(int i = 0; i < NUMBER_OF_SAMPLES; i++){     // Loop through each array element.
+    for(int i = 0; i < number_of_samples; i++){     // Loop through each array element.
         experiment_data[i] = data[i];               // Copy the data[] array into the experiment_data[] array.
     }
 
@@ -249,18 +282,24 @@ void dynamic_partitioning(Data data[NUMBER_OF_SAMPLES], int number_of_samples, R
 
     int number_of_failures = 0;                     // Initialize the number of failures to zero.
 
-    list<DynamicPartition> partitions;              // Create the list of partitions for this experiment.
+    reset_dynamic_partition_pool();                 // Start this experiment with a fresh pool of list nodes.
+    DynamicPartitionList partitions(                // Create the list of partitions for this experiment.
+        dynamic_partition_resource());              // Its nodes come from the pool instead of the heap.
 
     int num_data_members_in_partition_table = 0;    // Initialize the number of data members in the partition table to zero.
 
     int clock = 0;                                  // Initialize the clock to zero.
+
+    MemoryMetrics metrics;                          // The memory metrics for this experiment.
+    metrics.memory_size = memory_units;             // Utilization is relative to this memory.
+    metrics_add_hole(metrics, memory_units);        // Memory starts as a single hole.
     
     perform_first_fit_algorithm(experiment_data,    // Perform the first fit algorithm on the list of partitions and the experiment data.
-        partitions, next_data, 
+        number_of_samples, partitions, next_data, 
         num_data_members_in_partition_table, 
-        clock, number_of_failures);
+        clock, number_of_failures, metrics, memory_units);
 
-    list<DynamicPartition>::iterator it =           // Make an iterator to parse through the list.
+    DynamicPartitionList::iterator it =             // Make an iterator to parse through the list.
         partitions.begin();
 
     float average_num_data_members_in_partition_table = 0;  // Initialize the average number of data members in the partition
@@ -285,9 +324,29 @@ void dynamic_partitioning(Data data[NUMBER_OF_SAMPLES], int number_of_samples, R
             first_fit->relative_turn_around_time +=                         // Calculate the relative turnaround time and add it to the
                 (float)experiment_data[it->data_index].turn_around_time /   // cumulative variable used to calculate the average.
                 experiment_data[it->data_index].time;
+            record_completion(it->data_index, clock);                                       // Record when it finished.
+            histogram_record(first_fit->turn_around_histogram,                              // Record it for the percentiles.
+                experiment_data[it->data_index].turn_around_time);
+            record_relative_turn_around(first_fit->relative_turn_around_histogram,
+                experiment_data[it->data_index].turn_around_time,
+                experiment_data[it->data_index].time);
 
 
-            list<DynamicPartition>::iterator it_temp = it++;                // Create a temporary iterator variable and increment the original.
+            int hole_start = 0;                                             // Where the hole before this partition starts.
+            if(it != partitions.begin()){                                   // If there's a partition before this one:
+                hole_start = prev(it)->start_location + prev(it)->size;     // The hole starts after it.
+            }
+            int hole_end = memory_units;                                    // Where the hole after this partition ends.
+            if(next(it) != partitions.end()){                               // If there's a partition after this one:
+                hole_end = next(it)->start_location;                        // The hole ends at its start.
+            }
+            metrics_remove_hole(metrics, it->start_location - hole_start);  // The holes on either side of the partition
+            metrics_remove_hole(metrics,                                    // merge with it into a single hole.
+                hole_end - (it->start_location + it->size));
+            metrics_add_hole(metrics, hole_end - hole_start);
+            metrics_release(metrics, min(it->size, memory_units), it->size);    // The memory is no longer used.
+
+            DynamicPartitionList::iterator it_temp = it++;                  // Create a temporary iterator variable and increment the original.
             partitions.erase(it_temp);                                      // Erase the partition located at the iterator.
             just_erased_a_partition = true;                                 // Set this boolean to true.
 
@@ -295,9 +354,9 @@ void dynamic_partitioning(Data data[NUMBER_OF_SAMPLES], int number_of_samples, R
 
             num_data_members_in_partition_table--;                          // Decrement the number of data members in the partition table.
 
-            perform_first_fit_algorithm(experiment_data, partitions,        // Perform the first_fit algorithm.
-                next_data, num_data_members_in_partition_table, clock, 
-                number_of_failures);
+            perform_first_fit_algorithm(experiment_data, number_of_samples, // Perform the first_fit algorithm.
+                partitions, next_data, num_data_members_in_partition_table, clock, 
+                number_of_failures, metrics, memory_units);
             
             if(num_data_members_in_partition_table == 0){                   // If the partition list is empty:
                 break;                                                      // Break out of the loop to end the experiment.
@@ -319,6 +378,8 @@ void dynamic_partitioning(Data data[NUMBER_OF_SAMPLES], int number_of_samples, R
         clock++;                                                // Increment the clock.
         average_num_data_members_in_partition_table +=          // Add the number of data members in the partition to this variable.
         num_data_members_in_partition_table;                    // This is used to calculate the average.
+
+        metrics_tick(metrics, first_fit);                       // Add the memory metrics for this tick.
     }   
 
     average_num_data_members_in_partition_table /= clock;       // Calculate the average number of data members in the partition table.
@@ -327,4 +388,23 @@ void dynamic_partitioning(Data data[NUMBER_OF_SAMPLES], int number_of_samples, R
         average_num_data_members_in_partition_table;            // to calculate the average later on.
     first_fit->number_of_failures += number_of_failures;        // Add the number of failures to the cumulative variable used to calculate
                                                                 // the average.
+
+    metrics_finish_experiment(metrics, first_fit, clock);       // Add the memory metrics to the cumulative values.
+}
+
+/**************************************************************************************************
+ * void dynamic_partitioning(Data data[NUMBER_OF_SAMPLES], int number_of_samples, Results* first_fit)
+
+ * Author: Nolan Davenport
+ * Description: Performs the experiment for the dynamic partitioning style that uses the first fit 
+ *              placement algorithm. 
+ * 
+ * Parameters:
+ *  data                I/P     Data[NUMBER_OF_SAMPLES]     The data to be used in this experiment.
+ *  number_of_samples   I/P     int                         The number of samples in this experiment.
+ *  first_fit           O/P     Results*                    Pointer to the structure that holds the 
+ *                                                          results of this experiment.
+ *************************************************************************************************/
+void dynamic_partitioning(Data data[NUMBER_OF_SAMPLES], int number_of_samples, Results* first_fit){
+    dynamic_partitioning_in_memory(data, number_of_samples, first_fit, MEMORY_END+1);
 }
\ No newline at end of file
@@ -10,6 +10,9 @@
  * 
  * perform_first_fit_algorithm  - Performs the first fit placement algorithm. 
  * 
+ * dynamic_partitioning_in_memory  - Performs the dynamic partitioning experiment on a memory of
+ *                                   any size.
+ * 
  * dynamic_partitioning         - Performs the experiment for the dynamic partitioning style that 
  *                                uses the first fit placement algorithm.  
  *************************************************************************************************/
@@ -22,11 +25,14 @@
 #include<list>
 
 #include"main.h"
+#include"metrics.h"
+#include"partition_pool.h"
 
 using namespace std;
 
 // Function prototypes
-void print_dynamic_partitions(list<DynamicPartition> partitions, Data e[NUMBER_OF_SAMPLES], int next_data);
-int compact(list<DynamicPartition> &partitions);
-void perform_first_fit_algorithm(Data (&e)[NUMBER_OF_SAMPLES], list<DynamicPartition> &partitions, int &next_data, int &num_data_members_in_partition_table, int clock, int &number_of_failures);
-void dynamic_partitioning(Data e[NUMBER_OF_SAMPLES], int number_of_samples, Results* first_fit);
\ No newline at end of file
+void print_dynamic_partitions(const DynamicPartitionList &partitions, Data e[NUMBER_OF_SAMPLES], int next_data);
+int compact(DynamicPartitionList &partitions, int memory_units = MEMORY_END+1);
+void perform_first_fit_algorithm(Data (&e)[NUMBER_OF_SAMPLES], int number_of_samples, DynamicPartitionList &partitions, int &next_data, int &num_data_members_in_partition_table, int clock, int &number_of_failures, MemoryMetrics &metrics, int memory_units = MEMORY_END+1);
+void dynamic_partitioning(Data e[NUMBER_OF_SAMPLES], int number_of_samples, Results* first_fit);
+void dynamic_partitioning_in_memory(Data e[NUMBER_OF_SAMPLES], int number_of_samples, Results* first_fit, int memory_units);
\ No newline at end of file
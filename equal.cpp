@@ -12,7 +12,9 @@
 #include<list>
 
 #include"main.h"
+#include"histogram.h"
 #include"equal.h"
+#include"metrics.h"
 
 using namespace std;
 
@@ -30,18 +32,21 @@ using namespace std;
  *************************************************************************************************/
 void equal_partitioning(Data data[NUMBER_OF_SAMPLES], int number_of_samples, Results* equal){
     Data experiment_data[NUMBER_OF_SAMPLES];        // Create an array to copy the experiment data.
-    for(int i = 0; i < NUMBER_OF_SAMPLES; i++){     // Loop through each array element.
+    for(int i = 0; i < number_of_samples; i++){     // Loop through each array element.
         experiment_data[i] = data[i];               // Copy the data[] array into the experiment_data[] array.
     }
 
     int number_of_failures = 0;                     // Initialize number of failures to zero.
 
+    MemoryMetrics metrics;                          // The memory metrics for this experiment.
+
     // Initially assign the first 7 tasks/data
     StaticPartition partitions[7];                          // Create the array of static partitions. 
-    for(int i = 0; i < min(7, NUMBER_OF_SAMPLES); i++){     // Loop through the partitions.
+    for(int i = 0; i < min(7, number_of_samples); i++){     // Loop through the partitions.
         partitions[i].size = 8;                             // Set the size of the partition to 8MB.
         partitions[i].data_index = i;                       // Set the data index for the partition to the looping variable.
         experiment_data[i].time_start = 0;                  // Set the start time to zero.
+        metrics_admit(metrics, 8, experiment_data[i].size); // Count the memory it uses.
         if(experiment_data[i].size > 8){                    // If the size of the data is greater than 8MB:
             experiment_data[i].failure = true;              // Count it as a failure.
             number_of_failures++;                           // Increment the number of failures.
@@ -49,9 +54,9 @@ void equal_partitioning(Data data[NUMBER_OF_SAMPLES], int number_of_samples, Res
     }
 
     int num_data_members_in_partition_table =       // Set the number of data members in the partition table.
-        min(7, NUMBER_OF_SAMPLES);
+        min(7, number_of_samples);
 
-    int next_data = min(7, NUMBER_OF_SAMPLES);      // Set the next data element in the queue as the index into the data array.
+    int next_data = min(7, number_of_samples);      // Set the next data element in the queue as the index into the data array.
     int curr_partition = 0;                         // Initialize the current partition to zero.
 
     int clock = 0;                                  // Initialize the clock to zero.
@@ -61,7 +66,7 @@ void equal_partitioning(Data data[NUMBER_OF_SAMPLES], int number_of_samples, Res
     for(;;){                                                    // Clock loop.
         if(partitions[curr_partition].data_index == -1){        // If the partition is empty:
             curr_partition = (curr_partition + 1) %             // Increment curr_partition, looping back to zero if it reaches 7.
-                min(7, NUMBER_OF_SAMPLES);
+                min(7, number_of_samples);
             continue;
         }
 
@@ -81,12 +86,23 @@ void equal_partitioning(Data data[NUMBER_OF_SAMPLES], int number_of_samples, Res
             equal->relative_turn_around_time +=       // Calculate the relative turnaround time and add to cumulative variable.
                 (float)experiment_data[partitions[curr_partition].data_index].turn_around_time /    // This is used to calculate
                 experiment_data[partitions[curr_partition].data_index].time;                        // the average later on.
+            record_completion(partitions[curr_partition].data_index, clock);                // Record when it finished.
+            histogram_record(equal->turn_around_histogram,                                  // Record it for the percentiles.
+                experiment_data[partitions[curr_partition].data_index].turn_around_time);
+            record_relative_turn_around(equal->relative_turn_around_histogram,
+                experiment_data[partitions[curr_partition].data_index].turn_around_time,
+                experiment_data[partitions[curr_partition].data_index].time);
+
+            metrics_release(metrics, 8,                                 // The finished data no longer uses its memory.
+                experiment_data[partitions[curr_partition].data_index].size);
 
-            if(next_data != NUMBER_OF_SAMPLES){                         // If the queue isn't empty:
+            if(next_data != number_of_samples){                         // If the queue isn't empty:
                 partitions[curr_partition].data_index = next_data;      // Then add the item at the front of the queue to the
                                                                         // partition.
                 next_data++;                                            // Increment the next_data variable to put the next
                                                                         // data member at the front of the queue.
+                metrics_admit(metrics, 8,                               // Count the memory the new data uses.
+                    experiment_data[partitions[curr_partition].data_index].size);
                 // TODO: do something with this.
                 //experiment_data[partitions[curr_partition].data_index].time_start = clock+1;
                 if(experiment_data[partitions[curr_partition].data_index].size > 8){    // If the data item size that was just added
@@ -102,12 +118,14 @@ void equal_partitioning(Data data[NUMBER_OF_SAMPLES], int number_of_samples, Res
             }
         }
         curr_partition = (curr_partition + 1) %                 // Increment curr_partition, looping back to zero if it 
-            min(7, NUMBER_OF_SAMPLES);                          // reaches min(7, NUMBER_OF_SAMPLES).
+            min(7, number_of_samples);                          // reaches min(7, number_of_samples).
 
         clock++;                                                // Increment the clock.
 
         average_num_data_members_in_partition_table +=          // Add the number of data members in the partition to the cumulative
             num_data_members_in_partition_table;                // average variable. This will be used to get the average.
+
+        metrics_tick(metrics, equal);                           // Add the memory metrics for this tick.
     }
 
     average_num_data_members_in_partition_table /= clock;   // Calculate the average number of data members in the partition table.
@@ -117,4 +135,6 @@ void equal_partitioning(Data data[NUMBER_OF_SAMPLES], int number_of_samples, Res
 
     equal->number_of_failures += number_of_failures;        // Add the number of failures to the cumulative number of failures. Will be
                                                             // used in calculating the average later on.
+
+    metrics_finish_experiment(metrics, equal, clock);       // Add the memory metrics to the cumulative values.
 }
\ No newline at end of file
@@ -0,0 +1,73 @@
+/**************************************************************************************************
+ * File: experiment_data.cpp
+ * Author: Nolan Davenport
+ * Procedures:
+ * 
+ * generate_experiment_data         - Fills the data array for one experiment from the random 
+ *                                    distributions. 
+ * 
+ * size_tail_probability            - Gets the exact probability that a data size is above a 
+ *                                    threshold. 
+ *************************************************************************************************/
+
+#include<iostream>
+#include<random>
+#include<queue>
+#include<list>
+#include<cmath>
+
+#include"main.h"
+
+using namespace std;
+
+/**************************************************************************************************
+ * void generate_experiment_data(Data data[NUMBER_OF_SAMPLES], default_random_engine &gen, 
+ *                               poisson_distribution<int> &poisson_dist, 
+ *                               uniform_int_distribution<int> &uniform_dist)
+ * 
+ * Author: Nolan Davenport
+ * Description: Fills the data array for one experiment from the random distributions. 
+ * 
+ * Parameters:
+ *  data            O/P     Data[NUMBER_OF_SAMPLES]             The data array to fill.
+ *  gen             I/O     default_random_engine (&)           The random engine.
+ *  poisson_dist    I/O     poisson_distribution<int> (&)       The distribution used for the size.
+ *  uniform_dist    I/O     uniform_int_distribution<int> (&)   The distribution used for the time.
+ *************************************************************************************************/
+void generate_experiment_data(Data data[NUMBER_OF_SAMPLES], default_random_engine &gen, 
+                              poisson_distribution<int> &poisson_dist, 
+                              uniform_int_distribution<int> &uniform_dist){
+    for(int sample = 0; sample < NUMBER_OF_SAMPLES; sample++){      // Loop through samples. 
+        data[sample].size = max(1, poisson_dist(gen));              // Set the size of the sample according to the
+                                                                    // poisson distribution made earlier. 
+
+        data[sample].time = uniform_dist(gen);                      // Sets the time based on uniform distribution
+                                                                    // made earlier. 
+
+        // Setting a couple other members
+        data[sample].index = sample;                                // This member helps us know the data index for
+                                                                    // use in partitioning. 
+        data[sample].left = data[sample].time;                      // Initiate the time left to the time. 
+    }
+}
+
+/**************************************************************************************************
+ * double size_tail_probability(int threshold, double mean)
+ *
+ * Author: Nolan Davenport
+ * Description: Gets the exact probability that a data size is above a threshold of at least 1.
+ *              The terms of the tail are added directly, so probabilities far below the
+ *              precision of 1 - P(size <= threshold) are still exact.
+ *
+ * Parameters:
+ *  threshold               I/P     int         The largest size that doesn't fail.
+ *  mean                    I/P     double      The mean of the size distribution.
+ *  size_tail_probability   O/P     double      The probability the size is above the threshold.
+ *************************************************************************************************/
+double size_tail_probability(int threshold, double mean){
+    double tail = 0;
+    for(int k = threshold + 1; k <= threshold + 400; k++){      // The terms fall off quickly.
+        tail += exp(k * log(mean) - mean - lgamma(k + 1.0));
+    }
+    return tail;
+}
\ No newline at end of file
@@ -0,0 +1,142 @@
+/**************************************************************************************************
+ * File: histogram.cpp
+ * Author: Nolan Davenport
+ * Procedures:
+ *
+ * histogram_merge              - Adds the values of one histogram to another.
+ *
+ * histogram_count              - Gets the number of values in a histogram.
+ *
+ * histogram_percentile         - Gets a percentile of the values in a histogram.
+ *
+ * report_histogram             - Prints the percentiles of a histogram.
+ *
+ * report_percentiles           - Prints the turnaround time percentiles of a partitioning style.
+ *************************************************************************************************/
+
+#include<iostream>
+#include<random>
+#include<queue>
+#include<list>
+#include<cmath>
+
+#include"main.h"
+#include"histogram.h"
+
+using namespace std;
+
+thread_local int* completion_times = nullptr;       // Not recorded unless the differential harness asks.
+
+/**************************************************************************************************
+ * void histogram_merge(Histogram &into, const Histogram &from)
+ *
+ * Author: Nolan Davenport
+ * Description: Adds the values of one histogram to another, such as the histograms of two
+ *              threads or two sets of experiments.
+ *
+ * Parameters:
+ *  into        I/O     Histogram (&)           The histogram to add to.
+ *  from        I/P     const Histogram (&)     The histogram to add.
+ *************************************************************************************************/
+void histogram_merge(Histogram &into, const Histogram &from){
+    for(int i = 0; i < HISTOGRAM_BUCKETS; i++){     // Loop through the buckets.
+        into.counts[i] += from.counts[i];           // Add the counts.
+    }
+    into.max = max(into.max, from.max);             // Keep the larger maximum.
+}
+
+/**************************************************************************************************
+ * long long histogram_count(const Histogram &histogram)
+ *
+ * Author: Nolan Davenport
+ * Description: Gets the number of values in a histogram.
+ *
+ * Parameters:
+ *  histogram           I/P     const Histogram (&)     The histogram.
+ *  histogram_count     O/P     long long               The number of values.
+ *************************************************************************************************/
+long long histogram_count(const Histogram &histogram){
+    long long count = 0;                            // The running total.
+    for(int i = 0; i < HISTOGRAM_BUCKETS; i++){     // Loop through the buckets.
+        count += histogram.counts[i];               // Add the count.
+    }
+    return count;
+}
+
+/**************************************************************************************************
+ * long long histogram_percentile(const Histogram &histogram, double percentile)
+ *
+ * Author: Nolan Davenport
+ * Description: Gets a percentile of the values in a histogram. The result is the largest value
+ *              that falls in the same bucket as the percentile, so it is never below the true
+ *              value and at most about 3% above it. Values below 64 are exact.
+ *
+ * Parameters:
+ *  histogram               I/P     const Histogram (&)     The histogram.
+ *  percentile              I/P     double                  The percentile, from 0 to 100.
+ *  histogram_percentile    O/P     long long               The value at that percentile, or zero
+ *                                                          if the histogram is empty.
+ *************************************************************************************************/
+long long histogram_percentile(const Histogram &histogram, double percentile){
+    long long count = histogram_count(histogram);                   // The number of values.
+    if(count == 0){                                                 // If there are none:
+        return 0;                                                   // There is no percentile.
+    }
+
+    long long target = max(1LL, (long long)ceil(percentile / 100 * count));    // The rank to find.
+    long long seen = 0;                                             // Values in the buckets so far.
+    for(int i = 0; i < HISTOGRAM_BUCKETS; i++){                     // Loop through the buckets in order.
+        seen += histogram.counts[i];
+        if(seen >= target){                                         // If the rank is in this bucket:
+            if(i < 2 << HISTOGRAM_SUB_BUCKET_BITS){                 // Small values have a bucket each.
+                return min((long long)i, histogram.max);
+            }
+            int shift = (i >> HISTOGRAM_SUB_BUCKET_BITS) - 1;       // Otherwise find the bucket's range
+            long long next = (long long)((i & ((1 << HISTOGRAM_SUB_BUCKET_BITS) - 1)) +  // and return its
+                (1 << HISTOGRAM_SUB_BUCKET_BITS) + 1) << shift;     // largest value.
+            return min(next - 1, histogram.max);
+        }
+    }
+    return histogram.max;                                           // Not reached.
+}
+
+/**************************************************************************************************
+ * void report_histogram(const char* name, const Histogram &histogram, double scale, ostream &out)
+ *
+ * Author: Nolan Davenport
+ * Description: Prints the 50th, 90th, 99th and 99.9th percentiles and the maximum of a histogram
+ *              on one line.
+ *
+ * Parameters:
+ *  name        I/P     const char*             What the histogram holds.
+ *  histogram   I/P     const Histogram (&)     The histogram.
+ *  scale       I/P     double                  The recorded values are divided by this.
+ *  out         I/O     ostream (&)             Where the line goes.
+ *************************************************************************************************/
+void report_histogram(const char* name, const Histogram &histogram, double scale, ostream &out){
+    out << name <<
+        " p50: " << histogram_percentile(histogram, 50) / scale <<
+        " p90: " << histogram_percentile(histogram, 90) / scale <<
+        " p99: " << histogram_percentile(histogram, 99) / scale <<
+        " p99.9: " << histogram_percentile(histogram, 99.9) / scale <<
+        " max: " << histogram.max / scale << endl;
+}
+
+/**************************************************************************************************
+ * void report_percentiles(const char* name, const Results* results, ostream &out)
+ *
+ * Author: Nolan Davenport
+ * Description: Prints the turnaround time and relative turnaround time percentiles of a
+ *              partitioning style.
+ *
+ * Parameters:
+ *  name        I/P     const char*         The name of the partitioning style.
+ *  results     I/P     const Results*      The results of the partitioning style.
+ *  out         I/O     ostream (&)         Where the lines go.
+ *************************************************************************************************/
+void report_percentiles(const char* name, const Results* results, ostream &out){
+    string prefix = name;                                   // Every line starts with the style.
+    report_histogram((prefix + " turn_around_time").c_str(), results->turn_around_histogram, 1, out);
+    report_histogram((prefix + " relative_turn_around_time").c_str(),
+        results->relative_turn_around_histogram, RELATIVE_TURN_AROUND_SCALE, out);
+}
\ No newline at end of file
@@ -0,0 +1,97 @@
+/**************************************************************************************************
+ * File: histogram.h
+ * Author: Nolan Davenport
+ * Procedures:
+ *
+ * histogram_record             - Adds a value to a histogram.
+ *
+ * record_relative_turn_around  - Adds a relative turnaround time to a histogram.
+ *
+ * histogram_merge              - Adds the values of one histogram to another.
+ *
+ * histogram_count              - Gets the number of values in a histogram.
+ *
+ * histogram_percentile         - Gets a percentile of the values in a histogram.
+ *
+ * report_histogram             - Prints the percentiles of a histogram.
+ *
+ * report_percentiles           - Prints the turnaround time percentiles of a partitioning style.
+ *
+ * record_completion            - Records the clock at which a data item finished.
+ *************************************************************************************************/
+
+#pragma once
+
+#include<iostream>
+#include<random>
+#include<queue>
+#include<list>
+
+#include"main.h"
+
+using namespace std;
+
+/**************************************************************************************************
+ * inline void histogram_record(Histogram &histogram, long long value)
+ *
+ * Author: Nolan Davenport
+ * Description: Adds a value to a histogram. This is in the header so it is inlined into the
+ *              clock loops: it is a count of leading zeros, a shift and an increment.
+ *
+ * Parameters:
+ *  histogram   I/O     Histogram (&)   The histogram.
+ *  value       I/P     long long       The value to add. Must not be negative.
+ *************************************************************************************************/
+inline void histogram_record(Histogram &histogram, long long value){
+    unsigned long long bucket_value = min(value, (1LL << HISTOGRAM_MAX_BITS) - 1);  // Keep it in range.
+    int shift = max(0, 63 - __builtin_clzll(bucket_value | 1) - HISTOGRAM_SUB_BUCKET_BITS);
+    histogram.counts[(shift << HISTOGRAM_SUB_BUCKET_BITS) + (bucket_value >> shift)]++;
+    histogram.max = max(histogram.max, value);                  // Remember the largest value.
+}
+
+/**************************************************************************************************
+ * inline void record_relative_turn_around(Histogram &histogram, long long turn_around_time,
+ *                                         int time)
+ *
+ * Author: Nolan Davenport
+ * Description: Adds a relative turnaround time to a histogram, in units of
+ *              1/RELATIVE_TURN_AROUND_SCALE. It is computed in integers so every experiment puts
+ *              the same job in the same bucket.
+ *
+ * Parameters:
+ *  histogram           I/O     Histogram (&)   The histogram.
+ *  turn_around_time    I/P     long long       The turnaround time of the data.
+ *  time                I/P     int             The total time of the data.
+ *************************************************************************************************/
+inline void record_relative_turn_around(Histogram &histogram, long long turn_around_time, int time){
+    histogram_record(histogram, turn_around_time * RELATIVE_TURN_AROUND_SCALE / time);
+}
+
+// When set, the experiments write the clock at which each data item finishes here, indexed by
+// data index. Only the differential harness sets it. Each thread has its own, so experiments on
+// other threads never write into it.
+extern thread_local int* completion_times;
+
+/**************************************************************************************************
+ * inline void record_completion(int index, int clock)
+ *
+ * Author: Nolan Davenport
+ * Description: Records the clock at which a data item finished, if completion_times is set on
+ *              this thread.
+ *
+ * Parameters:
+ *  index       I/P     int     The index of the data item.
+ *  clock       I/P     int     The clock when it finished.
+ *************************************************************************************************/
+inline void record_completion(int index, int clock){
+    if(completion_times != nullptr){                // If the completion times are wanted:
+        completion_times[index] = clock;            // Record this one.
+    }
+}
+
+// Function prototypes
+void histogram_merge(Histogram &into, const Histogram &from);
+long long histogram_count(const Histogram &histogram);
+long long histogram_percentile(const Histogram &histogram, double percentile);
+void report_histogram(const char* name, const Histogram &histogram, double scale, ostream &out);
+void report_percentiles(const char* name, const Results* results, ostream &out);
\ No newline at end of file
@@ -0,0 +1,180 @@
+/**************************************************************************************************
+ * File: importance.cpp
+ * Author: Nolan Davenport
+ * Procedures:
+ *
+ * size_log_likelihood_ratio    - Gets the log of the likelihood ratio of a data size between the
+ *                                experiment distribution and a tilted one.
+ *
+ * importance_sample_style      - Estimates the failure probability of a partitioning style from
+ *                                tilted workloads.
+ *
+ * report_importance_estimate   - Prints a failure probability estimate and its relative error.
+ *
+ * run_importance_sampling      - Estimates the failure probability of every partitioning style
+ *                               with importance sampling.
+ *************************************************************************************************/
+
+#include<iostream>
+#include<random>
+#include<queue>
+#include<list>
+#include<cmath>
+
+#include"main.h"
+#include"equal.h"
+#include"one_queue_unequal.h"
+#include"multiple_queues_unequal.h"
+#include"dynamic.h"
+#include"importance.h"
+
+using namespace std;
+
+/**************************************************************************************************
+ * double size_log_likelihood_ratio(int size, double mean, double tilted_mean)
+ *
+ * Author: Nolan Davenport
+ * Description: Gets the log of the likelihood ratio of a data size between the experiment
+ *              distribution and a tilted one. Sizes are max(1, X) with X Poisson, so size 1 also
+ *              covers X = 0. For the Poisson distribution the ratio of size k >= 2 is
+ *              e^(tilted_mean - mean) * (mean / tilted_mean)^k.
+ *
+ * Parameters:
+ *  size                        I/P     int         The data size.
+ *  mean                        I/P     double      The mean of the experiment distribution.
+ *  tilted_mean                 I/P     double      The mean of the tilted distribution.
+ *  size_log_likelihood_ratio   O/P     double      The log of the ratio of their probabilities.
+ *************************************************************************************************/
+double size_log_likelihood_ratio(int size, double mean, double tilted_mean){
+    if(size <= 1){                                              // Both X = 0 and X = 1.
+        return tilted_mean - mean + log((1 + mean) / (1 + tilted_mean));
+    }
+    return tilted_mean - mean + size * log(mean / tilted_mean);
+}
+
+/**************************************************************************************************
+ * void importance_sample_style(const ImportanceStyle &style, int experiments, unsigned seed,
+ *                              Results* results, ImportanceEstimate &estimate)
+ *
+ * Author: Nolan Davenport
+ * Description: Runs the reference experiment of a partitioning style on workloads with sizes
+ *              from the tilted distribution. Each failing data item is weighted by its likelihood
+ *              ratio, and the weighted failures are added to the number of failures in the
+ *              results, so their average is an unbiased estimate of the failures per experiment
+ *              under the real distribution. The failures the experiment counts itself are checked
+ *              against the threshold.
+ *
+ * Parameters:
+ *  style           I/P     const ImportanceStyle (&)   The partitioning style.
+ *  experiments     I/P     int                         The number of tilted workloads.
+ *  seed            I/P     unsigned                    Seeds the tilted workloads.
+ *  results         O/P     Results*                    The results, with weighted failures.
+ *  estimate        O/P     ImportanceEstimate (&)      The running sums of the estimate.
+ *************************************************************************************************/
+void importance_sample_style(const ImportanceStyle &style, int experiments, unsigned seed, Results* results,
+                             ImportanceEstimate &estimate){
+    default_random_engine gen(seed);                            // The same engine as the experiments,
+    poisson_distribution<int> tilted_dist(style.tilted_mean);   // with the sizes tilted.
+    uniform_int_distribution<int> uniform_dist(1, 10);
+
+    for(int experiment = 0; experiment < experiments; experiment++){
+        Data experiment_data[NUMBER_OF_SAMPLES];                // Fill a tilted workload.
+        generate_experiment_data(experiment_data, gen, tilted_dist, uniform_dist);
+
+        float counted_before = results->number_of_failures;     // Run the experiment. Its own failure
+        style.experiment(experiment_data, NUMBER_OF_SAMPLES, results);  // count is replaced by the
+        long long counted = llround(results->number_of_failures - counted_before);  // weighted one.
+        results->number_of_failures = counted_before;
+
+        long long failures = 0;                                 // Weight each failure.
+        double weighted_failures = 0;
+        for(int i = 0; i < NUMBER_OF_SAMPLES; i++){
+            if(experiment_data[i].size <= style.threshold){     // It didn't fail.
+                continue;
+            }
+            double weight = exp(size_log_likelihood_ratio(experiment_data[i].size, SIZE_MEAN, style.tilted_mean));
+            failures++;
+            weighted_failures += weight;
+            estimate.weight_sum += weight;
+            estimate.weight_square_sum += weight * weight;
+        }
+        results->number_of_failures += weighted_failures;       // The estimate for this workload.
+
+        estimate.samples += NUMBER_OF_SAMPLES;
+        estimate.failures += failures;
+        if(counted != failures){                                // The threshold doesn't describe the
+            estimate.mismatches++;                              // experiment.
+        }
+    }
+}
+
+/**************************************************************************************************
+ * void report_importance_estimate(const ImportanceStyle &style, const ImportanceEstimate &estimate,
+ *                                 const Results* results, int experiments)
+ *
+ * Author: Nolan Davenport
+ * Description: Prints the estimated failure probability of a partitioning style next to the
+ *              exact one, the relative error of the estimate, and the number of samples plain
+ *              Monte Carlo would need for the same relative error.
+ *
+ * Parameters:
+ *  style           I/P     const ImportanceStyle (&)       The partitioning style.
+ *  estimate        I/P     const ImportanceEstimate (&)    The running sums of the estimate.
+ *  results         I/P     const Results*                  The results, with weighted failures.
+ *  experiments     I/P     int                             The number of tilted workloads.
+ *************************************************************************************************/
+void report_importance_estimate(const ImportanceStyle &style, const ImportanceEstimate &estimate,
+                                const Results* results, int experiments){
+    double n = estimate.samples;
+    double probability = estimate.weight_sum / n;                           // The estimate.
+    double variance = max(0.0, estimate.weight_square_sum / n - probability * probability);
+    double relative_error = (probability > 0) ? sqrt(variance / n) / probability : INFINITY;
+    double plain_samples = (probability > 0 && relative_error > 0) ?        // Plain Monte Carlo needs
+        (1 - probability) / (probability * relative_error * relative_error) : INFINITY;    // this many for it.
+
+    cout << style.name << " size > " << style.threshold << " (tilted mean " << style.tilted_mean << "): " <<
+        "failure probability " << probability << " exact " << size_tail_probability(style.threshold, SIZE_MEAN) <<
+        " relative error " << relative_error << endl;
+    cout << style.name << " average number_of_failures: " << results->number_of_failures / experiments <<
+        " from " << estimate.samples << " samples, " << estimate.failures << " of them failures; plain Monte Carlo needs " <<
+        plain_samples << " samples" << endl;
+    if(estimate.mismatches > 0){
+        cout << style.name << " failure count differs from the threshold in " << estimate.mismatches <<
+            " workloads" << endl;
+    }
+}
+
+/**************************************************************************************************
+ * int run_importance_sampling(int experiments)
+ *
+ * Author: Nolan Davenport
+ * Description: Estimates the failure probability of every partitioning style with importance
+ *              sampling. Each style gets sizes tilted to a mean just above its threshold, so
+ *              about half of its data fails instead of almost none.
+ *
+ * Parameters:
+ *  experiments                 I/P     int     The number of tilted workloads per style.
+ *  run_importance_sampling     O/P     int     Status code, non-zero if an experiment counted
+ *                                              failures the threshold doesn't explain.
+ *************************************************************************************************/
+int run_importance_sampling(int experiments){
+    ImportanceStyle styles[] = {
+        {"equal", equal_partitioning, 8, 9},
+        {"one_queue", one_queue_unequal_partitioning, 16, 17},
+        {"multiple_queue", multiple_queues_unequal_partitioning, 16, 17},
+        {"dynamic", dynamic_partitioning, MEMORY_END+1, MEMORY_END+2},
+    };
+
+    int status = 0;
+    for(const ImportanceStyle &style : styles){                 // Estimate each style on its own workloads.
+        Results* results = new Results();
+        ImportanceEstimate estimate;
+        importance_sample_style(style, experiments, IMPORTANCE_SEED, results, estimate);
+        report_importance_estimate(style, estimate, results, experiments);
+        if(estimate.mismatches > 0){
+            status = 1;
+        }
+        delete results;
+    }
+    return status;
+}
\ No newline at end of file
@@ -0,0 +1,56 @@
+/**************************************************************************************************
+ * File: importance.h
+ * Author: Nolan Davenport
+ * Procedures:
+ *
+ * size_log_likelihood_ratio    - Gets the log of the likelihood ratio of a data size between the
+ *                                experiment distribution and a tilted one.
+ *
+ * importance_sample_style      - Estimates the failure probability of a partitioning style from
+ *                                tilted workloads.
+ *
+ * report_importance_estimate   - Prints a failure probability estimate and its relative error.
+ *
+ * run_importance_sampling      - Estimates the failure probability of every partitioning style
+ *                               with importance sampling.
+ *************************************************************************************************/
+
+#pragma once
+
+#include<iostream>
+#include<random>
+#include<queue>
+#include<list>
+
+#include"main.h"
+
+using namespace std;
+
+#define IMPORTANCE_EXPERIMENTS 100      // The tilted workloads each style is run on by default.
+#define IMPORTANCE_SEED 4242            // Seeds the tilted workloads.
+#define SIZE_MEAN 8                     // The mean of the size distribution of the experiments.
+
+// Structure that describes how a partitioning style fails: data fails exactly when its size is
+// above the threshold, so sizes are drawn from a distribution tilted towards the threshold.
+typedef struct {
+    const char* name;                                   // The name of the partitioning style.
+    void (*experiment)(Data*, int, Results*);           // The reference experiment.
+    int threshold;                                      // The largest size that doesn't fail.
+    double tilted_mean;                                 // The mean of the tilted size distribution.
+} ImportanceStyle;
+
+// Structure that holds the running sums of an importance sampling estimate. Each data item
+// contributes its likelihood ratio if it fails and zero otherwise.
+typedef struct {
+    long long samples = 0;              // The data items drawn.
+    long long failures = 0;             // The data items that failed.
+    long long mismatches = 0;           // Workloads where the experiment counted other failures.
+    double weight_sum = 0;              // The sum of the contributions.
+    double weight_square_sum = 0;       // The sum of their squares.
+} ImportanceEstimate;
+
+// Function prototypes
+double size_log_likelihood_ratio(int size, double mean, double tilted_mean);
+void importance_sample_style(const ImportanceStyle &style, int experiments, unsigned seed, Results* results, ImportanceEstimate &estimate);
+void report_importance_estimate(const ImportanceStyle &style, const ImportanceEstimate &estimate, const Results* results, int experiments);
+int run_importance_sampling(int experiments);
\ No newline at end of file
@@ -0,0 +1,422 @@
+/**************************************************************************************************
+ * File: lockstep.cpp
+ * Author: Nolan Davenport
+ * Procedures:
+ *
+ * lockstep_simd_supported          - Checks whether the processor can run the vector engine.
+ *
+ * lockstep_load_lane               - Starts an experiment in a lane and fills its partitions.
+ *
+ * lockstep_complete                - Handles the data that finished in a lane this step.
+ *
+ * lockstep_work_scalar             - Works one quantum in every running lane, one lane at a time.
+ *
+ * lockstep_advance_scalar          - Moves the clock of the ticking lanes, one lane at a time.
+ *
+ * lockstep_work_avx2               - Works one quantum in every running lane with AVX2.
+ *
+ * lockstep_advance_avx2            - Moves the clock of the ticking lanes with AVX2.
+ *
+ * lockstep_static_partitioning     - Runs a batch of static partitioning experiments side by side,
+ *                                    one per lane.
+ *************************************************************************************************/
+
+#include<iostream>
+#include<random>
+#include<queue>
+#include<list>
+#include<vector>
+#include<algorithm>
+#include<immintrin.h>
+
+#include"main.h"
+#include"histogram.h"
+#include"static_layouts.h"
+#include"lockstep.h"
+
+using namespace std;
+
+/**************************************************************************************************
+ * bool lockstep_simd_supported()
+ *
+ * Author: Nolan Davenport
+ * Description: Checks whether the processor can run the vector engine. The AVX2 functions are
+ *              compiled for AVX2 on their own, so the rest of the program runs anywhere.
+ *
+ * Parameters:
+ *  lockstep_simd_supported     O/P     bool    Whether AVX2 is available.
+ *************************************************************************************************/
+bool lockstep_simd_supported(){
+    static const bool supported = __builtin_cpu_supports("avx2");  // Asked once.
+    return supported;
+}
+
+/**************************************************************************************************
+ * void lockstep_load_lane(LockstepState &state, LockstepLane &lane, int l, StaticStyle style,
+ *                         const int* sizes)
+ *
+ * Author: Nolan Davenport
+ * Description: Starts the experiment set in the lane and fills its partitions the way the
+ *              reference experiment of the style does before its clock loop.
+ *
+ * Parameters:
+ *  state       I/O     LockstepState&      The state of every lane.
+ *  lane        I/O     LockstepLane&       The lane, with its data already set.
+ *  l           I/P     int                 The index of the lane.
+ *  style       I/P     StaticStyle         The partitioning style.
+ *  sizes       I/P     const int*          The size of each partition in MB.
+ *************************************************************************************************/
+void lockstep_load_lane(LockstepState &state, LockstepLane &lane, int l, StaticStyle style, const int* sizes){
+    int count = state.partition_count;                          // The number of partitions.
+    int members = 0;                                            // Data members in the partition table.
+
+    lane.partitions.resize(count);
+    for(int i = 0; i < count; i++){                             // Start with every partition empty.
+        lane.partitions[i].size = sizes[i];
+        lane.partitions[i].data_index = -1;
+    }
+    lane.next_data = 0;
+    lane.number_of_failures = 0;
+    lane.turn_around_time = 0;
+    lane.relative_turn_around_time = 0;
+
+    if(style == EQUAL_STYLE){                                   // The first data go into the partitions in order.
+        int active = min(count, lane.number_of_samples);
+        for(int i = 0; i < active; i++){
+            lane.partitions[i].data_index = i;
+            if(lane.data[i].size > sizes[i]){                   // If it doesn't fit in the partition:
+                lane.number_of_failures++;                      // Count it as a failure.
+            }
+        }
+        members = active;
+        lane.next_data = active;
+    }else if(style == ONE_QUEUE_STYLE){                         // The single queue fills what it can.
+        one_queue_fill_generic(const_cast<Data*>(lane.data), lane.number_of_samples, lane.next_data,
+            lane.number_of_failures, lane.partitions, members);
+    }else{                                                      // Every partition takes the front of its queue.
+        lane.queues.assign(count, queue<int>());
+        lane.number_of_failures = multiple_queues_assign_generic(const_cast<Data*>(lane.data),
+            lane.number_of_samples, sizes, count, lane.queues);
+        for(int i = 0; i < count; i++){
+            if(!lane.queues[i].empty()){
+                lane.partitions[i].data_index = lane.queues[i].front();
+                lane.queues[i].pop();
+                members++;
+            }
+        }
+    }
+
+    state.occupied[l] = 0;                                      // Copy the partitions into the vector state.
+    for(int i = 0; i < count; i++){
+        int index = lane.partitions[i].data_index;
+        state.left[i][l] = (index == -1) ? 0 : lane.data[index].left;
+        if(index != -1){
+            state.occupied[l] |= 1 << i;
+        }
+    }
+    state.curr_partition[l] = 0;
+    state.clock[l] = 0;
+    state.members[l] = members;
+    state.average_num_data_members_in_partition_table[l] = 0;
+}
+
+/**************************************************************************************************
+ * bool lockstep_complete(LockstepState &state, LockstepLane &lane, int l, StaticStyle style,
+ *                        Results* results)
+ *
+ * Author: Nolan Davenport
+ * Description: Handles the data that finished in a lane this step: records it and refills the
+ *              partition the way the reference experiment of the style does. Only lanes with a
+ *              completion come here, so the vector engine leaves the rare work to scalar code.
+ *
+ * Parameters:
+ *  state               I/O     LockstepState&      The state of every lane.
+ *  lane                I/O     LockstepLane&       The lane.
+ *  l                   I/P     int                 The index of the lane.
+ *  style               I/P     StaticStyle         The partitioning style.
+ *  results             O/P     Results*            The histograms of the batch.
+ *  lockstep_complete   O/P     bool                Whether the experiment in the lane is done.
+ *************************************************************************************************/
+bool lockstep_complete(LockstepState &state, LockstepLane &lane, int l, StaticStyle style, Results* results){
+    int p = state.next_partition[l];                            // The partition that finished.
+    int index = lane.partitions[p].data_index;                  // The data that finished.
+    int clock = state.clock[l];
+
+    int turn_around_time = clock - lane.data[index].time_start;     // Calculate the turnaround time.
+    lane.turn_around_time += turn_around_time;                      // Add it to the cumulative turnaround time.
+    float relative_turn_around_time =                               // Calculate the relative turnaround time.
+        (float)turn_around_time / lane.data[index].time;
+    lane.relative_turn_around_time += relative_turn_around_time;    // Add it to the cumulative value.
+    record_completion(index, clock);                                // Record when it finished.
+    histogram_record(results->turn_around_histogram, turn_around_time); // Record both for the percentiles.
+    record_relative_turn_around(results->relative_turn_around_histogram,
+        turn_around_time, lane.data[index].time);
+
+    lane.partitions[p].data_index = -1;                         // Clear the partition.
+    state.occupied[l] &= ~(1 << p);
+    state.members[l]--;
+
+    vector<int> &filled = lane.filled;                          // The partitions that took data.
+    filled.clear();
+    if(style == EQUAL_STYLE){                                   // The front of the queue moves into the partition.
+        if(lane.next_data != lane.number_of_samples){
+            lane.partitions[p].data_index = lane.next_data;
+            if(lane.data[lane.next_data].size > lane.partitions[p].size){   // If it doesn't fit in the partition:
+                lane.number_of_failures++;                                  // Count it as a failure.
+            }
+            lane.next_data++;
+            state.members[l]++;
+            filled.push_back(p);
+        }
+    }else if(style == ONE_QUEUE_STYLE){                         // The single queue fills what it can.
+        one_queue_fill_generic(const_cast<Data*>(lane.data), lane.number_of_samples, lane.next_data,
+            lane.number_of_failures, lane.partitions, state.members[l], &filled);
+    }else if(!lane.queues[p].empty()){                          // The partition takes the front of its queue.
+        lane.partitions[p].data_index = lane.queues[p].front();
+        lane.queues[p].pop();
+        state.members[l]++;
+        filled.push_back(p);
+    }
+
+    for(int i : filled){                                        // Copy the new data into the vector state.
+        state.left[i][l] = lane.data[lane.partitions[i].data_index].left;
+        state.occupied[l] |= 1 << i;
+    }
+
+    return state.members[l] == 0;                               // The experiment is done once the table is empty.
+}
+
+/**************************************************************************************************
+ * int lockstep_work_scalar(LockstepState &state)
+ *
+ * Author: Nolan Davenport
+ * Description: Works one quantum in every running lane, one lane at a time. The processor skips
+ *              empty partitions without a clock tick, so the partition worked on is the first
+ *              occupied one at or after the current one. Idle lanes have no occupied partitions.
+ *
+ * Parameters:
+ *  state                   I/O     LockstepState&      The state of every lane.
+ *  lockstep_work_scalar    O/P     int                 Bit l is set if data finished in lane l.
+ *************************************************************************************************/
+int lockstep_work_scalar(LockstepState &state){
+    int count = state.partition_count;                          // The number of partitions.
+    int finished = 0;                                           // The lanes with a completion.
+    for(int l = 0; l < LOCKSTEP_LANES; l++){
+        unsigned occupied = state.occupied[l];
+        if(occupied == 0){                                      // The lane is idle.
+            continue;
+        }
+        unsigned rotated = ((occupied | (occupied << count)) >> state.curr_partition[l]);
+        int p = state.curr_partition[l] + __builtin_ctz(rotated);   // The first occupied partition.
+        if(p >= count){
+            p -= count;
+        }
+        state.next_partition[l] = p;
+        if(--state.left[p][l] == 0){                            // Work for one quantum. If the data is finished:
+            finished |= 1 << l;
+        }
+    }
+    return finished;
+}
+
+/**************************************************************************************************
+ * void lockstep_advance_scalar(LockstepState &state, int ticking)
+ *
+ * Author: Nolan Davenport
+ * Description: Moves the ticking lanes past the partition they worked on, increments their clock
+ *              and adds to their cumulative average, one lane at a time.
+ *
+ * Parameters:
+ *  state       I/O     LockstepState&      The state of every lane.
+ *  ticking     I/P     int                 Bit l is set if lane l ticks.
+ *************************************************************************************************/
+void lockstep_advance_scalar(LockstepState &state, int ticking){
+    for(int l = 0; l < LOCKSTEP_LANES; l++){
+        if(!(ticking & (1 << l))){
+            continue;
+        }
+        int next = state.next_partition[l] + 1;                 // Move to the next partition.
+        state.curr_partition[l] = (next == state.partition_count) ? 0 : next;
+        state.clock[l]++;                                       // Increment the clock.
+        state.average_num_data_members_in_partition_table[l] += state.members[l];
+    }
+}
+
+/**************************************************************************************************
+ * int lockstep_work_avx2(LockstepState &state)
+ *
+ * Author: Nolan Davenport
+ * Description: Works one quantum in every running lane with AVX2, the same as
+ *              lockstep_work_scalar. The occupied bits are rotated by the current partition with
+ *              a variable shift, and the lowest set bit is found from the exponent of its value
+ *              converted to float. Every partition row is updated with a mask of the lanes that
+ *              work on it, so no lane branches. Idle lanes match no partition.
+ *
+ * Parameters:
+ *  state               I/O     LockstepState&      The state of every lane.
+ *  lockstep_work_avx2  O/P     int                 Bit l is set if data finished in lane l.
+ *************************************************************************************************/
+__attribute__((target("avx2")))
+int lockstep_work_avx2(LockstepState &state){
+    int count = state.partition_count;                          // The number of partitions.
+    __m256i occupied = _mm256_load_si256((const __m256i*)state.occupied);
+    __m256i curr = _mm256_load_si256((const __m256i*)state.curr_partition);
+    __m256i zero = _mm256_setzero_si256();
+
+    __m256i doubled = _mm256_or_si256(occupied, _mm256_slli_epi32(occupied, count));
+    __m256i rotated = _mm256_srlv_epi32(doubled, curr);         // Bit 0 is the current partition.
+    __m256i lowest = _mm256_and_si256(rotated, _mm256_sub_epi32(zero, rotated));
+    __m256i exponent = _mm256_srli_epi32(_mm256_castps_si256(_mm256_cvtepi32_ps(lowest)), 23);
+    __m256i next = _mm256_add_epi32(curr, _mm256_sub_epi32(exponent, _mm256_set1_epi32(127)));
+    __m256i wrap = _mm256_cmpgt_epi32(next, _mm256_set1_epi32(count - 1));
+    next = _mm256_sub_epi32(next, _mm256_and_si256(wrap, _mm256_set1_epi32(count)));
+    _mm256_store_si256((__m256i*)state.next_partition, next);
+
+    __m256i finished = zero;                                    // The lanes with a completion.
+    for(int p = 0; p < count; p++){
+        __m256i working = _mm256_cmpeq_epi32(next, _mm256_set1_epi32(p));   // The lanes on this partition.
+        __m256i left = _mm256_add_epi32(_mm256_load_si256((const __m256i*)state.left[p]), working);
+        _mm256_store_si256((__m256i*)state.left[p], left);
+        finished = _mm256_or_si256(finished, _mm256_and_si256(working, _mm256_cmpeq_epi32(left, zero)));
+    }
+    return _mm256_movemask_ps(_mm256_castsi256_ps(finished));
+}
+
+/**************************************************************************************************
+ * void lockstep_advance_avx2(LockstepState &state, int ticking)
+ *
+ * Author: Nolan Davenport
+ * Description: Moves the ticking lanes with AVX2, the same as lockstep_advance_scalar. The
+ *              members are converted to float and added lane by lane, so every lane sums in the
+ *              same order as the reference experiment.
+ *
+ * Parameters:
+ *  state       I/O     LockstepState&      The state of every lane.
+ *  ticking     I/P     int                 Bit l is set if lane l ticks.
+ *************************************************************************************************/
+__attribute__((target("avx2")))
+void lockstep_advance_avx2(LockstepState &state, int ticking){
+    __m256i bits = _mm256_setr_epi32(1, 2, 4, 8, 16, 32, 64, 128);
+    __m256i tick = _mm256_cmpeq_epi32(_mm256_and_si256(_mm256_set1_epi32(ticking), bits), bits);
+
+    __m256i next = _mm256_add_epi32(_mm256_load_si256((const __m256i*)state.next_partition), _mm256_set1_epi32(1));
+    next = _mm256_andnot_si256(_mm256_cmpeq_epi32(next, _mm256_set1_epi32(state.partition_count)), next);
+    __m256i curr = _mm256_blendv_epi8(_mm256_load_si256((const __m256i*)state.curr_partition), next, tick);
+    _mm256_store_si256((__m256i*)state.curr_partition, curr);
+
+    __m256i clock = _mm256_sub_epi32(_mm256_load_si256((const __m256i*)state.clock), tick);
+    _mm256_store_si256((__m256i*)state.clock, clock);
+
+    __m256 average = _mm256_load_ps(state.average_num_data_members_in_partition_table);
+    __m256 added = _mm256_add_ps(average, _mm256_cvtepi32_ps(_mm256_load_si256((const __m256i*)state.members)));
+    _mm256_store_ps(state.average_num_data_members_in_partition_table,
+        _mm256_blendv_ps(average, added, _mm256_castsi256_ps(tick)));
+}
+
+/**************************************************************************************************
+ * void lockstep_static_partitioning(const Data* const workloads[], const int sample_counts[],
+ *                                   int number_of_workloads, StaticStyle style, const int* sizes,
+ *                                   int partition_count, Results* results, bool use_simd)
+ *
+ * Author: Nolan Davenport
+ * Description: Runs a batch of static partitioning experiments side by side, one per lane. Every
+ *              step each running lane works one quantum, the lanes where data finished are
+ *              handled one by one, and then the rest of the lanes tick. A lane whose experiment
+ *              is done takes the next one in the batch. Each lane gives the same results as the
+ *              generic engine of the style; they are added to the results in experiment order.
+ *              The workloads are not changed. Layouts with more partitions than a lane holds run
+ *              on the generic engines.
+ *
+ * Parameters:
+ *  workloads               I/P     const Data* const[]     The data of each experiment.
+ *  sample_counts           I/P     const int[]             The number of samples of each experiment.
+ *  number_of_workloads     I/P     int                     The number of experiments.
+ *  style                   I/P     StaticStyle             The partitioning style.
+ *  sizes                   I/P     const int*              The size of each partition in MB.
+ *  partition_count         I/P     int                     The number of partitions.
+ *  results                 O/P     Results*                Pointer to the structure that holds
+ *                                                          the results of the batch.
+ *  use_simd                I/P     bool                    Whether to use AVX2 when available.
+ *************************************************************************************************/
+void lockstep_static_partitioning(const Data* const workloads[], const int sample_counts[],
+                                  int number_of_workloads, StaticStyle style, const int* sizes,
+                                  int partition_count, Results* results, bool use_simd){
+    if(partition_count > LOCKSTEP_MAX_PARTITIONS){              // Too many partitions for a lane.
+        for(int experiment = 0; experiment < number_of_workloads; experiment++){
+            vector<Data> data(workloads[experiment], workloads[experiment] + sample_counts[experiment]);
+            if(style == EQUAL_STYLE){
+                equal_partitioning_generic(data.data(), data.size(), sizes[0], partition_count, results);
+            }else if(style == ONE_QUEUE_STYLE){
+                one_queue_partitioning_generic(data.data(), data.size(), sizes, partition_count, results);
+            }else{
+                multiple_queues_partitioning_generic(data.data(), data.size(), sizes, partition_count, results);
+            }
+        }
+        return;
+    }
+
+    bool simd = use_simd && lockstep_simd_supported();         // Choose the engine once.
+    int (*work)(LockstepState&) = simd ? lockstep_work_avx2 : lockstep_work_scalar;
+    void (*advance)(LockstepState&, int) = simd ? lockstep_advance_avx2 : lockstep_advance_scalar;
+
+    LockstepState state{};                                      // Every lane starts idle.
+    state.partition_count = partition_count;
+    LockstepLane lanes[LOCKSTEP_LANES];
+    vector<LockstepTotals> totals(number_of_workloads);         // The results of each experiment.
+
+    int next_experiment = 0;                                    // The next experiment to start.
+    int running = 0;                                            // Bit l is set while lane l has an experiment.
+    auto start_next = [&](int l){                               // Start the next experiment with data in a lane.
+        while(next_experiment < number_of_workloads && sample_counts[next_experiment] == 0){
+            next_experiment++;                                  // Skip experiments without data.
+        }
+        if(next_experiment == number_of_workloads){             // The batch is used up.
+            lanes[l].experiment = -1;
+            running &= ~(1 << l);
+            return;
+        }
+        lanes[l].data = workloads[next_experiment];
+        lanes[l].number_of_samples = sample_counts[next_experiment];
+        lanes[l].experiment = next_experiment++;
+        lockstep_load_lane(state, lanes[l], l, style, sizes);
+        running |= 1 << l;
+    };
+    for(int l = 0; l < LOCKSTEP_LANES; l++){                    // Fill every lane.
+        start_next(l);
+    }
+
+    while(running != 0){                                        // Clock loop of every lane.
+        int finished = work(state);                             // Work one quantum in every lane.
+        int done = 0;                                           // The lanes whose experiment is done.
+        for(int mask = finished; mask != 0; mask &= mask - 1){  // Handle each completion.
+            int l = __builtin_ctz(mask);
+            if(lockstep_complete(state, lanes[l], l, style, results)){
+                done |= 1 << l;
+            }
+        }
+
+        advance(state, running & ~done);                        // A done experiment stops before its clock tick.
+
+        for(int mask = done; mask != 0; mask &= mask - 1){      // Finish the done experiments.
+            int l = __builtin_ctz(mask);
+            LockstepTotals &total = totals[lanes[l].experiment];
+            total.turn_around_time = lanes[l].turn_around_time;
+            total.relative_turn_around_time = lanes[l].relative_turn_around_time;
+            total.average_num_data_members_in_partition_table =     // Calculate the average for this experiment.
+                state.average_num_data_members_in_partition_table[l] / state.clock[l];
+            total.number_of_failures = lanes[l].number_of_failures;
+            total.ran = true;
+            start_next(l);                                      // The lane takes the next experiment.
+        }
+    }
+
+    for(const LockstepTotals &total : totals){                  // Add the results in experiment order.
+        if(!total.ran){
+            continue;
+        }
+        results->turn_around_time += total.turn_around_time;
+        results->relative_turn_around_time += total.relative_turn_around_time;
+        results->average_num_data_members_in_partition_table += total.average_num_data_members_in_partition_table;
+        results->number_of_failures += total.number_of_failures;
+    }
+}
\ No newline at end of file
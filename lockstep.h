@@ -0,0 +1,85 @@
+/**************************************************************************************************
+ * File: lockstep.h
+ * Author: Nolan Davenport
+ * Procedures:
+ *
+ * lockstep_simd_supported          - Checks whether the processor can run the vector engine.
+ *
+ * lockstep_load_lane               - Starts an experiment in a lane and fills its partitions.
+ *
+ * lockstep_complete                - Handles the data that finished in a lane this step.
+ *
+ * lockstep_work_scalar             - Works one quantum in every running lane, one lane at a time.
+ *
+ * lockstep_advance_scalar          - Moves the clock of the ticking lanes, one lane at a time.
+ *
+ * lockstep_work_avx2               - Works one quantum in every running lane with AVX2.
+ *
+ * lockstep_advance_avx2            - Moves the clock of the ticking lanes with AVX2.
+ *
+ * lockstep_static_partitioning     - Runs a batch of static partitioning experiments side by side,
+ *                                    one per lane.
+ *************************************************************************************************/
+
+#pragma once
+
+#include<iostream>
+#include<random>
+#include<queue>
+#include<list>
+#include<vector>
+
+#include"main.h"
+#include"scheduling.h"
+
+using namespace std;
+
+#define LOCKSTEP_LANES 8                    // Experiments run side by side, one per 32 bit lane of AVX2.
+#define LOCKSTEP_MAX_PARTITIONS 16          // The occupied bits of a lane are rotated in 32 bits.
+
+// Structure that holds the state the lanes step through together. Every array has one entry per
+// lane, so one AVX2 register holds the same variable of every experiment.
+typedef struct {
+    alignas(32) int left[LOCKSTEP_MAX_PARTITIONS][LOCKSTEP_LANES];  // The time left of the data in each partition.
+    alignas(32) int occupied[LOCKSTEP_LANES];       // Bit p is set while partition p holds data.
+    alignas(32) int curr_partition[LOCKSTEP_LANES]; // The partition the processor is at.
+    alignas(32) int next_partition[LOCKSTEP_LANES]; // The partition worked on this step.
+    alignas(32) int clock[LOCKSTEP_LANES];          // The clock of each experiment.
+    alignas(32) int members[LOCKSTEP_LANES];        // The number of data members in the partition table.
+    alignas(32) float average_num_data_members_in_partition_table[LOCKSTEP_LANES]; // Cumulative value used for the average.
+    int partition_count;                            // The number of partitions in every lane.
+} LockstepState;
+
+// Structure that holds what a lane needs besides the vector state: the experiment it runs, its
+// queues and the per lane results, which are added in experiment order once the batch is done.
+typedef struct {
+    const Data* data = nullptr;                 // The data of the experiment in this lane.
+    int number_of_samples = 0;                  // The number of samples in the experiment.
+    int experiment = -1;                        // The experiment in this lane, -1 once the lane is idle.
+    vector<StaticPartition> partitions;         // The data index in each partition.
+    vector<queue<int>> queues;                  // The queue of each partition in the multiple queues style.
+    vector<int> filled;                         // The partitions refilled by a completion.
+    int next_data = 0;                          // The next data element in the single queue.
+    int number_of_failures = 0;                 // The failures of the experiment.
+    float turn_around_time = 0;                 // Cumulative turnaround time of the experiment.
+    float relative_turn_around_time = 0;        // Cumulative relative turnaround time of the experiment.
+} LockstepLane;
+
+// Structure that holds the results of one experiment until they are added to the batch results.
+typedef struct {
+    float turn_around_time = 0;                                 // Cumulative turnaround time.
+    float relative_turn_around_time = 0;                        // Cumulative relative turnaround time.
+    float average_num_data_members_in_partition_table = 0;      // The average for the experiment.
+    int number_of_failures = 0;                                 // The failures of the experiment.
+    bool ran = false;                                           // Whether the experiment had any data.
+} LockstepTotals;
+
+// Function prototypes
+bool lockstep_simd_supported();
+void lockstep_load_lane(LockstepState &state, LockstepLane &lane, int l, StaticStyle style, const int* sizes);
+bool lockstep_complete(LockstepState &state, LockstepLane &lane, int l, StaticStyle style, Results* results);
+int lockstep_work_scalar(LockstepState &state);
+void lockstep_advance_scalar(LockstepState &state, int ticking);
+int lockstep_work_avx2(LockstepState &state);
+void lockstep_advance_avx2(LockstepState &state, int ticking);
+void lockstep_static_partitioning(const Data* const workloads[], const int sample_counts[], int number_of_workloads, StaticStyle style, const int* sizes, int partition_count, Results* results, bool use_simd = true);
\ No newline at end of file
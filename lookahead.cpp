@@ -0,0 +1,491 @@
+/**************************************************************************************************
+ * File: lookahead.cpp
+ * Author: Nolan Davenport
+ * Procedures:
+ *
+ * pending_window_fill                  - Adds queued data to the lookahead window until it is
+ *                                        full.
+ *
+ * pending_window_remove                - Removes a data item from the lookahead window.
+ *
+ * pending_window_take_fitting          - Takes the largest data in the lookahead window that
+ *                                        fits in the given space.
+ *
+ * one_queue_lookahead_partitioning     - Performs the one queue experiment with blocked data
+ *                                        bypassed by smaller data behind it.
+ *
+ * dynamic_lookahead_partitioning       - Performs the dynamic partitioning experiment on a bitmap
+ *                                        memory with blocked data bypassed by smaller data behind
+ *                                        it.
+ *
+ * report_lookahead_stats               - Prints the bypass statistics of a partitioning style.
+ *************************************************************************************************/
+
+#include<iostream>
+#include<random>
+#include<queue>
+#include<list>
+#include<vector>
+#include<map>
+
+#include"main.h"
+#include"histogram.h"
+#include"metrics.h"
+#include"bitmap_memory.h"
+#include"partition_pool.h"
+#include"lookahead.h"
+
+using namespace std;
+
+/**************************************************************************************************
+ * void pending_window_fill(PendingWindow &window, Data data[NUMBER_OF_SAMPLES],
+ *                          int number_of_samples)
+ *
+ * Author: Nolan Davenport
+ * Description: Adds data from the queue to the lookahead window, in queue order, until the window
+ *              is full or the queue is empty. Only data in the window is ever admitted out of
+ *              order, so everything from window_end on is still waiting.
+ *
+ * Parameters:
+ *  window              I/O     PendingWindow (&)           The lookahead window.
+ *  data                I/P     Data[NUMBER_OF_SAMPLES]     The data being processed.
+ *  number_of_samples   I/P     int                         The number of samples.
+ *************************************************************************************************/
+void pending_window_fill(PendingWindow &window, Data data[NUMBER_OF_SAMPLES], int number_of_samples){
+    while((int)window.by_size.size() < window.capacity && window.window_end < number_of_samples){
+        window.by_size.emplace(data[window.window_end].size, window.window_end);   // Goes after data of the
+        window.window_end++;                                                        // same size.
+    }
+}
+
+/**************************************************************************************************
+ * void pending_window_remove(PendingWindow &window, int index, int size)
+ *
+ * Author: Nolan Davenport
+ * Description: Removes a data item from the lookahead window when it is admitted from the head of
+ *              the queue.
+ *
+ * Parameters:
+ *  window      I/O     PendingWindow (&)   The lookahead window.
+ *  index       I/P     int                 The data being removed.
+ *  size        I/P     int                 Its size.
+ *************************************************************************************************/
+void pending_window_remove(PendingWindow &window, int index, int size){
+    auto range = window.by_size.equal_range(size);                  // Only data of this size.
+    for(auto entry = range.first; entry != range.second; entry++){  // The head is the first of its
+        if(entry->second == index){                                 // size, so this stops right away.
+            window.by_size.erase(entry);
+            return;
+        }
+    }
+}
+
+/**************************************************************************************************
+ * int pending_window_take_fitting(PendingWindow &window, int space)
+ *
+ * Author: Nolan Davenport
+ * Description: Takes the largest data in the lookahead window that fits in the given space out of
+ *              the window. Of data with the same size, the one queued first is taken.
+ *
+ * Parameters:
+ *  window                          I/O     PendingWindow (&)   The lookahead window.
+ *  space                           I/P     int                 The space available in MB.
+ *  pending_window_take_fitting     O/P     int                 The data taken, or -1 if nothing
+ *                                                              in the window fits.
+ *************************************************************************************************/
+int pending_window_take_fitting(PendingWindow &window, int space){
+    auto above = window.by_size.upper_bound(space);                 // The first data too large to fit.
+    if(above == window.by_size.begin()){                            // Nothing fits.
+        return -1;
+    }
+    auto entry = window.by_size.lower_bound(prev(above)->first);    // The first queued of the largest size
+    int index = entry->second;                                      // that fits.
+    window.by_size.erase(entry);
+    return index;
+}
+
+/**************************************************************************************************
+ * void one_queue_lookahead_partitioning(Data data[NUMBER_OF_SAMPLES], int number_of_samples,
+ *                                       const int* sizes, int partition_count,
+ *                                       const LookaheadConfig &config, Results* results,
+ *                                       LookaheadStats* stats)
+ *
+ * Author: Nolan Davenport
+ * Description: Performs the one queue experiment for a runtime layout with lookahead admission.
+ *              When the head of the queue is blocked, the largest data in the window behind it
+ *              that fits in an empty partition is admitted ahead of it, into the first empty
+ *              partition it fits in. Once the head has been bypassed max_bypasses times the queue
+ *              waits for it. With a window of zero it follows the same rules as
+ *              one_queue_partitioning_generic.
+ *
+ * Parameters:
+ *  data                I/P     Data[NUMBER_OF_SAMPLES]         The data to be used in this experiment.
+ *  number_of_samples   I/P     int                             The number of samples in this experiment.
+ *  sizes               I/P     const int*                      The size of each partition, smallest first.
+ *  partition_count     I/P     int                             The number of partitions.
+ *  config              I/P     const LookaheadConfig (&)       The lookahead settings.
+ *  results             O/P     Results*                        Pointer to the structure that holds the
+ *                                                              results of this experiment.
+ *  stats               O/P     LookaheadStats*                 The bypass statistics.
+ *************************************************************************************************/
+void one_queue_lookahead_partitioning(Data data[NUMBER_OF_SAMPLES], int number_of_samples, const int* sizes,
+                                      int partition_count, const LookaheadConfig &config, Results* results,
+                                      LookaheadStats* stats){
+    int last = partition_count - 1;                 // The partition that takes anything.
+
+    vector<int> left(number_of_samples);            // Only the time left changes during the experiment.
+    vector<char> admitted(number_of_samples, 0);    // Whether each data item has been admitted.
+    for(int i = 0; i < number_of_samples; i++){     // Loop through each sample.
+        left[i] = data[i].left;                     // Copy the time left.
+    }
+
+    vector<StaticPartition> partitions(partition_count);    // Create the partitions.
+    for(int i = 0; i < partition_count; i++){               // Loop through the partitions.
+        partitions[i].size = sizes[i];                      // Set the size from the layout.
+        partitions[i].data_index = -1;                      // Mark the partition as empty.
+    }
+
+    PendingWindow window{multimap<int, int>(), config.window + 1, 0};   // The head and the data behind it.
+    int head_bypasses = 0;                          // The times the head has been bypassed.
+    int next_data = 0;                              // The head of the queue.
+    int number_of_failures = 0;                     // Initialize the number of failures to zero.
+    int num_data_members_in_partition_table = 0;    // The number of data members in the partition table.
+    int clock = 0;                                  // Initialize the clock to zero.
+    float average_num_data_members_in_partition_table = 0;  // Cumulative value used for the average.
+    MemoryMetrics metrics;                          // The memory metrics for this experiment.
+
+    // Puts a data item into a partition.
+    auto place = [&](int index, int chosen){
+        partitions[chosen].data_index = index;
+        admitted[index] = 1;
+        num_data_members_in_partition_table++;
+        metrics_admit(metrics, partitions[chosen].size, data[index].size);
+    };
+
+    // Admits data from the head of the queue, then from the window behind it while the head is
+    // blocked.
+    auto admit = [&](){
+        for(;;){
+            while(next_data != number_of_samples && admitted[next_data]){   // Skip data that was admitted
+                next_data++;                                                // ahead of its turn.
+            }
+            if(next_data == number_of_samples){                 // If nothing is waiting:
+                break;                                          // Stop.
+            }
+            pending_window_fill(window, data, number_of_samples);  // Look at the data behind the head.
+
+            int size = data[next_data].size;                    // The size of the head.
+            int chosen = -1;                                    // The partition it goes into.
+            for(int p = 0; p <= last; p++){                     // The first empty partition it fits in,
+                if(partitions[p].data_index == -1 && (p == last || size <= partitions[p].size)){    // or the
+                    chosen = p;                                 // last partition, which takes anything.
+                    break;
+                }
+            }
+
+            if(chosen != -1){                                   // The head goes in as usual.
+                if(chosen == last && size > partitions[last].size){   // If it is larger than the last partition:
+                    number_of_failures++;                       // Count it as a failure.
+                }
+                pending_window_remove(window, next_data, size);
+                place(next_data, chosen);
+                head_bypasses = 0;                              // The next head hasn't been bypassed yet.
+                continue;
+            }
+
+            if(head_bypasses >= config.max_bypasses){           // The head has waited long enough, so
+                if(config.window > 0){                          // nothing else goes ahead of it.
+                    stats->aged_blocks++;
+                }
+                break;
+            }
+
+            int space = -1;                                     // The largest empty partition. The last one
+            for(int p = 0; p < last; p++){                      // is in use, or the head would have fit.
+                if(partitions[p].data_index == -1){
+                    space = max(space, partitions[p].size);
+                }
+            }
+            int index = pending_window_take_fitting(window, space);    // The largest data that fits.
+            if(index == -1){                                    // Nothing behind the head fits.
+                break;
+            }
+
+            for(int p = 0; p < last; p++){                      // The first empty partition it fits in.
+                if(partitions[p].data_index == -1 && data[index].size <= partitions[p].size){
+                    chosen = p;
+                    break;
+                }
+            }
+            place(index, chosen);                               // Admit it ahead of the head.
+            head_bypasses++;
+            stats->bypasses++;
+        }
+    };
+
+    admit();                                        // Put the initial data into the table.
+
+    int curr_partition = 0;                         // Initialize the current partition to zero.
+    for(;;){                                                        // Start the clock loop.
+        int index = partitions[curr_partition].data_index;          // The data in the current partition.
+        if(index == -1){                                            // If the partition is empty, skip it
+            curr_partition = (curr_partition + 1) % partition_count;    // without incrementing the clock.
+            continue;
+        }
+
+        if(--left[index] == 0){                                     // Work for one quantum. If the data is finished:
+            int turn_around_time = clock - data[index].time_start;  // Calculate the turnaround time.
+
+            results->turn_around_time += turn_around_time;          // Add it to the cumulative turnaround time.
+            float relative_turn_around_time =                       // Calculate the relative turnaround time.
+                (float)turn_around_time / data[index].time;
+            results->relative_turn_around_time += relative_turn_around_time;  // Add it to the cumulative value.
+            record_completion(index, clock);                                   // Record when it finished.
+            histogram_record(results->turn_around_histogram, turn_around_time);    // Record both for the percentiles.
+            record_relative_turn_around(results->relative_turn_around_histogram,
+                turn_around_time, data[index].time);
+
+            partitions[curr_partition].data_index = -1;             // Clear this partition.
+            num_data_members_in_partition_table--;                  // Decrement the number of data members.
+            metrics_release(metrics, partitions[curr_partition].size, data[index].size);
+
+            admit();                                                // Admit whatever is waiting.
+            if(num_data_members_in_partition_table == 0){           // If nothing is left anywhere:
+                break;                                              // End this experiment.
+            }
+        }
+
+        curr_partition = (curr_partition + 1) % partition_count;    // Move to the next partition.
+        clock++;                                                    // Increment the clock.
+        average_num_data_members_in_partition_table +=              // Add to the cumulative average variable.
+            num_data_members_in_partition_table;
+        metrics_tick(metrics, results);                             // Add the memory metrics for this tick.
+    }
+
+    average_num_data_members_in_partition_table /= clock;           // Calculate the average for this experiment.
+
+    results->average_num_data_members_in_partition_table +=         // Add it to the cumulative variable.
+        average_num_data_members_in_partition_table;
+    results->number_of_failures += number_of_failures;              // Add the failures to the cumulative variable.
+    metrics_finish_experiment(metrics, results, clock);             // Add the memory metrics to the cumulative values.
+
+    stats->experiments++;                           // Add this experiment to the statistics.
+}
+
+/**************************************************************************************************
+ * void dynamic_lookahead_partitioning(Data data[NUMBER_OF_SAMPLES], int number_of_samples,
+ *                                     int memory_units, int blocks_per_unit,
+ *                                     const LookaheadConfig &config, Results* results,
+ *                                     LookaheadStats* stats)
+ *
+ * Author: Nolan Davenport
+ * Description: Performs the dynamic partitioning experiment on a bitmap memory with lookahead
+ *              admission. Data is admitted whenever there is enough free memory in total,
+ *              compacting if no hole is large enough, so when the head of the queue is blocked
+ *              the largest data in the window behind it that fits in the free memory is admitted
+ *              ahead of it. Once the head has been bypassed max_bypasses times the queue waits for
+ *              it. With a window of zero it follows the same rules as dynamic_bitmap_partitioning.
+ *
+ * Parameters:
+ *  data                I/P     Data[NUMBER_OF_SAMPLES]         The data to be used in this experiment.
+ *  number_of_samples   I/P     int                             The number of samples in this experiment.
+ *  memory_units        I/P     int                             The size of memory in MB.
+ *  blocks_per_unit     I/P     int                             The number of blocks in one MB.
+ *  config              I/P     const LookaheadConfig (&)       The lookahead settings.
+ *  results             O/P     Results*                        Pointer to the structure that holds the
+ *                                                              results of this experiment.
+ *  stats               O/P     LookaheadStats*                 The bypass statistics.
+ *************************************************************************************************/
+void dynamic_lookahead_partitioning(Data data[NUMBER_OF_SAMPLES], int number_of_samples, int memory_units,
+                                    int blocks_per_unit, const LookaheadConfig &config, Results* results,
+                                    LookaheadStats* stats){
+    vector<int> left(number_of_samples);            // Only the time left changes during the experiment.
+    vector<char> admitted(number_of_samples, 0);    // Whether each data item has been admitted.
+    for(int i = 0; i < number_of_samples; i++){     // Loop through each sample.
+        left[i] = data[i].left;                     // Copy the time left.
+    }
+
+    reset_dynamic_partition_pool();                 // Start this experiment with a fresh pool of nodes.
+
+    BitmapPartitions partitions{                    // Set up an empty memory.
+        BitmapMemory(), ResidentMap(dynamic_partition_resource()), vector<int>(number_of_samples),
+        vector<int>(number_of_samples), memory_units, blocks_per_unit, 0};
+    bitmap_init(partitions.memory, memory_units * blocks_per_unit);
+
+    MemoryMetrics metrics;                          // The memory metrics for this experiment.
+    metrics.memory_size = memory_units;             // Utilization is relative to this memory.
+    bitmap_add_hole(partitions, 0, memory_units * blocks_per_unit, metrics);   // Memory starts as a single hole.
+
+    PendingWindow window{multimap<int, int>(), config.window + 1, 0};   // The head and the data behind it.
+    int head_bypasses = 0;                          // The times the head has been bypassed.
+    int next_data = 0;                              // The head of the queue.
+    int number_of_failures = 0;                     // Initialize the number of failures to zero.
+    int num_data_members_in_partition_table = 0;    // The number of data members in memory.
+    int clock = 0;                                  // Initialize the clock to zero.
+    float average_num_data_members_in_partition_table = 0;  // Cumulative value used for the average.
+
+    ResidentMap::iterator it = partitions.resident.end();   // The data the processor works on.
+
+    // Finds the block a data item goes at, compacting if no hole is large enough. Returns -1 if
+    // there isn't enough free memory.
+    auto find_room = [&](int size){
+        if(partitions.used_units > memory_units ||              // Data larger than memory leaves no hole,
+            memory_units - partitions.used_units < size){       // and there must be enough free memory.
+            return -1;
+        }
+        int start = bitmap_find_hole(partitions, size * blocks_per_unit);
+        if(start == -1){                                        // If no hole is large enough,
+            bitmap_compact(partitions, metrics);                // compact the free memory into one hole.
+            start = bitmap_find_hole(partitions, size * blocks_per_unit);
+        }
+        return start;
+    };
+
+    // Puts a data item into memory at a block.
+    auto place = [&](int index, int start){
+        int size = data[index].size;
+        int blocks = min(size, memory_units) * blocks_per_unit;     // Blocks it occupies.
+        bitmap_set_range(partitions.memory, start, blocks);         // Mark them as used.
+        ResidentMap::iterator entry =                               // Add it to memory in address order.
+            partitions.resident.emplace(start, index);
+        partitions.start_block[index] = start;                      // Remember where it is
+        partitions.block_count[index] = blocks;                     // and how much of it there is.
+        partitions.used_units += size;                              // Count the memory it holds.
+        bitmap_fill_hole(partitions, entry, metrics);
+        metrics_admit(metrics, min(size, memory_units), size);
+        admitted[index] = 1;
+        num_data_members_in_partition_table++;                      // One more data member in memory.
+    };
+
+    // Admits data from the head of the queue, then from the window behind it while the head is
+    // blocked.
+    auto admit = [&](){
+        for(;;){
+            while(next_data != number_of_samples && admitted[next_data]){   // Skip data that was admitted
+                next_data++;                                                // ahead of its turn.
+            }
+            if(next_data == number_of_samples){                 // If nothing is waiting:
+                break;                                          // Stop.
+            }
+            pending_window_fill(window, data, number_of_samples);  // Look at the data behind the head.
+
+            int size = data[next_data].size;                    // The size of the head.
+            int start = -1;                                     // The block it gets placed at.
+            if(partitions.resident.empty()){                    // In an empty memory it goes at the start,
+                start = 0;                                      // even if it is too large. If it is larger
+                if(size > memory_units){                        // than all of memory, count it as a failure.
+                    number_of_failures++;
+                }
+            }else{
+                start = find_room(size);
+            }
+
+            if(start != -1){                                    // The head goes in as usual.
+                pending_window_remove(window, next_data, size);
+                place(next_data, start);
+                head_bypasses = 0;                              // The next head hasn't been bypassed yet.
+                continue;
+            }
+
+            if(head_bypasses >= config.max_bypasses){           // The head has waited long enough, so
+                if(config.window > 0){                          // nothing else goes ahead of it.
+                    stats->aged_blocks++;
+                }
+                break;
+            }
+            if(partitions.used_units > memory_units){           // Memory is overfull, so nothing fits.
+                break;
+            }
+
+            int index = pending_window_take_fitting(window,     // The largest data that fits in the
+                memory_units - partitions.used_units);          // free memory.
+            if(index == -1){                                    // Nothing behind the head fits.
+                break;
+            }
+            place(index, find_room(data[index].size));          // Admit it ahead of the head.
+            head_bypasses++;
+            stats->bypasses++;
+        }
+    };
+
+    admit();                                                // Place the initial data.
+    it = partitions.resident.begin();                       // Start at the lowest address.
+
+    for(;;){                                                // Clock loop.
+        int index = it->index;                              // The data the processor is on.
+        bool just_erased_a_partition = false;               // Whether the iterator has already moved on.
+
+        if(--left[index] == 0){                             // Work for one quantum. If the data is finished:
+            int turn_around_time = clock - data[index].time_start;  // Calculate the turnaround time.
+
+            results->turn_around_time += turn_around_time;          // Add it to the cumulative turnaround time.
+            float relative_turn_around_time =                       // Calculate the relative turnaround time.
+                (float)turn_around_time / data[index].time;
+            results->relative_turn_around_time += relative_turn_around_time;  // Add it to the cumulative value.
+            record_completion(index, clock);                                   // Record when it finished.
+            histogram_record(results->turn_around_histogram, turn_around_time);    // Record both for the percentiles.
+            record_relative_turn_around(results->relative_turn_around_histogram,
+                turn_around_time, data[index].time);
+
+            bitmap_clear_range(partitions.memory, it->start, partitions.block_count[index]);
+            partitions.used_units -= data[index].size;      // Free its memory.
+            bitmap_merge_holes(partitions, it, metrics);
+            metrics_release(metrics, min(data[index].size, memory_units), data[index].size);
+            num_data_members_in_partition_table--;          // One fewer data member in memory.
+            it = partitions.resident.erase(it);             // Remove it and move on.
+            just_erased_a_partition = true;
+
+            bool was_empty = partitions.resident.empty();   // Whether memory was empty before placing more.
+            admit();                                        // Admit whatever is waiting.
+
+            if(num_data_members_in_partition_table == 0){   // If nothing is left anywhere:
+                break;                                      // The experiment is done.
+            }else if(was_empty){                            // If memory was empty, start from the beginning.
+                it = partitions.resident.begin();
+            }
+        }
+
+        if(!just_erased_a_partition){                       // If nothing was erased, move on.
+            it++;
+        }
+
+        if(it == partitions.resident.end()){                // If the end of memory was reached:
+            it = partitions.resident.begin();               // Go back to the start.
+        }
+
+        clock++;                                            // Increment the clock.
+        average_num_data_members_in_partition_table +=      // Add to the cumulative average variable.
+            num_data_members_in_partition_table;
+        metrics_tick(metrics, results);                     // Add the memory metrics for this tick.
+    }
+
+    average_num_data_members_in_partition_table /= clock;   // Calculate the average for this experiment.
+
+    results->average_num_data_members_in_partition_table += // Add it to the cumulative variable.
+        average_num_data_members_in_partition_table;
+    results->number_of_failures += number_of_failures;      // Add the failures to the cumulative variable.
+    metrics_finish_experiment(metrics, results, clock);     // Add the memory metrics to the cumulative values.
+
+    stats->experiments++;                           // Add this experiment to the statistics.
+}
+
+/**************************************************************************************************
+ * void report_lookahead_stats(const char* name, const LookaheadStats &stats)
+ *
+ * Author: Nolan Davenport
+ * Description: Prints the bypass statistics of a partitioning style: the average number of data
+ *              members admitted ahead of a blocked head, and the times the aging bound stopped
+ *              them, per experiment.
+ *
+ * Parameters:
+ *  name        I/P     const char*                 The name of the partitioning style.
+ *  stats       I/P     const LookaheadStats (&)    The bypass statistics.
+ *************************************************************************************************/
+void report_lookahead_stats(const char* name, const LookaheadStats &stats){
+    if(stats.experiments == 0){                     // Nothing to report.
+        return;
+    }
+    double experiments = stats.experiments;         // Averages are per experiment.
+    cout << name << " average bypasses: " << stats.bypasses / experiments <<
+        " aged blocks: " << stats.aged_blocks / experiments << endl;
+}
\ No newline at end of file
@@ -0,0 +1,67 @@
+/**************************************************************************************************
+ * File: lookahead.h
+ * Author: Nolan Davenport
+ * Procedures:
+ *
+ * pending_window_fill                  - Adds queued data to the lookahead window until it is
+ *                                        full.
+ *
+ * pending_window_remove                - Removes a data item from the lookahead window.
+ *
+ * pending_window_take_fitting          - Takes the largest data in the lookahead window that
+ *                                        fits in the given space.
+ *
+ * one_queue_lookahead_partitioning     - Performs the one queue experiment with blocked data
+ *                                        bypassed by smaller data behind it.
+ *
+ * dynamic_lookahead_partitioning       - Performs the dynamic partitioning experiment on a bitmap
+ *                                        memory with blocked data bypassed by smaller data behind
+ *                                        it.
+ *
+ * report_lookahead_stats               - Prints the bypass statistics of a partitioning style.
+ *************************************************************************************************/
+
+#pragma once
+
+#include<iostream>
+#include<random>
+#include<queue>
+#include<list>
+#include<vector>
+#include<map>
+
+#include"main.h"
+
+using namespace std;
+
+// Structure that holds the settings of lookahead admission. When the head of the queue is
+// blocked, the next window data members behind it are searched for one that fits. The head can
+// be bypassed at most max_bypasses times, after which the queue waits for it as usual.
+typedef struct {
+    int window = 8;                 // The number of data members behind the head that are searched.
+    int max_bypasses = 16;          // The number of times the head can be bypassed.
+} LookaheadConfig;
+
+// Structure that holds the data waiting at the front of the queue, indexed by size so the largest
+// one that fits a space is found without rescanning the queue. Data of the same size keeps its
+// queue order.
+typedef struct {
+    multimap<int, int> by_size;     // Size to data index.
+    int capacity;                   // The most data the window holds, the head included.
+    int window_end;                 // The next queued data to add to the window.
+} PendingWindow;
+
+// Structure that holds the cumulative bypass statistics of a partitioning style.
+typedef struct {
+    long long experiments = 0;      // The number of experiments.
+    long long bypasses = 0;         // The data admitted ahead of a blocked head.
+    long long aged_blocks = 0;      // The times the head blocked the queue because it aged out.
+} LookaheadStats;
+
+// Function prototypes
+void pending_window_fill(PendingWindow &window, Data data[NUMBER_OF_SAMPLES], int number_of_samples);
+void pending_window_remove(PendingWindow &window, int index, int size);
+int pending_window_take_fitting(PendingWindow &window, int space);
+void one_queue_lookahead_partitioning(Data data[NUMBER_OF_SAMPLES], int number_of_samples, const int* sizes, int partition_count, const LookaheadConfig &config, Results* results, LookaheadStats* stats);
+void dynamic_lookahead_partitioning(Data data[NUMBER_OF_SAMPLES], int number_of_samples, int memory_units, int blocks_per_unit, const LookaheadConfig &config, Results* results, LookaheadStats* stats);
+void report_lookahead_stats(const char* name, const LookaheadStats &stats);
\ No newline at end of file
@@ -17,12 +17,35 @@
 #include<queue>
 #include<list>
 #include<ctime>
+#include<cstdlib>
+#include<cctype>
+#include<memory>
 
 #include"main.h"
 #include"equal.h"
 #include"one_queue_unequal.h"
 #include"multiple_queues_unequal.h"
 #include"dynamic.h"
+#include"benchmark.h"
+#include"metrics.h"
+#include"histogram.h"
+#include"bitmap_memory.h"
+#include"streaming.h"
+#include"pipeline.h"
+#include"differential.h"
+#include"static_layouts.h"
+#include"scheduling.h"
+#include"swapping.h"
+#include"lookahead.h"
+#include"resizing.h"
+#include"numa.h"
+#include"optimizer.h"
+#include"importance.h"
+#include"checkpoint.h"
+#include"paging.h"
+#include"slab.h"
+#include"telemetry.h"
+#include"scenario.h"
 
 using namespace std;
 
@@ -43,6 +66,10 @@ void setup_unequal_static_partitions(StaticPartition (&partitions)[7]){
     partitions[4].size = 8;     // Partition 4 is 8MB large.
     partitions[5].size = 12;    // Partition 5 is 12MB large.
     partitions[6].size = 16;    // Partition 6 is 16MB large.
+
+    for(int i = 0; i < 7; i++){         // Loop through the partitions.
+        partitions[i].data_index = -1;  // Mark each partition as empty.
+    }
 }
 
 /**************************************************************************************************
@@ -79,6 +106,11 @@ void report_results(Results* equal, Results* one_queue_unequal,
     equal->average_num_data_members_in_partition_table /=   // this value was calculated once per experiment, so
         NUMBER_OF_EXPERIMENTS;                              // only divide by NUMBER_OF_EXPERIMENTS. 
 
+    equal->average_memory_utilization /= NUMBER_OF_EXPERIMENTS;        // The memory metrics were also calculated
+    equal->average_internal_fragmentation /= NUMBER_OF_EXPERIMENTS;    // once per experiment.
+    equal->average_hole_count /= NUMBER_OF_EXPERIMENTS;
+    equal->average_largest_hole /= NUMBER_OF_EXPERIMENTS;
+
     // Calculate the results for the one queue unequal partition style. 
     one_queue_unequal->number_of_failures =                             // This value was calculated once per experiment, so
         one_queue_unequal->number_of_failures / NUMBER_OF_EXPERIMENTS;  // to get the average, divide by NUMBER_OF_EXPERIMENTS. 
@@ -94,6 +126,11 @@ void report_results(Results* equal, Results* one_queue_unequal,
     one_queue_unequal->average_num_data_members_in_partition_table /=   // this value was calculated once per experiment, so
         NUMBER_OF_EXPERIMENTS;                                          // only divide by NUMBER_OF_EXPERIMENTS. 
 
+    one_queue_unequal->average_memory_utilization /= NUMBER_OF_EXPERIMENTS;        // The memory metrics were also calculated
+    one_queue_unequal->average_internal_fragmentation /= NUMBER_OF_EXPERIMENTS;    // once per experiment.
+    one_queue_unequal->average_hole_count /= NUMBER_OF_EXPERIMENTS;
+    one_queue_unequal->average_largest_hole /= NUMBER_OF_EXPERIMENTS;
+
     // Calculate the results for the multiple queue unequal partition style.
     multiple_queues_unequal->number_of_failures =                           // This value was calculated once per experiment, so
         multiple_queues_unequal->number_of_failures / NUMBER_OF_EXPERIMENTS;// to get the average, divide by NUMBER_OF_EXPERIMENTS. 
@@ -109,6 +146,11 @@ void report_results(Results* equal, Results* one_queue_unequal,
     multiple_queues_unequal->average_num_data_members_in_partition_table /= // this value was calculated once per experiment, so
         NUMBER_OF_EXPERIMENTS;                                              // only divide by NUMBER_OF_EXPERIMENTS. 
 
+    multiple_queues_unequal->average_memory_utilization /= NUMBER_OF_EXPERIMENTS;        // The memory metrics were also calculated
+    multiple_queues_unequal->average_internal_fragmentation /= NUMBER_OF_EXPERIMENTS;    // once per experiment.
+    multiple_queues_unequal->average_hole_count /= NUMBER_OF_EXPERIMENTS;
+    multiple_queues_unequal->average_largest_hole /= NUMBER_OF_EXPERIMENTS;
+
     // Calculate the results for the dynamic partition style using first_fit. 
     first_fit->number_of_failures =                             // This value was calculated once per experiment, so
         first_fit->number_of_failures / NUMBER_OF_EXPERIMENTS;  // to get the average, divide by NUMBER_OF_EXPERIMENTS. 
@@ -123,6 +165,11 @@ void report_results(Results* equal, Results* one_queue_unequal,
 
     first_fit->average_num_data_members_in_partition_table /=   // this value was calculated once per experiment, so
         NUMBER_OF_EXPERIMENTS;                                  // only divide by NUMBER_OF_EXPERIMENTS. 
+
+    first_fit->average_memory_utilization /= NUMBER_OF_EXPERIMENTS;        // The memory metrics were also calculated
+    first_fit->average_internal_fragmentation /= NUMBER_OF_EXPERIMENTS;    // once per experiment.
+    first_fit->average_hole_count /= NUMBER_OF_EXPERIMENTS;
+    first_fit->average_largest_hole /= NUMBER_OF_EXPERIMENTS;
     
     // Print results for the equal partition style. 
     cout << "equal average number_of_failures: " <<                         // Print average number of failures.
@@ -132,7 +179,13 @@ void report_results(Results* equal, Results* one_queue_unequal,
     cout << "equal average relative_turn_around_time: " <<                  // Print average relative turnaround time. 
         equal->relative_turn_around_time << endl;
     cout << "equal average number of data members in StaticPartition table: " <<  // Print average number of members in partition table. 
-        equal->average_num_data_members_in_partition_table << endl << endl;
+        equal->average_num_data_members_in_partition_table << endl;
+    cout << "equal average memory utilization: " <<                         // Print average memory utilization.
+        equal->average_memory_utilization << endl;
+    cout << "equal average internal fragmentation: " <<                     // Print average internal fragmentation.
+        equal->average_internal_fragmentation << endl;
+    report_percentiles("equal", equal, cout);                                   // Print the turnaround time percentiles.
+    cout << endl;
 
     // Print results for the one queue unequal partition style. 
     cout << "one_queue average number_of_failures: " <<                         // Print average number of failures.
@@ -142,7 +195,13 @@ void report_results(Results* equal, Results* one_queue_unequal,
     cout << "one_queue average relative_turn_around_time: " <<                  // Print average relative turnaround time.
         one_queue_unequal->relative_turn_around_time << endl;
     cout << "one_queue average number of data members in StaticPartition table: " <<  // Print average number of members in partition table. 
-        one_queue_unequal->average_num_data_members_in_partition_table << endl << endl; 
+        one_queue_unequal->average_num_data_members_in_partition_table << endl;
+    cout << "one_queue average memory utilization: " <<                         // Print average memory utilization.
+        one_queue_unequal->average_memory_utilization << endl;
+    cout << "one_queue average internal fragmentation: " <<                     // Print average internal fragmentation.
+        one_queue_unequal->average_internal_fragmentation << endl;
+    report_percentiles("one_queue", one_queue_unequal, cout);                   // Print the turnaround time percentiles.
+    cout << endl;
 
     // Print results for the multiple queue unequal partition style.
     cout << "multiple_queue average number_of_failures: " <<                            // Print average number of failures.
@@ -152,7 +211,13 @@ void report_results(Results* equal, Results* one_queue_unequal,
     cout << "multiple_queue average relative_turn_around_time: " <<                     // Print average relative turnaround time.
         multiple_queues_unequal->relative_turn_around_time << endl;
     cout << "multiple_queue average number of data members in StaticPartition table: " <<     // Print average number of members in partition table. 
-        multiple_queues_unequal->average_num_data_members_in_partition_table << endl << endl;
+        multiple_queues_unequal->average_num_data_members_in_partition_table << endl;
+    cout << "multiple_queue average memory utilization: " <<                            // Print average memory utilization.
+        multiple_queues_unequal->average_memory_utilization << endl;
+    cout << "multiple_queue average internal fragmentation: " <<                        // Print average internal fragmentation.
+        multiple_queues_unequal->average_internal_fragmentation << endl;
+    report_percentiles("multiple_queue", multiple_queues_unequal, cout);        // Print the turnaround time percentiles.
+    cout << endl;
 
     // Prints results for the dynamic partition style using first_fit. 
     cout << "dynamic average number_of_failures: " <<                         // Print average number of failures.
@@ -162,7 +227,21 @@ void report_results(Results* equal, Results* one_queue_unequal,
     cout << "dynamic average relative_turn_around_time: " <<                  // Print average relative turnaround time.
         first_fit->relative_turn_around_time << endl;
     cout << "dynamic average number of data members in DynamicPartition list: " <<  // Print average number of members in partition table. 
-        first_fit->average_num_data_members_in_partition_table << endl << endl;
+        first_fit->average_num_data_members_in_partition_table << endl;
+    cout << "dynamic average memory utilization: " <<                         // Print average memory utilization.
+        first_fit->average_memory_utilization << endl;
+    cout << "dynamic average hole count: " <<                                 // Print average number of holes.
+        first_fit->average_hole_count << endl;
+    cout << "dynamic average largest hole: " <<                               // Print average size of the largest hole.
+        first_fit->average_largest_hole << endl;
+    report_percentiles("dynamic", first_fit, cout);                             // Print the turnaround time percentiles.
+    cout << endl;
+
+    // Write the memory utilization over time for each partition style. 
+    write_time_series(&equal->memory_utilization_over_time, "equal_utilization.csv");
+    write_time_series(&one_queue_unequal->memory_utilization_over_time, "one_queue_utilization.csv");
+    write_time_series(&multiple_queues_unequal->memory_utilization_over_time, "multiple_queue_utilization.csv");
+    write_time_series(&first_fit->memory_utilization_over_time, "dynamic_utilization.csv");
 }
 
 /**************************************************************************************************
@@ -170,6 +249,68 @@ void report_results(Results* equal, Results* one_queue_unequal,
  * 
  * Author: Nolan Davenport
  * Description: Entry point for this program. Initializes the data and initiates the experiments. 
+ *              Options:
+ *                  --benchmark                             Run the benchmarks instead.
+ *                  --differential [workloads]              Check the fast engines against the
+ *                                                          reference experiments, and the rules
+ *                                                          they rarely reach, instead.
+ *                  --optimize <mean|p99|failures> [one|multiple [trace file]]
+ *                                                          Search for the layout of static
+ *                                                          partitions that minimizes the average or
+ *                                                          99th percentile turnaround or the
+ *                                                          failures of the one queue or multiple
+ *                                                          queues style instead, on a trace if one
+ *                                                          is given after the style.
+ *                  --importance [workloads]                Estimate the failure probability of each
+ *                                                          style with importance sampling instead.
+ *                  --scenario <file>                       Run the scenarios described in the file
+ *                                                          instead. See scenario.h for the format.
+ *                  --stream <jobs>                         Run the equal, one queue and dynamic
+ *                                                          experiments on a stream of that many
+ *                                                          jobs instead.
+ *                  --pipeline                              Run each partitioning style on its own
+ *                                                          thread.
+ *                  --telemetry <file> [seconds]            Write the progress, rates and running
+ *                                                          means of every style to the file in the
+ *                                                          Prometheus text format every that many
+ *                                                          seconds, 5 by default.
+ *                  --checkpoint <file> [experiments]       Save the progress of the run to the file
+ *                                                          every that many experiments, 50 by
+ *                                                          default.
+ *                  --resume <file>                         Continue the run saved in the checkpoint,
+ *                                                          with the same other options.
+ *                  --schedule <rr|srtf|mlfq> [quantum]     Share the processor between the static
+ *                                                          partitions with round robin, shortest
+ *                                                          remaining time first or multilevel
+ *                                                          feedback.
+ *                  --swap <longest|largest|oldest> [ticks per MB]
+ *                                                          Swap resident data out to admit blocked
+ *                                                          data in the one queue and dynamic styles,
+ *                                                          choosing the victim with the most time
+ *                                                          left, the most memory or the longest
+ *                                                          time in memory.
+ *                  --lookahead <window> [max bypasses]     Let data behind a blocked head of the
+ *                                                          queue be admitted ahead of it in the one
+ *                                                          queue and dynamic styles, searching that
+ *                                                          many data members behind the head.
+ *                  --resize <probability> [ticks per MB]   Let data grow and shrink while it runs in
+ *                                                          the dynamic style, with that chance each
+ *                                                          quantum.
+ *                  --numa <banks> <local|interleave|least> [remote penalty %] [shared|per-bank]
+ *                                                          Split memory into banks in the one queue
+ *                                                          and dynamic styles, choosing the bank
+ *                                                          for each data item by its home bank, in
+ *                                                          turn, or by the least data held. The
+ *                                                          banks share one processor unless
+ *                                                          per-bank gives each its own.
+ *                  --bitmap-memory <MB> <blocks per MB>    Run dynamic partitioning on a bitmap
+ *                                                          memory of the given size.
+ *                  --paging [page size MB]                 Also run the paged style, which maps the
+ *                                                          pages of each data item to any free
+ *                                                          frames, 4 MB pages by default.
+ *                  --slab [slab MB]                        Also run the slab allocator, which keeps a
+ *                                                          free list of objects for each size class,
+ *                                                          16 MB slabs by default.
  * 
  * Parameters:
  *  argc    I/P     int         The number of arguments on the command line.
@@ -177,11 +318,213 @@ void report_results(Results* equal, Results* one_queue_unequal,
  *  main    O/P     int         Status code (not currently used).
  *************************************************************************************************/
 int main(int argc, char* argv[]){
+    int bitmap_memory_units = 0;                        // The size of the bitmap memory in MB, or zero to use
+                                                        // the partition list for dynamic partitioning.
+    int bitmap_blocks_per_unit = 1;                     // The number of blocks in one MB of the bitmap memory.
+    bool pipelined = false;                             // Whether to run each style on its own thread.
+    bool scheduled = false;                             // Whether the static styles use a scheduling policy.
+    SchedulingConfig scheduling;                        // The scheduling policy and its settings.
+    bool swap = false;                                  // Whether blocked data can swap resident data out.
+    SwapConfig swapping;                                // The swapping settings.
+    bool lookahead = false;                             // Whether blocked data can be bypassed.
+    LookaheadConfig lookahead_config;                   // The lookahead settings.
+    bool resize = false;                                // Whether data resizes while it runs.
+    ResizeConfig resizing;                              // The resizing settings.
+    bool numa = false;                                  // Whether memory is split into banks.
+    NumaConfig numa_config;                             // The bank settings.
+    bool paging = false;                                // Whether the paged style runs as well.
+    PagingConfig paging_config;                         // The page size and memory size.
+    bool slab = false;                                  // Whether the slab allocator runs as well.
+    SlabConfig slab_config;                             // The slab size, memory size and size classes.
+    unique_ptr<Telemetry> telemetry;                    // The telemetry of the run, if any. Freed
+                                                        // on every return.
+    Checkpointer* checkpointer = nullptr;               // The checkpoints of the run, if any.
+    string checkpoint_file;                             // The checkpoint file to write.
+    int checkpoint_interval = CHECKPOINT_INTERVAL;      // The experiments between checkpoints.
+    string resume_file;                                 // The checkpoint to resume from.
+    string run_options;                                 // The options that decide the results, which a
+                                                        // resumed run must repeat.
+
+    for(int arg = 1; arg < argc; arg++){                // Loop through the command line options.
+        string option = argv[arg];                      // The current option.
+        int first_arg = arg;                            // Where the option starts.
+        if(option == "--benchmark"){                    // If the benchmarks were requested:
+            run_benchmarks();                           // Run them instead of the experiments.
+            return 0;
+        }else if(option == "--differential"){                      // If the differential tests were requested:
+            int number_of_workloads = DIFFERENTIAL_WORKLOADS;       // Use the default number of workloads
+            if(arg + 1 < argc && atoi(argv[arg + 1]) > 0){          // unless one is given.
+                number_of_workloads = atoi(argv[++arg]);
+            }
+            return run_differential_tests(number_of_workloads);     // Run them instead of the experiments.
+        }else if(option == "--optimize" && arg + 1 < argc){        // If the layout optimizer was requested:
+            OptimizerConfig optimizer;                              // Read what to minimize.
+            if(!parse_layout_objective(argv[++arg], optimizer.objective)){
+                cerr << "--optimize needs mean, p99 or failures" << endl;
+                return 1;
+            }
+            const char* trace_file = nullptr;                       // The trace, if one is given.
+            if(arg + 1 < argc && argv[arg + 1][0] != '-'){          // Read the style if one is given,
+                if(!parse_layout_style(argv[++arg], optimizer.style)){
+                    cerr << "Usage: main --optimize <mean|p99|failures> [one|multiple [trace file]]" << endl;
+                    return 1;
+                }
+                if(arg + 1 < argc && argv[arg + 1][0] != '-'){      // and then the trace.
+                    trace_file = argv[++arg];
+                }
+            }
+            return run_layout_optimizer(optimizer, trace_file);     // Run it instead of the experiments.
+        }else if(option == "--importance"){                        // If importance sampling was requested:
+            int experiments = IMPORTANCE_EXPERIMENTS;               // Use the default number of workloads
+            if(arg + 1 < argc && atoi(argv[arg + 1]) > 0){          // unless one is given.
+                experiments = atoi(argv[++arg]);
+            }
+            return run_importance_sampling(experiments);            // Run it instead of the experiments.
+        }else if(option == "--scenario" && arg + 1 < argc){        // If a scenario file was given:
+            return run_scenarios(argv[++arg]);                      // Run its scenarios instead.
+        }else if(option == "--pipeline"){                           // If the pipeline was requested:
+            pipelined = true;                                       // Run each style on its own thread.
+        }else if(option == "--checkpoint" && arg + 1 < argc){      // If checkpoints were requested:
+            checkpoint_file = argv[++arg];                          // Read the file
+            if(arg + 1 < argc && isdigit(argv[arg + 1][0])){        // and the interval if one is given.
+                checkpoint_interval = atoi(argv[++arg]);
+                if(checkpoint_interval <= 0){
+                    cerr << "--checkpoint needs a positive number of experiments" << endl;
+                    return 1;
+                }
+            }
+        }else if(option == "--resume" && arg + 1 < argc){          // If a run should be resumed:
+            resume_file = argv[++arg];                              // Read its checkpoint.
+        }else if(option == "--stream" && arg + 1 < argc){          // If a streamed experiment was requested:
+            long long total_jobs = atoll(argv[++arg]);              // Read the number of jobs.
+            if(total_jobs <= 0){
+                cerr << "--stream needs a positive number of jobs" << endl;
+                return 1;
+            }
+            run_streamed_experiments(total_jobs, time(nullptr));    // Run it instead of the experiments.
+            return 0;
+        }else if(option == "--schedule" && arg + 1 < argc){        // If a scheduling policy was requested:
+            if(!parse_scheduling_policy(argv[++arg], scheduling.policy)){
+                cerr << "--schedule needs rr, srtf or mlfq" << endl;
+                return 1;
+            }
+            scheduled = true;                                       // Schedule the static styles with it.
+            if(arg + 1 < argc && atoi(argv[arg + 1]) > 0){          // Read the quantum if one is given.
+                scheduling.quantum = atoi(argv[++arg]);
+            }
+        }else if(option == "--swap" && arg + 1 < argc){            // If swapping was requested:
+            if(!parse_swap_victim_policy(argv[++arg], swapping.victim)){
+                cerr << "--swap needs longest, largest or oldest" << endl;
+                return 1;
+            }
+            swap = true;                                            // Swap in the one queue and dynamic styles.
+            if(arg + 1 < argc && isdigit(argv[arg + 1][0])){        // Read the cost per MB if one is given.
+                swapping.ticks_per_mb = atoi(argv[++arg]);          // Zero makes swapping free.
+            }
+        }else if(option == "--lookahead" && arg + 1 < argc){       // If lookahead admission was requested:
+            lookahead_config.window = atoi(argv[++arg]);            // Read the window.
+            if(lookahead_config.window < 0){
+                cerr << "--lookahead needs a window of zero or more" << endl;
+                return 1;
+            }
+            lookahead = true;                                       // Bypass in the one queue and dynamic styles.
+            if(arg + 1 < argc && isdigit(argv[arg + 1][0])){        // Read the aging bound if one is given.
+                lookahead_config.max_bypasses = atoi(argv[++arg]);
+            }
+        }else if(option == "--resize" && arg + 1 < argc){          // If resizing was requested:
+            resizing.probability = atof(argv[++arg]);               // Read the chance of resizing.
+            if(resizing.probability < 0 || resizing.probability > 1){
+                cerr << "--resize needs a probability from 0 to 1" << endl;
+                return 1;
+            }
+            resize = true;                                          // Resize in the dynamic style.
+            if(arg + 1 < argc && isdigit(argv[arg + 1][0])){        // Read the cost per MB if one is given.
+                resizing.ticks_per_mb = atoi(argv[++arg]);          // Zero makes moving data free.
+            }
+        }else if(option == "--numa" && arg + 2 < argc){            // If memory banks were requested:
+            numa_config.banks = atoi(argv[++arg]);                  // Read the number of banks.
+            if(numa_config.banks <= 0 || numa_config.banks > NUMA_MAX_BANKS){
+                cerr << "--numa needs from 1 to " << NUMA_MAX_BANKS << " banks" << endl;
+                return 1;
+            }
+            if(!parse_bank_policy(argv[++arg], numa_config.policy)){
+                cerr << "--numa needs local, interleave or least" << endl;
+                return 1;
+            }
+            numa = true;                                            // Use banks in the one queue and dynamic styles.
+            if(arg + 1 < argc && isdigit(argv[arg + 1][0])){        // Read the remote penalty if one is given.
+                numa_config.remote_penalty = atoi(argv[++arg]);
+            }
+            if(arg + 1 < argc && (string(argv[arg + 1]) == "shared" ||  // Read the processors if given.
+                string(argv[arg + 1]) == "per-bank")){
+                numa_config.processor_per_bank = (string(argv[++arg]) == "per-bank");
+            }
+        }else if(option == "--bitmap-memory" && arg + 2 < argc){    // If a bitmap memory was requested:
+            bitmap_memory_units = atoi(argv[++arg]);                // Read its size in MB
+            bitmap_blocks_per_unit = atoi(argv[++arg]);             // and the blocks in each MB.
+            if(bitmap_memory_units <= 0 || bitmap_blocks_per_unit <= 0){
+                cerr << "--bitmap-memory needs a positive size and block count" << endl;
+                return 1;
+            }
+        }else if(option == "--paging"){                 // If paged memory was requested:
+            paging = true;
+            if(arg + 1 < argc && isdigit(argv[arg + 1][0])){        // Read the page size if one is given.
+                paging_config.page_size = atoi(argv[++arg]);
+            }
+            if(paging_config.page_size <= 0){
+                cerr << "--paging needs a positive page size" << endl;
+                return 1;
+            }
+        }else if(option == "--slab"){                   // If the slab allocator was requested:
+            slab = true;
+            if(arg + 1 < argc && isdigit(argv[arg + 1][0])){        // Read the slab size if one is given.
+                slab_config.slab_size = atoi(argv[++arg]);
+            }
+            if(slab_config.slab_size <= 0){
+                cerr << "--slab needs a positive slab size" << endl;
+                return 1;
+            }
+        }else if(option == "--telemetry" && arg + 1 < argc){        // If telemetry was requested:
+            telemetry = make_unique<Telemetry>();
+            telemetry->file_name = argv[++arg];                     // Read the file
+            if(arg + 1 < argc && isdigit(argv[arg + 1][0])){        // and the interval if one is given.
+                telemetry->interval = atoi(argv[++arg]);
+            }
+            if(telemetry->interval <= 0){
+                cerr << "--telemetry needs a positive interval" << endl;
+                return 1;
+            }
+        }else{                                          // Anything else is a mistake.
+            cerr << "Unknown option: " << option << endl;
+            cerr << "Usage: main [--benchmark] [--differential [workloads]] [--optimize <mean|p99|failures> [one|multiple [trace file]]] [--importance [workloads]] [--scenario <file>] [--stream <jobs>] [--pipeline] [--telemetry <file> [seconds]] [--checkpoint <file> [experiments]] [--resume <file>] [--schedule <rr|srtf|mlfq> [quantum]] [--swap <longest|largest|oldest> [ticks per MB]] [--lookahead <window> [max bypasses]] [--resize <probability> [ticks per MB]] [--numa <banks> <local|interleave|least> [remote penalty %] [shared|per-bank]] [--bitmap-memory <MB> <blocks per MB>] [--paging [page size MB]] [--slab [slab MB]]" << endl;
+            return 1;
+        }
+
+        if(option != "--pipeline" && option != "--telemetry" && option != "--checkpoint" &&  // Remember the
+            option != "--resume"){                                                          // options that
+            for(int i = first_arg; i <= arg; i++){                                          // change results.
+                run_options += (run_options.empty() ? "" : " ") + string(argv[i]);
+            }
+        }
+    }
+    if(swap + lookahead + resize + numa > 1){           // They replace the same styles.
+        cerr << "--swap, --lookahead, --resize and --numa can't be used together" << endl;
+        return 1;
+    }
+    int numa_max_banks = min(UnequalLayout::count,      // Every bank needs a partition of the layout
+        (bitmap_memory_units > 0) ? bitmap_memory_units : MEMORY_END+1);    // and a MB of memory.
+    if(numa && numa_config.banks > numa_max_banks){
+        cerr << "--numa needs from 1 to " << numa_max_banks << " banks" << endl;
+        return 1;
+    }
+
     // Create structures that will hold the results. 
     Results* equal = new Results();                     // Create the Results structure for the equal partitioning style. 
     Results* one_queue_unequal = new Results();         // Create the Results structure for the one queue unequal partitioning style. 
     Results* multiple_queues_unequal = new Results();   // Create the Results structure for the multiple queues unequal partitioning style.
     Results* first_fit = new Results();                 // Create the Results structure for the dynamic partitioning style. 
+    Results* paged = new Results();                     // Create the Results structure for the paged style.
+    Results* slabs = new Results();                     // Create the Results structure for the slab allocator.
 
     time_t seed = time(nullptr);    // Create a seed based on the current time to ensure randomness.
     default_random_engine gen;      // The random engine to generate random numbers. 
@@ -192,40 +535,260 @@ int main(int argc, char* argv[]){
     uniform_int_distribution<int> uniform_dist(1,10);   // Create the uniform distribution to use for the time. 
                                                         // It will have values 1 through 10 inclusively. 
 
-    for(int experiment = 0; experiment < NUMBER_OF_EXPERIMENTS; experiment++){  // Loop through experiments. 
-        Data experiment_data[NUMBER_OF_SAMPLES];                        // Create data array for use in exp    
-        for(int sample = 0; sample < NUMBER_OF_SAMPLES; sample++){      // Loop through samples. 
-            experiment_data[sample].size = max(1, poisson_dist(gen));   // Set the size of the sample according to the
-                                                                        // poisson distribution made earlier. 
+    PipelineStrategy dynamic_strategy = dynamic_partitioning;   // Dynamic partitioning uses the partition list,
+    if(bitmap_memory_units > 0){                                // or the bitmap memory if one was requested.
+        dynamic_strategy = [=](Data* data, int number_of_samples, Results* results){
+            dynamic_bitmap_partitioning(data, number_of_samples, results,
+                bitmap_memory_units, bitmap_blocks_per_unit);
+        };
+    }
+
+    PipelineStrategy equal_strategy = equal_partitioning;                       // The static styles use the
+    PipelineStrategy one_queue_strategy = one_queue_unequal_partitioning;       // reference experiments, or the
+    PipelineStrategy multiple_queues_strategy = multiple_queues_unequal_partitioning;   // scheduled engine if a
+    if(scheduled){                                                              // policy was requested.
+        equal_strategy = [=](Data* data, int number_of_samples, Results* results){
+            scheduled_static_partitioning(data, number_of_samples, EQUAL_STYLE,
+                EqualLayout::sizes, EqualLayout::count, scheduling, results);
+        };
+        one_queue_strategy = [=](Data* data, int number_of_samples, Results* results){
+            scheduled_static_partitioning(data, number_of_samples, ONE_QUEUE_STYLE,
+                UnequalLayout::sizes, UnequalLayout::count, scheduling, results);
+        };
+        multiple_queues_strategy = [=](Data* data, int number_of_samples, Results* results){
+            scheduled_static_partitioning(data, number_of_samples, MULTIPLE_QUEUES_STYLE,
+                UnequalLayout::sizes, UnequalLayout::count, scheduling, results);
+        };
+    }
+
+    SwapStats one_queue_swaps, one_queue_blocking;                              // Swapping statistics, and the
+    SwapStats dynamic_swaps, dynamic_blocking;                                  // same without swapping.
+    if(swap){                                                                   // If swapping was requested, the
+        one_queue_strategy = [&](Data* data, int number_of_samples, Results* results){  // styles swap, and
+            SwapConfig blocking = swapping;                                     // run again without it to
+            blocking.victim = SWAP_NEVER;                                       // compare the turnaround.
+            Results scratch{};                                                  // Results of the run without swapping.
+            one_queue_swapping_partitioning(data, number_of_samples, UnequalLayout::sizes,
+                UnequalLayout::count, swapping, results, &one_queue_swaps);
+            one_queue_swapping_partitioning(data, number_of_samples, UnequalLayout::sizes,
+                UnequalLayout::count, blocking, &scratch, &one_queue_blocking);
+        };
+        int memory_units = (bitmap_memory_units > 0) ? bitmap_memory_units : MEMORY_END+1;
+        dynamic_strategy = [&, memory_units](Data* data, int number_of_samples, Results* results){
+            SwapConfig blocking = swapping;
+            blocking.victim = SWAP_NEVER;
+            Results scratch{};                                                  // Results of the run without swapping.
+            dynamic_swapping_partitioning(data, number_of_samples, memory_units,
+                bitmap_blocks_per_unit, swapping, results, &dynamic_swaps);
+            dynamic_swapping_partitioning(data, number_of_samples, memory_units,
+                bitmap_blocks_per_unit, blocking, &scratch, &dynamic_blocking);
+        };
+    }
+
+    LookaheadStats one_queue_bypasses, dynamic_bypasses;                        // Bypass statistics.
+    if(lookahead){                                                              // If lookahead was requested,
+        one_queue_strategy = [&](Data* data, int number_of_samples, Results* results){  // the styles admit
+            one_queue_lookahead_partitioning(data, number_of_samples,           // data behind a blocked head.
+                UnequalLayout::sizes, UnequalLayout::count, lookahead_config, results, &one_queue_bypasses);
+        };
+        int memory_units = (bitmap_memory_units > 0) ? bitmap_memory_units : MEMORY_END+1;
+        dynamic_strategy = [&, memory_units](Data* data, int number_of_samples, Results* results){
+            dynamic_lookahead_partitioning(data, number_of_samples, memory_units,
+                bitmap_blocks_per_unit, lookahead_config, results, &dynamic_bypasses);
+        };
+    }
+
+    ResizeStats resizes;                                                        // Resizing statistics.
+    if(resize){                                                                 // If resizing was requested,
+        resizing.seed = seed;                                                   // dynamic partitioning resizes
+        dynamic_strategy = [&](Data* data, int number_of_samples, Results* results){    // the data on the
+            dynamic_resizing_partitioning(data, number_of_samples, resizing, results, &resizes);  // list.
+        };
+    }
 
-            experiment_data[sample].time = uniform_dist(gen);           // Sets the time based on uniform distribution
-                                                                        // made earlier. 
+    NumaStats one_queue_banks, dynamic_banks;                                   // Bank placement statistics.
+    if(numa){                                                                   // If banks were requested, the
+        one_queue_strategy = [&](Data* data, int number_of_samples, Results* results){  // styles place data
+            one_queue_numa_partitioning(data, number_of_samples,                // in banks of their own kind
+                UnequalLayout::sizes, UnequalLayout::count, numa_config, results, &one_queue_banks);  // of memory.
+        };
+        int memory_units = (bitmap_memory_units > 0) ? bitmap_memory_units : MEMORY_END+1;
+        dynamic_strategy = [&, memory_units](Data* data, int number_of_samples, Results* results){
+            dynamic_numa_partitioning(data, number_of_samples, memory_units,
+                bitmap_blocks_per_unit, numa_config, results, &dynamic_banks);
+        };
+    }
 
-            // Setting a couple other members
-            experiment_data[sample].index = sample;                         // This member helps us know the data index for
-                                                                            // use in partitioning. 
-            experiment_data[sample].left = experiment_data[sample].time;    // Initiate the time left to the time. 
+    PagingStats paging_stats;                                                   // Page table statistics.
+    if(paging){                                                                 // If paging was requested, it
+        paging_config.memory_units = (bitmap_memory_units > 0) ? bitmap_memory_units : MEMORY_END+1;
+        if(paging_config.page_size > paging_config.memory_units){               // Memory needs at least one frame.
+            cerr << "--paging needs a page size no larger than memory" << endl;
+            return 1;
         }
+        dynamic_strategy = [&, base = dynamic_strategy](Data* data, int number_of_samples, Results* results){
+            base(data, number_of_samples, results);                             // runs on the same data right
+            paged_partitioning(data, number_of_samples, paging_config, paged, &paging_stats);  // after dynamic.
+        };
+    }
 
-        equal_partitioning(experiment_data, NUMBER_OF_SAMPLES, equal);  // Perform equal partitions experiment.
+    SlabStats slab_stats;                                                       // Allocator statistics.
+    if(slab){                                                                   // If the slab allocator was
+        slab_config.memory_units = (bitmap_memory_units > 0) ? bitmap_memory_units : MEMORY_END+1;
+        if(slab_config.slab_size > slab_config.memory_units){                   // Memory needs at least one slab.
+            cerr << "--slab needs a slab size no larger than memory" << endl;
+            return 1;
+        }
+        tune_slab_classes(slab_config, poisson_dist.mean());                    // requested, it runs on the
+        dynamic_strategy = [&, base = dynamic_strategy](Data* data, int number_of_samples, Results* results){
+            base(data, number_of_samples, results);                             // same data right after
+            slab_partitioning(data, number_of_samples, slab_config, slabs, &slab_stats);   // dynamic.
+        };
+    }
+
+    if(telemetry != nullptr){                                                   // If telemetry was requested,
+        PipelineStrategy* strategies[TELEMETRY_STYLES] = {&equal_strategy,      // every style publishes its
+            &one_queue_strategy, &multiple_queues_strategy, &dynamic_strategy}; // progress after each
+        for(int style = 0; style < TELEMETRY_STYLES; style++){                  // experiment.
+            *strategies[style] = [=, sink = telemetry.get(), base = *strategies[style]](Data* data, int number_of_samples, Results* results){
+                base(data, number_of_samples, results);
+                telemetry_record(sink, style, data, number_of_samples, results);
+            };
+        }
+    }
+
+    int first_experiment = 0;                                               // Where the experiments start.
+    if(!checkpoint_file.empty() || !resume_file.empty()){                   // If checkpoints are used, list what
+        checkpointer = new Checkpointer();                                  // each style accumulates.
+        checkpointer->styles = {{equal, {}}, {one_queue_unequal, {}}, {multiple_queues_unequal, {}}, {first_fit, {}}};
+        vector<CheckpointRegion> &one_queue_regions = checkpointer->styles[1].regions;
+        vector<CheckpointRegion> &dynamic_regions = checkpointer->styles[3].regions;
+        if(swap){
+            one_queue_regions = {checkpoint_region("one_queue swaps", one_queue_swaps),
+                checkpoint_region("one_queue blocking", one_queue_blocking)};
+            dynamic_regions = {checkpoint_region("dynamic swaps", dynamic_swaps),
+                checkpoint_region("dynamic blocking", dynamic_blocking)};
+        }
+        if(lookahead){
+            one_queue_regions = {checkpoint_region("one_queue bypasses", one_queue_bypasses)};
+            dynamic_regions = {checkpoint_region("dynamic bypasses", dynamic_bypasses)};
+        }
+        if(resize){
+            dynamic_regions = {checkpoint_region("resizes", resizes)};
+        }
+        if(numa){
+            one_queue_regions = {checkpoint_region("one_queue banks", one_queue_banks)};
+            dynamic_regions = {checkpoint_region("dynamic banks", dynamic_banks)};
+        }
+        if(paging){
+            dynamic_regions.push_back(checkpoint_region("paged results", *paged));
+            dynamic_regions.push_back(checkpoint_region("paging", paging_stats));
+        }
+        if(slab){
+            dynamic_regions.push_back(checkpoint_region("slab results", *slabs));
+            dynamic_regions.push_back(checkpoint_region("slab", slab_stats));
+        }
+
+        if(!resume_file.empty()){                                           // Pick up where the run stopped.
+            CheckpointSnapshot snapshot;
+            string error;
+            if(!load_checkpoint(resume_file, checkpointer->styles, run_options, snapshot, error) ||
+                !restore_random_state(snapshot.random_state, gen, poisson_dist, uniform_dist)){
+                cerr << "Can't resume from " << resume_file << ": " << (error.empty() ? "bad random state" : error) << endl;
+                return 1;
+            }
+            apply_checkpoint(snapshot, checkpointer->styles);
+            seed = snapshot.seed;                                           // The run keeps its seed.
+            resizing.seed = seed;
+            first_experiment = snapshot.experiment;
+            if(checkpoint_file.empty()){                                    // Keep checkpointing to the same file.
+                checkpoint_file = resume_file;
+            }
+        }
 
-        one_queue_unequal_partitioning(experiment_data,                 // Perform one queue unequal experiment.
-            NUMBER_OF_SAMPLES, one_queue_unequal);
+        checkpointer->file_name = checkpoint_file;
+        checkpointer->interval = checkpoint_interval;
+        checkpointer->options = run_options;
+        checkpointer->seed = seed;
+        start_checkpoints(checkpointer);
+    }
 
-        multiple_queues_unequal_partitioning(experiment_data,           // Perform multiple queues unequal experiment.
-            NUMBER_OF_SAMPLES, multiple_queues_unequal);   
+    if(telemetry != nullptr){                                               // Start publishing the progress.
+        telemetry->first_experiment = first_experiment;
+        start_telemetry(telemetry.get());
+    }
 
-        dynamic_partitioning(experiment_data,                           // Perform dynamic partitioning experiment.
-            NUMBER_OF_SAMPLES, first_fit);
+    if(pipelined){                                                          // If the pipeline was requested:
+        PipelineStrategy strategies[PIPELINE_WORKERS] = {equal_strategy,        // Run every style on its
+            one_queue_strategy, multiple_queues_strategy, dynamic_strategy};    // own worker.
+        Results* results[PIPELINE_WORKERS] = {equal, one_queue_unequal, multiple_queues_unequal, first_fit};
+        run_pipelined_experiments(strategies, results, NUMBER_OF_EXPERIMENTS, gen, poisson_dist, uniform_dist,
+            first_experiment, checkpointer);
+    }else{
+        for(int experiment = first_experiment; experiment < NUMBER_OF_EXPERIMENTS; experiment++){  // Loop through experiments. 
+            Data experiment_data[NUMBER_OF_SAMPLES];                        // Create data array for use in exp    
+            generate_experiment_data(experiment_data, gen,                  // Fill it from the distributions.
+                poisson_dist, uniform_dist);
+
+            equal_strategy(experiment_data, NUMBER_OF_SAMPLES, equal);      // Perform equal partitions experiment.
+
+            one_queue_strategy(experiment_data,                             // Perform one queue unequal experiment.
+                NUMBER_OF_SAMPLES, one_queue_unequal);
+
+            multiple_queues_strategy(experiment_data,                       // Perform multiple queues unequal experiment.
+                NUMBER_OF_SAMPLES, multiple_queues_unequal);   
+
+            dynamic_strategy(experiment_data,                               // Perform dynamic partitioning experiment.
+                NUMBER_OF_SAMPLES, first_fit);
+
+            int done = experiment + 1;                                      // Checkpoint between experiments.
+            if(checkpointer != nullptr && done % checkpointer->interval == 0 && done < NUMBER_OF_EXPERIMENTS){
+                capture_random_state(checkpointer, done, save_random_state(gen, poisson_dist, uniform_dist));
+                for(int style = 0; style < PIPELINE_WORKERS; style++){
+                    capture_style(checkpointer, done, style);
+                }
+            }
+        }
+    }
+    if(telemetry != nullptr){                                               // Publish the final progress.
+        finish_telemetry(telemetry.get());
+        telemetry.reset();
+    }
+    if(checkpointer != nullptr){                                            // Write the last checkpoint.
+        finish_checkpoints(checkpointer);
+        delete checkpointer;
     }
 
     report_results(equal, one_queue_unequal, multiple_queues_unequal, first_fit);   // Report the results. 
+    if(swap){                                                                       // Report the swapping.
+        report_swap_stats("one_queue", one_queue_swaps, one_queue_blocking);
+        report_swap_stats("dynamic", dynamic_swaps, dynamic_blocking);
+    }
+    if(lookahead){                                                                  // Report the bypasses.
+        report_lookahead_stats("one_queue", one_queue_bypasses);
+        report_lookahead_stats("dynamic", dynamic_bypasses);
+    }
+    if(resize){                                                                     // Report the resizing.
+        report_resize_stats(resizes);
+    }
+    if(numa){                                                                       // Report the banks.
+        report_numa_stats("one_queue", numa_config, one_queue_banks);
+        report_numa_stats("dynamic", numa_config, dynamic_banks);
+    }
+    if(paging){                                                                     // Report the paged style.
+        report_paging_results(paged, paging_config, paging_stats);
+    }
+    if(slab){                                                                       // Report the slab allocator.
+        report_slab_results(slabs, slab_config, slab_stats);
+    }
 
     // Delete each Results structure pointer. 
     delete equal;                   // Delete the equal Results structure pointer. 
     delete one_queue_unequal;       // Delete the one_queue_unequal Results structure pointer. 
     delete multiple_queues_unequal; // Delete the multiple_queues_unequal Results structure pointer. 
     delete first_fit;               // Delete the first_fit Results structure pointer. 
+    delete paged;                   // Delete the paged Results structure pointer.
+    delete slabs;                   // Delete the slab Results structure pointer.
 
     return 0;                       // Return to end the program.
 }
\ No newline at end of file
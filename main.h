@@ -8,21 +8,61 @@
  * 
  * report_results                   - Repots the results after completing each experiment. 
  * 
+ * generate_experiment_data         - Fills the data array for one experiment from the random 
+ *                                    distributions. 
+ * 
+ * size_tail_probability            - Gets the exact probability that a data size is above a 
+ *                                    threshold. 
+ * 
  * main                             - Entry point for this program. Initializes the data and 
  *                                    initiates the experiments. 
  *************************************************************************************************/
 
 #pragma once
 
+#include<random>
+
 #define NUMBER_OF_EXPERIMENTS 1000
 #define NUMBER_OF_SAMPLES 1000
 
+#define TIME_SERIES_CAPACITY 1024
+
+#define HISTOGRAM_SUB_BUCKET_BITS 5                                     // 32 buckets per power of two, about 3% apart.
+#define HISTOGRAM_MAX_BITS 48                                           // Values up to 2^48 are recorded exactly enough.
+#define HISTOGRAM_BUCKETS ((HISTOGRAM_MAX_BITS - HISTOGRAM_SUB_BUCKET_BITS + 1) << HISTOGRAM_SUB_BUCKET_BITS)
+#define RELATIVE_TURN_AROUND_SCALE 1000                                 // Relative turnaround is recorded in thousandths.
+
+// Structure that holds a value over time in a fixed amount of memory. When it fills up, 
+// neighbouring points are averaged together and each point covers twice as many ticks. 
+typedef struct {
+    float values[TIME_SERIES_CAPACITY];     // The recorded points.
+    int count = 0;                          // The number of recorded points.
+    int ticks_per_point = 1;                // The number of ticks averaged into each point.
+    float pending_sum = 0;                  // The sum of the ticks not yet made into a point.
+    int pending_ticks = 0;                  // The number of ticks not yet made into a point.
+} TimeSeries;
+
+// Structure that counts values in logarithmic buckets, so percentiles can be found in a fixed
+// amount of memory. Values below 64 each get their own bucket. Above that, each power of two is
+// split into 32 buckets. Histograms are merged by adding their counts.
+typedef struct {
+    long long counts[HISTOGRAM_BUCKETS] = {};   // The number of values in each bucket.
+    long long max = 0;                          // The largest value recorded.
+} Histogram;
+
 // Structure that holds the results for the experiments. 
 typedef struct {
     float turn_around_time = 0;
     float relative_turn_around_time = 0;
     float number_of_failures = 0;
     float average_num_data_members_in_partition_table = 0;
+    float average_memory_utilization = 0;
+    float average_internal_fragmentation = 0;
+    float average_hole_count = 0;
+    float average_largest_hole = 0;
+    TimeSeries memory_utilization_over_time;
+    Histogram turn_around_histogram;
+    Histogram relative_turn_around_histogram;
 } Results;
 
 // Structure that holds the information for a single member of data.
@@ -55,4 +95,6 @@ typedef struct{
 // Function prototypes
 void setup_unequal_static_partitions(StaticPartition (&partitions)[7]);
 void report_results(Results* equal, Results* one_queue_unequal, Results* multiple_queues_unequal, Results* first_fit);
+void generate_experiment_data(Data e[NUMBER_OF_SAMPLES], std::default_random_engine &gen, std::poisson_distribution<int> &poisson_dist, std::uniform_int_distribution<int> &uniform_dist);
+double size_tail_probability(int threshold, double mean);
 int main(int argc, char* argv[]);
\ No newline at end of file
@@ -0,0 +1,408 @@
+/**************************************************************************************************
+ * File: memsim.cpp
+ * Author: Nolan Davenport
+ * Procedures:
+ *
+ * memsim_api_version       - Gets the version of the C API the library was built with.
+ *
+ * memsim_status_string     - Gets a description of a status code.
+ *
+ * memsim_config_init       - Fills a configuration with the settings of the experiments in main.
+ *
+ * memsim_create            - Creates a simulation from a configuration.
+ *
+ * memsim_destroy           - Frees a simulation.
+ *
+ * memsim_set_workloads     - Lets a simulation read its workloads from memory the caller owns.
+ *
+ * memsim_run               - Runs experiments and adds them to the results of the simulation.
+ *                            Attached workloads are used in turn, starting over after the last.
+ *
+ * memsim_get_results       - Gets the averages and percentiles over every experiment run so far.
+ *
+ * memsim_reset             - Clears the results of a simulation.
+ *************************************************************************************************/
+
+#include<iostream>
+#include<random>
+#include<queue>
+#include<list>
+#include<vector>
+#include<new>
+#include<cstring>
+#include<cstddef>
+
+#include"main.h"
+#include"histogram.h"
+#include"static_layouts.h"
+#include"bitmap_memory.h"
+#include"memsim.h"
+
+using namespace std;
+
+#define MEMSIM_BATCH 64             // Experiments run together, sharing the generated workloads.
+
+// The jobs are read in place as the simulator's data.
+static_assert(MEMSIM_MAX_JOBS_PER_EXPERIMENT == NUMBER_OF_SAMPLES, "memsim.h must match main.h");
+static_assert(sizeof(memsim_job) == sizeof(Data), "memsim_job must match Data");
+static_assert(offsetof(memsim_job, size) == offsetof(Data, size), "memsim_job must match Data");
+static_assert(offsetof(memsim_job, time) == offsetof(Data, time), "memsim_job must match Data");
+static_assert(offsetof(memsim_job, left) == offsetof(Data, left), "memsim_job must match Data");
+static_assert(offsetof(memsim_job, time_start) == offsetof(Data, time_start), "memsim_job must match Data");
+static_assert(offsetof(memsim_job, failure) == offsetof(Data, failure), "memsim_job must match Data");
+
+// The state behind a memsim_simulation handle.
+struct memsim_simulation {
+    memsim_config config;                               // The settings, with the layout copied below.
+    vector<int> partition_sizes;                        // The static layout.
+    const Data* workloads = nullptr;                    // The attached jobs, or null to generate workloads.
+    size_t number_of_workloads = 0;                     // The whole experiments in the attached jobs.
+    int jobs_per_experiment = 0;                        // The jobs in each attached experiment.
+    size_t next_workload = 0;                           // The attached experiment to run next.
+    default_random_engine gen;                          // Draws the generated workloads.
+    poisson_distribution<int> poisson_dist{8};          // Same size distribution as main.
+    uniform_int_distribution<int> uniform_dist{1, 10};  // Same time distribution as main.
+    vector<Data> generated;                             // The generated workloads of a batch.
+    Results* results = nullptr;                         // The results over every experiment.
+    long long experiments = 0;                          // The experiments run.
+    long long jobs = 0;                                 // The data items in them.
+};
+
+/**************************************************************************************************
+ * int memsim_api_version()
+ *
+ * Author: Nolan Davenport
+ * Description: Gets the version of the C API the library was built with. A caller compares it
+ *              with MEMSIM_API_VERSION from its own header.
+ *
+ * Parameters:
+ *  memsim_api_version      O/P     int     The version.
+ *************************************************************************************************/
+int memsim_api_version(void){
+    return MEMSIM_API_VERSION;
+}
+
+/**************************************************************************************************
+ * const char* memsim_status_string(memsim_status status)
+ *
+ * Author: Nolan Davenport
+ * Description: Gets a description of a status code.
+ *
+ * Parameters:
+ *  status                  I/P     memsim_status   The status.
+ *  memsim_status_string    O/P     const char*     Its description, which is never freed.
+ *************************************************************************************************/
+const char* memsim_status_string(memsim_status status){
+    switch(status){
+        case MEMSIM_OK: return "ok";
+        case MEMSIM_INVALID_ARGUMENT: return "invalid argument";
+        case MEMSIM_OUT_OF_MEMORY: return "out of memory";
+        case MEMSIM_NO_WORKLOADS: return "the attached jobs don't make up a whole experiment";
+    }
+    return "unknown status";
+}
+
+/**************************************************************************************************
+ * void memsim_config_init(memsim_config* config)
+ *
+ * Author: Nolan Davenport
+ * Description: Fills a configuration with the settings of the experiments in main: the dynamic
+ *              style in 56MB, and the layout of each static style.
+ *
+ * Parameters:
+ *  config      O/P     memsim_config*      The configuration to fill.
+ *************************************************************************************************/
+void memsim_config_init(memsim_config* config){
+    if(config == nullptr){
+        return;
+    }
+    memset(config, 0, sizeof(memsim_config));
+    config->struct_size = sizeof(memsim_config);
+    config->strategy = MEMSIM_DYNAMIC;
+    config->partition_sizes = nullptr;              // The layout of the style.
+    config->partition_count = 0;
+    config->memory_mb = MEMORY_END + 1;
+    config->seed = 0;
+}
+
+/**************************************************************************************************
+ * memsim_status memsim_create(const memsim_config* config, memsim_simulation** simulation)
+ *
+ * Author: Nolan Davenport
+ * Description: Creates a simulation from a configuration. Fields past the struct_size of the
+ *              caller keep their defaults. The partition sizes are copied. The equal style
+ *              only takes partitions of one size.
+ *
+ * Parameters:
+ *  config          I/P     const memsim_config*    The settings.
+ *  simulation      O/P     memsim_simulation**     The new simulation, or null on failure.
+ *  memsim_create   O/P     memsim_status           MEMSIM_OK, or why it failed.
+ *************************************************************************************************/
+memsim_status memsim_create(const memsim_config* config, memsim_simulation** simulation){
+    if(simulation == nullptr){
+        return MEMSIM_INVALID_ARGUMENT;
+    }
+    *simulation = nullptr;
+    if(config == nullptr || config->struct_size < offsetof(memsim_config, seed)){
+        return MEMSIM_INVALID_ARGUMENT;             // Every version has the fields up to the seed.
+    }
+
+    memsim_config settings;                         // The caller's settings over the defaults.
+    memsim_config_init(&settings);
+    memcpy(&settings, config, min(config->struct_size, sizeof(memsim_config)));
+    settings.struct_size = sizeof(memsim_config);
+
+    if(settings.strategy < MEMSIM_EQUAL || settings.strategy > MEMSIM_DYNAMIC){
+        return MEMSIM_INVALID_ARGUMENT;
+    }
+    if(settings.strategy == MEMSIM_DYNAMIC && settings.memory_mb <= 0){
+        return MEMSIM_INVALID_ARGUMENT;
+    }
+    if(settings.partition_sizes != nullptr){        // A layout of the caller.
+        if(settings.partition_count <= 0){
+            return MEMSIM_INVALID_ARGUMENT;
+        }
+        for(int i = 0; i < settings.partition_count; i++){
+            if(settings.partition_sizes[i] <= 0){
+                return MEMSIM_INVALID_ARGUMENT;
+            }
+            if(settings.strategy == MEMSIM_EQUAL && settings.partition_sizes[i] != settings.partition_sizes[0]){
+                return MEMSIM_INVALID_ARGUMENT;     // The equal engines only read the first size.
+            }
+        }
+    }
+
+    try{
+        memsim_simulation* created = new memsim_simulation();
+        created->config = settings;
+        if(settings.partition_sizes != nullptr){
+            created->partition_sizes.assign(settings.partition_sizes, settings.partition_sizes + settings.partition_count);
+        }else if(settings.strategy == MEMSIM_EQUAL){
+            created->partition_sizes.assign(EqualLayout::sizes, EqualLayout::sizes + EqualLayout::count);
+        }else{
+            created->partition_sizes.assign(UnequalLayout::sizes, UnequalLayout::sizes + UnequalLayout::count);
+        }
+        created->config.partition_sizes = nullptr;  // The caller's array isn't kept.
+        created->config.partition_count = created->partition_sizes.size();
+        created->gen.seed(settings.seed);
+        created->results = new Results();
+        *simulation = created;
+    }catch(const bad_alloc&){
+        return MEMSIM_OUT_OF_MEMORY;
+    }
+    return MEMSIM_OK;
+}
+
+/**************************************************************************************************
+ * void memsim_destroy(memsim_simulation* simulation)
+ *
+ * Author: Nolan Davenport
+ * Description: Frees a simulation. The attached jobs belong to the caller and are not freed.
+ *
+ * Parameters:
+ *  simulation      I/O     memsim_simulation*  The simulation, or null.
+ *************************************************************************************************/
+void memsim_destroy(memsim_simulation* simulation){
+    if(simulation == nullptr){
+        return;
+    }
+    delete simulation->results;
+    delete simulation;
+}
+
+/**************************************************************************************************
+ * memsim_status memsim_set_workloads(memsim_simulation* simulation, memsim_job* jobs,
+ *                                    size_t number_of_jobs, int jobs_per_experiment)
+ *
+ * Author: Nolan Davenport
+ * Description: Lets a simulation read its workloads from memory the caller owns. Every
+ *              jobs_per_experiment jobs make up one experiment; jobs past the last whole one are
+ *              ignored. The bookkeeping fields of each job are filled here, once. The runs only
+ *              read the jobs, so they must stay alive and unchanged until other workloads are
+ *              set or the simulation is destroyed. Null jobs go back to generated workloads.
+ *              An experiment holds at most MEMSIM_MAX_JOBS_PER_EXPERIMENT jobs, like the
+ *              experiments of main.
+ *
+ * Parameters:
+ *  simulation              I/O     memsim_simulation*  The simulation.
+ *  jobs                    I/O     memsim_job*         The jobs, experiment after experiment.
+ *  number_of_jobs          I/P     size_t              The number of jobs.
+ *  jobs_per_experiment     I/P     int                 The jobs in each experiment.
+ *  memsim_set_workloads    O/P     memsim_status       MEMSIM_OK, or why it failed.
+ *************************************************************************************************/
+memsim_status memsim_set_workloads(memsim_simulation* simulation, memsim_job* jobs, size_t number_of_jobs,
+                                   int jobs_per_experiment){
+    if(simulation == nullptr){
+        return MEMSIM_INVALID_ARGUMENT;
+    }
+    if(jobs == nullptr){                            // Go back to generated workloads.
+        simulation->workloads = nullptr;
+        simulation->number_of_workloads = 0;
+        simulation->jobs_per_experiment = 0;
+        simulation->next_workload = 0;
+        return MEMSIM_OK;
+    }
+    if(jobs_per_experiment <= 0 || jobs_per_experiment > MEMSIM_MAX_JOBS_PER_EXPERIMENT){
+        return MEMSIM_INVALID_ARGUMENT;
+    }
+    if(number_of_jobs < (size_t)jobs_per_experiment){
+        return MEMSIM_NO_WORKLOADS;
+    }
+    for(size_t i = 0; i < number_of_jobs; i++){
+        if(jobs[i].size < 0 || jobs[i].time <= 0){  // Every job needs time on the processor.
+            return MEMSIM_INVALID_ARGUMENT;
+        }
+    }
+
+    for(size_t i = 0; i < number_of_jobs; i++){     // Fill the bookkeeping fields.
+        jobs[i].index = i % jobs_per_experiment;
+        jobs[i].left = jobs[i].time;
+        jobs[i].time_start = 0;                     // Every job arrives at the start.
+    }
+
+    simulation->workloads = reinterpret_cast<const Data*>(jobs);
+    simulation->number_of_workloads = number_of_jobs / jobs_per_experiment;
+    simulation->jobs_per_experiment = jobs_per_experiment;
+    simulation->next_workload = 0;
+    return MEMSIM_OK;
+}
+
+/**************************************************************************************************
+ * memsim_status memsim_run(memsim_simulation* simulation, int experiments)
+ *
+ * Author: Nolan Davenport
+ * Description: Runs experiments and adds them to the results of the simulation. The experiments
+ *              run in batches. The static styles run each batch on the engine for their layout
+ *              and the dynamic style runs on the bitmap memory, so neither writes to the
+ *              workloads.
+ *              Attached workloads are used in turn, starting over after the last. Otherwise each
+ *              experiment draws NUMBER_OF_SAMPLES data items like main does.
+ *
+ * Parameters:
+ *  simulation      I/O     memsim_simulation*  The simulation.
+ *  experiments     I/P     int                 The number of experiments to run.
+ *  memsim_run      O/P     memsim_status       MEMSIM_OK, or why it failed.
+ *************************************************************************************************/
+memsim_status memsim_run(memsim_simulation* simulation, int experiments){
+    if(simulation == nullptr || experiments < 0){
+        return MEMSIM_INVALID_ARGUMENT;
+    }
+
+    try{
+        vector<const Data*> batch;                                  // The workloads of a batch.
+        vector<int> sample_counts;                                  // Their sizes.
+        for(int done = 0; done < experiments; done += batch.size()){
+            int batch_size = min(experiments - done, MEMSIM_BATCH);
+            batch.clear();
+            sample_counts.clear();
+            if(simulation->workloads != nullptr){                   // Take the next attached workloads.
+                for(int i = 0; i < batch_size; i++){
+                    batch.push_back(simulation->workloads +
+                        simulation->next_workload * simulation->jobs_per_experiment);
+                    sample_counts.push_back(simulation->jobs_per_experiment);
+                    simulation->next_workload = (simulation->next_workload + 1) % simulation->number_of_workloads;
+                }
+            }else{                                                  // Draw new workloads.
+                simulation->generated.resize(MEMSIM_BATCH * NUMBER_OF_SAMPLES);
+                for(int i = 0; i < batch_size; i++){
+                    Data* workload = &simulation->generated[i * NUMBER_OF_SAMPLES];
+                    generate_experiment_data(workload, simulation->gen, simulation->poisson_dist,
+                        simulation->uniform_dist);
+                    batch.push_back(workload);
+                    sample_counts.push_back(NUMBER_OF_SAMPLES);
+                }
+            }
+
+            if(simulation->config.strategy == MEMSIM_DYNAMIC){
+                for(int i = 0; i < batch_size; i++){                // The bitmap engine copies the time left.
+                    dynamic_bitmap_partitioning(const_cast<Data*>(batch[i]), sample_counts[i],
+                        simulation->results, simulation->config.memory_mb, 1);
+                }
+            }else{
+                StaticStyle style = (simulation->config.strategy == MEMSIM_EQUAL) ? EQUAL_STYLE :
+                    (simulation->config.strategy == MEMSIM_ONE_QUEUE) ? ONE_QUEUE_STYLE : MULTIPLE_QUEUES_STYLE;
+                batch_static_partitioning(batch.data(), sample_counts.data(), batch_size, style,
+                    simulation->partition_sizes.data(), simulation->partition_sizes.size(), simulation->results);
+            }
+
+            simulation->experiments += batch_size;
+            for(int count : sample_counts){
+                simulation->jobs += count;
+            }
+        }
+    }catch(const bad_alloc&){
+        return MEMSIM_OUT_OF_MEMORY;
+    }
+    return MEMSIM_OK;
+}
+
+/**************************************************************************************************
+ * memsim_status memsim_get_results(const memsim_simulation* simulation, memsim_results* results)
+ *
+ * Author: Nolan Davenport
+ * Description: Gets the averages and percentiles over every experiment run so far, the same
+ *              values report_results prints. Only the fields inside the struct_size of the caller
+ *              are written. With no experiments run every value is zero.
+ *
+ * Parameters:
+ *  simulation          I/P     const memsim_simulation*    The simulation.
+ *  results             I/O     memsim_results*             The results, with struct_size set.
+ *  memsim_get_results  O/P     memsim_status               MEMSIM_OK, or why it failed.
+ *************************************************************************************************/
+memsim_status memsim_get_results(const memsim_simulation* simulation, memsim_results* results){
+    if(simulation == nullptr || results == nullptr || results->struct_size < sizeof(size_t)){
+        return MEMSIM_INVALID_ARGUMENT;
+    }
+
+    memsim_results found;                           // Every field, copied out up to the caller's size.
+    memset(&found, 0, sizeof(memsim_results));
+    found.struct_size = results->struct_size;
+    found.experiments = simulation->experiments;
+    found.jobs = simulation->jobs;
+    if(simulation->experiments > 0){
+        const Results* totals = simulation->results;
+        double experiments = simulation->experiments;
+        found.average_turn_around_time = totals->turn_around_time / (double)simulation->jobs;
+        found.average_relative_turn_around_time = totals->relative_turn_around_time / (double)simulation->jobs;
+        found.average_failures = totals->number_of_failures / experiments;
+        found.average_data_members = totals->average_num_data_members_in_partition_table / experiments;
+        found.has_memory_metrics = (simulation->config.strategy == MEMSIM_DYNAMIC);
+        found.average_memory_utilization = totals->average_memory_utilization / experiments;
+        found.average_internal_fragmentation = totals->average_internal_fragmentation / experiments;
+        found.average_hole_count = totals->average_hole_count / experiments;
+        found.average_largest_hole = totals->average_largest_hole / experiments;
+        found.turn_around_p50 = histogram_percentile(totals->turn_around_histogram, 50);
+        found.turn_around_p90 = histogram_percentile(totals->turn_around_histogram, 90);
+        found.turn_around_p99 = histogram_percentile(totals->turn_around_histogram, 99);
+        found.turn_around_max = totals->turn_around_histogram.max;
+    }
+
+    memcpy(results, &found, min(results->struct_size, sizeof(memsim_results)));
+    return MEMSIM_OK;
+}
+
+/**************************************************************************************************
+ * memsim_status memsim_reset(memsim_simulation* simulation)
+ *
+ * Author: Nolan Davenport
+ * Description: Clears the results of a simulation. The workloads and the random engine carry on.
+ *
+ * Parameters:
+ *  simulation      I/O     memsim_simulation*  The simulation.
+ *  memsim_reset    O/P     memsim_status       MEMSIM_OK, or why it failed.
+ *************************************************************************************************/
+memsim_status memsim_reset(memsim_simulation* simulation){
+    if(simulation == nullptr){
+        return MEMSIM_INVALID_ARGUMENT;
+    }
+    try{
+        Results* cleared = new Results();
+        delete simulation->results;
+        simulation->results = cleared;
+    }catch(const bad_alloc&){
+        return MEMSIM_OUT_OF_MEMORY;
+    }
+    simulation->experiments = 0;
+    simulation->jobs = 0;
+    return MEMSIM_OK;
+}
\ No newline at end of file
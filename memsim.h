@@ -0,0 +1,126 @@
+/**************************************************************************************************
+ * File: memsim.h
+ * Author: Nolan Davenport
+ * Procedures:
+ *
+ * memsim_api_version       - Gets the version of the C API the library was built with.
+ *
+ * memsim_status_string     - Gets a description of a status code.
+ *
+ * memsim_config_init       - Fills a configuration with the settings of the experiments in main.
+ *
+ * memsim_create            - Creates a simulation from a configuration.
+ *
+ * memsim_destroy           - Frees a simulation.
+ *
+ * memsim_set_workloads     - Lets a simulation read its workloads from memory the caller owns.
+ *
+ * memsim_run               - Runs experiments and adds them to the results of the simulation.
+ *                            Attached workloads are used in turn, starting over after the last.
+ *
+ * memsim_get_results       - Gets the averages and percentiles over every experiment run so far.
+ *
+ * memsim_reset             - Clears the results of a simulation.
+ *
+ * The C interface of the simulator library built by build_library.sh. A simulation runs one
+ * partitioning style. Experiments read either workloads the caller attached or workloads drawn
+ * from the same distributions as main. The structures only ever grow at the end, and the caller
+ * sets struct_size (memsim_config_init does), so a program built against an older header keeps
+ * working with a newer library. Different simulations can run on different threads at once.
+ *************************************************************************************************/
+
+#pragma once
+
+#include<stddef.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#define MEMSIM_API_VERSION 1                                // Changes only when the interface breaks.
+#define MEMSIM_MAX_JOBS_PER_EXPERIMENT 1000                 // The most jobs an experiment can have.
+
+#if defined(__GNUC__)
+#define MEMSIM_API __attribute__((visibility("default")))   // Only the C interface is exported.
+#else
+#define MEMSIM_API
+#endif
+
+// The status returned by every call.
+typedef enum {
+    MEMSIM_OK = 0,                  // The call succeeded.
+    MEMSIM_INVALID_ARGUMENT = 1,    // A pointer was null or a setting was out of range.
+    MEMSIM_OUT_OF_MEMORY = 2,       // The simulation couldn't allocate memory.
+    MEMSIM_NO_WORKLOADS = 3         // The attached jobs don't make up a whole experiment.
+} memsim_status;
+
+// The partitioning styles a simulation can run.
+typedef enum {
+    MEMSIM_EQUAL = 0,               // Equal static partitions refilled from a single queue.
+    MEMSIM_ONE_QUEUE = 1,           // Unequal static partitions filled from a single queue.
+    MEMSIM_MULTIPLE_QUEUES = 2,     // Unequal static partitions with a queue each.
+    MEMSIM_DYNAMIC = 3              // Dynamic partitions placed with first fit.
+} memsim_strategy;
+
+// The settings of a simulation. Fill it with memsim_config_init before changing fields.
+typedef struct {
+    size_t struct_size;             // sizeof(memsim_config) of the caller.
+    memsim_strategy strategy;       // The partitioning style.
+    const int* partition_sizes;     // The static partition sizes in MB, or null for the layout of the style.
+                                    // Every equal partition has the same size.
+    int partition_count;            // The number of static partitions.
+    int memory_mb;                  // The memory of the dynamic style in MB.
+    unsigned seed;                  // Seeds the generated workloads.
+} memsim_config;
+
+// One data item of a workload. The layout matches the simulator's own data, so workloads are read
+// in place. The caller sets size and time; memsim_set_workloads fills the rest.
+typedef struct {
+    int index;                      // The position of the item in its experiment.
+    int size;                       // The memory it needs in MB.
+    int time;                       // The processor time it needs.
+    int left;                       // The time left, set to time.
+    int time_start;                 // When it arrived, set to zero.
+    int time_end;                   // Unused.
+    int turn_around_time;           // Unused.
+    unsigned char failure;          // Unused.
+} memsim_job;
+
+// The results over every experiment run so far. Averages are per data item, except failures and
+// the table and memory averages, which are per experiment like the report of main.
+typedef struct {
+    size_t struct_size;                             // sizeof(memsim_results) of the caller.
+    long long experiments;                          // The experiments run.
+    long long jobs;                                 // The data items in them.
+    double average_turn_around_time;                // Per data item.
+    double average_relative_turn_around_time;       // Per data item.
+    double average_failures;                        // Per experiment.
+    double average_data_members;                    // Data in the partition table, per experiment.
+    int has_memory_metrics;                         // Whether the four memory averages are filled.
+    double average_memory_utilization;              // Per experiment, dynamic style only.
+    double average_internal_fragmentation;          // Per experiment, dynamic style only.
+    double average_hole_count;                      // Per experiment, dynamic style only.
+    double average_largest_hole;                    // Per experiment, dynamic style only.
+    long long turn_around_p50;                      // Turnaround percentiles, within about 3%.
+    long long turn_around_p90;
+    long long turn_around_p99;
+    long long turn_around_max;                      // The largest turnaround.
+} memsim_results;
+
+// A simulation. Only the library sees inside it.
+typedef struct memsim_simulation memsim_simulation;
+
+// Function prototypes
+MEMSIM_API int memsim_api_version(void);
+MEMSIM_API const char* memsim_status_string(memsim_status status);
+MEMSIM_API void memsim_config_init(memsim_config* config);
+MEMSIM_API memsim_status memsim_create(const memsim_config* config, memsim_simulation** simulation);
+MEMSIM_API void memsim_destroy(memsim_simulation* simulation);
+MEMSIM_API memsim_status memsim_set_workloads(memsim_simulation* simulation, memsim_job* jobs, size_t number_of_jobs, int jobs_per_experiment);
+MEMSIM_API memsim_status memsim_run(memsim_simulation* simulation, int experiments);
+MEMSIM_API memsim_status memsim_get_results(const memsim_simulation* simulation, memsim_results* results);
+MEMSIM_API memsim_status memsim_reset(memsim_simulation* simulation);
+
+#ifdef __cplusplus
+}
+#endif
\ No newline at end of file
@@ -0,0 +1,128 @@
+/**************************************************************************************************
+ * File: memsim_smoke.c
+ * Author: Nolan Davenport
+ * Procedures:
+ *
+ * check        - Prints a failed check and counts it.
+ *
+ * run_style    - Runs a few experiments of one partitioning style and checks the results.
+ *
+ * main         - Entry point for the smoke test of the C interface. build_library.sh builds it as
+ *                C99 against libmemsim.so and runs it.
+ *************************************************************************************************/
+
+#include<stdio.h>
+#include<string.h>
+
+#include"memsim.h"
+
+static int failures = 0;    /* The number of failed checks. */
+
+/**************************************************************************************************
+ * static void check(int ok, const char* what)
+ *
+ * Author: Nolan Davenport
+ * Description: Prints a failed check and counts it.
+ *
+ * Parameters:
+ *  ok      I/P     int             Whether the check passed.
+ *  what    I/P     const char*     What was checked.
+ *************************************************************************************************/
+static void check(int ok, const char* what){
+    if(!ok){                                        /* Only failures are printed. */
+        fprintf(stderr, "memsim smoke test failed: %s\n", what);
+        failures++;
+    }
+}
+
+/**************************************************************************************************
+ * static void run_style(memsim_strategy strategy)
+ *
+ * Author: Nolan Davenport
+ * Description: Runs a few experiments of one partitioning style on generated workloads, then
+ *              on attached ones, and checks the results.
+ *
+ * Parameters:
+ *  strategy    I/P     memsim_strategy     The partitioning style.
+ *************************************************************************************************/
+static void run_style(memsim_strategy strategy){
+    memsim_config config;
+    memsim_simulation* simulation = NULL;
+    memsim_results results;
+    memsim_job jobs[2 * 20];                        /* Two attached experiments of 20 jobs. */
+    int i;
+
+    memsim_config_init(&config);                    /* The settings of main. */
+    config.strategy = strategy;
+    config.seed = 12345;
+    check(memsim_create(&config, &simulation) == MEMSIM_OK, "create");
+    if(simulation == NULL){
+        return;
+    }
+
+    check(memsim_run(simulation, 10) == MEMSIM_OK, "run generated workloads");
+    memset(&results, 0, sizeof(results));
+    results.struct_size = sizeof(results);
+    check(memsim_get_results(simulation, &results) == MEMSIM_OK, "get results");
+    check(results.experiments == 10 && results.jobs > 0, "experiment and job counts");
+    check(results.average_turn_around_time > 0 && results.turn_around_p99 >= results.turn_around_p50,
+        "turnaround averages and percentiles");
+    if(strategy == MEMSIM_DYNAMIC){                 /* Only the dynamic style has memory metrics. */
+        check(results.has_memory_metrics && results.average_memory_utilization > 0 &&
+            results.average_hole_count > 0, "dynamic memory metrics");
+    }
+
+    memset(jobs, 0, sizeof(jobs));                  /* Attach jobs of every size and time. */
+    for(i = 0; i < 2 * 20; i++){
+        jobs[i].size = 1 + i % 16;
+        jobs[i].time = 1 + i % 10;
+    }
+    check(memsim_reset(simulation) == MEMSIM_OK, "reset");
+    check(memsim_set_workloads(simulation, jobs, 2 * 20, 20) == MEMSIM_OK, "attach workloads");
+    check(memsim_run(simulation, 4) == MEMSIM_OK, "run attached workloads");
+    check(memsim_get_results(simulation, &results) == MEMSIM_OK && results.experiments == 4 &&
+        results.jobs == 4 * 20, "attached workload counts");
+    check(memsim_set_workloads(simulation, jobs, 2 * 20, 50) == MEMSIM_NO_WORKLOADS,
+        "reject a partial experiment");
+    check(memsim_set_workloads(simulation, jobs, 2 * 20, MEMSIM_MAX_JOBS_PER_EXPERIMENT + 1) ==
+        MEMSIM_INVALID_ARGUMENT, "reject an experiment longer than the limit");
+
+    memsim_destroy(simulation);
+}
+
+/**************************************************************************************************
+ * int main(void)
+ *
+ * Author: Nolan Davenport
+ * Description: Entry point for the smoke test of the C interface. Runs every partitioning style
+ *              and checks that bad arguments are refused.
+ *
+ * Parameters:
+ *  main    O/P     int     Zero if every check passed.
+ *************************************************************************************************/
+int main(void){
+    memsim_simulation* simulation = NULL;
+    memsim_config config;
+    int mixed_sizes[3] = {8, 8, 16};                /* Not a layout of equal partitions. */
+
+    check(memsim_api_version() == MEMSIM_API_VERSION, "api version");
+    check(strlen(memsim_status_string(MEMSIM_INVALID_ARGUMENT)) > 0, "status string");
+    check(memsim_create(NULL, &simulation) == MEMSIM_INVALID_ARGUMENT, "reject a null config");
+    check(memsim_run(NULL, 1) == MEMSIM_INVALID_ARGUMENT, "reject a null simulation");
+    memsim_config_init(&config);
+    config.strategy = MEMSIM_EQUAL;
+    config.partition_sizes = mixed_sizes;
+    config.partition_count = 3;
+    check(memsim_create(&config, &simulation) == MEMSIM_INVALID_ARGUMENT && simulation == NULL,
+        "reject equal partitions of different sizes");
+
+    run_style(MEMSIM_EQUAL);
+    run_style(MEMSIM_ONE_QUEUE);
+    run_style(MEMSIM_MULTIPLE_QUEUES);
+    run_style(MEMSIM_DYNAMIC);
+
+    if(failures == 0){
+        printf("memsim smoke test passed\n");
+    }
+    return failures == 0 ? 0 : 1;
+}
\ No newline at end of file
@@ -0,0 +1,237 @@
+/**************************************************************************************************
+ * File: metrics.cpp
+ * Author: Nolan Davenport
+ * Procedures:
+ * 
+ * time_series_record           - Records one tick into a time series, halving its resolution 
+ *                                when it is full. 
+ * 
+ * write_time_series            - Writes a time series to a csv file. 
+ * 
+ * metrics_admit                - Updates the memory metrics when data is placed in memory. 
+ * 
+ * metrics_release              - Updates the memory metrics when data leaves memory. 
+ * 
+ * metrics_add_hole             - Adds a hole to the hole metrics of dynamic partitioning. 
+ * 
+ * metrics_remove_hole          - Removes a hole from the hole metrics of dynamic partitioning. 
+ * 
+ * metrics_reset_holes          - Replaces every hole with a single hole, as after compaction. 
+ * 
+ * metrics_tick                 - Adds the current memory metrics for one clock tick. 
+ * 
+ * metrics_finish_experiment    - Averages the memory metrics over an experiment and adds them 
+ *                                to the results. 
+ *************************************************************************************************/
+
+#include<iostream>
+#include<fstream>
+#include<random>
+#include<queue>
+#include<list>
+#include<vector>
+#include<algorithm>
+
+#include"main.h"
+#include"metrics.h"
+
+using namespace std;
+
+/**************************************************************************************************
+ * void time_series_record(TimeSeries* series, float value)
+ * 
+ * Author: Nolan Davenport
+ * Description: Records one tick into a time series. Ticks are averaged into points of 
+ *              ticks_per_point ticks. When every point is used, neighbouring points are averaged 
+ *              together so the series keeps covering the whole run in the same memory. 
+ * 
+ * Parameters:
+ *  series      I/O     TimeSeries*     The time series to record into.
+ *  value       I/P     float           The value for this tick.
+ *************************************************************************************************/
+void time_series_record(TimeSeries* series, float value){
+    series->pending_sum += value;                               // Add the value to the current point.
+    series->pending_ticks++;                                    // Count the tick.
+
+    if(series->pending_ticks < series->ticks_per_point){        // If the current point isn't complete yet:
+        return;                                                 // Nothing else to do.
+    }
+
+    if(series->count == TIME_SERIES_CAPACITY){                  // If every point is used:
+        for(int i = 0; i < TIME_SERIES_CAPACITY / 2; i++){      // Average each pair of points into one.
+            series->values[i] = (series->values[2*i] + series->values[2*i + 1]) / 2;
+        }
+        series->count = TIME_SERIES_CAPACITY / 2;               // Half of the points are now used.
+        series->ticks_per_point *= 2;                           // Each point covers twice as many ticks.
+
+        if(series->pending_ticks < series->ticks_per_point){    // The current point now needs more ticks.
+            return;
+        }
+    }
+
+    series->values[series->count++] =                           // Store the completed point.
+        series->pending_sum / series->pending_ticks;
+    series->pending_sum = 0;                                    // Start a new point.
+    series->pending_ticks = 0;
+}
+
+/**************************************************************************************************
+ * void write_time_series(const TimeSeries* series, const char* file_name)
+ * 
+ * Author: Nolan Davenport
+ * Description: Writes a time series to a csv file. The first column is the tick where each 
+ *              point starts, counting the ticks of every experiment back to back. The ticks not
+ *              yet made into a point are written as a shorter last point.
+ * 
+ * Parameters:
+ *  series      I/P     const TimeSeries*   The time series to write.
+ *  file_name   I/P     const char*         The name of the csv file.
+ *************************************************************************************************/
+void write_time_series(const TimeSeries* series, const char* file_name){
+    ofstream file(file_name);                                   // Open the file.
+    file << "tick, memory_utilization" << endl;                 // Write the header.
+    for(int i = 0; i < series->count; i++){                     // Loop through the points.
+        file << (long long)i * series->ticks_per_point <<       // Write the tick and the value.
+            ", " << series->values[i] << endl;
+    }
+    if(series->pending_ticks > 0){                              // Write the partial point too.
+        file << (long long)series->count * series->ticks_per_point <<
+            ", " << series->pending_sum / series->pending_ticks << endl;
+    }
+}
+
+/**************************************************************************************************
+ * void metrics_admit(MemoryMetrics &metrics, int partition_size, int data_size)
+ * 
+ * Author: Nolan Davenport
+ * Description: Updates the memory metrics when data is placed in memory. 
+ * 
+ * Parameters:
+ *  metrics         I/O     MemoryMetrics (&)   The metrics of this experiment.
+ *  partition_size  I/P     int                 The size of the partition the data was placed in.
+ *  data_size       I/P     int                 The size of the data.
+ *************************************************************************************************/
+void metrics_admit(MemoryMetrics &metrics, int partition_size, int data_size){
+    metrics.used_memory += min(partition_size, data_size);              // Data larger than its partition only uses the partition.
+    metrics.internal_fragmentation += max(0, partition_size - data_size);   // The rest of the partition is wasted.
+}
+
+/**************************************************************************************************
+ * void metrics_release(MemoryMetrics &metrics, int partition_size, int data_size)
+ * 
+ * Author: Nolan Davenport
+ * Description: Updates the memory metrics when data leaves memory. 
+ * 
+ * Parameters:
+ *  metrics         I/O     MemoryMetrics (&)   The metrics of this experiment.
+ *  partition_size  I/P     int                 The size of the partition the data was in.
+ *  data_size       I/P     int                 The size of the data.
+ *************************************************************************************************/
+void metrics_release(MemoryMetrics &metrics, int partition_size, int data_size){
+    metrics.used_memory -= min(partition_size, data_size);              // Undo what metrics_admit added.
+    metrics.internal_fragmentation -= max(0, partition_size - data_size);
+}
+
+/**************************************************************************************************
+ * void metrics_add_hole(MemoryMetrics &metrics, int size)
+ * 
+ * Author: Nolan Davenport
+ * Description: Adds a hole to the hole metrics of dynamic partitioning. Holes of size zero or 
+ *              less are not holes and are ignored. 
+ * 
+ * Parameters:
+ *  metrics     I/O     MemoryMetrics (&)   The metrics of this experiment.
+ *  size        I/P     int                 The size of the hole.
+ *************************************************************************************************/
+void metrics_add_hole(MemoryMetrics &metrics, int size){
+    if(size <= 0){                                  // If there isn't really a hole:
+        return;                                     // Nothing to add.
+    }
+    if(size >= (int)metrics.hole_sizes.size()){     // If no hole this large was seen before:
+        metrics.hole_sizes.resize(size + 1, 0);     // Make room to count it.
+    }
+    metrics.hole_sizes[size]++;                     // Count the hole under its size.
+    metrics.hole_count++;                           // Count the hole.
+    metrics.largest_hole = max(metrics.largest_hole, size); // Update the largest hole.
+}
+
+/**************************************************************************************************
+ * void metrics_remove_hole(MemoryMetrics &metrics, int size)
+ * 
+ * Author: Nolan Davenport
+ * Description: Removes a hole from the hole metrics of dynamic partitioning. If the largest hole 
+ *              is removed, the next largest is found by walking down the sizes. 
+ * 
+ * Parameters:
+ *  metrics     I/O     MemoryMetrics (&)   The metrics of this experiment.
+ *  size        I/P     int                 The size of the hole.
+ *************************************************************************************************/
+void metrics_remove_hole(MemoryMetrics &metrics, int size){
+    if(size <= 0){                                  // If there isn't really a hole:
+        return;                                     // Nothing to remove.
+    }
+    metrics.hole_sizes[size]--;                     // Uncount the hole under its size.
+    metrics.hole_count--;                           // Uncount the hole.
+    while(metrics.largest_hole > 0 &&               // Walk down to the largest size that still has a hole.
+        metrics.hole_sizes[metrics.largest_hole] == 0){
+        metrics.largest_hole--;
+    }
+}
+
+/**************************************************************************************************
+ * void metrics_reset_holes(MemoryMetrics &metrics, int size)
+ * 
+ * Author: Nolan Davenport
+ * Description: Replaces every hole with a single hole, as after compaction. 
+ * 
+ * Parameters:
+ *  metrics     I/O     MemoryMetrics (&)   The metrics of this experiment.
+ *  size        I/P     int                 The size of the remaining hole.
+ *************************************************************************************************/
+void metrics_reset_holes(MemoryMetrics &metrics, int size){
+    fill(metrics.hole_sizes.begin(), metrics.hole_sizes.end(), 0);  // Clear every hole size.
+    metrics.hole_count = 0;                         // There are no holes left.
+    metrics.largest_hole = 0;
+    metrics_add_hole(metrics, size);                // Except for the one at the end of memory.
+}
+
+/**************************************************************************************************
+ * void metrics_tick(MemoryMetrics &metrics, Results* results)
+ * 
+ * Author: Nolan Davenport
+ * Description: Adds the current memory metrics for one clock tick and records the memory 
+ *              utilization into the time series of the results. 
+ * 
+ * Parameters:
+ *  metrics     I/O     MemoryMetrics (&)   The metrics of this experiment.
+ *  results     O/P     Results*            The results that hold the time series.
+ *************************************************************************************************/
+void metrics_tick(MemoryMetrics &metrics, Results* results){
+    float memory_utilization = (float)metrics.used_memory / metrics.memory_size;   // Fraction of memory in use.
+
+    metrics.memory_utilization_sum += memory_utilization;           // Add this tick to the sums.
+    metrics.internal_fragmentation_sum += metrics.internal_fragmentation;
+    metrics.hole_count_sum += metrics.hole_count;
+    metrics.largest_hole_sum += metrics.largest_hole;
+
+    time_series_record(&results->memory_utilization_over_time,     // Record the utilization over time.
+        memory_utilization);
+}
+
+/**************************************************************************************************
+ * void metrics_finish_experiment(MemoryMetrics &metrics, Results* results, int clock)
+ * 
+ * Author: Nolan Davenport
+ * Description: Averages the memory metrics over an experiment and adds them to the results. 
+ * 
+ * Parameters:
+ *  metrics     I/P     MemoryMetrics (&)   The metrics of this experiment.
+ *  results     O/P     Results*            Pointer to the structure that holds the results.
+ *  clock       I/P     int                 The number of ticks in this experiment.
+ *************************************************************************************************/
+void metrics_finish_experiment(MemoryMetrics &metrics, Results* results, int clock){
+    results->average_memory_utilization += metrics.memory_utilization_sum / clock;      // Add the averages for this
+    results->average_internal_fragmentation += metrics.internal_fragmentation_sum / clock;  // experiment to the
+    results->average_hole_count += metrics.hole_count_sum / clock;                      // cumulative values.
+    results->average_largest_hole += metrics.largest_hole_sum / clock;
+}
\ No newline at end of file
@@ -0,0 +1,64 @@
+/**************************************************************************************************
+ * File: metrics.h
+ * Author: Nolan Davenport
+ * Procedures:
+ * 
+ * time_series_record           - Records one tick into a time series, halving its resolution 
+ *                                when it is full. 
+ * 
+ * write_time_series            - Writes a time series to a csv file. 
+ * 
+ * metrics_admit                - Updates the memory metrics when data is placed in memory. 
+ * 
+ * metrics_release              - Updates the memory metrics when data leaves memory. 
+ * 
+ * metrics_add_hole             - Adds a hole to the hole metrics of dynamic partitioning. 
+ * 
+ * metrics_remove_hole          - Removes a hole from the hole metrics of dynamic partitioning. 
+ * 
+ * metrics_reset_holes          - Replaces every hole with a single hole, as after compaction. 
+ * 
+ * metrics_tick                 - Adds the current memory metrics for one clock tick. 
+ * 
+ * metrics_finish_experiment    - Averages the memory metrics over an experiment and adds them 
+ *                                to the results. 
+ *************************************************************************************************/
+
+#pragma once
+
+#include<iostream>
+#include<random>
+#include<queue>
+#include<list>
+#include<vector>
+
+#include"main.h"
+
+using namespace std;
+
+// Structure that holds the memory metrics of one experiment. They are updated whenever data 
+// enters or leaves memory so that nothing has to be rescanned each clock tick. 
+typedef struct {
+    int memory_size = MEMORY_END + 1;           // The size of memory the utilization is relative to.
+    int used_memory = 0;                        // Memory held by data in the partitions.
+    int internal_fragmentation = 0;             // Memory in occupied partitions not used by their data.
+    vector<int> hole_sizes;                     // The number of holes of each size (dynamic only). It
+                                                // grows to the largest hole, so any memory size fits.
+    int hole_count = 0;                         // The number of holes (dynamic only).
+    int largest_hole = 0;                       // The size of the largest hole (dynamic only).
+    float memory_utilization_sum = 0;           // Per tick sums used for the averages.
+    float internal_fragmentation_sum = 0;
+    float hole_count_sum = 0;
+    float largest_hole_sum = 0;
+} MemoryMetrics;
+
+// Function prototypes
+void time_series_record(TimeSeries* series, float value);
+void write_time_series(const TimeSeries* series, const char* file_name);
+void metrics_admit(MemoryMetrics &metrics, int partition_size, int data_size);
+void metrics_release(MemoryMetrics &metrics, int partition_size, int data_size);
+void metrics_add_hole(MemoryMetrics &metrics, int size);
+void metrics_remove_hole(MemoryMetrics &metrics, int size);
+void metrics_reset_holes(MemoryMetrics &metrics, int size);
+void metrics_tick(MemoryMetrics &metrics, Results* results);
+void metrics_finish_experiment(MemoryMetrics &metrics, Results* results, int clock);
\ No newline at end of file
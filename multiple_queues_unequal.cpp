@@ -16,12 +16,14 @@
 #include<list>
 
 #include"main.h"
+#include"histogram.h"
 #include"multiple_queues_unequal.h"
+#include"metrics.h"
 
 using namespace std;
 
 /**************************************************************************************************
- * void preprocess_multiple_queues(queue<Data> (&queues)[7], Data(&data)[NUMBER_OF_SAMPLES], 
+ * void preprocess_multiple_queues(queue<Data> (&queues)[7], Data(&data)[NUMBER_OF_SAMPLES], int number_of_samples,
  *                                 int &number_of_failures)
  * 
  * Author: Nolan Davenport
@@ -31,10 +33,11 @@ using namespace std;
  *  queues                  I/O     queue<Data> (&)[7]              The queues that will hold the data 
  *                                                                  before it gets processed.
  *  data                    I/P     Data (&)[NUMBER_OF_SAMPLES]     The data for this experiment.
+ *  number_of_samples       I/P     int                             The number of samples.
  *  number_of_failures      O/P     int (&)                         The number of failures for this
  *                                                                  experiment. 
  *************************************************************************************************/
-void preprocess_multiple_queues(queue<Data> (&queues)[7], Data(&data)[NUMBER_OF_SAMPLES], 
+void preprocess_multiple_queues(queue<Data> (&queues)[7], Data(&data)[NUMBER_OF_SAMPLES], int number_of_samples,
                                 int &number_of_failures){
 
     enum LAST_8MB_USED{         // An enumeration that is used to handle the fact that there's two 8MB partitions.
@@ -43,7 +46,7 @@ void preprocess_multiple_queues(queue<Data> (&queues)[7], Data(&data)[NUMBER_OF_
     } last_8mb_used;            // Create the variable.
     last_8mb_used = SECOND;     // Initialize it to SECOND so that the first is used.
 
-    for(int i = 0; i < NUMBER_OF_SAMPLES; i++){     // Loop through all samples.
+    for(int i = 0; i < number_of_samples; i++){     // Loop through all samples.
         if(data[i].size <= 2){              // If the size of the data is <= 2MB:
             queues[0].push(data[i]);        // Put it in the first queue.
         }else if(data[i].size <= 4){        // If the size of the data is <= 4MB:
@@ -89,14 +92,14 @@ void multiple_queues_unequal_partitioning(Data data[NUMBER_OF_SAMPLES], int numb
                                           Results* multiple_queues_unequal){
 
     Data experiment_data[NUMBER_OF_SAMPLES];        // Create an array to copy the experiment data.
-    for(int i = 0; i < NUMBER_OF_SAMPLES; i++){     // Loop through each array element.
+    for(int i = 0; i < number_of_samples; i++){     // Loop through each array element.
         experiment_data[i] = data[i];               // Copy the data[] array into the experiment_data[] array.
     }
 
     int number_of_failures = 0;                     // Initialize the number of failures to zero.
 
     queue<Data> queues[7];                          // Create an array of queues of type Data. These are the multiple queues.
-    preprocess_multiple_queues(queues, experiment_data, number_of_failures);    // Preprocess the data array into the multiple queues.
+    preprocess_multiple_queues(queues, experiment_data, number_of_samples, number_of_failures);    // Preprocess the data array into the multiple queues.
 
 
     // Setup StaticPartition table
@@ -105,6 +108,8 @@ void multiple_queues_unequal_partitioning(Data data[NUMBER_OF_SAMPLES], int numb
 
     int num_data_members_in_partition_table = 0;    // Initialize the number of data members in the partition table to zero.
 
+    MemoryMetrics metrics;                          // The memory metrics for this experiment.
+
     for(int i = 0; i < 7; i++){                     // Loop through the partitions.
         if(!queues[i].empty()){                     // As long as the queue for the partition isn't empty:
             Data data = queues[i].front();          // Store the value of the front of the queue in a temp variable.
@@ -112,6 +117,7 @@ void multiple_queues_unequal_partitioning(Data data[NUMBER_OF_SAMPLES], int numb
             partitions[i].data_index = data.index;  // Set the index of the data member at the front of the queue in
                                                     // the partition.
             num_data_members_in_partition_table++;  // Increment the number of data items in the partition table.
+            metrics_admit(metrics, partitions[i].size, data.size);  // Count the memory it uses.
         }
     }
 
@@ -145,8 +151,17 @@ void multiple_queues_unequal_partitioning(Data data[NUMBER_OF_SAMPLES], int numb
             multiple_queues_unequal->relative_turn_around_time +=                                   // Calculate the relative turnaround time for this
                 (float)experiment_data[partitions[curr_partition].data_index].turn_around_time /    // data and add the result to the cumulative relative
                 experiment_data[partitions[curr_partition].data_index].time;                        // turnaround time. This is used in calculating the average
+            record_completion(partitions[curr_partition].data_index, clock);                // Record when it finished.
+            histogram_record(multiple_queues_unequal->turn_around_histogram,                // Record it for the percentiles.
+                experiment_data[partitions[curr_partition].data_index].turn_around_time);
+            record_relative_turn_around(multiple_queues_unequal->relative_turn_around_histogram,
+                experiment_data[partitions[curr_partition].data_index].turn_around_time,
+                experiment_data[partitions[curr_partition].data_index].time);
                                                                                                     // relative turnaround time.
 
+            metrics_release(metrics, partitions[curr_partition].size,                   // The finished data no longer uses
+                experiment_data[partitions[curr_partition].data_index].size);           // its memory.
+
             partitions[curr_partition].data_index = -1; // Clear this partition by setting the data_index to -1.
             num_data_members_in_partition_table--;      // Decrement the number of data members in the partition table.
             
@@ -160,6 +175,8 @@ void multiple_queues_unequal_partitioning(Data data[NUMBER_OF_SAMPLES], int numb
                 //experiment_data[partitions[curr_partition].data_index].time_start = clock+1;
 
                 num_data_members_in_partition_table++;              // Increment the number of data members in the partition table.
+                metrics_admit(metrics,                              // Count the memory the new data uses.
+                    partitions[curr_partition].size, data.size);
             }else if(num_data_members_in_partition_table == 0){     // Else if the number of data members in the partition table is zero.
                                                                     // Meaning there's no more data to process.
                 break;                                              // Break out of the loop to end this experiment.
@@ -171,6 +188,8 @@ void multiple_queues_unequal_partitioning(Data data[NUMBER_OF_SAMPLES], int numb
         average_num_data_members_in_partition_table += 
             num_data_members_in_partition_table;                    // Add the number of data items to the variable that will be used
                                                                     // to calculate the average number of data members in the partition table.
+
+        metrics_tick(metrics, multiple_queues_unequal);             // Add the memory metrics for this tick.
     }
 
     average_num_data_members_in_partition_table /= clock;                       // Calculate the average number of data members in the
@@ -180,5 +199,6 @@ void multiple_queues_unequal_partitioning(Data data[NUMBER_OF_SAMPLES], int numb
         average_num_data_members_in_partition_table;                            // value used to get the average.
     multiple_queues_unequal->number_of_failures += number_of_failures;          // Add the number of failures to the cumulative value.
                                                                                 // Used to get the average number of failures.
+    metrics_finish_experiment(metrics, multiple_queues_unequal, clock);         // Add the memory metrics to the cumulative values.
 
 }
\ No newline at end of file
@@ -22,5 +22,5 @@
 using namespace std;
 
 // Function prototypes
-void preprocess_multiple_queues(queue<Data> (&queues)[7], Data(&e)[NUMBER_OF_SAMPLES], int &number_of_failures);
+void preprocess_multiple_queues(queue<Data> (&queues)[7], Data(&e)[NUMBER_OF_SAMPLES], int number_of_samples, int &number_of_failures);
 void multiple_queues_unequal_partitioning(Data e[NUMBER_OF_SAMPLES], int number_of_samples, Results* multiple_queues_unequal);
\ No newline at end of file
@@ -0,0 +1,520 @@
+/**************************************************************************************************
+ * File: numa.cpp
+ * Author: Nolan Davenport
+ * Procedures:
+ *
+ * parse_bank_policy                - Reads a bank placement policy from its name.
+ *
+ * choose_bank                      - Chooses the bank a data item is placed in.
+ *
+ * remote_service_time              - Stretches the service time of data placed away from its
+ *                                    home bank.
+ *
+ * one_queue_numa_partitioning      - Performs the one queue experiment on several banks of
+ *                                    static partitions.
+ *
+ * dynamic_numa_partitioning        - Performs the dynamic partitioning experiment on several
+ *                                    banks of bitmap memory.
+ *
+ * report_numa_stats                - Prints the bank placement statistics of a partitioning style.
+ *************************************************************************************************/
+
+#include<iostream>
+#include<random>
+#include<queue>
+#include<list>
+#include<vector>
+#include<string>
+#include<functional>
+
+#include"main.h"
+#include"histogram.h"
+#include"metrics.h"
+#include"bitmap_memory.h"
+#include"partition_pool.h"
+#include"numa.h"
+
+using namespace std;
+
+/**************************************************************************************************
+ * bool parse_bank_policy(const string &name, BankPolicy &policy)
+ *
+ * Author: Nolan Davenport
+ * Description: Reads a bank placement policy from its name on the command line: local,
+ *              interleave or least.
+ *
+ * Parameters:
+ *  name                I/P     const string (&)    The name of the policy.
+ *  policy              O/P     BankPolicy (&)      The policy.
+ *  parse_bank_policy   O/P     bool                False if the name is unknown.
+ *************************************************************************************************/
+bool parse_bank_policy(const string &name, BankPolicy &policy){
+    if(name == "local"){                            // The home bank first.
+        policy = BANK_LOCAL_FIRST;
+    }else if(name == "interleave"){                 // The banks in turn.
+        policy = BANK_INTERLEAVE;
+    }else if(name == "least"){                      // The bank holding the least.
+        policy = BANK_LEAST_LOADED;
+    }else{                                          // Anything else is a mistake.
+        return false;
+    }
+    return true;
+}
+
+/**************************************************************************************************
+ * int choose_bank(const NumaConfig &config, int home, int &interleave_cursor,
+ *                 const function<bool(int)> &fits, const function<int(int)> &load)
+ *
+ * Author: Nolan Davenport
+ * Description: Chooses the bank a data item is placed in. Only the banks it fits in are
+ *              considered, and each bank answers for itself, so choosing takes one check per
+ *              bank whatever the partitions inside them look like.
+ *
+ * Parameters:
+ *  config              I/P     const NumaConfig (&)            The bank settings.
+ *  home                I/P     int                             The home bank of the data.
+ *  interleave_cursor   I/O     int (&)                         The bank interleaving tries next.
+ *  fits                I/P     const function<bool(int)> (&)   Whether the data fits in a bank.
+ *  load                I/P     const function<int(int)> (&)    The memory a bank holds.
+ *  choose_bank         O/P     int                             The bank, or -1 if it fits in none.
+ *************************************************************************************************/
+int choose_bank(const NumaConfig &config, int home, int &interleave_cursor,
+                const function<bool(int)> &fits, const function<int(int)> &load){
+    int origin = (config.policy == BANK_INTERLEAVE) ? interleave_cursor : home;  // Where the search starts.
+    int chosen = -1;                                                // The bank the data goes into.
+    for(int step = 0; step < config.banks; step++){                 // Look at every bank once.
+        int bank = (origin + step) % config.banks;
+        if(!fits(bank)){                                            // It has no room for the data.
+            continue;
+        }
+        if(config.policy != BANK_LEAST_LOADED){                     // The first bank with room,
+            chosen = bank;
+            break;
+        }
+        if(chosen == -1 || load(bank) < load(chosen)){              // or the one holding the least.
+            chosen = bank;
+        }
+    }
+    if(chosen != -1 && config.policy == BANK_INTERLEAVE){           // The next data starts after it.
+        interleave_cursor = (chosen + 1) % config.banks;
+    }
+    return chosen;
+}
+
+/**************************************************************************************************
+ * int remote_service_time(const NumaConfig &config, int time, bool remote)
+ *
+ * Author: Nolan Davenport
+ * Description: Stretches the service time of data placed away from its home bank by the remote
+ *              penalty, rounding up.
+ *
+ * Parameters:
+ *  config                  I/P     const NumaConfig (&)    The bank settings.
+ *  time                    I/P     int                     The service time in its home bank.
+ *  remote                  I/P     bool                    Whether it is away from its home bank.
+ *  remote_service_time     O/P     int                     The service time it needs.
+ *************************************************************************************************/
+int remote_service_time(const NumaConfig &config, int time, bool remote){
+    if(!remote){                                                    // Local data runs at full speed.
+        return time;
+    }
+    return time + (time * config.remote_penalty + 99) / 100;        // Remote data takes longer.
+}
+
+/**************************************************************************************************
+ * void one_queue_numa_partitioning(Data data[NUMBER_OF_SAMPLES], int number_of_samples,
+ *                                  const int* sizes, int partition_count,
+ *                                  const NumaConfig &config, Results* results, NumaStats* stats)
+ *
+ * Author: Nolan Davenport
+ * Description: Performs the one queue experiment with the given layout of static partitions
+ *              split across several banks. Partition i goes into bank i % banks, so the banks
+ *              together hold exactly the layout of the flat experiment, and only its largest
+ *              partition takes anything. The head of the single queue goes into the bank the
+ *              placement policy chooses, and into the first empty partition it fits in there.
+ *              A single processor visits the partitions in layout order unless each bank has its
+ *              own processor, in which case every bank's processor works for one quantum each
+ *              tick. With one bank it follows the same rules as one_queue_partitioning_generic.
+ *
+ * Parameters:
+ *  data                I/P     Data[NUMBER_OF_SAMPLES]     The data to be used in this experiment.
+ *  number_of_samples   I/P     int                         The number of samples in this experiment.
+ *  sizes               I/P     const int*                  The size of each partition, smallest first.
+ *  partition_count     I/P     int                         The number of partitions in the layout.
+ *                                                          Must be at least the number of banks.
+ *  config              I/P     const NumaConfig (&)        The bank settings.
+ *  results             O/P     Results*                    Pointer to the structure that holds the
+ *                                                          results of this experiment.
+ *  stats               O/P     NumaStats*                  The bank placement statistics.
+ *************************************************************************************************/
+void one_queue_numa_partitioning(Data data[NUMBER_OF_SAMPLES], int number_of_samples, const int* sizes,
+                                 int partition_count, const NumaConfig &config, Results* results,
+                                 NumaStats* stats){
+    int banks = config.banks;                       // The number of banks.
+    int last = partition_count - 1;                 // The partition that takes anything.
+    int processors = config.processor_per_bank ? banks : 1;     // The number of processors.
+
+    vector<int> left(number_of_samples);            // Only the time left changes during the experiment.
+
+    vector<StaticPartition> partitions(partition_count);    // The partitions of every bank, in layout order.
+    vector<int> bank_of(partition_count);           // The bank each partition is in.
+    int memory_size = 0;                            // The memory in every bank.
+    for(int i = 0; i < partition_count; i++){       // Loop through the partitions.
+        partitions[i].size = sizes[i];              // Set the size from the layout.
+        partitions[i].data_index = -1;              // Mark the partition as empty.
+        bank_of[i] = i % banks;                     // Deal the partitions out to the banks.
+        memory_size += sizes[i];
+    }
+    vector<int> curr_partition(processors, 0);      // The partition each processor is on.
+    vector<int> bank_members(banks, 0);             // The data in each bank.
+    vector<int> bank_load(banks, 0);                // The memory the data in each bank holds.
+
+    int interleave_cursor = 0;                      // The bank interleaving tries next.
+    int next_data = 0;                              // The head of the queue.
+    int number_of_failures = 0;                     // Initialize the number of failures to zero.
+    int num_data_members_in_partition_table = 0;    // The number of data members in every bank.
+    int clock = 0;                                  // Initialize the clock to zero.
+    float average_num_data_members_in_partition_table = 0;  // Cumulative value used for the average.
+    MemoryMetrics metrics;                          // The memory metrics for this experiment.
+    metrics.memory_size = memory_size;              // Utilization is relative to every bank.
+
+    // The first empty partition of a bank the data fits in, or the last partition of the layout,
+    // which takes anything. -1 if there is none.
+    auto first_partition = [&](int bank, int size){
+        for(int p = 0; p <= last; p++){
+            if(bank_of[p] == bank && partitions[p].data_index == -1 && (p == last || size <= partitions[p].size)){
+                return p;
+            }
+        }
+        return -1;
+    };
+
+    // Whether a processor works on a partition. A single processor works on all of them.
+    auto serves = [&](int processor, int p){
+        return !config.processor_per_bank || bank_of[p] == processor;
+    };
+
+    // Admits data from the head of the queue until it fits in no bank.
+    auto admit = [&](){
+        while(next_data != number_of_samples){
+            int size = data[next_data].size;                    // The size of the head.
+            int home = next_data % banks;                       // The bank it arrived at.
+            int bank = choose_bank(config, home, interleave_cursor,
+                [&](int b){ return first_partition(b, size) != -1; },
+                [&](int b){ return bank_load[b]; });
+            if(bank == -1){                                     // The head of the queue is blocked.
+                break;
+            }
+
+            int chosen = first_partition(bank, size);           // Put it into the partition.
+            partitions[chosen].data_index = next_data;
+            if(chosen == last && size > partitions[last].size){ // If it is larger than the last partition:
+                number_of_failures++;                           // Count it as a failure.
+            }
+            left[next_data] = remote_service_time(config, data[next_data].left, bank != home);
+            stats->penalty_ticks += left[next_data] - data[next_data].left;
+            if(bank == home){                                   // Count where it went.
+                stats->local++;
+            }else{
+                stats->remote++;
+            }
+            stats->placements[bank]++;
+
+            bank_members[bank]++;
+            bank_load[bank] += size;
+            num_data_members_in_partition_table++;
+            metrics_admit(metrics, partitions[chosen].size, size);
+            next_data++;                                        // Move to the next item in the queue.
+        }
+    };
+
+    admit();                                        // Put the initial data into the banks.
+
+    for(;;){                                                        // Start the clock loop.
+        for(int processor = 0; processor < processors; processor++){    // Every processor works for one quantum.
+            int members = config.processor_per_bank ?               // The data this processor works on.
+                bank_members[processor] : num_data_members_in_partition_table;
+            if(members == 0){                                       // Nothing to work on.
+                continue;
+            }
+            int &current = curr_partition[processor];               // Skip the empty partitions and those of
+            while(partitions[current].data_index == -1 ||           // other banks without incrementing the clock.
+                !serves(processor, current)){
+                current = (current + 1) % partition_count;
+            }
+
+            int index = partitions[current].data_index;             // The data in the current partition.
+            if(--left[index] == 0){                                 // Work for one quantum. If the data is finished:
+                int turn_around_time = clock - data[index].time_start;  // Calculate the turnaround time.
+
+                results->turn_around_time += turn_around_time;      // Add it to the cumulative turnaround time.
+                float relative_turn_around_time =                   // Calculate the relative turnaround time.
+                    (float)turn_around_time / data[index].time;
+                results->relative_turn_around_time += relative_turn_around_time;  // Add it to the cumulative value.
+                record_completion(index, clock);                    // Record when it finished.
+                histogram_record(results->turn_around_histogram, turn_around_time);    // Record both for the percentiles.
+                record_relative_turn_around(results->relative_turn_around_histogram,
+                    turn_around_time, data[index].time);
+
+                int bank = bank_of[current];                        // The bank the data was in.
+                partitions[current].data_index = -1;                // Clear this partition.
+                bank_members[bank]--;
+                bank_load[bank] -= data[index].size;
+                num_data_members_in_partition_table--;              // Decrement the number of data members.
+                metrics_release(metrics, partitions[current].size, data[index].size);
+
+                admit();                                            // Admit whatever is waiting.
+            }
+            current = (current + 1) % partition_count;              // Move to the next partition.
+        }
+
+        if(num_data_members_in_partition_table == 0){               // If nothing is left anywhere:
+            break;                                                  // End this experiment.
+        }
+
+        clock++;                                                    // Increment the clock.
+        average_num_data_members_in_partition_table +=              // Add to the cumulative average variable.
+            num_data_members_in_partition_table;
+        metrics_tick(metrics, results);                             // Add the memory metrics for this tick.
+    }
+
+    average_num_data_members_in_partition_table /= clock;           // Calculate the average for this experiment.
+
+    results->average_num_data_members_in_partition_table +=         // Add it to the cumulative variable.
+        average_num_data_members_in_partition_table;
+    results->number_of_failures += number_of_failures;              // Add the failures to the cumulative variable.
+    metrics_finish_experiment(metrics, results, clock);             // Add the memory metrics to the cumulative values.
+
+    stats->experiments++;                           // Add this experiment to the statistics.
+}
+
+/**************************************************************************************************
+ * void dynamic_numa_partitioning(Data data[NUMBER_OF_SAMPLES], int number_of_samples,
+ *                                int memory_units, int blocks_per_unit,
+ *                                const NumaConfig &config, Results* results, NumaStats* stats)
+ *
+ * Author: Nolan Davenport
+ * Description: Performs the dynamic partitioning experiment on a bitmap memory split into
+ *              several banks of equal size, the first banks taking one more MB when it doesn't
+ *              divide evenly. The head of the single queue goes into the bank the placement
+ *              policy chooses, at the first hole there large enough, compacting only that bank
+ *              if none is. A single processor works through the data of each bank in address
+ *              order before moving on to the next bank, unless each bank has its own processor,
+ *              in which case every bank's processor works for one quantum each tick. With one
+ *              bank it follows the same rules as dynamic_bitmap_partitioning.
+ *
+ * Parameters:
+ *  data                I/P     Data[NUMBER_OF_SAMPLES]     The data to be used in this experiment.
+ *  number_of_samples   I/P     int                         The number of samples in this experiment.
+ *  memory_units        I/P     int                         The size of all the banks together in
+ *                                                          MB. Must be at least the number of banks.
+ *  blocks_per_unit     I/P     int                         The number of blocks in one MB.
+ *  config              I/P     const NumaConfig (&)        The bank settings.
+ *  results             O/P     Results*                    Pointer to the structure that holds the
+ *                                                          results of this experiment.
+ *  stats               O/P     NumaStats*                  The bank placement statistics.
+ *************************************************************************************************/
+void dynamic_numa_partitioning(Data data[NUMBER_OF_SAMPLES], int number_of_samples, int memory_units,
+                               int blocks_per_unit, const NumaConfig &config, Results* results,
+                               NumaStats* stats){
+    int banks = config.banks;                       // The number of banks.
+
+    vector<int> left(number_of_samples);            // Only the time left changes during the experiment.
+
+    reset_dynamic_partition_pool();                 // Start this experiment with a fresh pool of nodes.
+
+    MemoryMetrics metrics;                          // The memory metrics for this experiment.
+    metrics.memory_size = memory_units;             // Utilization is relative to every bank.
+
+    vector<BitmapPartitions> memory;                // Each bank starts empty.
+    memory.reserve(banks);
+    for(int bank = 0; bank < banks; bank++){
+        int bank_units = memory_units / banks + (bank < memory_units % banks ? 1 : 0);     // Its share of memory.
+        memory.push_back(BitmapPartitions{BitmapMemory(), ResidentMap(dynamic_partition_resource()),
+            vector<int>(number_of_samples), vector<int>(number_of_samples), bank_units, blocks_per_unit, 0});
+        bitmap_init(memory[bank].memory, bank_units * blocks_per_unit);
+        bitmap_add_hole(memory[bank], 0, bank_units * blocks_per_unit, metrics);   // Each bank starts as a single hole.
+    }
+    vector<ResidentMap::iterator> cursor(banks);    // Where the processor is in each bank.
+    for(int bank = 0; bank < banks; bank++){
+        cursor[bank] = memory[bank].resident.end();
+    }
+    int current_bank = 0;                           // The bank a single processor is working in.
+
+    int interleave_cursor = 0;                      // The bank interleaving tries next.
+    int next_data = 0;                              // The head of the queue.
+    int number_of_failures = 0;                     // Initialize the number of failures to zero.
+    int num_data_members_in_partition_table = 0;    // The number of data members in every bank.
+    int clock = 0;                                  // Initialize the clock to zero.
+    float average_num_data_members_in_partition_table = 0;  // Cumulative value used for the average.
+
+    // Whether the data fits in a bank. An empty bank takes anything, and otherwise there must be
+    // enough free memory, which compaction turns into one hole if it has to.
+    auto fits = [&](int bank, int size){
+        const BitmapPartitions &partitions = memory[bank];
+        return partitions.resident.empty() || (partitions.used_units <= partitions.memory_units &&
+            partitions.memory_units - partitions.used_units >= size);
+    };
+
+    // Admits data from the head of the queue until it fits in no bank.
+    auto admit = [&](){
+        while(next_data != number_of_samples){
+            int size = data[next_data].size;                    // The size of the head.
+            int home = next_data % banks;                       // The bank it arrived at.
+            int bank = choose_bank(config, home, interleave_cursor,
+                [&](int b){ return fits(b, size); },
+                [&](int b){ return memory[b].used_units; });
+            if(bank == -1){                                     // The head of the queue is blocked.
+                break;
+            }
+
+            BitmapPartitions &partitions = memory[bank];        // Only this bank is touched.
+            int bank_units = partitions.memory_units;           // The size of the bank.
+            bool was_empty = partitions.resident.empty();       // Whether its processor was idle.
+            int start = 0;                                      // The block it gets placed at.
+            if(was_empty){                                      // In an empty bank it goes at the start,
+                if(size > bank_units){                          // even if it is too large. If it is larger
+                    number_of_failures++;                       // than the bank, count it as a failure.
+                }
+            }else{
+                start = bitmap_find_hole(partitions, size * blocks_per_unit);
+                if(start == -1){                                // If no hole is large enough,
+                    bitmap_compact(partitions, metrics);        // compact the bank into one hole.
+                    start = bitmap_find_hole(partitions, size * blocks_per_unit);
+                }
+            }
+
+            int blocks = min(size, bank_units) * blocks_per_unit;       // Blocks it occupies.
+            bitmap_set_range(partitions.memory, start, blocks); // Mark them as used.
+            ResidentMap::iterator entry =                       // Add it to the bank in address order.
+                partitions.resident.emplace(start, next_data);
+            partitions.start_block[next_data] = start;          // Remember where it is
+            partitions.block_count[next_data] = blocks;         // and how much of it there is.
+            partitions.used_units += size;                      // Count the memory it holds.
+            bitmap_fill_hole(partitions, entry, metrics);
+            metrics_admit(metrics, min(size, bank_units), size);
+            if(was_empty){                                      // The processor starts on it.
+                cursor[bank] = partitions.resident.begin();
+            }
+
+            left[next_data] = remote_service_time(config, data[next_data].left, bank != home);
+            stats->penalty_ticks += left[next_data] - data[next_data].left;
+            if(bank == home){                                   // Count where it went.
+                stats->local++;
+            }else{
+                stats->remote++;
+            }
+            stats->placements[bank]++;
+
+            num_data_members_in_partition_table++;              // One more data member in memory.
+            next_data++;                                        // Move to the next item in the queue.
+        }
+    };
+
+    // Works for one quantum on the data the processor is on in a bank and moves on to the next.
+    // Returns true if that went past the end of the bank.
+    auto work = [&](int bank){
+        BitmapPartitions &partitions = memory[bank];
+        ResidentMap::iterator &it = cursor[bank];           // The data the processor is on.
+        int index = it->index;
+        bool just_erased_a_partition = false;               // Whether the iterator has already moved on.
+
+        if(--left[index] == 0){                             // Work for one quantum. If the data is finished:
+            int turn_around_time = clock - data[index].time_start;  // Calculate the turnaround time.
+
+            results->turn_around_time += turn_around_time;          // Add it to the cumulative turnaround time.
+            float relative_turn_around_time =                       // Calculate the relative turnaround time.
+                (float)turn_around_time / data[index].time;
+            results->relative_turn_around_time += relative_turn_around_time;  // Add it to the cumulative value.
+            record_completion(index, clock);                        // Record when it finished.
+            histogram_record(results->turn_around_histogram, turn_around_time);    // Record both for the percentiles.
+            record_relative_turn_around(results->relative_turn_around_histogram,
+                turn_around_time, data[index].time);
+
+            int size = data[index].size;                    // Free its memory.
+            bitmap_clear_range(partitions.memory, it->start, partitions.block_count[index]);
+            partitions.used_units -= size;
+            bitmap_merge_holes(partitions, it, metrics);
+            metrics_release(metrics, min(size, partitions.memory_units), size);
+            num_data_members_in_partition_table--;
+            it = partitions.resident.erase(it);             // Remove it and move on.
+            just_erased_a_partition = true;
+
+            admit();                                        // Admit whatever is waiting.
+        }
+
+        if(!just_erased_a_partition){                       // If nothing was erased, move on.
+            it++;
+        }
+
+        if(it == partitions.resident.end()){                // If the end of the bank was reached:
+            it = partitions.resident.begin();               // Go back to the start.
+            return true;
+        }
+        return false;
+    };
+
+    admit();                                                // Place the initial data.
+
+    for(;;){                                                // Clock loop.
+        if(config.processor_per_bank){                      // Every processor works for one quantum.
+            for(int bank = 0; bank < banks; bank++){
+                if(!memory[bank].resident.empty()){         // Unless its bank is empty.
+                    work(bank);
+                }
+            }
+        }else{                                              // The single processor works in the next
+            while(memory[current_bank].resident.empty()){   // bank holding data,
+                current_bank = (current_bank + 1) % banks;
+            }
+            if(work(current_bank)){                         // moving to the bank after it once it has
+                current_bank = (current_bank + 1) % banks;  // worked through this one.
+            }
+        }
+
+        if(num_data_members_in_partition_table == 0){       // If nothing is left anywhere:
+            break;                                          // The experiment is done.
+        }
+
+        clock++;                                            // Increment the clock.
+        average_num_data_members_in_partition_table +=      // Add to the cumulative average variable.
+            num_data_members_in_partition_table;
+        metrics_tick(metrics, results);                     // Add the memory metrics for this tick.
+    }
+
+    average_num_data_members_in_partition_table /= clock;   // Calculate the average for this experiment.
+
+    results->average_num_data_members_in_partition_table += // Add it to the cumulative variable.
+        average_num_data_members_in_partition_table;
+    results->number_of_failures += number_of_failures;      // Add the failures to the cumulative variable.
+    metrics_finish_experiment(metrics, results, clock);     // Add the memory metrics to the cumulative values.
+
+    stats->experiments++;                           // Add this experiment to the statistics.
+}
+
+/**************************************************************************************************
+ * void report_numa_stats(const char* name, const NumaConfig &config, const NumaStats &stats)
+ *
+ * Author: Nolan Davenport
+ * Description: Prints the bank placement statistics of a partitioning style: the share of data
+ *              placed in its home bank, the extra service time of remote data, and the average
+ *              data placed in each bank per experiment.
+ *
+ * Parameters:
+ *  name        I/P     const char*             The name of the partitioning style.
+ *  config      I/P     const NumaConfig (&)    The bank settings.
+ *  stats       I/P     const NumaStats (&)     The bank placement statistics.
+ *************************************************************************************************/
+void report_numa_stats(const char* name, const NumaConfig &config, const NumaStats &stats){
+    if(stats.experiments == 0){                     // Nothing to report.
+        return;
+    }
+    double experiments = stats.experiments;         // Averages are per experiment.
+    cout << name << " local placements: " << 100.0 * stats.local / max(1LL, stats.local + stats.remote) <<
+        "% remote penalty: " << stats.penalty_ticks / experiments << " ticks" << endl;
+    cout << name << " average placements per bank:";
+    for(int bank = 0; bank < config.banks; bank++){ // One count per bank.
+        cout << " " << stats.placements[bank] / experiments;
+    }
+    cout << endl;
+}
\ No newline at end of file
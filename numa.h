@@ -0,0 +1,72 @@
+/**************************************************************************************************
+ * File: numa.h
+ * Author: Nolan Davenport
+ * Procedures:
+ *
+ * parse_bank_policy                - Reads a bank placement policy from its name.
+ *
+ * choose_bank                      - Chooses the bank a data item is placed in.
+ *
+ * remote_service_time              - Stretches the service time of data placed away from its
+ *                                    home bank.
+ *
+ * one_queue_numa_partitioning      - Performs the one queue experiment on several banks of
+ *                                    static partitions.
+ *
+ * dynamic_numa_partitioning        - Performs the dynamic partitioning experiment on several
+ *                                    banks of bitmap memory.
+ *
+ * report_numa_stats                - Prints the bank placement statistics of a partitioning style.
+ *************************************************************************************************/
+
+#pragma once
+
+#include<iostream>
+#include<random>
+#include<queue>
+#include<list>
+#include<vector>
+#include<string>
+#include<functional>
+
+#include"main.h"
+
+using namespace std;
+
+#define NUMA_MAX_BANKS 64
+
+// How the bank for a data item is chosen among the banks it fits in. Data arrives at home bank
+// index % banks.
+typedef enum {
+    BANK_LOCAL_FIRST,           // Its home bank, or the next bank after it that it fits in.
+    BANK_INTERLEAVE,            // The next bank it fits in after the last one used.
+    BANK_LEAST_LOADED           // The bank it fits in holding the least data, its home bank on a tie.
+} BankPolicy;
+
+// Structure that holds the settings of the memory banks. The memory of the flat experiment is
+// split between the banks, so the total stays the same. Data placed away from its home bank
+// takes remote_penalty percent longer. One processor serves every bank unless
+// processor_per_bank is set, which adds a processor for each bank and so more compute.
+typedef struct {
+    int banks = 2;                          // The number of banks.
+    BankPolicy policy = BANK_LOCAL_FIRST;   // How the bank is chosen.
+    int remote_penalty = 50;                // The extra service time of remote data, in percent.
+    bool processor_per_bank = false;        // Whether each bank has its own processor.
+} NumaConfig;
+
+// Structure that holds the cumulative bank placement statistics of a partitioning style.
+typedef struct {
+    long long experiments = 0;                      // The number of experiments.
+    long long local = 0;                            // The data placed in its home bank.
+    long long remote = 0;                           // The data placed in another bank.
+    long long penalty_ticks = 0;                    // The extra service time of remote data.
+    long long placements[NUMA_MAX_BANKS] = {};      // The data placed in each bank.
+} NumaStats;
+
+// Function prototypes
+bool parse_bank_policy(const string &name, BankPolicy &policy);
+int choose_bank(const NumaConfig &config, int home, int &interleave_cursor, const function<bool(int)> &fits, const function<int(int)> &load);
+int remote_service_time(const NumaConfig &config, int time, bool remote);
+void one_queue_numa_partitioning(Data data[NUMBER_OF_SAMPLES], int number_of_samples, const int* sizes, int partition_count, const NumaConfig &config, Results* results, NumaStats* stats);
+void dynamic_numa_partitioning(Data data[NUMBER_OF_SAMPLES], int number_of_samples, int memory_units, int blocks_per_unit, const NumaConfig &config, Results* results, NumaStats* stats);
+void report_numa_stats(const char* name, const NumaConfig &config, const NumaStats &stats);
\ No newline at end of file
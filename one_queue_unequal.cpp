@@ -17,11 +17,14 @@
 #include<list>
 
 #include"main.h"
+#include"histogram.h"
+#include"metrics.h"
 
 /**************************************************************************************************
- * void one_queue_fill_unequal_partitions(Data (&data)[NUMBER_OF_SAMPLES], int &next_data, 
+ * void one_queue_fill_unequal_partitions(Data (&data)[NUMBER_OF_SAMPLES], int number_of_samples, int &next_data, 
  *                                        int &number_of_failures, StaticPartition (&partitions)[7], 
- *                                        int &num_data_members_in_partition_table, int clock){
+ *                                        int &num_data_members_in_partition_table, int clock, 
+ *                                        MemoryMetrics &metrics){
  * 
  * Author: Nolan Davenport
  * Description: Fills the next available partition with the data member at the front of the queue 
@@ -30,6 +33,7 @@
  * Parameters:
  *  data                                    I/P     Data (&)[NUMBER_OF_SAMPLES]     The array of data that 
  *                                                                                  is being processed.
+ *  number_of_samples                       I/P     int                             The number of samples.
  *  next_data                               I/O     int (&)                         The index of the next 
  *                                                                                  piece of data at the
  *                                                                                  head of the queue. 
@@ -41,30 +45,41 @@
  *                                                                                  members in the partition
  *                                                                                  table.
  *  clock                                   I/P     int                             The clock value.
+ *  metrics                                 I/O     MemoryMetrics (&)               The memory metrics
+ *                                                                                  of this experiment.
  *************************************************************************************************/
-void one_queue_fill_unequal_partitions(Data (&data)[NUMBER_OF_SAMPLES], int &next_data, int &number_of_failures, 
-                        StaticPartition (&partitions)[7], int &num_data_members_in_partition_table, int clock){
+void one_queue_fill_unequal_partitions(Data (&data)[NUMBER_OF_SAMPLES], int number_of_samples, int &next_data, int &number_of_failures, 
+                        StaticPartition (&partitions)[7], int &num_data_members_in_partition_table, int clock, 
+                        MemoryMetrics &metrics){
 
-    for(;;){                                                                    // Start the loop to fill as much partitions as it can.
+    while(next_data != number_of_samples){                                      // Start the loop to fill as much partitions as it can.
         int next_data_size = data[next_data].size;                              // Get the size of the next element in the queue.
+        int chosen_partition;                                                   // The partition the next element is placed in.
 
         if(next_data_size <= 2 && partitions[0].data_index == -1){              // If the next data size is <= 2 and the partition is empty.
             partitions[0].data_index = next_data;                               // Set the 2MB partition to the index of the next item in the queue.
+            chosen_partition = 0;                                               // Remember which partition was used.
         }else if(next_data_size <= 4 && partitions[1].data_index == -1){        // If the next data size is <= 4 and the partition is empty.
             partitions[1].data_index = next_data;                               // Set the 4MB partition to the index of the next item in the queue.
+            chosen_partition = 1;                                               // Remember which partition was used.
         }else if(next_data_size <= 6 && partitions[2].data_index == -1){        // If the next data size is <= 6 and the partition is empty.
             partitions[2].data_index = next_data;                               // Set the 6MB partition to the index of the next item in the queue.
+            chosen_partition = 2;                                               // Remember which partition was used.
         }else if(next_data_size <= 8 &&
         (partitions[3].data_index == -1 || partitions[4].data_index == -1)){    // If the next data size is <= 8 and either of the 8MB partitions is empty.
             if(partitions[3].data_index == -1){                                 // If the first 8MB partition is empty:
                 partitions[3].data_index = next_data;                           // Set it to the index of the next item in the queue.
+                chosen_partition = 3;                                           // Remember which partition was used.
             }else{                                                              // Otherwise:
                 partitions[4].data_index = next_data;                           // Set the second 8MB partition to the next item in the queue.
+                chosen_partition = 4;                                           // Remember which partition was used.
             }
         }else if(next_data_size <= 12 && partitions[5].data_index == -1){       // If the next data size is <= 12 and the partition is empty.
             partitions[5].data_index = next_data;                               // Set the 12MB partition to the index of the next item in the queue.
+            chosen_partition = 5;                                               // Remember which partition was used.
         }else if(partitions[6].data_index == -1){                               // Anything greater than 12 and if the 16MB partition is empty.
             partitions[6].data_index = next_data;                               // Set the 16MB partition to the index of the next item in the queue.
+            chosen_partition = 6;                                               // Remember which partition was used.
 
             if(next_data_size > 16){                                            // If the size of the item just inserter is greater than 16MB,
                 number_of_failures++;                                           // Then increment the number of failures. 
@@ -75,6 +90,9 @@ void one_queue_fill_unequal_partitions(Data (&data)[NUMBER_OF_SAMPLES], int &nex
         // TODO: figure this out
         //data[next_data].time_start = clock;
 
+        metrics_admit(metrics, partitions[chosen_partition].size,   // Count the memory the element uses.
+            next_data_size);
+
         num_data_members_in_partition_table++;  // Increment the number of data members in the partition table
                                                 // Because an item was added if it got to this point. 
         next_data++;                            // Increment the index to show the next data item in the queue.
@@ -98,7 +116,7 @@ void one_queue_unequal_partitioning(Data data[NUMBER_OF_SAMPLES], int number_of_
                                     Results* one_queue_unequal){
 
     Data experiment_data[NUMBER_OF_SAMPLES];        // Create an array to copy the experiment data.
-    for(int i = 0; i < NUMBER_OF_SAMPLES; i++){     // Loop through each array element.
+    for(int i = 0; i < number_of_samples; i++){     // Loop through each array element.
         experiment_data[i] = data[i];               // Copy the data[] array into the experiment_data[] array.
     }
 
@@ -112,9 +130,11 @@ void one_queue_unequal_partitioning(Data data[NUMBER_OF_SAMPLES], int number_of_
     // Put intitial data into the StaticPartition table. 
     int next_data = 0;                                  // Initialize the index that shows the next data item into the queue to zero.
     int num_data_members_in_partition_table = 0;        // Initialize the number of data members in the partition table to zero. 
+    MemoryMetrics metrics;                              // The memory metrics for this experiment.
     one_queue_fill_unequal_partitions(experiment_data,  // Call the one_queue_fill_unequal_partitions function to fill the unequal
-        next_data, number_of_failures, partitions,      // partitions.
-        num_data_members_in_partition_table, 0);
+        number_of_samples, next_data,                   // partitions.
+        number_of_failures, partitions,
+        num_data_members_in_partition_table, 0, metrics);
 
     int curr_partition = 0;     // Initialize the current partition to zero. For use in looping through partitions as the process runs.
 
@@ -146,14 +166,24 @@ void one_queue_unequal_partitioning(Data data[NUMBER_OF_SAMPLES], int number_of_
             one_queue_unequal->relative_turn_around_time +=                                         // Calculate the relative turnaround
                 (float)experiment_data[partitions[curr_partition].data_index].turn_around_time /    // time and add it to the cumulative
                 experiment_data[partitions[curr_partition].data_index].time;                        // turnaround time for this experiment.
+            record_completion(partitions[curr_partition].data_index, clock);                // Record when it finished.
+            histogram_record(one_queue_unequal->turn_around_histogram,                      // Record it for the percentiles.
+                experiment_data[partitions[curr_partition].data_index].turn_around_time);
+            record_relative_turn_around(one_queue_unequal->relative_turn_around_histogram,
+                experiment_data[partitions[curr_partition].data_index].turn_around_time,
+                experiment_data[partitions[curr_partition].data_index].time);
+
+            metrics_release(metrics, partitions[curr_partition].size,                   // The finished data no longer uses
+                experiment_data[partitions[curr_partition].data_index].size);           // its memory.
 
             partitions[curr_partition].data_index = -1; // Clear this partition by setting the data index to -1.
             num_data_members_in_partition_table--;      // Decrement the number of data members in the partition table.
             
-            if(next_data != NUMBER_OF_SAMPLES){                     // As long as there exists more data items in the queue:
+            if(next_data != number_of_samples){                     // As long as there exists more data items in the queue:
                 one_queue_fill_unequal_partitions(experiment_data,  // Perform the algorithm to fill the unequal partitions
-                    next_data, number_of_failures, partitions,      // using only one queue.
-                    num_data_members_in_partition_table, clock+1);
+                    number_of_samples, next_data,                   // using only one queue.
+                    number_of_failures, partitions,
+                    num_data_members_in_partition_table, clock+1, metrics);
             }else{                                                  // Otherwise, there's no more data items in the queue.
                 if(num_data_members_in_partition_table == 0){       // If there's no items left in the queue and no data members in
                                                                     // the partition:
@@ -167,6 +197,8 @@ void one_queue_unequal_partitioning(Data data[NUMBER_OF_SAMPLES], int number_of_
         average_num_data_members_in_partition_table += 
             num_data_members_in_partition_table;                    // Add the number of data items to the variable that will be used
                                                                     // to calculate the average number of data members in the partition table.
+
+        metrics_tick(metrics, one_queue_unequal);                   // Add the memory metrics for this tick.
     }
 
     average_num_data_members_in_partition_table /= clock;               // Calculate the average number of data members in the partition table.
@@ -176,4 +208,6 @@ void one_queue_unequal_partitioning(Data data[NUMBER_OF_SAMPLES], int number_of_
 
     one_queue_unequal->number_of_failures += number_of_failures;        // Add the number of failures for this experiment to the cumulative value.
                                                                         // For use in calculating average.
+
+    metrics_finish_experiment(metrics, one_queue_unequal, clock);       // Add the memory metrics to the cumulative values.
 }
\ No newline at end of file
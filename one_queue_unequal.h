@@ -19,7 +19,8 @@
 #include<list>
 
 #include"main.h"
+#include"metrics.h"
 
 // Function prototypes
-void one_queue_fill_unequal_partitions(Data (&e)[NUMBER_OF_SAMPLES], int &next_data, int &number_of_failures, StaticPartition (&p)[7], int &n, int clock);
+void one_queue_fill_unequal_partitions(Data (&e)[NUMBER_OF_SAMPLES], int number_of_samples, int &next_data, int &number_of_failures, StaticPartition (&p)[7], int &n, int clock, MemoryMetrics &metrics);
 void one_queue_unequal_partitioning(Data e[NUMBER_OF_SAMPLES], int number_of_samples, Results* one_queue_unequal);
\ No newline at end of file
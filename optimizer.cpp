@@ -0,0 +1,459 @@
+/**************************************************************************************************
+ * File: optimizer.cpp
+ * Author: Nolan Davenport
+ * Procedures:
+ *
+ * parse_layout_objective       - Reads a layout objective from its name.
+ *
+ * parse_layout_style           - Reads the partitioning style a layout is optimized for from its
+ *                                name.
+ *
+ * generate_layout_workloads    - Makes the workloads every layout is scored on from the random
+ *                                distributions.
+ *
+ * load_trace_workloads         - Makes the workloads every layout is scored on from a trace file.
+ *
+ * score_layout                 - Scores a layout by simulating it on every workload.
+ *
+ * cached_layout_score          - Scores a layout, reusing the score if it was scored before.
+ *
+ * random_layout                - Makes a random layout of the given memory.
+ *
+ * neighbour_layout             - Moves memory from one partition of a layout to another.
+ *
+ * anneal_layout                - Searches for a better layout with simulated annealing.
+ *
+ * optimize_layout              - Runs several annealing searches in parallel and keeps the best
+ *                                layout found.
+ *
+ * run_layout_optimizer         - Searches for the best layout and prints it next to the
+ *                                hand-picked one.
+ *************************************************************************************************/
+
+#include<iostream>
+#include<fstream>
+#include<sstream>
+#include<random>
+#include<queue>
+#include<list>
+#include<vector>
+#include<map>
+#include<mutex>
+#include<thread>
+#include<string>
+#include<chrono>
+#include<cmath>
+#include<algorithm>
+
+#include"main.h"
+#include"histogram.h"
+#include"static_layouts.h"
+#include"scheduling.h"
+#include"optimizer.h"
+
+using namespace std;
+
+/**************************************************************************************************
+ * bool parse_layout_objective(const string &name, LayoutObjective &objective)
+ *
+ * Author: Nolan Davenport
+ * Description: Reads a layout objective from its name on the command line: mean, p99 or
+ *              failures.
+ *
+ * Parameters:
+ *  name                    I/P     const string (&)        The name of the objective.
+ *  objective               O/P     LayoutObjective (&)     The objective.
+ *  parse_layout_objective  O/P     bool                    False if the name is unknown.
+ *************************************************************************************************/
+bool parse_layout_objective(const string &name, LayoutObjective &objective){
+    if(name == "mean"){                             // The average turnaround time.
+        objective = MEAN_TURN_AROUND;
+    }else if(name == "p99"){                        // The tail of the turnaround time.
+        objective = P99_TURN_AROUND;
+    }else if(name == "failures"){                   // The data too large for its partition.
+        objective = FAILURES;
+    }else{                                          // Anything else is a mistake.
+        return false;
+    }
+    return true;
+}
+
+/**************************************************************************************************
+ * bool parse_layout_style(const string &name, StaticStyle &style)
+ *
+ * Author: Nolan Davenport
+ * Description: Reads the partitioning style a layout is optimized for from its name on the
+ *              command line: one or multiple. The equal style has no layout to search.
+ *
+ * Parameters:
+ *  name                I/P     const string (&)    The name of the style.
+ *  style               O/P     StaticStyle (&)     The style.
+ *  parse_layout_style  O/P     bool                False if the name is unknown.
+ *************************************************************************************************/
+bool parse_layout_style(const string &name, StaticStyle &style){
+    if(name == "one"){                              // The single queue.
+        style = ONE_QUEUE_STYLE;
+    }else if(name == "multiple"){                   // A queue for every partition.
+        style = MULTIPLE_QUEUES_STYLE;
+    }else{                                          // Anything else is a mistake.
+        return false;
+    }
+    return true;
+}
+
+/**************************************************************************************************
+ * void generate_layout_workloads(vector<vector<Data>> &workloads, int number_of_workloads,
+ *                                unsigned seed)
+ *
+ * Author: Nolan Davenport
+ * Description: Makes the workloads every layout is scored on from the same distributions as the
+ *              experiments. Every layout sees the same workloads, so the difference between two
+ *              scores comes from the layouts and not from the random numbers.
+ *
+ * Parameters:
+ *  workloads               O/P     vector<vector<Data>> (&)    The workloads.
+ *  number_of_workloads     I/P     int                         The number of workloads to make.
+ *  seed                    I/P     unsigned                    Seeds the random numbers.
+ *************************************************************************************************/
+void generate_layout_workloads(vector<vector<Data>> &workloads, int number_of_workloads, unsigned seed){
+    default_random_engine gen(seed);                        // The same engine and distributions as
+    poisson_distribution<int> poisson_dist(8);              // the experiments.
+    uniform_int_distribution<int> uniform_dist(1, 10);
+
+    workloads.assign(number_of_workloads, vector<Data>(NUMBER_OF_SAMPLES));
+    for(vector<Data> &workload : workloads){                // Fill each workload.
+        generate_experiment_data(workload.data(), gen, poisson_dist, uniform_dist);
+    }
+}
+
+/**************************************************************************************************
+ * bool load_trace_workloads(const char* file_name, vector<vector<Data>> &workloads)
+ *
+ * Author: Nolan Davenport
+ * Description: Makes the workloads every layout is scored on from a trace file. The file is a
+ *              csv with a header line and one "size, time" line per data item, in the order they
+ *              arrive. The trace is split into workloads of NUMBER_OF_SAMPLES data items.
+ *
+ * Parameters:
+ *  file_name               I/P     const char*                 The name of the trace file.
+ *  workloads               O/P     vector<vector<Data>> (&)    The workloads.
+ *  load_trace_workloads    O/P     bool                        False if the file can't be read or
+ *                                                              holds no data.
+ *************************************************************************************************/
+bool load_trace_workloads(const char* file_name, vector<vector<Data>> &workloads){
+    ifstream file(file_name);                                   // Open the file.
+    if(!file){
+        return false;
+    }
+
+    workloads.clear();
+    string line;
+    getline(file, line);                                        // Skip the header.
+    while(getline(file, line)){                                 // Read each data item.
+        Data item{};
+        char comma;
+        istringstream fields(line);
+        if(!(fields >> item.size >> comma >> item.time) || item.size < 0 || item.time <= 0){
+            continue;                                           // Skip anything that isn't one.
+        }
+        if(workloads.empty() || workloads.back().size() == NUMBER_OF_SAMPLES){     // Start a new workload.
+            workloads.emplace_back();
+        }
+        item.index = workloads.back().size();                   // Its place in the workload.
+        item.left = item.time;                                  // Nothing has run yet.
+        workloads.back().push_back(item);
+    }
+    return !workloads.empty();
+}
+
+/**************************************************************************************************
+ * double score_layout(const vector<int> &sizes, const OptimizerConfig &config,
+ *                     const vector<vector<Data>> &workloads)
+ *
+ * Author: Nolan Davenport
+ * Description: Scores a layout by simulating the partitioning style with it on every workload.
+ *              Lower is better. The workloads run as one batch on the engine for the layout.
+ *
+ * Parameters:
+ *  sizes           I/P     const vector<int> (&)               The layout, smallest first.
+ *  config          I/P     const OptimizerConfig (&)           The optimizer settings.
+ *  workloads       I/P     const vector<vector<Data>> (&)      The workloads.
+ *  score_layout    O/P     double                              The score.
+ *************************************************************************************************/
+double score_layout(const vector<int> &sizes, const OptimizerConfig &config, const vector<vector<Data>> &workloads){
+    Results* results = new Results();                           // The results over every workload.
+    long long number_of_samples = 0;                            // The data in every workload.
+    vector<const Data*> batch;                                  // Every workload runs in one batch.
+    vector<int> sample_counts;
+    for(const vector<Data> &workload : workloads){
+        batch.push_back(workload.data());
+        sample_counts.push_back(workload.size());
+        number_of_samples += workload.size();
+    }
+    batch_static_partitioning(batch.data(), sample_counts.data(), workloads.size(), config.style,
+        sizes.data(), sizes.size(), results);
+
+    double score = 0;
+    switch(config.objective){
+        case MEAN_TURN_AROUND: score = results->turn_around_time / number_of_samples; break;
+        case P99_TURN_AROUND: score = histogram_percentile(results->turn_around_histogram, 99); break;
+        case FAILURES: score = results->number_of_failures / workloads.size(); break;
+    }
+    delete results;
+    return score;
+}
+
+/**************************************************************************************************
+ * double cached_layout_score(const vector<int> &sizes, const OptimizerConfig &config,
+ *                            const vector<vector<Data>> &workloads, LayoutCache &cache)
+ *
+ * Author: Nolan Davenport
+ * Description: Scores a layout, reusing its score if any search scored it before. The lock is
+ *              not held while simulating, so two searches reaching a new layout at the same time
+ *              may both simulate it.
+ *
+ * Parameters:
+ *  sizes                   I/P     const vector<int> (&)               The layout, smallest first.
+ *  config                  I/P     const OptimizerConfig (&)           The optimizer settings.
+ *  workloads               I/P     const vector<vector<Data>> (&)      The workloads.
+ *  cache                   I/O     LayoutCache (&)                     The scores so far.
+ *  cached_layout_score     O/P     double                              The score.
+ *************************************************************************************************/
+double cached_layout_score(const vector<int> &sizes, const OptimizerConfig &config,
+                           const vector<vector<Data>> &workloads, LayoutCache &cache){
+    {
+        lock_guard<mutex> guard(cache.lock);                    // Look for the score.
+        auto entry = cache.scores.find(sizes);
+        if(entry != cache.scores.end()){
+            cache.hits++;
+            return entry->second;
+        }
+    }
+
+    double score = score_layout(sizes, config, workloads);      // Simulate it.
+
+    lock_guard<mutex> guard(cache.lock);                        // Remember the score.
+    cache.scores.emplace(sizes, score);
+    cache.misses++;
+    return score;
+}
+
+/**************************************************************************************************
+ * vector<int> random_layout(const OptimizerConfig &config, mt19937 &gen)
+ *
+ * Author: Nolan Davenport
+ * Description: Makes a random layout of the memory: partition_count partitions of at least 1 MB
+ *              that add up to total_memory, smallest first.
+ *
+ * Parameters:
+ *  config          I/P     const OptimizerConfig (&)   The optimizer settings.
+ *  gen             I/O     mt19937 (&)                 The random numbers.
+ *  random_layout   O/P     vector<int>                 The layout.
+ *************************************************************************************************/
+vector<int> random_layout(const OptimizerConfig &config, mt19937 &gen){
+    vector<int> cuts;                                           // Where memory is cut between partitions.
+    for(int mb = 1; mb < config.total_memory; mb++){
+        cuts.push_back(mb);
+    }
+    shuffle(cuts.begin(), cuts.end(), gen);                     // Take partition_count - 1 of them
+    cuts.resize(config.partition_count - 1);                    // at random.
+    cuts.push_back(0);
+    cuts.push_back(config.total_memory);
+    sort(cuts.begin(), cuts.end());
+
+    vector<int> sizes;                                          // The partitions between the cuts.
+    for(int i = 0; i < config.partition_count; i++){
+        sizes.push_back(cuts[i + 1] - cuts[i]);
+    }
+    sort(sizes.begin(), sizes.end());                           // Smallest first.
+    return sizes;
+}
+
+/**************************************************************************************************
+ * vector<int> neighbour_layout(const vector<int> &sizes, const OptimizerConfig &config,
+ *                              mt19937 &gen)
+ *
+ * Author: Nolan Davenport
+ * Description: Moves up to max_step MB from one partition of a layout to another, leaving every
+ *              partition at least 1 MB.
+ *
+ * Parameters:
+ *  sizes               I/P     const vector<int> (&)       The layout, smallest first.
+ *  config              I/P     const OptimizerConfig (&)   The optimizer settings.
+ *  gen                 I/O     mt19937 (&)                 The random numbers.
+ *  neighbour_layout    O/P     vector<int>                 The new layout, smallest first.
+ *************************************************************************************************/
+vector<int> neighbour_layout(const vector<int> &sizes, const OptimizerConfig &config, mt19937 &gen){
+    vector<int> next(sizes);
+    int count = next.size();
+    uniform_int_distribution<int> pick(0, count - 1);           // The partitions to move between.
+    for(int attempt = 0; attempt < 64; attempt++){              // Find a partition that can give memory.
+        int from = pick(gen), to = pick(gen);
+        if(from == to || next[from] <= 1){
+            continue;
+        }
+        int step = uniform_int_distribution<int>(1, min(config.max_step, next[from] - 1))(gen);
+        next[from] -= step;                                     // Move the memory.
+        next[to] += step;
+        break;
+    }
+    sort(next.begin(), next.end());                             // Smallest first.
+    return next;
+}
+
+/**************************************************************************************************
+ * void anneal_layout(vector<int> start, const OptimizerConfig &config,
+ *                    const vector<vector<Data>> &workloads, LayoutCache &cache, unsigned seed,
+ *                    vector<int> &best, double &best_score)
+ *
+ * Author: Nolan Davenport
+ * Description: Searches for a better layout with simulated annealing. Each step tries a
+ *              neighbouring layout and moves to it if it is better, or if it is worse with a
+ *              chance that shrinks with how much worse it is and as the temperature cools.
+ *
+ * Parameters:
+ *  start           I/P     vector<int>                         The layout to start from.
+ *  config          I/P     const OptimizerConfig (&)           The optimizer settings.
+ *  workloads       I/P     const vector<vector<Data>> (&)      The workloads.
+ *  cache           I/O     LayoutCache (&)                     The scores so far.
+ *  seed            I/P     unsigned                            Seeds this search.
+ *  best            O/P     vector<int> (&)                     The best layout found.
+ *  best_score      O/P     double (&)                          Its score.
+ *************************************************************************************************/
+void anneal_layout(vector<int> start, const OptimizerConfig &config, const vector<vector<Data>> &workloads,
+                   LayoutCache &cache, unsigned seed, vector<int> &best, double &best_score){
+    mt19937 gen(seed);                                          // The random numbers of this search.
+    uniform_real_distribution<double> chance(0, 1);
+
+    vector<int> current = start;                                // Where the search is.
+    double current_score = cached_layout_score(current, config, workloads, cache);
+    best = current;
+    best_score = current_score;
+
+    double cooling = pow(config.end_temperature / config.start_temperature,        // The temperature falls
+        1.0 / max(1, config.iterations - 1));                                       // geometrically.
+    double temperature = config.start_temperature;
+    for(int iteration = 0; iteration < config.iterations; iteration++){
+        vector<int> candidate = neighbour_layout(current, config, gen);
+        double candidate_score = cached_layout_score(candidate, config, workloads, cache);
+
+        double worsening = (candidate_score - current_score) /     // How much worse it is, relative to
+            max(current_score, 1e-9);                               // where the search is.
+        if(worsening <= 0 || chance(gen) < exp(-worsening / temperature)){
+            current = candidate;                                    // Move to it.
+            current_score = candidate_score;
+            if(current_score < best_score){                         // Keep the best one seen.
+                best = current;
+                best_score = current_score;
+            }
+        }
+        temperature *= cooling;
+    }
+}
+
+/**************************************************************************************************
+ * vector<int> optimize_layout(const vector<int> &start, const OptimizerConfig &config,
+ *                             const vector<vector<Data>> &workloads, LayoutCache &cache,
+ *                             double &best_score)
+ *
+ * Author: Nolan Davenport
+ * Description: Runs several annealing searches on their own threads, sharing the workloads and
+ *              the scores. The first search starts from the given layout and the rest from random
+ *              layouts. The best layout of every search is kept.
+ *
+ * Parameters:
+ *  start               I/P     const vector<int> (&)               The layout the first search starts from.
+ *  config              I/P     const OptimizerConfig (&)           The optimizer settings.
+ *  workloads           I/P     const vector<vector<Data>> (&)      The workloads.
+ *  cache               I/O     LayoutCache (&)                     The scores so far.
+ *  best_score          O/P     double (&)                          The score of the best layout.
+ *  optimize_layout     O/P     vector<int>                         The best layout.
+ *************************************************************************************************/
+vector<int> optimize_layout(const vector<int> &start, const OptimizerConfig &config,
+                            const vector<vector<Data>> &workloads, LayoutCache &cache, double &best_score){
+    int chains = config.chains;                                 // One search per core unless told otherwise.
+    if(chains <= 0){
+        chains = max(1u, thread::hardware_concurrency());
+    }
+
+    mt19937 gen(OPTIMIZER_SEED);                                // The starting layouts.
+    vector<vector<int>> starts(chains);
+    for(int chain = 0; chain < chains; chain++){
+        starts[chain] = (chain == 0) ? start : random_layout(config, gen);
+    }
+
+    vector<vector<int>> bests(chains);                          // The best layout of each search.
+    vector<double> scores(chains);
+    vector<thread> searches;
+    for(int chain = 0; chain < chains; chain++){                // Start the searches.
+        searches.emplace_back(anneal_layout, starts[chain], cref(config), cref(workloads), ref(cache),
+            OPTIMIZER_SEED + chain + 1, ref(bests[chain]), ref(scores[chain]));
+    }
+    for(thread &search : searches){                             // Wait for them to finish.
+        search.join();
+    }
+
+    int best = 0;                                               // Keep the best of them.
+    for(int chain = 1; chain < chains; chain++){
+        if(scores[chain] < scores[best]){
+            best = chain;
+        }
+    }
+    best_score = scores[best];
+    return bests[best];
+}
+
+/**************************************************************************************************
+ * int run_layout_optimizer(const OptimizerConfig &config, const char* trace_file)
+ *
+ * Author: Nolan Davenport
+ * Description: Searches for the best layout of static partitions for a partitioning style and
+ *              prints it next to the hand-picked unequal layout. The layouts are scored on a
+ *              trace if one is given, or on workloads from the experiment distributions.
+ *
+ * Parameters:
+ *  config                  I/P     const OptimizerConfig (&)   The optimizer settings.
+ *  trace_file              I/P     const char*                 The trace file, or null.
+ *  run_layout_optimizer    O/P     int                         Status code, non-zero if the trace
+ *                                                              can't be read.
+ *************************************************************************************************/
+int run_layout_optimizer(const OptimizerConfig &config, const char* trace_file){
+    vector<vector<Data>> workloads;                             // The workloads every layout is scored on.
+    if(trace_file != nullptr){
+        if(!load_trace_workloads(trace_file, workloads)){
+            cerr << "Can't read a trace from " << trace_file << endl;
+            return 1;
+        }
+    }else{
+        generate_layout_workloads(workloads, OPTIMIZER_WORKLOADS, OPTIMIZER_SEED);
+    }
+
+    vector<int> hand_picked(UnequalLayout::sizes, UnequalLayout::sizes + UnequalLayout::count);
+    LayoutCache cache;                                          // Shared by every search.
+
+    auto start_time = chrono::steady_clock::now();
+    double hand_picked_score = cached_layout_score(hand_picked, config, workloads, cache);
+    double best_score = 0;
+    vector<int> best = optimize_layout(hand_picked, config, workloads, cache, best_score);
+    double seconds = chrono::duration<double>(chrono::steady_clock::now() - start_time).count();
+
+    static const char* objectives[] = {"mean turnaround", "p99 turnaround", "failures"};
+    auto print_layout = [](const vector<int> &sizes){
+        for(size_t i = 0; i < sizes.size(); i++){
+            cout << (i ? "/" : "") << sizes[i];
+        }
+    };
+
+    cout << "layout optimizer: " << objectives[config.objective] << " of the " <<
+        ((config.style == MULTIPLE_QUEUES_STYLE) ? "multiple queues" : "one queue") << " style on " <<
+        workloads.size() << " workloads" << endl;
+    cout << "hand-picked layout ";
+    print_layout(hand_picked);
+    cout << ": " << hand_picked_score << endl;
+    cout << "best layout ";
+    print_layout(best);
+    cout << ": " << best_score << endl;
+    cout << "layouts simulated: " << cache.misses << " reused: " << cache.hits << " in " << seconds <<
+        " s" << endl;
+    return 0;
+}
\ No newline at end of file
@@ -0,0 +1,93 @@
+/**************************************************************************************************
+ * File: optimizer.h
+ * Author: Nolan Davenport
+ * Procedures:
+ *
+ * parse_layout_objective       - Reads a layout objective from its name.
+ *
+ * parse_layout_style           - Reads the partitioning style a layout is optimized for from its
+ *                                name.
+ *
+ * generate_layout_workloads    - Makes the workloads every layout is scored on from the random
+ *                                distributions.
+ *
+ * load_trace_workloads         - Makes the workloads every layout is scored on from a trace file.
+ *
+ * score_layout                 - Scores a layout by simulating it on every workload.
+ *
+ * cached_layout_score          - Scores a layout, reusing the score if it was scored before.
+ *
+ * random_layout                - Makes a random layout of the given memory.
+ *
+ * neighbour_layout             - Moves memory from one partition of a layout to another.
+ *
+ * anneal_layout                - Searches for a better layout with simulated annealing.
+ *
+ * optimize_layout              - Runs several annealing searches in parallel and keeps the best
+ *                                layout found.
+ *
+ * run_layout_optimizer         - Searches for the best layout and prints it next to the
+ *                                hand-picked one.
+ *************************************************************************************************/
+
+#pragma once
+
+#include<iostream>
+#include<random>
+#include<queue>
+#include<list>
+#include<vector>
+#include<map>
+#include<mutex>
+#include<string>
+
+#include"main.h"
+#include"scheduling.h"
+
+using namespace std;
+
+#define OPTIMIZER_WORKLOADS 32          // The workloads each layout is scored on.
+#define OPTIMIZER_SEED 20240601         // Seeds the workloads and the searches.
+
+// What the layout optimizer minimizes.
+typedef enum {
+    MEAN_TURN_AROUND,           // The average turnaround time.
+    P99_TURN_AROUND,            // The 99th percentile of the turnaround time.
+    FAILURES                    // The average number of failures per workload.
+} LayoutObjective;
+
+// Structure that holds the settings of the layout optimizer. Layouts have partition_count
+// partitions of at least 1 MB that add up to total_memory, smallest first.
+typedef struct {
+    LayoutObjective objective = MEAN_TURN_AROUND;   // What to minimize.
+    StaticStyle style = ONE_QUEUE_STYLE;            // The partitioning style the layout is for.
+    int total_memory = MEMORY_END + 1;              // The memory the partitions share, in MB.
+    int partition_count = 7;                        // The number of partitions.
+    int chains = 0;                                 // The parallel searches, or zero for one per core.
+    int iterations = 400;                           // The layouts each search tries.
+    int max_step = 4;                               // The most MB moved between partitions in one step.
+    double start_temperature = 0.05;                // The relative worsening accepted at first.
+    double end_temperature = 0.0005;                // The relative worsening accepted at the end.
+} OptimizerConfig;
+
+// Structure that holds the scores of every layout tried so far. The searches share it, so each
+// layout is only simulated once.
+typedef struct {
+    map<vector<int>, double> scores;    // Layout to score.
+    mutex lock;                         // Guards the scores.
+    long long hits = 0;                 // The scores found in the cache.
+    long long misses = 0;               // The scores that had to be simulated.
+} LayoutCache;
+
+// Function prototypes
+bool parse_layout_objective(const string &name, LayoutObjective &objective);
+bool parse_layout_style(const string &name, StaticStyle &style);
+void generate_layout_workloads(vector<vector<Data>> &workloads, int number_of_workloads, unsigned seed);
+bool load_trace_workloads(const char* file_name, vector<vector<Data>> &workloads);
+double score_layout(const vector<int> &sizes, const OptimizerConfig &config, const vector<vector<Data>> &workloads);
+double cached_layout_score(const vector<int> &sizes, const OptimizerConfig &config, const vector<vector<Data>> &workloads, LayoutCache &cache);
+vector<int> random_layout(const OptimizerConfig &config, mt19937 &gen);
+vector<int> neighbour_layout(const vector<int> &sizes, const OptimizerConfig &config, mt19937 &gen);
+void anneal_layout(vector<int> start, const OptimizerConfig &config, const vector<vector<Data>> &workloads, LayoutCache &cache, unsigned seed, vector<int> &best, double &best_score);
+vector<int> optimize_layout(const vector<int> &start, const OptimizerConfig &config, const vector<vector<Data>> &workloads, LayoutCache &cache, double &best_score);
+int run_layout_optimizer(const OptimizerConfig &config, const char* trace_file);
\ No newline at end of file
@@ -0,0 +1,276 @@
+/**************************************************************************************************
+ * File: paging.cpp
+ * Author: Nolan Davenport
+ * Procedures:
+ *
+ * pages_for_size               - Gets the number of pages data of a size needs.
+ *
+ * map_pages                    - Builds the page table of data from the free frame stack.
+ *
+ * unmap_pages                  - Returns the frames of a page table to the free frame stack.
+ *
+ * paged_admission              - Admits data from the front of the queue while there are enough
+ *                                free frames.
+ *
+ * paged_partitioning           - Performs the paged memory experiment.
+ *
+ * report_paging_results        - Prints the results of the paged memory experiment next to the
+ *                                other styles.
+ *************************************************************************************************/
+
+#include<iostream>
+#include<random>
+#include<queue>
+#include<list>
+#include<vector>
+
+#include"main.h"
+#include"metrics.h"
+#include"histogram.h"
+#include"paging.h"
+
+using namespace std;
+
+/**************************************************************************************************
+ * int pages_for_size(int size, int page_size)
+ *
+ * Author: Nolan Davenport
+ * Description: Gets the number of pages data of a size needs. The last page is only partly used
+ *              unless the size is a multiple of the page size.
+ *
+ * Parameters:
+ *  size            I/P     int     The size of the data in MB.
+ *  page_size       I/P     int     The size of a page in MB.
+ *  pages_for_size  O/P     int     The number of pages.
+ *************************************************************************************************/
+int pages_for_size(int size, int page_size){
+    return (size + page_size - 1) / page_size;      // Round up to whole pages.
+}
+
+/**************************************************************************************************
+ * void map_pages(PagedMemory &memory, int index, int pages)
+ *
+ * Author: Nolan Davenport
+ * Description: Builds the page table of data from the free frame stack. The frames need not be
+ *              next to each other. There must be enough free frames.
+ *
+ * Parameters:
+ *  memory      I/O     PagedMemory (&)     The paged memory.
+ *  index       I/P     int                 The index of the data.
+ *  pages       I/P     int                 The number of pages to map.
+ *************************************************************************************************/
+void map_pages(PagedMemory &memory, int index, int pages){
+    vector<int> &page_table = memory.page_tables[index];   // The page table of the data.
+    for(int page = 0; page < pages; page++){                // Back each page with a free frame.
+        page_table.push_back(memory.free_frames.back());
+        memory.free_frames.pop_back();
+    }
+    memory.mapped_pages += pages;                           // The entries are now in use.
+}
+
+/**************************************************************************************************
+ * void unmap_pages(PagedMemory &memory, int index)
+ *
+ * Author: Nolan Davenport
+ * Description: Returns the frames of a page table to the free frame stack and empties it.
+ *
+ * Parameters:
+ *  memory      I/O     PagedMemory (&)     The paged memory.
+ *  index       I/P     int                 The index of the data.
+ *************************************************************************************************/
+void unmap_pages(PagedMemory &memory, int index){
+    vector<int> &page_table = memory.page_tables[index];   // The page table of the data.
+    for(int page = page_table.size() - 1; page >= 0; page--){   // Free the frames, last page first.
+        memory.free_frames.push_back(page_table[page]);
+    }
+    memory.mapped_pages -= page_table.size();               // The entries are no longer in use.
+    page_table.clear();
+}
+
+/**************************************************************************************************
+ * void paged_admission(Data data[], int number_of_samples, const PagingConfig &config,
+ *                      PagedMemory &memory, list<int> &resident, int &next_data,
+ *                      int &number_of_failures, MemoryMetrics &metrics, PagingStats* stats)
+ *
+ * Author: Nolan Davenport
+ * Description: Admits data from the front of the queue while there are enough free frames. Like
+ *              the dynamic style, data larger than all of memory is a failure that gets the whole
+ *              memory once it is empty. Admitted data joins the end of the processor's rotation.
+ *
+ * Parameters:
+ *  data                I/P     Data[]                  The data of the experiment.
+ *  number_of_samples   I/P     int                     The number of samples in the experiment.
+ *  config              I/P     const PagingConfig (&)  The paging settings.
+ *  memory              I/O     PagedMemory (&)         The paged memory.
+ *  resident            I/O     list<int> (&)           The data in memory, in rotation order.
+ *  next_data           I/O     int (&)                 The front of the queue.
+ *  number_of_failures  I/O     int (&)                 The failures of the experiment.
+ *  metrics             I/O     MemoryMetrics (&)       The memory metrics of the experiment.
+ *  stats               I/O     PagingStats*            The page table statistics.
+ *************************************************************************************************/
+void paged_admission(Data data[], int number_of_samples, const PagingConfig &config, PagedMemory &memory,
+                     list<int> &resident, int &next_data, int &number_of_failures, MemoryMetrics &metrics,
+                     PagingStats* stats){
+    while(next_data != number_of_samples){                              // Admit as much as fits.
+        int pages = pages_for_size(data[next_data].size, config.page_size);     // The pages it needs.
+        if(pages > memory.frame_count){                                 // If it is larger than memory:
+            if(!resident.empty()){                                      // It waits for memory to empty,
+                break;
+            }
+            pages = memory.frame_count;                                 // then takes all of it and fails.
+            number_of_failures++;
+        }else if(pages > (int)memory.free_frames.size()){               // If there aren't enough free frames:
+            break;                                                      // The front of the queue waits.
+        }
+
+        map_pages(memory, next_data, pages);                            // Give it its frames.
+        metrics_admit(metrics, pages * config.page_size, data[next_data].size);     // The rest of the last page is wasted.
+        resident.push_back(next_data);                                  // It joins the rotation.
+        stats->pages_mapped += pages;
+        stats->peak_mapped_pages = max(stats->peak_mapped_pages, memory.mapped_pages);
+        next_data++;                                                    // Move to the next item in the queue.
+    }
+}
+
+/**************************************************************************************************
+ * void paged_partitioning(Data data[], int number_of_samples, const PagingConfig &config,
+ *                         Results* paged, PagingStats* stats)
+ *
+ * Author: Nolan Davenport
+ * Description: Performs the paged memory experiment. Data is admitted in queue order like the
+ *              dynamic style, but its pages can use any free frames, so data waits only when
+ *              there isn't enough free memory in total and memory is never compacted. The
+ *              processor gives each resident data member one quantum in turn. Only the last page
+ *              of each data member wastes memory.
+ *
+ * Parameters:
+ *  data                I/P     Data[]                  The data to be used in this experiment.
+ *  number_of_samples   I/P     int                     The number of samples in this experiment.
+ *  config              I/P     const PagingConfig (&)  The paging settings.
+ *  paged               O/P     Results*                Pointer to the structure that holds the
+ *                                                      results of this experiment.
+ *  stats               I/O     PagingStats*            The page table statistics.
+ *************************************************************************************************/
+void paged_partitioning(Data data[], int number_of_samples, const PagingConfig &config, Results* paged,
+                        PagingStats* stats){
+    vector<int> left(number_of_samples);            // Only the time left changes during the experiment.
+    for(int i = 0; i < number_of_samples; i++){     // Loop through each sample.
+        left[i] = data[i].left;                     // Copy the time left.
+    }
+
+    PagedMemory memory;                                         // Every frame starts free, with frame
+    memory.frame_count = config.memory_units / config.page_size;    // zero on top of the stack.
+    for(int frame = memory.frame_count - 1; frame >= 0; frame--){
+        memory.free_frames.push_back(frame);
+    }
+    memory.page_tables.resize(number_of_samples);
+    memory.mapped_pages = 0;
+
+    MemoryMetrics metrics;                          // The memory metrics for this experiment.
+    metrics.memory_size = config.memory_units;
+
+    list<int> resident;                             // The data in memory, in rotation order.
+    int next_data = 0;                              // The front of the queue.
+    int number_of_failures = 0;                     // Initialize the number of failures to zero.
+    int clock = 0;                                  // Initialize the clock to zero.
+    float average_num_data_members_in_partition_table = 0;  // Cumulative value used for the average.
+
+    paged_admission(data, number_of_samples, config, memory, resident, next_data, number_of_failures,
+        metrics, stats);
+
+    list<int>::iterator it = resident.begin();      // The data the processor is at.
+    for(;;){                                                        // Clock loop.
+        int index = *it;                                            // The data at the processor.
+        if(--left[index] == 0){                                     // Work for one quantum. If the data is finished:
+            int turn_around_time = clock - data[index].time_start;  // Calculate the turnaround time.
+            paged->turn_around_time += turn_around_time;            // Add it to the cumulative turnaround time.
+            paged->relative_turn_around_time +=                     // Add the relative turnaround time.
+                (float)turn_around_time / data[index].time;
+            record_completion(index, clock);                        // Record when it finished.
+            histogram_record(paged->turn_around_histogram, turn_around_time);   // Record both for the percentiles.
+            record_relative_turn_around(paged->relative_turn_around_histogram,
+                turn_around_time, data[index].time);
+
+            metrics_release(metrics, memory.page_tables[index].size() * config.page_size, data[index].size);
+            unmap_pages(memory, index);                             // Free its frames.
+            it = resident.erase(it);                                // It leaves the rotation.
+
+            bool was_empty = resident.empty();                      // Admit what now fits.
+            paged_admission(data, number_of_samples, config, memory, resident, next_data, number_of_failures,
+                metrics, stats);
+
+            if(resident.empty()){                                   // If memory is empty:
+                break;                                              // The experiment is done.
+            }else if(was_empty){                                    // Start the rotation over with the new data.
+                it = resident.begin();
+            }
+        }else{
+            it++;                                                   // Move to the next data.
+        }
+
+        if(it == resident.end()){                                   // Wrap around the rotation.
+            it = resident.begin();
+        }
+
+        clock++;                                                    // Increment the clock.
+        average_num_data_members_in_partition_table += resident.size();
+        metrics_tick(metrics, paged);                               // Add the memory metrics for this tick.
+        stats->mapped_page_ticks += memory.mapped_pages;            // And the page table entries in use.
+        if(next_data != number_of_samples){                         // The front of the queue is still waiting.
+            stats->blocked_ticks++;
+        }
+    }
+
+    average_num_data_members_in_partition_table /= clock;           // Calculate the average for this experiment.
+    paged->average_num_data_members_in_partition_table += average_num_data_members_in_partition_table;
+    paged->number_of_failures += number_of_failures;                // Add the failures to the cumulative variable.
+    metrics_finish_experiment(metrics, paged, clock);               // Add the memory metrics to the cumulative values.
+
+    stats->experiments++;
+    stats->ticks += clock;
+}
+
+/**************************************************************************************************
+ * void report_paging_results(Results* paged, const PagingConfig &config, const PagingStats &stats)
+ *
+ * Author: Nolan Davenport
+ * Description: Prints the results of the paged memory experiment in the same form as the other
+ *              styles, then the page table overhead. Like report_results, the cumulative values
+ *              are turned into averages in place.
+ *
+ * Parameters:
+ *  paged       I/O     Results*                The results of the paged experiments.
+ *  config      I/P     const PagingConfig (&)  The paging settings.
+ *  stats       I/P     const PagingStats (&)   The page table statistics.
+ *************************************************************************************************/
+void report_paging_results(Results* paged, const PagingConfig &config, const PagingStats &stats){
+    if(stats.experiments == 0){                     // Nothing to report.
+        return;
+    }
+    double experiments = stats.experiments;         // Averages are per experiment,
+    paged->number_of_failures /= experiments;
+    paged->turn_around_time /= experiments * NUMBER_OF_SAMPLES;                 // or per data item.
+    paged->relative_turn_around_time /= experiments * NUMBER_OF_SAMPLES;
+    paged->average_num_data_members_in_partition_table /= experiments;
+    paged->average_memory_utilization /= experiments;
+    paged->average_internal_fragmentation /= experiments;
+
+    cout << "paged average number_of_failures: " << paged->number_of_failures << endl;
+    cout << "paged average turn_around_time: " << paged->turn_around_time << endl;
+    cout << "paged average relative_turn_around_time: " << paged->relative_turn_around_time << endl;
+    cout << "paged average number of data members in page tables: " <<
+        paged->average_num_data_members_in_partition_table << endl;
+    cout << "paged average memory utilization: " << paged->average_memory_utilization << endl;
+    cout << "paged average internal fragmentation: " << paged->average_internal_fragmentation << endl;
+
+    double average_entries = (double)stats.mapped_page_ticks / stats.ticks;     // Per tick of every experiment.
+    cout << "paged " << config.page_size << " MB pages, " << config.memory_units / config.page_size <<
+        " frames, average page table entries: " << average_entries << " (" <<
+        average_entries * PAGE_TABLE_ENTRY_BYTES << " bytes), peak: " << stats.peak_mapped_pages << endl;
+    cout << "paged average time the front of the queue waited for frames: " <<
+        stats.blocked_ticks / experiments << " ticks" << endl;
+    report_percentiles("paged", paged, cout);           // Print the turnaround time percentiles.
+    cout << endl;
+
+    write_time_series(&paged->memory_utilization_over_time, "paged_utilization.csv");
+}
\ No newline at end of file
@@ -0,0 +1,68 @@
+/**************************************************************************************************
+ * File: paging.h
+ * Author: Nolan Davenport
+ * Procedures:
+ *
+ * pages_for_size               - Gets the number of pages data of a size needs.
+ *
+ * map_pages                    - Builds the page table of data from the free frame stack.
+ *
+ * unmap_pages                  - Returns the frames of a page table to the free frame stack.
+ *
+ * paged_admission              - Admits data from the front of the queue while there are enough
+ *                                free frames.
+ *
+ * paged_partitioning           - Performs the paged memory experiment.
+ *
+ * report_paging_results        - Prints the results of the paged memory experiment next to the
+ *                                other styles.
+ *************************************************************************************************/
+
+#pragma once
+
+#include<iostream>
+#include<random>
+#include<queue>
+#include<list>
+#include<vector>
+
+#include"main.h"
+#include"metrics.h"
+
+using namespace std;
+
+#define PAGE_TABLE_ENTRY_BYTES 8        // One 64 bit entry per mapped page.
+
+// Structure that holds the settings of the paged memory. Memory is split into frames of one page
+// each, and the page size need not divide the memory; the remainder is never used.
+typedef struct {
+    int page_size = 4;                  // The size of a page and a frame in MB.
+    int memory_units = MEMORY_END + 1;  // The size of memory in MB.
+} PagingConfig;
+
+// Structure that holds the memory of the paged experiment. Any free frame can back any page, so
+// there is no external fragmentation and nothing to compact.
+typedef struct {
+    vector<int> free_frames;            // The free frame stack. The most recently freed frame is reused first.
+    vector<vector<int>> page_tables;    // The frame of each page of each data item, by data index.
+    int frame_count;                    // The number of frames in memory.
+    int mapped_pages;                   // The page table entries in use.
+} PagedMemory;
+
+// Structure that holds the page table statistics of the paged experiment.
+typedef struct {
+    long long experiments = 0;              // The number of experiments.
+    long long ticks = 0;                    // The clock ticks of every experiment.
+    long long pages_mapped = 0;             // The pages mapped for admitted data.
+    long long mapped_page_ticks = 0;        // The page table entries in use, summed every tick.
+    int peak_mapped_pages = 0;              // The most page table entries in use at once.
+    long long blocked_ticks = 0;            // The ticks the front of the queue waited for frames.
+} PagingStats;
+
+// Function prototypes
+int pages_for_size(int size, int page_size);
+void map_pages(PagedMemory &memory, int index, int pages);
+void unmap_pages(PagedMemory &memory, int index);
+void paged_admission(Data data[], int number_of_samples, const PagingConfig &config, PagedMemory &memory, list<int> &resident, int &next_data, int &number_of_failures, MemoryMetrics &metrics, PagingStats* stats);
+void paged_partitioning(Data data[], int number_of_samples, const PagingConfig &config, Results* paged, PagingStats* stats);
+void report_paging_results(Results* paged, const PagingConfig &config, const PagingStats &stats);
\ No newline at end of file
@@ -0,0 +1,91 @@
+/**************************************************************************************************
+ * File: partition_pool.cpp
+ * Author: Nolan Davenport
+ * Procedures:
+ * 
+ * dynamic_partition_resource           - Gets the memory resource that the list of dynamic 
+ *                                        partitions allocates its nodes from. 
+ * 
+ * reset_dynamic_partition_pool         - Resets the pool of dynamic partition nodes for the next 
+ *                                        experiment. 
+ * 
+ * dynamic_partition_node_allocations   - Gets how many dynamic partition nodes were allocated. 
+ * 
+ * dynamic_partition_heap_allocations   - Gets how many times the pool had to allocate from the 
+ *                                        heap. 
+ *************************************************************************************************/
+
+#include<iostream>
+#include<random>
+#include<queue>
+#include<list>
+#include<memory_resource>
+
+#include"main.h"
+#include"partition_pool.h"
+
+using namespace std;
+
+// Structure that holds one thread's pool of dynamic partition nodes. Nodes are carved out of a 
+// fixed buffer and freed nodes are reused, so the heap is only touched if the buffer runs out. 
+struct PartitionPool{
+    CountingResource heap{pmr::new_delete_resource()};                          // Counts calls to the heap.
+    alignas(max_align_t) unsigned char buffer[PARTITION_POOL_BUFFER_SIZE];      // The memory nodes come from.
+    pmr::monotonic_buffer_resource arena{buffer, sizeof(buffer), &heap};        // Carves the buffer up.
+    pmr::unsynchronized_pool_resource pool{&arena};                             // Reuses freed nodes.
+    CountingResource nodes{&pool};                                              // Counts node allocations.
+};
+
+thread_local PartitionPool partition_pool;      // Each thread gets its own pool, so no locking is needed.
+
+/**************************************************************************************************
+ * pmr::memory_resource* dynamic_partition_resource()
+ * 
+ * Author: Nolan Davenport
+ * Description: Gets the memory resource that the list of dynamic partitions allocates its nodes 
+ *              from. 
+ * 
+ * Parameters:
+ *  dynamic_partition_resource  O/P     pmr::memory_resource*   This thread's pool.
+ *************************************************************************************************/
+pmr::memory_resource* dynamic_partition_resource(){
+    return &partition_pool.nodes;
+}
+
+/**************************************************************************************************
+ * void reset_dynamic_partition_pool()
+ * 
+ * Author: Nolan Davenport
+ * Description: Resets the pool of dynamic partition nodes for the next experiment. Every list 
+ *              using the pool must be empty or destroyed. 
+ *************************************************************************************************/
+void reset_dynamic_partition_pool(){
+    partition_pool.pool.release();      // Drop the pool's free lists.
+    partition_pool.arena.release();     // Start carving from the beginning of the buffer again.
+}
+
+/**************************************************************************************************
+ * long long dynamic_partition_node_allocations()
+ * 
+ * Author: Nolan Davenport
+ * Description: Gets how many dynamic partition nodes were allocated on this thread. 
+ * 
+ * Parameters:
+ *  dynamic_partition_node_allocations  O/P     long long   The number of node allocations.
+ *************************************************************************************************/
+long long dynamic_partition_node_allocations(){
+    return partition_pool.nodes.allocations;
+}
+
+/**************************************************************************************************
+ * long long dynamic_partition_heap_allocations()
+ * 
+ * Author: Nolan Davenport
+ * Description: Gets how many times the pool on this thread had to allocate from the heap. 
+ * 
+ * Parameters:
+ *  dynamic_partition_heap_allocations  O/P     long long   The number of heap allocations.
+ *************************************************************************************************/
+long long dynamic_partition_heap_allocations(){
+    return partition_pool.heap.allocations;
+}
\ No newline at end of file
@@ -0,0 +1,61 @@
+/**************************************************************************************************
+ * File: partition_pool.h
+ * Author: Nolan Davenport
+ * Procedures:
+ * 
+ * dynamic_partition_resource           - Gets the memory resource that the list of dynamic 
+ *                                        partitions allocates its nodes from. 
+ * 
+ * reset_dynamic_partition_pool         - Resets the pool of dynamic partition nodes for the next 
+ *                                        experiment. 
+ * 
+ * dynamic_partition_node_allocations   - Gets how many dynamic partition nodes were allocated. 
+ * 
+ * dynamic_partition_heap_allocations   - Gets how many times the pool had to allocate from the 
+ *                                        heap. 
+ *************************************************************************************************/
+
+#pragma once
+
+#include<iostream>
+#include<random>
+#include<queue>
+#include<list>
+#include<memory_resource>
+
+#include"main.h"
+
+using namespace std;
+
+#define PARTITION_POOL_BUFFER_SIZE 65536
+
+// Memory resource that counts the allocations passing through it on the way to another resource.
+class CountingResource : public pmr::memory_resource{
+public:
+    explicit CountingResource(pmr::memory_resource* upstream) : upstream(upstream){}
+
+    long long allocations = 0;                  // The number of allocations made.
+
+private:
+    pmr::memory_resource* upstream;             // The resource that does the real work.
+
+    void* do_allocate(size_t bytes, size_t alignment) override{
+        allocations++;                                      // Count the allocation.
+        return upstream->allocate(bytes, alignment);        // Pass it on.
+    }
+    void do_deallocate(void* p, size_t bytes, size_t alignment) override{
+        upstream->deallocate(p, bytes, alignment);          // Pass it on.
+    }
+    bool do_is_equal(const pmr::memory_resource &other) const noexcept override{
+        return this == &other;
+    }
+};
+
+// The list of dynamic partitions. Its nodes come from a per thread pool instead of the heap.
+typedef pmr::list<DynamicPartition> DynamicPartitionList;
+
+// Function prototypes
+pmr::memory_resource* dynamic_partition_resource();
+void reset_dynamic_partition_pool();
+long long dynamic_partition_node_allocations();
+long long dynamic_partition_heap_allocations();
\ No newline at end of file
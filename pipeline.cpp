@@ -0,0 +1,131 @@
+/**************************************************************************************************
+ * File: pipeline.cpp
+ * Author: Nolan Davenport
+ * Procedures:
+ *
+ * pipeline_worker              - Runs one partitioning style on every workload of the pipeline.
+ *
+ * run_pipelined_experiments    - Runs the experiments with each partitioning style on its own
+ *                                worker thread, fed by a generator stage.
+ *************************************************************************************************/
+
+#include<iostream>
+#include<random>
+#include<queue>
+#include<list>
+#include<atomic>
+#include<thread>
+#include<functional>
+
+#include"main.h"
+#include"pipeline.h"
+
+using namespace std;
+
+/**************************************************************************************************
+ * static void pipeline_worker(WorkloadBroadcast* broadcast, int worker, PipelineStrategy strategy,
+ *                             Results* results, int first_experiment, int number_of_experiments,
+ *                             Checkpointer* checkpointer)
+ *
+ * Author: Nolan Davenport
+ * Description: Runs one partitioning style on every workload of the pipeline, in order, waiting
+ *              for the generator whenever it gets ahead of it. At every checkpoint interval it
+ *              copies its accumulators into the checkpoint and carries on.
+ *
+ * Parameters:
+ *  broadcast               I/O     WorkloadBroadcast*  The workloads being broadcast.
+ *  worker                  I/P     int                 The number of this worker.
+ *  strategy                I/P     PipelineStrategy    The partitioning style to run.
+ *  results                 O/P     Results*            The results of this partitioning style.
+ *  first_experiment        I/P     int                 The first experiment to run.
+ *  number_of_experiments   I/P     int                 The number of experiments to run.
+ *  checkpointer            I/O     Checkpointer*       The checkpoints of the run, or null.
+ *************************************************************************************************/
+static void pipeline_worker(WorkloadBroadcast* broadcast, int worker, PipelineStrategy strategy,
+                            Results* results, int first_experiment, int number_of_experiments,
+                            Checkpointer* checkpointer){
+    for(int experiment = first_experiment; experiment < number_of_experiments; experiment++){  // Loop through experiments.
+        while(broadcast->produced.load(memory_order_acquire) <= experiment){        // Wait for the workload.
+            this_thread::yield();
+        }
+
+        strategy(broadcast->workloads[experiment % PIPELINE_SLOTS],                 // Perform the experiment.
+            NUMBER_OF_SAMPLES, results);
+
+        broadcast->finished[worker].store(experiment + 1, memory_order_release);    // Done with the workload.
+
+        int done = experiment + 1;                                                  // Checkpoint between experiments.
+        if(checkpointer != nullptr && done % checkpointer->interval == 0 && done < number_of_experiments){
+            capture_style(checkpointer, done, worker);
+        }
+    }
+}
+
+/**************************************************************************************************
+ * void run_pipelined_experiments(PipelineStrategy strategies[PIPELINE_WORKERS],
+ *                                Results* results[PIPELINE_WORKERS], int number_of_experiments,
+ *                                default_random_engine &gen,
+ *                                poisson_distribution<int> &poisson_dist,
+ *                                uniform_int_distribution<int> &uniform_dist,
+ *                                int first_experiment, Checkpointer* checkpointer)
+ *
+ * Author: Nolan Davenport
+ * Description: Runs the experiments with each partitioning style on its own worker thread. The
+ *              calling thread is the generator stage: it makes each workload once and broadcasts
+ *              it to every worker. The workloads are made in the same order as the sequential
+ *              loop in main, so the results are the same. A resumed run starts
+ *              at first_experiment. The generator adds its random state to each checkpoint and
+ *              each worker its accumulators, so no thread waits for another to checkpoint.
+ *
+ * Parameters:
+ *  strategies              I/P     PipelineStrategy[]          The partitioning styles.
+ *  results                 O/P     Results*[]                  The results of each style.
+ *  number_of_experiments   I/P     int                         The number of experiments.
+ *  gen                     I/O     default_random_engine (&)   The random engine.
+ *  poisson_dist            I/O     poisson_distribution (&)    The distribution of sizes.
+ *  uniform_dist            I/O     uniform_int_distribution (&) The distribution of times.
+ *  first_experiment        I/P     int                         The first experiment to run.
+ *  checkpointer            I/O     Checkpointer*               The checkpoints of the run, or null.
+ *************************************************************************************************/
+void run_pipelined_experiments(PipelineStrategy strategies[PIPELINE_WORKERS], Results* results[PIPELINE_WORKERS],
+                               int number_of_experiments, default_random_engine &gen,
+                               poisson_distribution<int> &poisson_dist,
+                               uniform_int_distribution<int> &uniform_dist,
+                               int first_experiment, Checkpointer* checkpointer){
+    WorkloadBroadcast* broadcast = new WorkloadBroadcast();     // The ring is too large for the stack.
+    broadcast->produced.store(first_experiment);                // Nothing has been generated
+    for(int worker = 0; worker < PIPELINE_WORKERS; worker++){   // or finished yet.
+        broadcast->finished[worker].store(first_experiment);
+    }
+
+    thread workers[PIPELINE_WORKERS];                           // Start a worker for each style.
+    for(int worker = 0; worker < PIPELINE_WORKERS; worker++){
+        workers[worker] = thread(pipeline_worker, broadcast, worker, strategies[worker],
+            results[worker], first_experiment, number_of_experiments, checkpointer);
+    }
+
+    for(int experiment = first_experiment; experiment < number_of_experiments; experiment++){  // Loop through experiments.
+        if(checkpointer != nullptr && experiment > first_experiment &&            // Checkpoint the random state
+            experiment % checkpointer->interval == 0){                          // before the next workload.
+            capture_random_state(checkpointer, experiment, save_random_state(gen, poisson_dist, uniform_dist));
+        }
+
+        for(int worker = 0; worker < PIPELINE_WORKERS; worker++){               // Wait until every worker is
+            while(broadcast->finished[worker].load(memory_order_acquire) <=     // done with the workload that
+                experiment - PIPELINE_SLOTS){                                   // was in this slot before.
+                this_thread::yield();
+            }
+        }
+
+        generate_experiment_data(broadcast->workloads[experiment % PIPELINE_SLOTS],    // Generate the workload.
+            gen, poisson_dist, uniform_dist);
+
+        broadcast->produced.store(experiment + 1, memory_order_release);       // Hand it to the workers.
+    }
+
+    for(int worker = 0; worker < PIPELINE_WORKERS; worker++){   // Wait for the workers to finish.
+        workers[worker].join();
+    }
+
+    delete broadcast;                                           // Delete the ring.
+}
\ No newline at end of file
@@ -0,0 +1,41 @@
+/**************************************************************************************************
+ * File: pipeline.h
+ * Author: Nolan Davenport
+ * Procedures:
+ *
+ * run_pipelined_experiments    - Runs the experiments with each partitioning style on its own
+ *                                worker thread, fed by a generator stage.
+ *************************************************************************************************/
+
+#pragma once
+
+#include<iostream>
+#include<random>
+#include<queue>
+#include<list>
+#include<atomic>
+#include<functional>
+
+#include"main.h"
+#include"checkpoint.h"
+
+using namespace std;
+
+#define PIPELINE_SLOTS 8        // The number of workloads that can be in flight at once.
+#define PIPELINE_WORKERS 4      // One worker for each partitioning style.
+
+// One partitioning style as run by a pipeline worker.
+typedef function<void(Data*, int, Results*)> PipelineStrategy;
+
+// Structure that broadcasts each workload from the generator to every worker. The generator
+// only writes produced and each worker only writes its own finished count, so no locks are
+// needed. A slot is reused only after every worker has finished with it, which keeps a fast
+// worker from running more than PIPELINE_SLOTS experiments ahead of the slowest.
+typedef struct {
+    Data workloads[PIPELINE_SLOTS][NUMBER_OF_SAMPLES];  // The ring of workloads.
+    atomic<int> produced;                               // The number of workloads generated.
+    atomic<int> finished[PIPELINE_WORKERS];             // The number of experiments each worker has done.
+} WorkloadBroadcast;
+
+// Function prototypes
+void run_pipelined_experiments(PipelineStrategy strategies[PIPELINE_WORKERS], Results* results[PIPELINE_WORKERS], int number_of_experiments, std::default_random_engine &gen, std::poisson_distribution<int> &poisson_dist, std::uniform_int_distribution<int> &uniform_dist, int first_experiment = 0, Checkpointer* checkpointer = nullptr);
\ No newline at end of file
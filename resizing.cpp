@@ -0,0 +1,326 @@
+/**************************************************************************************************
+ * File: resizing.cpp
+ * Author: Nolan Davenport
+ * Procedures:
+ *
+ * find_relocation_hole             - Finds the first hole a growing partition could move to.
+ *
+ * resize_dynamic_partition         - Grows or shrinks the data in a dynamic partition, moving it
+ *                                    if it has to.
+ *
+ * dynamic_resizing_partitioning    - Performs the dynamic partitioning experiment with data that
+ *                                    grows and shrinks while it runs.
+ *
+ * report_resize_stats              - Prints the resizing statistics.
+ *************************************************************************************************/
+
+#include<iostream>
+#include<random>
+#include<queue>
+#include<list>
+#include<vector>
+
+#include"main.h"
+#include"histogram.h"
+#include"dynamic.h"
+#include"metrics.h"
+#include"partition_pool.h"
+#include"resizing.h"
+
+using namespace std;
+
+/**************************************************************************************************
+ * bool find_relocation_hole(DynamicPartitionList &partitions,
+ *                           DynamicPartitionList::iterator self, int size,
+ *                           DynamicPartitionList::iterator &position, int &start)
+ *
+ * Author: Nolan Davenport
+ * Description: Finds the first hole that a partition growing to the given size could move to. The
+ *              memory the partition holds now counts as free, since it is released by the move.
+ *
+ * Parameters:
+ *  partitions              I/P     DynamicPartitionList (&)        The partitions in memory.
+ *  self                    I/P     DynamicPartitionList::iterator  The partition that is growing.
+ *  size                    I/P     int                             The size it grows to.
+ *  position                O/P     DynamicPartitionList::iterator (&)  The partition it goes before.
+ *  start                   O/P     int (&)                         Where it starts.
+ *  find_relocation_hole    O/P     bool                            False if no hole is large enough.
+ *************************************************************************************************/
+bool find_relocation_hole(DynamicPartitionList &partitions, DynamicPartitionList::iterator self, int size,
+                          DynamicPartitionList::iterator &position, int &start){
+    int hole_start = 0;                                             // Where the current hole starts.
+    for(auto it = partitions.begin(); it != partitions.end(); ++it){    // The hole before each partition.
+        if(it == self){                                             // Its own memory is part of the hole.
+            continue;
+        }
+        if(it->start_location - hole_start >= size){                // If the hole is large enough:
+            position = it;                                          // Go before this partition.
+            start = hole_start;
+            return true;
+        }
+        hole_start = it->start_location + it->size;                 // The next hole starts after it.
+    }
+    if(MEMORY_END+1 - hole_start >= size){                          // The hole at the end of memory.
+        position = partitions.end();
+        start = hole_start;
+        return true;
+    }
+    return false;
+}
+
+/**************************************************************************************************
+ * int resize_dynamic_partition(DynamicPartitionList &partitions,
+ *                              DynamicPartitionList::iterator self, int new_size,
+ *                              MemoryMetrics &metrics, ResizeStats* stats)
+ *
+ * Author: Nolan Davenport
+ * Description: Grows or shrinks the data in a dynamic partition. Shrinking and growing into the
+ *              hole right after it happen in place. Otherwise the data moves to the first hole
+ *              large enough, or if there is none but enough free memory in total, memory is
+ *              compacted with the data moved to the end. If there isn't enough free memory the
+ *              data keeps its size. The partition keeps its list node, so iterators to it stay
+ *              valid. Only the holes the resize touches are updated in the hole metrics.
+ *
+ * Parameters:
+ *  partitions                  I/O     DynamicPartitionList (&)        The partitions in memory.
+ *  self                        I/O     DynamicPartitionList::iterator  The partition to resize.
+ *  new_size                    I/P     int                             The size it needs.
+ *  metrics                     I/O     MemoryMetrics (&)               The memory metrics.
+ *  stats                       O/P     ResizeStats*                    The resizing statistics.
+ *  resize_dynamic_partition    O/P     int                             The MB of data moved.
+ *************************************************************************************************/
+int resize_dynamic_partition(DynamicPartitionList &partitions, DynamicPartitionList::iterator self, int new_size,
+                             MemoryMetrics &metrics, ResizeStats* stats){
+    int old_size = self->size;                                      // The size it has now.
+    int hole_start = (self == partitions.begin()) ? 0 :             // Where the hole before it starts
+        prev(self)->start_location + prev(self)->size;
+    int hole_end = (next(self) == partitions.end()) ?               // and the hole after it ends.
+        MEMORY_END+1 : next(self)->start_location;
+    int hole_after = hole_end - (self->start_location + old_size);  // The hole right after it.
+
+    if(new_size < old_size || self->start_location + new_size <= hole_end){   // Shrinking, or growing into
+        metrics_remove_hole(metrics, hole_after);                               // the hole after it, happens
+        metrics_add_hole(metrics, hole_end - (self->start_location + new_size));   // in place.
+        self->size = new_size;
+        if(new_size < old_size){
+            stats->shrinks++;
+        }else{
+            stats->grows++;
+            stats->in_place++;
+        }
+        return 0;
+    }
+
+    stats->grows++;
+    DynamicPartitionList::iterator position;                        // Where it moves to.
+    int start = 0;
+    if(find_relocation_hole(partitions, self, new_size, position, start)){  // Move it to the first hole
+        metrics_remove_hole(metrics, self->start_location - hole_start);    // large enough. The holes on
+        metrics_remove_hole(metrics, hole_after);                           // either side of where it was
+        metrics_add_hole(metrics, hole_end - hole_start);                   // merge into one.
+        int target_end = (position == partitions.end()) ?           // The hole it moves into, which
+            MEMORY_END+1 : position->start_location;                // may be that one.
+        metrics_remove_hole(metrics, target_end - start);           // It fills the start of the hole,
+        metrics_add_hole(metrics, target_end - start - new_size);   // leaving the rest.
+
+        partitions.splice(position, partitions, self);              // It keeps its node.
+        self->start_location = start;
+        self->size = new_size;
+        stats->relocations++;
+        stats->moved_mb += old_size;                                // Its data is copied over.
+        return old_size;
+    }
+
+    int used = 0;                                                   // The memory in use once it grows.
+    for(const DynamicPartition &p : partitions){
+        used += p.size;
+    }
+    if(used - old_size + new_size > MEMORY_END+1){                  // Not enough memory, so it stays
+        stats->denied++;                                            // the same size.
+        return 0;
+    }
+
+    partitions.splice(partitions.end(), partitions, self);          // It goes last, next to the hole
+    vector<int> starts_before;                                      // that compaction leaves. Remember
+    for(const DynamicPartition &p : partitions){                    // where everything was.
+        starts_before.push_back(p.start_location);
+    }
+    int free_space = compact(partitions);
+
+    int moved = 0;                                                  // Count the data compaction moved.
+    size_t i = 0;
+    for(const DynamicPartition &p : partitions){
+        if(p.start_location != starts_before[i++]){
+            moved += p.size;
+        }
+    }
+    self->size = new_size;                                          // Grow into the hole at the end,
+    metrics_reset_holes(metrics, free_space - (new_size - old_size));  // the only hole left.
+    stats->compactions++;
+    stats->moved_mb += moved;
+    return moved;
+}
+
+/**************************************************************************************************
+ * void dynamic_resizing_partitioning(Data data[NUMBER_OF_SAMPLES], int number_of_samples,
+ *                                    const ResizeConfig &config, Results* results,
+ *                                    ResizeStats* stats)
+ *
+ * Author: Nolan Davenport
+ * Description: Performs the dynamic partitioning experiment with data that grows and shrinks
+ *              while it runs. Data is placed with perform_first_fit_algorithm and resized with
+ *              resize_dynamic_partition after each quantum it runs without finishing. Moving data
+ *              stalls the processor. Each experiment draws its resizes from its own seed. With a
+ *              probability of zero it follows the same rules as dynamic_partitioning.
+ *
+ * Parameters:
+ *  data                I/P     Data[NUMBER_OF_SAMPLES]     The data to be used in this experiment.
+ *  number_of_samples   I/P     int                         The number of samples in this experiment.
+ *  config              I/P     const ResizeConfig (&)      The resizing settings.
+ *  results             O/P     Results*                    Pointer to the structure that holds the
+ *                                                          results of this experiment.
+ *  stats               O/P     ResizeStats*                The resizing statistics.
+ *************************************************************************************************/
+void dynamic_resizing_partitioning(Data data[NUMBER_OF_SAMPLES], int number_of_samples, const ResizeConfig &config,
+                                   Results* results, ResizeStats* stats){
+    Data experiment_data[NUMBER_OF_SAMPLES];        // The sizes change during the experiment, so copy
+    for(int i = 0; i < number_of_samples; i++){     // the data.
+        experiment_data[i] = data[i];
+    }
+
+    mt19937 gen(config.seed + stats->experiments);  // The resizes of this experiment.
+    uniform_real_distribution<float> chance(0, 1);  // Whether to resize, and which way.
+    uniform_int_distribution<int> step(1, max(1, config.max_step));     // How much to resize by.
+
+    reset_dynamic_partition_pool();                 // Start this experiment with a fresh pool of nodes.
+    DynamicPartitionList partitions(dynamic_partition_resource());      // Memory starts empty.
+
+    int next_data = 0;                              // The head of the queue.
+    int number_of_failures = 0;                     // Initialize the number of failures to zero.
+    int num_data_members_in_partition_table = 0;    // The number of data members in memory.
+    int clock = 0;                                  // Initialize the clock to zero.
+    float average_num_data_members_in_partition_table = 0;  // Cumulative value used for the average.
+    MemoryMetrics metrics;                          // The memory metrics for this experiment.
+    metrics_add_hole(metrics, MEMORY_END+1);        // Memory starts as a single hole.
+
+    // Stalls the processor while data is moved.
+    auto stall = [&](int mb){
+        int ticks = mb * config.ticks_per_mb;                   // The time the move takes.
+        stats->move_ticks += ticks;
+        for(int tick = 0; tick < ticks; tick++){                // Nothing runs while it happens.
+            clock++;
+            average_num_data_members_in_partition_table += num_data_members_in_partition_table;
+            metrics_tick(metrics, results);
+        }
+    };
+
+    perform_first_fit_algorithm(experiment_data, number_of_samples, partitions, next_data,
+        num_data_members_in_partition_table, clock, number_of_failures, metrics);   // Place the initial data.
+
+    DynamicPartitionList::iterator it = partitions.begin(); // Start at the lowest address.
+
+    for(;;){                                                // Clock loop.
+        int index = it->data_index;                         // The data the processor is on.
+        bool just_erased_a_partition = false;               // Whether the iterator has already moved on.
+
+        if(--experiment_data[index].left == 0){             // Work for one quantum. If the data is finished:
+            int turn_around_time = clock - experiment_data[index].time_start;  // Calculate the turnaround time.
+
+            results->turn_around_time += turn_around_time;          // Add it to the cumulative turnaround time.
+            results->relative_turn_around_time +=                   // Add the relative turnaround time too.
+                (float)turn_around_time / experiment_data[index].time;
+            record_completion(index, clock);                        // Record when it finished.
+            histogram_record(results->turn_around_histogram, turn_around_time);    // Record both for the percentiles.
+            record_relative_turn_around(results->relative_turn_around_histogram,
+                turn_around_time, experiment_data[index].time);
+
+            int hole_start = (it == partitions.begin()) ? 0 :      // The holes on either side of the
+                prev(it)->start_location + prev(it)->size;          // partition merge with it into a
+            int hole_end = (next(it) == partitions.end()) ?         // single hole.
+                MEMORY_END+1 : next(it)->start_location;
+            metrics_remove_hole(metrics, it->start_location - hole_start);
+            metrics_remove_hole(metrics, hole_end - (it->start_location + it->size));
+            metrics_add_hole(metrics, hole_end - hole_start);
+            metrics_release(metrics, min(it->size, MEMORY_END+1), it->size);    // The memory is no longer used.
+
+            it = partitions.erase(it);                      // Remove it and move on.
+            just_erased_a_partition = true;
+            num_data_members_in_partition_table--;          // One fewer data member in memory.
+
+            bool was_empty = partitions.empty();            // Whether memory was empty before placing more.
+            perform_first_fit_algorithm(experiment_data, number_of_samples, partitions, next_data,
+                num_data_members_in_partition_table, clock, number_of_failures, metrics);
+
+            if(num_data_members_in_partition_table == 0){   // If nothing is left anywhere:
+                break;                                      // The experiment is done.
+            }else if(was_empty){                            // If memory was empty, start from the beginning.
+                it = partitions.begin();
+            }
+        }else if(it->size <= MEMORY_END+1 && chance(gen) < config.probability){    // Data too large for memory
+            int new_size = it->size;                                                // never resizes.
+            if(chance(gen) < config.grow_share){            // Grow, but never past the size of memory,
+                new_size = min(new_size + step(gen), MEMORY_END+1);
+            }else{                                          // or shrink, but never to nothing.
+                new_size = max(new_size - step(gen), 1);
+            }
+            if(new_size != it->size){                       // If the size changes:
+                DynamicPartitionList::iterator resume = next(it);       // The processor moves on to the data
+                                                                        // after it, even if it moves.
+                int old_size = it->size;
+                metrics_release(metrics, old_size, old_size);           // It gives up its memory,
+                int moved = resize_dynamic_partition(partitions, it, new_size, metrics, stats);
+                metrics_admit(metrics, it->size, it->size);             // takes its new size,
+                experiment_data[index].size = it->size;                 // which placement uses from now on.
+                stall(moved);                                           // Wait for any data moved.
+                it = resume;
+                just_erased_a_partition = true;                         // The iterator has already moved on.
+            }
+        }
+
+        if(!just_erased_a_partition){                       // If nothing was erased, move on.
+            it++;
+        }
+
+        if(it == partitions.end()){                         // If the end of memory was reached:
+            it = partitions.begin();                        // Go back to the start.
+        }
+
+        clock++;                                            // Increment the clock.
+        average_num_data_members_in_partition_table +=      // Add to the cumulative average variable.
+            num_data_members_in_partition_table;
+        metrics_tick(metrics, results);                     // Add the memory metrics for this tick.
+    }
+
+    average_num_data_members_in_partition_table /= clock;   // Calculate the average for this experiment.
+
+    results->average_num_data_members_in_partition_table += // Add it to the cumulative variable.
+        average_num_data_members_in_partition_table;
+    results->number_of_failures += number_of_failures;      // Add the failures to the cumulative variable.
+    metrics_finish_experiment(metrics, results, clock);     // Add the memory metrics to the cumulative values.
+
+    stats->experiments++;                           // Add this experiment to the statistics.
+}
+
+/**************************************************************************************************
+ * void report_resize_stats(const ResizeStats &stats)
+ *
+ * Author: Nolan Davenport
+ * Description: Prints the resizing statistics of dynamic partitioning: how often data grew and
+ *              shrank per experiment, how the grows were satisfied, and the data moved for them.
+ *
+ * Parameters:
+ *  stats       I/P     const ResizeStats (&)   The resizing statistics.
+ *************************************************************************************************/
+void report_resize_stats(const ResizeStats &stats){
+    if(stats.experiments == 0){                     // Nothing to report.
+        return;
+    }
+    double experiments = stats.experiments;         // Averages are per experiment.
+    cout << "dynamic average grows: " << stats.grows / experiments << " shrinks: " <<
+        stats.shrinks / experiments << endl;
+    cout << "dynamic average grows in place: " << stats.in_place / experiments << " relocated: " <<
+        stats.relocations / experiments << " compacted: " << stats.compactions / experiments <<
+        " denied: " << stats.denied / experiments << endl;
+    cout << "dynamic average data moved: " << stats.moved_mb / experiments << " MB, " <<
+        stats.move_ticks / experiments << " ticks" << endl;
+}
\ No newline at end of file
@@ -0,0 +1,58 @@
+/**************************************************************************************************
+ * File: resizing.h
+ * Author: Nolan Davenport
+ * Procedures:
+ *
+ * find_relocation_hole             - Finds the first hole a growing partition could move to.
+ *
+ * resize_dynamic_partition         - Grows or shrinks the data in a dynamic partition, moving it
+ *                                    if it has to.
+ *
+ * dynamic_resizing_partitioning    - Performs the dynamic partitioning experiment with data that
+ *                                    grows and shrinks while it runs.
+ *
+ * report_resize_stats              - Prints the resizing statistics.
+ *************************************************************************************************/
+
+#pragma once
+
+#include<iostream>
+#include<random>
+#include<queue>
+#include<list>
+
+#include"main.h"
+#include"metrics.h"
+#include"partition_pool.h"
+
+using namespace std;
+
+// Structure that holds the settings of the resizing model. Each quantum a data member runs
+// without finishing, it resizes with the given probability, growing or shrinking by up to
+// max_step MB. Moving data to make room for it stalls the processor for ticks_per_mb ticks per MB.
+typedef struct {
+    float probability = 0.1;        // The chance of resizing each quantum.
+    float grow_share = 0.6;         // The share of resizes that grow.
+    int max_step = 4;               // The most MB one resize changes.
+    int ticks_per_mb = 1;           // The cost of moving one MB of data.
+    unsigned seed = 1;              // Seeds the resizes of the first experiment.
+} ResizeConfig;
+
+// Structure that holds the cumulative resizing statistics.
+typedef struct {
+    long long experiments = 0;      // The number of experiments.
+    long long grows = 0;            // The resizes that grew data.
+    long long shrinks = 0;          // The resizes that shrank data.
+    long long in_place = 0;         // The grows into the hole right after the data.
+    long long relocations = 0;      // The grows that moved the data to another hole.
+    long long compactions = 0;      // The grows that compacted memory.
+    long long denied = 0;           // The grows without enough free memory.
+    long long moved_mb = 0;         // The MB moved by relocation and compaction.
+    long long move_ticks = 0;       // The ticks the processor stalled for moving data.
+} ResizeStats;
+
+// Function prototypes
+bool find_relocation_hole(DynamicPartitionList &partitions, DynamicPartitionList::iterator self, int size, DynamicPartitionList::iterator &position, int &start);
+int resize_dynamic_partition(DynamicPartitionList &partitions, DynamicPartitionList::iterator self, int new_size, MemoryMetrics &metrics, ResizeStats* stats);
+void dynamic_resizing_partitioning(Data data[NUMBER_OF_SAMPLES], int number_of_samples, const ResizeConfig &config, Results* results, ResizeStats* stats);
+void report_resize_stats(const ResizeStats &stats);
\ No newline at end of file
@@ -0,0 +1,534 @@
+/**************************************************************************************************
+ * File: scenario.cpp
+ * Author: Nolan Davenport
+ * Procedures:
+ *
+ * parse_scenario_strategy      - Gets the partitioning style a scenario file names.
+ *
+ * parse_scenario_setting       - Applies one "key = value" line of a scenario file.
+ *
+ * load_scenarios               - Reads every scenario in a scenario file.
+ *
+ * scenario_workload_key        - Describes the workloads of a scenario, so scenarios that would
+ *                                draw the same workloads share them.
+ *
+ * make_scenario_workloads      - Draws or reads the workloads of a scenario.
+ *
+ * run_scenario_style           - Runs one partitioning style of a scenario on its workloads.
+ *
+ * report_scenario              - Prints the results of a scenario in the form main uses.
+ *
+ * run_scenarios                - Runs every scenario in a scenario file as one batch.
+ *************************************************************************************************/
+
+#include<iostream>
+#include<fstream>
+#include<sstream>
+#include<random>
+#include<queue>
+#include<list>
+#include<vector>
+#include<map>
+#include<string>
+#include<thread>
+#include<atomic>
+#include<ctime>
+#include<algorithm>
+
+#include"main.h"
+#include"metrics.h"
+#include"histogram.h"
+#include"scheduling.h"
+#include"static_layouts.h"
+#include"bitmap_memory.h"
+#include"optimizer.h"
+#include"scenario.h"
+
+using namespace std;
+
+// The names of the styles in scenario files, and in reports as main prints them.
+static const char* const scenario_strategy_names[SCENARIO_STRATEGIES] = {"equal", "one_queue", "multiple_queues", "dynamic"};
+static const char* const scenario_report_names[SCENARIO_STRATEGIES] = {"equal", "one_queue", "multiple_queue", "dynamic"};
+
+/**************************************************************************************************
+ * static bool parse_scenario_number(const string &text, long long &number)
+ *
+ * Author: Nolan Davenport
+ * Description: Reads a whole number that makes up all of a setting.
+ *
+ * Parameters:
+ *  text                    I/P     const string (&)    The setting.
+ *  number                  O/P     long long (&)       The number.
+ *  parse_scenario_number   O/P     bool                False if it isn't just a number.
+ *************************************************************************************************/
+static bool parse_scenario_number(const string &text, long long &number){
+    istringstream stream(text);
+    char extra;
+    return (stream >> number) && !(stream >> extra);
+}
+
+/**************************************************************************************************
+ * bool parse_scenario_strategy(const string &name, int &strategy)
+ *
+ * Author: Nolan Davenport
+ * Description: Gets the partitioning style a scenario file names.
+ *
+ * Parameters:
+ *  name                        I/P     const string (&)    The name in the file.
+ *  strategy                    O/P     int (&)             The style.
+ *  parse_scenario_strategy     O/P     bool                False if the name is unknown.
+ *************************************************************************************************/
+bool parse_scenario_strategy(const string &name, int &strategy){
+    for(strategy = 0; strategy < SCENARIO_STRATEGIES; strategy++){
+        if(name == scenario_strategy_names[strategy] || name == scenario_report_names[strategy]){
+            return true;
+        }
+    }
+    return false;
+}
+
+/**************************************************************************************************
+ * bool parse_scenario_setting(Scenario &scenario, const string &key, const string &value,
+ *                             string &error)
+ *
+ * Author: Nolan Davenport
+ * Description: Applies one "key = value" line of a scenario file.
+ *
+ * Parameters:
+ *  scenario                I/O     Scenario (&)        The scenario, or the defaults of the file.
+ *  key                     I/P     const string (&)    The setting.
+ *  value                   I/P     const string (&)    Its value.
+ *  error                   O/P     string (&)          What is wrong with the line, if anything.
+ *  parse_scenario_setting  O/P     bool                False if the line is wrong.
+ *************************************************************************************************/
+bool parse_scenario_setting(Scenario &scenario, const string &key, const string &value, string &error){
+    long long number = 0;
+    if(key == "strategies"){                                        // A list of styles.
+        istringstream names(value);
+        string name;
+        bool chosen[SCENARIO_STRATEGIES] = {};
+        int count = 0;
+        while(names >> name){
+            int strategy;
+            if(!parse_scenario_strategy(name, strategy)){
+                error = "unknown strategy " + name;
+                return false;
+            }
+            chosen[strategy] = true;
+            count++;
+        }
+        if(count == 0){
+            error = "strategies needs at least one strategy";
+            return false;
+        }
+        copy(chosen, chosen + SCENARIO_STRATEGIES, scenario.strategies);
+    }else if(key == "equal_layout"){                                // A size and a count.
+        istringstream fields(value);
+        char extra;
+        if(!(fields >> scenario.equal_size >> scenario.equal_count) || (fields >> extra) ||
+            scenario.equal_size <= 0 || scenario.equal_count <= 0){
+            error = "equal_layout needs a positive size and count";
+            return false;
+        }
+    }else if(key == "unequal_layout"){                              // A list of sizes.
+        istringstream fields(value);
+        vector<int> sizes;
+        int size;
+        while(fields >> size){
+            sizes.push_back(size);
+        }
+        if(!fields.eof() || sizes.empty() || *min_element(sizes.begin(), sizes.end()) <= 0){
+            error = "unequal_layout needs positive partition sizes";
+            return false;
+        }
+        scenario.unequal_sizes = sizes;
+    }else if(key == "trace" || key == "output" || key == "utilization"){   // File names.
+        if(value.empty()){
+            error = key + " needs a file name";
+            return false;
+        }
+        (key == "trace" ? scenario.trace_file : key == "output" ? scenario.output : scenario.utilization_file) = value;
+    }else if(key == "size_mean"){                                   // A real number.
+        istringstream stream(value);
+        char extra;
+        if(!(stream >> scenario.size_mean) || (stream >> extra) || scenario.size_mean <= 0){
+            error = "size_mean needs a positive mean";
+            return false;
+        }
+    }else if(!parse_scenario_number(value, number)){                // The rest are whole numbers.
+        error = key + " needs a whole number";
+        return false;
+    }else if(key == "seed" && number >= 0){
+        scenario.seed = number;
+    }else if(key == "memory" && number > 0 && number <= 1 << 20){
+        scenario.memory_units = number;
+    }else if(key == "experiments" && number > 0 && number <= 1 << 24){
+        scenario.experiments = number;
+    }else if(key == "samples" && number > 0 && number <= NUMBER_OF_SAMPLES){
+        scenario.samples = number;
+    }else if(key == "time_min" && number > 0 && number <= 1 << 20){
+        scenario.time_min = number;
+    }else if(key == "time_max" && number > 0 && number <= 1 << 20){
+        scenario.time_max = number;
+    }else if(key == "seed" || key == "memory" || key == "experiments" || key == "samples" ||
+        key == "time_min" || key == "time_max"){
+        error = key + " is out of range";
+        return false;
+    }else{
+        error = "unknown setting " + key;
+        return false;
+    }
+    return true;
+}
+
+/**************************************************************************************************
+ * bool load_scenarios(const char* file_name, vector<Scenario> &scenarios, int &threads,
+ *                     string &error)
+ *
+ * Author: Nolan Davenport
+ * Description: Reads every scenario in a scenario file, in order. Settings before the first
+ *              scenario are copied into each one before its own settings.
+ *
+ * Parameters:
+ *  file_name       I/P     const char*             The scenario file.
+ *  scenarios       O/P     vector<Scenario> (&)    The scenarios.
+ *  threads         O/P     int (&)                 The worker threads asked for, or zero.
+ *  error           O/P     string (&)              What is wrong with the file, if anything.
+ *  load_scenarios  O/P     bool                    False if the file can't be read or is wrong.
+ *************************************************************************************************/
+bool load_scenarios(const char* file_name, vector<Scenario> &scenarios, int &threads, string &error){
+    ifstream file(file_name);
+    if(!file){
+        error = string("can't read ") + file_name;
+        return false;
+    }
+
+    auto trim = [](const string &text){                             // Drop the spaces around text.
+        size_t first = text.find_first_not_of(" \t\r");
+        size_t last = text.find_last_not_of(" \t\r");
+        return (first == string::npos) ? string() : text.substr(first, last - first + 1);
+    };
+
+    Scenario defaults;                                              // The settings every scenario starts with.
+    scenarios.clear();
+    threads = 0;
+    string line;
+    for(int line_number = 1; getline(file, line); line_number++){  // Read each line.
+        line = trim(line);
+        string where = string(file_name) + ":" + to_string(line_number) + ": ";
+        if(line.empty() || line[0] == '#'){                         // Skip blank lines and comments.
+            continue;
+        }
+
+        if(line[0] == '['){                                         // A new scenario.
+            if(line.back() != ']' || trim(line.substr(1, line.size() - 2)).empty()){
+                error = where + "a scenario needs a name in brackets";
+                return false;
+            }
+            scenarios.push_back(defaults);
+            scenarios.back().name = trim(line.substr(1, line.size() - 2));
+            scenarios.back().line = line_number;
+            continue;
+        }
+
+        size_t equals = line.find('=');                             // A setting.
+        if(equals == string::npos){
+            error = where + "expected \"key = value\"";
+            return false;
+        }
+        string key = trim(line.substr(0, equals));
+        string value = trim(line.substr(equals + 1));
+        if(key == "threads"){                                       // The batch shares one pool.
+            long long number;
+            if(!scenarios.empty() || !parse_scenario_number(value, number) || number <= 0 || number > 1024){
+                error = where + "threads needs a positive number before the first scenario";
+                return false;
+            }
+            threads = number;
+            continue;
+        }
+        string problem;
+        if(!parse_scenario_setting(scenarios.empty() ? defaults : scenarios.back(), key, value, problem)){
+            error = where + problem;
+            return false;
+        }
+    }
+
+    if(scenarios.empty()){
+        error = string(file_name) + ": no scenarios";
+        return false;
+    }
+    for(const Scenario &scenario : scenarios){                      // Check what spans several lines.
+        if(scenario.time_min > scenario.time_max){
+            error = string(file_name) + ":" + to_string(scenario.line) + ": time_min is above time_max";
+            return false;
+        }
+    }
+    return true;
+}
+
+/**************************************************************************************************
+ * string scenario_workload_key(const Scenario &scenario)
+ *
+ * Author: Nolan Davenport
+ * Description: Describes the workloads of a scenario. Scenarios with the same description draw
+ *              the same workloads, so they are made once and shared.
+ *
+ * Parameters:
+ *  scenario                I/P     const Scenario (&)  The scenario, with its seed set.
+ *  scenario_workload_key   O/P     string              The description.
+ *************************************************************************************************/
+string scenario_workload_key(const Scenario &scenario){
+    ostringstream key;
+    key.precision(17);
+    if(!scenario.trace_file.empty()){
+        key << "trace " << scenario.trace_file;
+    }else{
+        key << "seed " << scenario.seed << " size " << scenario.size_mean << " time " << scenario.time_min <<
+            " " << scenario.time_max << " samples " << scenario.samples;
+    }
+    return key.str();
+}
+
+/**************************************************************************************************
+ * bool make_scenario_workloads(const Scenario &scenario, int experiments,
+ *                              vector<vector<Data>> &workloads)
+ *
+ * Author: Nolan Davenport
+ * Description: Draws or reads the workloads of a scenario. Drawn workloads come from the
+ *              distributions in the same order generate_experiment_data uses, so the default
+ *              distributions with NUMBER_OF_SAMPLES samples give the workloads main would with
+ *              the same seed. A trace gives all of its workloads.
+ *
+ * Parameters:
+ *  scenario                I/P     const Scenario (&)          The scenario, with its seed set.
+ *  experiments             I/P     int                         The workloads to draw.
+ *  workloads               O/P     vector<vector<Data>> (&)    The workloads.
+ *  make_scenario_workloads O/P     bool                        False if the trace can't be read.
+ *************************************************************************************************/
+bool make_scenario_workloads(const Scenario &scenario, int experiments, vector<vector<Data>> &workloads){
+    if(!scenario.trace_file.empty()){
+        return load_trace_workloads(scenario.trace_file.c_str(), workloads);
+    }
+
+    default_random_engine gen;                                      // The same generator main uses.
+    gen.seed(scenario.seed);
+    poisson_distribution<int> poisson_dist(scenario.size_mean);
+    uniform_int_distribution<int> uniform_dist(scenario.time_min, scenario.time_max);
+    workloads.assign(experiments, vector<Data>(scenario.samples));
+    for(vector<Data> &workload : workloads){
+        for(int sample = 0; sample < scenario.samples; sample++){
+            workload[sample].size = max(1, poisson_dist(gen));
+            workload[sample].time = uniform_dist(gen);
+            workload[sample].index = sample;
+            workload[sample].left = workload[sample].time;
+        }
+    }
+    return true;
+}
+
+/**************************************************************************************************
+ * void run_scenario_style(const Scenario &scenario, int strategy, int experiments,
+ *                         const vector<vector<Data>> &workloads, Results* results)
+ *
+ * Author: Nolan Davenport
+ * Description: Runs one partitioning style of a scenario on the first experiments of its
+ *              workloads. The static styles run on the generic engines and the dynamic style on
+ *              the bitmap memory, which give the same results as the reference experiments
+ *              without writing to the workloads, so other styles can read them at the same time.
+ *
+ * Parameters:
+ *  scenario    I/P     const Scenario (&)                  The scenario.
+ *  strategy    I/P     int                                 The style.
+ *  experiments I/P     int                                 The experiments to run.
+ *  workloads   I/P     const vector<vector<Data>> (&)      The workloads.
+ *  results     O/P     Results*                            The results of the style.
+ *************************************************************************************************/
+void run_scenario_style(const Scenario &scenario, int strategy, int experiments,
+                        const vector<vector<Data>> &workloads, Results* results){
+    for(int experiment = 0; experiment < experiments; experiment++){   // The engines copy the time left.
+        Data* data = const_cast<Data*>(workloads[experiment].data());
+        int number_of_samples = workloads[experiment].size();
+        if(strategy == SCENARIO_EQUAL){
+            equal_partitioning_generic(data, number_of_samples, scenario.equal_size, scenario.equal_count, results);
+        }else if(strategy == SCENARIO_ONE_QUEUE){
+            one_queue_partitioning_generic(data, number_of_samples, scenario.unequal_sizes.data(),
+                scenario.unequal_sizes.size(), results);
+        }else if(strategy == SCENARIO_MULTIPLE_QUEUES){
+            multiple_queues_partitioning_generic(data, number_of_samples, scenario.unequal_sizes.data(),
+                scenario.unequal_sizes.size(), results);
+        }else{
+            dynamic_bitmap_partitioning(data, number_of_samples, results, scenario.memory_units, 1);
+        }
+    }
+}
+
+/**************************************************************************************************
+ * void report_scenario(const Scenario &scenario, int experiments, long long jobs,
+ *                      Results* const results[SCENARIO_STRATEGIES], ostream &out)
+ *
+ * Author: Nolan Davenport
+ * Description: Prints the results of the styles a scenario ran, in the form report_results
+ *              uses. The generic engines don't measure memory, so only the dynamic style
+ *              reports it. The cumulative values are turned into averages in place.
+ *
+ * Parameters:
+ *  scenario        I/P     const Scenario (&)                  The scenario.
+ *  experiments     I/P     int                                 The experiments it ran.
+ *  jobs            I/P     long long                           The data items in them.
+ *  results         I/O     Results* const[SCENARIO_STRATEGIES] The results of each style it ran.
+ *  out             I/O     ostream (&)                         Where the report goes.
+ *************************************************************************************************/
+void report_scenario(const Scenario &scenario, int experiments, long long jobs,
+                     Results* const results[SCENARIO_STRATEGIES], ostream &out){
+    out << "scenario " << scenario.name << ": " << experiments << " experiments, " << jobs << " data items, ";
+    if(scenario.trace_file.empty()){
+        out << "seed " << scenario.seed << endl;
+    }else{
+        out << "trace " << scenario.trace_file << endl;
+    }
+    out << endl;
+
+    for(int strategy = 0; strategy < SCENARIO_STRATEGIES; strategy++){
+        if(!scenario.strategies[strategy]){
+            continue;
+        }
+        Results* style = results[strategy];
+        const char* name = scenario_report_names[strategy];
+        style->number_of_failures /= experiments;                   // Average as report_results does.
+        style->turn_around_time /= jobs;
+        style->relative_turn_around_time /= jobs;
+        style->average_num_data_members_in_partition_table /= experiments;
+        style->average_memory_utilization /= experiments;
+        style->average_internal_fragmentation /= experiments;
+
+        out << name << " average number_of_failures: " << style->number_of_failures << endl;
+        out << name << " average turn_around_time: " << style->turn_around_time << endl;
+        out << name << " average relative_turn_around_time: " << style->relative_turn_around_time << endl;
+        out << name << " average number of data members in " <<
+            (strategy == SCENARIO_DYNAMIC ? "DynamicPartition list: " : "StaticPartition table: ") <<
+            style->average_num_data_members_in_partition_table << endl;
+        if(strategy == SCENARIO_DYNAMIC){
+            out << name << " average memory utilization: " << style->average_memory_utilization << endl;
+            out << name << " average internal fragmentation: " << style->average_internal_fragmentation << endl;
+        }
+        report_percentiles(name, style, out);
+        out << endl;
+    }
+
+    if(scenario.strategies[SCENARIO_DYNAMIC] && !scenario.utilization_file.empty()){
+        write_time_series(&results[SCENARIO_DYNAMIC]->memory_utilization_over_time, scenario.utilization_file.c_str());
+    }
+}
+
+/**************************************************************************************************
+ * int run_scenarios(const char* file_name)
+ *
+ * Author: Nolan Davenport
+ * Description: Runs every scenario in a scenario file as one batch. Scenarios that would draw
+ *              the same workloads share one copy of them. Each style of each scenario is a task,
+ *              and a pool of worker threads takes the tasks in turn, so styles no scenario asks
+ *              for never run. The workloads of each scenario are looked up before the workers
+ *              start, so the workers only read them. Each task adds its experiments in order, so
+ *              the results don't depend on the number of threads. The reports come out in file order once every
+ *              task is done.
+ *
+ * Parameters:
+ *  file_name       I/P     const char*     The scenario file.
+ *  run_scenarios   O/P     int             Status code, 1 if the file or a trace couldn't be used.
+ *************************************************************************************************/
+int run_scenarios(const char* file_name){
+    vector<Scenario> scenarios;
+    int threads;
+    string error;
+    if(!load_scenarios(file_name, scenarios, threads, error)){
+        cerr << error << endl;
+        return 1;
+    }
+
+    long long file_seed = time(nullptr);                            // Scenarios without a seed share one.
+    map<string, vector<vector<Data>>> workloads;                    // The workloads, shared by key.
+    map<string, int> needed;                                        // The experiments each key needs.
+    vector<string> keys(scenarios.size());
+    for(size_t i = 0; i < scenarios.size(); i++){
+        if(scenarios[i].seed < 0){
+            scenarios[i].seed = file_seed;
+        }
+        keys[i] = scenario_workload_key(scenarios[i]);
+        int experiments = (scenarios[i].experiments > 0) ? scenarios[i].experiments : NUMBER_OF_EXPERIMENTS;
+        needed[keys[i]] = max(needed[keys[i]], experiments);
+    }
+    for(size_t i = 0; i < scenarios.size(); i++){                   // Make each set of workloads once.
+        if(workloads.count(keys[i]) == 0 &&
+            !make_scenario_workloads(scenarios[i], needed[keys[i]], workloads[keys[i]])){
+            cerr << file_name << ":" << scenarios[i].line << ": can't read trace " << scenarios[i].trace_file << endl;
+            return 1;
+        }
+    }
+
+    vector<int> experiments(scenarios.size());                      // What each scenario runs.
+    vector<long long> jobs(scenarios.size());
+    vector<const vector<vector<Data>>*> shared(scenarios.size());  // The workloads of each scenario, found
+    vector<Results*> results(scenarios.size() * SCENARIO_STRATEGIES, nullptr);  // before the workers start.
+    vector<pair<int, int>> tasks;                                   // Each style of each scenario.
+    for(size_t i = 0; i < scenarios.size(); i++){
+        shared[i] = &workloads.at(keys[i]);
+        experiments[i] = (scenarios[i].experiments > 0) ? min<size_t>(scenarios[i].experiments, shared[i]->size()) :
+            scenarios[i].trace_file.empty() ? NUMBER_OF_EXPERIMENTS : shared[i]->size();
+        for(int experiment = 0; experiment < experiments[i]; experiment++){
+            jobs[i] += (*shared[i])[experiment].size();
+        }
+        for(int strategy = 0; strategy < SCENARIO_STRATEGIES; strategy++){
+            if(scenarios[i].strategies[strategy]){
+                results[i * SCENARIO_STRATEGIES + strategy] = new Results();
+                tasks.push_back({i, strategy});
+            }
+        }
+    }
+
+    if(threads == 0){                                               // One worker per core by default.
+        threads = max(1u, thread::hardware_concurrency());
+    }
+    threads = min<int>(threads, tasks.size());
+    atomic<int> next_task(0);                                       // The next task nobody has taken.
+    auto worker = [&](){
+        for(int task = next_task++; task < (int)tasks.size(); task = next_task++){
+            int i = tasks[task].first;
+            int strategy = tasks[task].second;
+            run_scenario_style(scenarios[i], strategy, experiments[i], *shared[i],
+                results[i * SCENARIO_STRATEGIES + strategy]);
+        }
+    };
+    vector<thread> pool;
+    for(int t = 1; t < threads; t++){                               // This thread is a worker too.
+        pool.push_back(thread(worker));
+    }
+    worker();
+    for(thread &t : pool){
+        t.join();
+    }
+
+    map<string, ofstream> files;                                    // The report files, opened once.
+    int status = 0;
+    for(size_t i = 0; i < scenarios.size(); i++){                   // Report in file order.
+        ostream* out = &cout;
+        if(!scenarios[i].output.empty()){
+            ofstream &file = files[scenarios[i].output];
+            if(!file.is_open()){
+                file.open(scenarios[i].output);
+            }
+            if(!file){
+                cerr << file_name << ":" << scenarios[i].line << ": can't write " << scenarios[i].output << endl;
+                status = 1;
+                continue;
+            }
+            out = &file;
+        }
+        report_scenario(scenarios[i], experiments[i], jobs[i], &results[i * SCENARIO_STRATEGIES], *out);
+    }
+
+    for(Results* style : results){
+        delete style;
+    }
+    return status;
+}
\ No newline at end of file
@@ -0,0 +1,96 @@
+/**************************************************************************************************
+ * File: scenario.h
+ * Author: Nolan Davenport
+ * Procedures:
+ *
+ * parse_scenario_strategy      - Gets the partitioning style a scenario file names.
+ *
+ * parse_scenario_setting       - Applies one "key = value" line of a scenario file.
+ *
+ * load_scenarios               - Reads every scenario in a scenario file.
+ *
+ * scenario_workload_key        - Describes the workloads of a scenario, so scenarios that would
+ *                                draw the same workloads share them.
+ *
+ * make_scenario_workloads      - Draws or reads the workloads of a scenario.
+ *
+ * run_scenario_style           - Runs one partitioning style of a scenario on its workloads.
+ *
+ * report_scenario              - Prints the results of a scenario in the form main uses.
+ *
+ * run_scenarios                - Runs every scenario in a scenario file as one batch.
+ *
+ * A scenario file describes runs without rebuilding the program. Blank lines and lines starting
+ * with # are skipped. A line "[name]" starts a scenario, and "key = value" lines set it up.
+ * Settings before the first scenario are the defaults of every scenario in the file.
+ *
+ *  strategies = <equal one_queue multiple_queues dynamic>  The styles to run, all by default.
+ *  equal_layout = <size> <count>               The equal partitions, 7 of 8 MB by default.
+ *  unequal_layout = <size> ...                 The unequal partitions of both queue styles,
+ *                                              2 4 6 8 8 12 16 by default.
+ *  memory = <MB>                               The memory of the dynamic style, 56 by default.
+ *  experiments = <count>                       The experiments, 1000 or the whole trace by default.
+ *  samples = <count>                           The data items in each experiment, up to 1000.
+ *  seed = <number>                             Seeds the workloads, one time based seed per file
+ *                                              by default.
+ *  size_mean = <MB>                            The mean of the Poisson data size, 8 by default.
+ *  time_min = <quanta>, time_max = <quanta>    The range of the uniform data time, 1 to 10.
+ *  trace = <file>                              Read the workloads from a trace instead.
+ *  output = <file>                             Where the report goes, the screen by default.
+ *                                              Scenarios with the same file share it, in order.
+ *  utilization = <file>                        Write the dynamic memory utilization over time.
+ *  threads = <count>                           The worker threads, one per core by default. Only
+ *                                              before the first scenario.
+ *************************************************************************************************/
+
+#pragma once
+
+#include<iostream>
+#include<random>
+#include<queue>
+#include<list>
+#include<vector>
+#include<string>
+
+#include"main.h"
+
+using namespace std;
+
+// The partitioning styles a scenario can run, in the order they are reported.
+typedef enum {
+    SCENARIO_EQUAL,                 // Equal static partitions.
+    SCENARIO_ONE_QUEUE,             // Unequal static partitions filled from a single queue.
+    SCENARIO_MULTIPLE_QUEUES,       // Unequal static partitions with a queue each.
+    SCENARIO_DYNAMIC,               // Dynamic partitions placed with first fit.
+    SCENARIO_STRATEGIES             // The number of styles.
+} ScenarioStrategy;
+
+// Structure that holds one scenario of a scenario file.
+typedef struct {
+    string name;                                        // The name in the file.
+    int line = 0;                                       // The line it starts on.
+    bool strategies[SCENARIO_STRATEGIES] = {true, true, true, true};   // The styles to run.
+    int equal_size = 8;                                 // The size of each equal partition in MB.
+    int equal_count = 7;                                // The number of equal partitions.
+    vector<int> unequal_sizes = {2, 4, 6, 8, 8, 12, 16};    // The unequal partitions in MB.
+    int memory_units = MEMORY_END + 1;                  // The memory of the dynamic style in MB.
+    int experiments = 0;                                // The experiments, or zero for the default.
+    int samples = NUMBER_OF_SAMPLES;                    // The data items in each experiment.
+    long long seed = -1;                                // Seeds the workloads, or -1 for the file's.
+    double size_mean = 8;                               // The mean of the data size.
+    int time_min = 1;                                   // The range of the data time.
+    int time_max = 10;
+    string trace_file;                                  // The trace to read, if any.
+    string output;                                      // The report file, or empty for the screen.
+    string utilization_file;                            // The utilization file, if any.
+} Scenario;
+
+// Function prototypes
+bool parse_scenario_strategy(const string &name, int &strategy);
+bool parse_scenario_setting(Scenario &scenario, const string &key, const string &value, string &error);
+bool load_scenarios(const char* file_name, vector<Scenario> &scenarios, int &threads, string &error);
+string scenario_workload_key(const Scenario &scenario);
+bool make_scenario_workloads(const Scenario &scenario, int experiments, vector<vector<Data>> &workloads);
+void run_scenario_style(const Scenario &scenario, int strategy, int experiments, const vector<vector<Data>> &workloads, Results* results);
+void report_scenario(const Scenario &scenario, int experiments, long long jobs, Results* const results[SCENARIO_STRATEGIES], ostream &out);
+int run_scenarios(const char* file_name);
\ No newline at end of file
@@ -0,0 +1,397 @@
+/**************************************************************************************************
+ * File: scheduling.cpp
+ * Author: Nolan Davenport
+ * Procedures:
+ *
+ * parse_scheduling_policy          - Reads a scheduling policy from its name.
+ *
+ * ready_set_init                   - Sets up an empty ready set for a partition table.
+ *
+ * ready_set_add                    - Makes a partition ready to run.
+ *
+ * ready_set_select                 - Takes the partition that runs next out of the ready set.
+ *
+ * ready_set_slice                  - Finds how long the selected partition runs for.
+ *
+ * ready_set_requeue                - Puts a partition whose slice ended back in the ready set.
+ *
+ * scheduled_static_partitioning    - Performs a static partitioning experiment with a pluggable
+ *                                    CPU scheduling policy.
+ *************************************************************************************************/
+
+#include<iostream>
+#include<random>
+#include<queue>
+#include<list>
+#include<vector>
+#include<string>
+#include<algorithm>
+#include<functional>
+
+#include"main.h"
+#include"histogram.h"
+#include"metrics.h"
+#include"static_layouts.h"
+#include"scheduling.h"
+
+using namespace std;
+
+/**************************************************************************************************
+ * bool parse_scheduling_policy(const string &name, SchedulingPolicy &policy)
+ *
+ * Author: Nolan Davenport
+ * Description: Reads a scheduling policy from its name on the command line: rr, srtf or mlfq.
+ *
+ * Parameters:
+ *  name                        I/P     const string (&)        The name of the policy.
+ *  policy                      O/P     SchedulingPolicy (&)    The policy.
+ *  parse_scheduling_policy     O/P     bool                    False if the name is unknown.
+ *************************************************************************************************/
+bool parse_scheduling_policy(const string &name, SchedulingPolicy &policy){
+    if(name == "rr"){                               // Round robin.
+        policy = ROUND_ROBIN;
+    }else if(name == "srtf"){                       // Shortest remaining time first.
+        policy = SHORTEST_REMAINING_TIME;
+    }else if(name == "mlfq"){                       // Multilevel feedback.
+        policy = MULTILEVEL_FEEDBACK;
+    }else{                                          // Anything else is a mistake.
+        return false;
+    }
+    return true;
+}
+
+/**************************************************************************************************
+ * void ready_set_init(ReadySet &ready, const SchedulingConfig &config, int partition_count)
+ *
+ * Author: Nolan Davenport
+ * Description: Sets up an empty ready set for a partition table. Round robin keeps a bitmap of
+ *              the ready partitions so the next one is found a word at a time, shortest
+ *              remaining time keeps a binary heap and multilevel feedback keeps a queue per level
+ *              with a mask of the levels that are not empty.
+ *
+ * Parameters:
+ *  ready               O/P     ReadySet (&)                The ready set.
+ *  config              I/P     const SchedulingConfig (&)  The policy and its settings.
+ *  partition_count     I/P     int                         The number of partitions.
+ *************************************************************************************************/
+void ready_set_init(ReadySet &ready, const SchedulingConfig &config, int partition_count){
+    ready.config = config;                                      // Keep the settings.
+    ready.config.quantum = max(1, config.quantum);              // A quantum is at least one tick.
+    ready.config.levels = min(max(1, config.levels), MLFQ_MAX_LEVELS);  // Keep the levels in range.
+    ready.ready_count = 0;                                      // Nothing is ready yet.
+
+    switch(ready.config.policy){
+        case ROUND_ROBIN:
+            ready.ready_bits.assign((partition_count + 63) / 64, 0);    // One bit per partition.
+            ready.cursor = 0;                                           // Start with the first partition.
+            break;
+        case SHORTEST_REMAINING_TIME:
+            ready.heap.clear();                                         // The heap starts empty.
+            ready.heap.reserve(partition_count);                        // It never holds more than every partition.
+            break;
+        case MULTILEVEL_FEEDBACK:
+            ready.levels.assign(ready.config.levels, queue<int>());     // One queue per level.
+            ready.busy_levels = 0;                                      // Every level is empty.
+            ready.level_of.assign(partition_count, 0);                  // Everything starts on the top level.
+            break;
+    }
+}
+
+/**************************************************************************************************
+ * void ready_set_add(ReadySet &ready, int partition, int left)
+ *
+ * Author: Nolan Davenport
+ * Description: Makes a partition that was just given new data ready to run. With multilevel
+ *              feedback new data starts on the top level.
+ *
+ * Parameters:
+ *  ready       I/O     ReadySet (&)    The ready set.
+ *  partition   I/P     int             The partition.
+ *  left        I/P     int             The time its data has left.
+ *************************************************************************************************/
+void ready_set_add(ReadySet &ready, int partition, int left){
+    switch(ready.config.policy){
+        case ROUND_ROBIN:
+            ready.ready_bits[partition >> 6] |= 1ULL << (partition & 63);  // Set its bit.
+            break;
+        case SHORTEST_REMAINING_TIME:
+            ready.heap.push_back({left, partition});                    // Add it to the heap.
+            push_heap(ready.heap.begin(), ready.heap.end(), greater<pair<int, int>>());
+            break;
+        case MULTILEVEL_FEEDBACK:
+            ready.level_of[partition] = 0;                              // New data starts on the top level.
+            ready.levels[0].push(partition);
+            ready.busy_levels |= 1;                                     // The top level isn't empty.
+            break;
+    }
+    ready.ready_count++;                                        // One more partition is ready.
+}
+
+/**************************************************************************************************
+ * int ready_set_select(ReadySet &ready)
+ *
+ * Author: Nolan Davenport
+ * Description: Takes the partition that runs next out of the ready set. Round robin takes the
+ *              first ready partition at or after the one after the last to run, wrapping around,
+ *              which is the order the partitioning experiments visit partitions in. Shortest
+ *              remaining time takes the data with the least time left, the lowest partition on a
+ *              tie. Multilevel feedback takes the front of the highest level that isn't empty.
+ *              The ready set must not be empty.
+ *
+ * Parameters:
+ *  ready               I/O     ReadySet (&)    The ready set.
+ *  ready_set_select    O/P     int             The partition that runs next.
+ *************************************************************************************************/
+int ready_set_select(ReadySet &ready){
+    int partition = -1;                                         // The partition that runs next.
+
+    switch(ready.config.policy){
+        case ROUND_ROBIN:{
+            int words = ready.ready_bits.size();                // The number of bitmap words.
+            int word = ready.cursor >> 6;                       // Start with the word holding the cursor,
+            uint64_t bits = ready.ready_bits[word] & (~0ULL << (ready.cursor & 63));   // ignoring earlier partitions.
+            while(bits == 0){                                   // Until a ready partition is found:
+                word = (word + 1 == words) ? 0 : word + 1;      // Look at the next word, wrapping around.
+                bits = ready.ready_bits[word];
+            }
+            partition = (word << 6) + __builtin_ctzll(bits);    // The first ready partition.
+            ready.ready_bits[word] &= ~(1ULL << (partition & 63));  // It is no longer ready.
+            ready.cursor = partition + 1;                       // Start after it next time.
+            if(ready.cursor == words * 64){                     // Wrap around at the end of the bitmap.
+                ready.cursor = 0;
+            }
+            break;
+        }
+        case SHORTEST_REMAINING_TIME:
+            pop_heap(ready.heap.begin(), ready.heap.end(), greater<pair<int, int>>());  // Take the least time left.
+            partition = ready.heap.back().second;
+            ready.heap.pop_back();
+            break;
+        case MULTILEVEL_FEEDBACK:{
+            int level = __builtin_ctzll(ready.busy_levels);     // The highest level that isn't empty.
+            partition = ready.levels[level].front();            // Take the front of its queue.
+            ready.levels[level].pop();
+            if(ready.levels[level].empty()){                    // If that emptied the level:
+                ready.busy_levels &= ~(1ULL << level);          // Clear its bit.
+            }
+            break;
+        }
+    }
+
+    ready.ready_count--;                                        // One less partition is ready.
+    return partition;
+}
+
+/**************************************************************************************************
+ * int ready_set_slice(const ReadySet &ready, int partition, int left)
+ *
+ * Author: Nolan Davenport
+ * Description: Finds how many ticks the selected partition runs for before the scheduler decides
+ *              again. Round robin runs for one quantum and multilevel feedback for the quantum of
+ *              its level. Shortest remaining time runs the data until it finishes: new data only
+ *              arrives when data finishes, so nothing can preempt it before then.
+ *
+ * Parameters:
+ *  ready               I/P     const ReadySet (&)  The ready set.
+ *  partition           I/P     int                 The selected partition.
+ *  left                I/P     int                 The time its data has left.
+ *  ready_set_slice     O/P     int                 The ticks it runs for.
+ *************************************************************************************************/
+int ready_set_slice(const ReadySet &ready, int partition, int left){
+    switch(ready.config.policy){
+        case ROUND_ROBIN:
+            return min(ready.config.quantum, left);             // One quantum, or less if it finishes.
+        case SHORTEST_REMAINING_TIME:
+            return left;                                        // Until it finishes.
+        case MULTILEVEL_FEEDBACK:
+            return (int)min((long long)ready.config.quantum << ready.level_of[partition],  // The quantum of
+                (long long)left);                                                         // its level.
+    }
+    return left;
+}
+
+/**************************************************************************************************
+ * void ready_set_requeue(ReadySet &ready, int partition, int left)
+ *
+ * Author: Nolan Davenport
+ * Description: Puts a partition whose slice ended before its data finished back in the ready
+ *              set. With multilevel feedback it used its whole quantum, so it drops a level.
+ *
+ * Parameters:
+ *  ready       I/O     ReadySet (&)    The ready set.
+ *  partition   I/P     int             The partition.
+ *  left        I/P     int             The time its data has left.
+ *************************************************************************************************/
+void ready_set_requeue(ReadySet &ready, int partition, int left){
+    switch(ready.config.policy){
+        case ROUND_ROBIN:
+            ready.ready_bits[partition >> 6] |= 1ULL << (partition & 63);  // Set its bit again.
+            break;
+        case SHORTEST_REMAINING_TIME:
+            ready.heap.push_back({left, partition});                    // Put it back in the heap.
+            push_heap(ready.heap.begin(), ready.heap.end(), greater<pair<int, int>>());
+            break;
+        case MULTILEVEL_FEEDBACK:{
+            int level = min(ready.level_of[partition] + 1,              // Drop a level, unless it is
+                ready.config.levels - 1);                               // already on the bottom one.
+            ready.level_of[partition] = level;
+            ready.levels[level].push(partition);
+            ready.busy_levels |= 1ULL << level;                         // That level isn't empty.
+            break;
+        }
+    }
+    ready.ready_count++;                                        // One more partition is ready.
+}
+
+/**************************************************************************************************
+ * void scheduled_static_partitioning(Data data[NUMBER_OF_SAMPLES], int number_of_samples,
+ *                                    StaticStyle style, const int* sizes, int partition_count,
+ *                                    const SchedulingConfig &config, Results* results)
+ *
+ * Author: Nolan Davenport
+ * Description: Performs a static partitioning experiment for a runtime layout, with the CPU
+ *              time shared between the resident partitions by a scheduling policy instead of
+ *              one tick of round robin. Memory is managed the same way as the generic engines and
+ *              tracked the same way as the reference experiments.
+ *              Round robin with a quantum of one gives the same results as the reference
+ *              experiments.
+ *
+ * Parameters:
+ *  data                I/P     Data[NUMBER_OF_SAMPLES]     The data to be used in this experiment.
+ *  number_of_samples   I/P     int                         The number of samples in this experiment.
+ *  style               I/P     StaticStyle                 How the partitions are filled.
+ *  sizes               I/P     const int*                  The size of each partition, smallest first.
+ *  partition_count     I/P     int                         The number of partitions.
+ *  config              I/P     const SchedulingConfig (&)  The scheduling policy and its settings.
+ *  results             O/P     Results*                    Pointer to the structure that holds the
+ *                                                          results of this experiment.
+ *************************************************************************************************/
+void scheduled_static_partitioning(Data data[NUMBER_OF_SAMPLES], int number_of_samples, StaticStyle style,
+                                   const int* sizes, int partition_count, const SchedulingConfig &config,
+                                   Results* results){
+    vector<int> left(number_of_samples);            // Only the time left changes during the experiment.
+    for(int i = 0; i < number_of_samples; i++){     // Loop through each sample.
+        left[i] = data[i].left;                     // Copy the time left.
+    }
+
+    int number_of_failures = 0;                     // Initialize the number of failures to zero.
+    int num_data_members_in_partition_table = 0;    // The number of data members in the partition table.
+    int next_data = 0;                              // The head of the single queue.
+
+    vector<StaticPartition> partitions(partition_count);    // Create the partitions.
+    for(int i = 0; i < partition_count; i++){               // Loop through the partitions.
+        partitions[i].size = sizes[i];                      // Set the size from the layout.
+        partitions[i].data_index = -1;                      // Start with the partition empty.
+    }
+
+    MemoryMetrics metrics;                          // The memory metrics for this experiment.
+
+    ReadySet ready;                                 // The partitions that are ready to run.
+    ready_set_init(ready, config, partition_count);
+
+    vector<queue<int>> queues;                      // The multiple queues, holding data indexes.
+    vector<int> filled;                             // The partitions the single queue just filled.
+
+    // Puts the next data for a partition into it and makes it ready, following the style.
+    auto refill = [&](int partition){
+        switch(style){
+            case EQUAL_STYLE:
+                if(next_data != number_of_samples){                 // If the queue isn't empty:
+                    partitions[partition].data_index = next_data;   // Move the front of the queue into the partition.
+                    if(data[next_data].size > partitions[partition].size){  // If it doesn't fit:
+                        number_of_failures++;                       // Count it as a failure.
+                    }
+                    num_data_members_in_partition_table++;
+                    metrics_admit(metrics, partitions[partition].size, data[next_data].size);  // Count its memory.
+                    ready_set_add(ready, partition, left[next_data]);
+                    next_data++;                                    // Move to the next item in the queue.
+                }
+                break;
+            case ONE_QUEUE_STYLE:
+                filled.clear();
+                one_queue_fill_generic(data, number_of_samples,     // Fill any partitions that the
+                    next_data, number_of_failures, partitions,      // head of the queue fits in.
+                    num_data_members_in_partition_table, &filled);
+                for(int p : filled){                                // Count their memory and make them ready.
+                    metrics_admit(metrics, partitions[p].size, data[partitions[p].data_index].size);
+                    ready_set_add(ready, p, left[partitions[p].data_index]);
+                }
+                break;
+            case MULTIPLE_QUEUES_STYLE:
+                if(!queues[partition].empty()){                     // If the queue for this partition isn't empty:
+                    int index = queues[partition].front();          // Take the item at the front of the queue.
+                    queues[partition].pop();
+                    partitions[partition].data_index = index;
+                    num_data_members_in_partition_table++;
+                    metrics_admit(metrics, partitions[partition].size, data[index].size);  // Count its memory.
+                    ready_set_add(ready, partition, left[index]);
+                }
+                break;
+        }
+    };
+
+    if(style == MULTIPLE_QUEUES_STYLE){                         // Put every sample in its queue.
+        queues.resize(partition_count);
+        number_of_failures = multiple_queues_assign_generic(data, number_of_samples,
+            sizes, partition_count, queues);
+    }
+    if(style == ONE_QUEUE_STYLE){                               // The single queue fills the table at once.
+        refill(0);
+    }else{
+        for(int i = 0; i < partition_count; i++){               // Otherwise fill every partition in order.
+            refill(i);
+        }
+    }
+
+    int clock = 0;                                  // Initialize the clock to zero.
+    float average_num_data_members_in_partition_table = 0;  // Cumulative value used for the average.
+
+    while(ready.ready_count > 0){                               // Until every partition is empty:
+        int partition = ready_set_select(ready);                // Pick the partition to run.
+        int index = partitions[partition].data_index;           // The data in it.
+        int slice = ready_set_slice(ready, partition, left[index]);
+
+        for(int tick = 1; tick < slice; tick++){                // Work for all but the last tick of the
+            left[index]--;                                      // slice, which can't finish the data.
+            clock++;                                            // Increment the clock.
+            average_num_data_members_in_partition_table +=      // Add to the cumulative average variable.
+                num_data_members_in_partition_table;
+            metrics_tick(metrics, results);                     // Add the memory metrics for this tick.
+        }
+
+        if(--left[index] == 0){                                 // Work the last tick. If the data is finished:
+            int turn_around_time = clock - data[index].time_start;  // Calculate the turnaround time.
+
+            results->turn_around_time += turn_around_time;      // Add it to the cumulative turnaround time.
+            float relative_turn_around_time =                           // Calculate the relative turnaround time.
+                (float)turn_around_time / data[index].time;
+            results->relative_turn_around_time += relative_turn_around_time;  // Add it to the cumulative value.
+            record_completion(index, clock);                                   // Record when it finished.
+            histogram_record(results->turn_around_histogram, turn_around_time);    // Record both for the percentiles.
+            record_relative_turn_around(results->relative_turn_around_histogram,
+                turn_around_time, data[index].time);
+
+            metrics_release(metrics, partitions[partition].size, data[index].size); // It no longer uses its memory.
+            partitions[partition].data_index = -1;              // Clear this partition.
+            num_data_members_in_partition_table--;              // Decrement the number of data members.
+            refill(partition);                                  // Give it the next data.
+            if(num_data_members_in_partition_table == 0){       // If the partition table is empty:
+                break;                                          // The experiment is done.
+            }
+        }else{
+            ready_set_requeue(ready, partition, left[index]);   // Otherwise it waits for another slice.
+        }
+
+        clock++;                                                // Increment the clock.
+        average_num_data_members_in_partition_table +=          // Add to the cumulative average variable.
+            num_data_members_in_partition_table;
+        metrics_tick(metrics, results);                         // Add the memory metrics for this tick.
+    }
+
+    average_num_data_members_in_partition_table /= clock;       // Calculate the average for this experiment.
+
+    results->average_num_data_members_in_partition_table +=     // Add it to the cumulative variable.
+        average_num_data_members_in_partition_table;
+    results->number_of_failures += number_of_failures;          // Add the failures to the cumulative variable.
+    metrics_finish_experiment(metrics, results, clock);         // Add the memory metrics to the cumulative values.
+}
\ No newline at end of file
@@ -0,0 +1,84 @@
+/**************************************************************************************************
+ * File: scheduling.h
+ * Author: Nolan Davenport
+ * Procedures:
+ *
+ * parse_scheduling_policy          - Reads a scheduling policy from its name.
+ *
+ * ready_set_init                   - Sets up an empty ready set for a partition table.
+ *
+ * ready_set_add                    - Makes a partition ready to run.
+ *
+ * ready_set_select                 - Takes the partition that runs next out of the ready set.
+ *
+ * ready_set_slice                  - Finds how long the selected partition runs for.
+ *
+ * ready_set_requeue                - Puts a partition whose slice ended back in the ready set.
+ *
+ * scheduled_static_partitioning    - Performs a static partitioning experiment with a pluggable
+ *                                    CPU scheduling policy.
+ *************************************************************************************************/
+
+#pragma once
+
+#include<iostream>
+#include<random>
+#include<queue>
+#include<list>
+#include<vector>
+#include<string>
+#include<cstdint>
+
+#include"main.h"
+
+using namespace std;
+
+#define MLFQ_MAX_LEVELS 32      // The most multilevel feedback levels. The quantum doubles with each one.
+
+// The CPU scheduling policies that can run the resident partitions.
+typedef enum {
+    ROUND_ROBIN,                // Each partition in turn, in partition order, for one quantum.
+    SHORTEST_REMAINING_TIME,    // The data with the least time left, until it finishes.
+    MULTILEVEL_FEEDBACK         // Round robin per level. Data that uses its whole quantum drops a
+                                // level, and each level down doubles the quantum.
+} SchedulingPolicy;
+
+// The partitioning styles that scheduled_static_partitioning can run.
+typedef enum {
+    EQUAL_STYLE,                // Every partition refills from the single queue.
+    ONE_QUEUE_STYLE,            // The single queue fills the first empty partition the data fits.
+    MULTIPLE_QUEUES_STYLE       // Every partition refills from its own queue.
+} StaticStyle;
+
+// Structure that holds the settings of a scheduling policy.
+typedef struct {
+    SchedulingPolicy policy = ROUND_ROBIN;  // The policy.
+    int quantum = 1;                        // The ticks in one quantum (the top level for multilevel).
+    int levels = 3;                         // The number of multilevel feedback levels.
+} SchedulingConfig;
+
+// Structure that holds the partitions that are ready to run. Only the parts for the chosen policy
+// are used.
+typedef struct {
+    SchedulingConfig config;                // The policy and its settings.
+
+    vector<uint64_t> ready_bits;            // Round robin: one bit per ready partition.
+    int cursor;                             // Round robin: the search for the next partition starts here.
+
+    vector<pair<int, int>> heap;            // Shortest remaining time: (time left, partition), least first.
+
+    vector<queue<int>> levels;              // Multilevel feedback: the ready partitions of each level.
+    uint64_t busy_levels;                   // Multilevel feedback: one bit per level that has partitions.
+    vector<int> level_of;                   // Multilevel feedback: the level of each partition.
+
+    int ready_count;                        // The number of ready partitions.
+} ReadySet;
+
+// Function prototypes
+bool parse_scheduling_policy(const string &name, SchedulingPolicy &policy);
+void ready_set_init(ReadySet &ready, const SchedulingConfig &config, int partition_count);
+void ready_set_add(ReadySet &ready, int partition, int left);
+int ready_set_select(ReadySet &ready);
+int ready_set_slice(const ReadySet &ready, int partition, int left);
+void ready_set_requeue(ReadySet &ready, int partition, int left);
+void scheduled_static_partitioning(Data data[NUMBER_OF_SAMPLES], int number_of_samples, StaticStyle style, const int* sizes, int partition_count, const SchedulingConfig &config, Results* results);
\ No newline at end of file
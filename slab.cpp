@@ -0,0 +1,636 @@
+/**************************************************************************************************
+ * File: slab.cpp
+ * Author: Nolan Davenport
+ * Procedures:
+ *
+ * tune_slab_classes            - Picks the size classes from quantiles of the data size
+ *                                distribution.
+ *
+ * slab_class_for_size          - Gets the size class data of a size is allocated from.
+ *
+ * slab_objects_per_slab        - Gets the number of objects in a slab of a size class.
+ *
+ * slab_link                    - Puts a slab with free objects on the free list of its class.
+ *
+ * slab_unlink                  - Takes a slab off the free list of its class.
+ *
+ * slab_carve                   - Carves a new slab for a size class out of free memory.
+ *
+ * slab_release                 - Returns an empty slab to free memory.
+ *
+ * slab_rebalance               - Releases the empty slabs of the other size classes so a class
+ *                                that ran dry can carve a slab.
+ *
+ * slab_allocate                - Allocates an object for data from its size class.
+ *
+ * slab_free                    - Returns the object of data to its size class.
+ *
+ * slab_prefill                 - Carves the slabs each size class is expected to need, from the
+ *                                demand of the earlier experiments.
+ *
+ * slab_partitioning            - Performs the slab allocator experiment.
+ *
+ * report_slab_results          - Prints the results of the slab allocator experiment next to the
+ *                                other styles.
+ *************************************************************************************************/
+
+#include<iostream>
+#include<random>
+#include<queue>
+#include<list>
+#include<vector>
+#include<algorithm>
+
+#include"main.h"
+#include"metrics.h"
+#include"histogram.h"
+#include"slab.h"
+
+using namespace std;
+
+/**************************************************************************************************
+ * void tune_slab_classes(SlabConfig &config, double mean)
+ *
+ * Author: Nolan Davenport
+ * Description: Picks the size classes from quantiles of the data size distribution, so each
+ *              class holds a known share of the data and the sizes most data has get a class of
+ *              their own. Quantiles that land on the same size make one class.
+ *
+ * Parameters:
+ *  config      I/O     SlabConfig (&)  The slab settings to fill in.
+ *  mean        I/P     double          The mean of the size distribution.
+ *************************************************************************************************/
+void tune_slab_classes(SlabConfig &config, double mean){
+    double quantiles[] = SLAB_CLASS_QUANTILES;      // The shares of data at or below each class.
+    config.class_count = 0;
+    int size = 1;                                   // The smallest size at the current quantile.
+    for(double quantile : quantiles){
+        while(1 - size_tail_probability(size, mean) < quantile){    // Walk up to the quantile.
+            size++;
+        }
+        if(config.class_count == 0 || config.class_sizes[config.class_count - 1] < size){
+            config.class_sizes[config.class_count++] = size;        // Add it unless it repeats.
+        }
+    }
+}
+
+/**************************************************************************************************
+ * int slab_class_for_size(const SlabConfig &config, int size)
+ *
+ * Author: Nolan Davenport
+ * Description: Gets the size class data of a size is allocated from, the smallest one its size
+ *              fits in. Data larger than every class is large.
+ *
+ * Parameters:
+ *  config                  I/P     const SlabConfig (&)    The slab settings.
+ *  size                    I/P     int                     The size of the data in MB.
+ *  slab_class_for_size     O/P     int                     The class, or class_count if large.
+ *************************************************************************************************/
+int slab_class_for_size(const SlabConfig &config, int size){
+    int size_class = 0;                             // There are only a few classes to look through.
+    while(size_class < config.class_count && config.class_sizes[size_class] < size){
+        size_class++;
+    }
+    return size_class;
+}
+
+/**************************************************************************************************
+ * int slab_objects_per_slab(const SlabConfig &config, int size_class)
+ *
+ * Author: Nolan Davenport
+ * Description: Gets the number of objects in a slab of a size class. A slab holds about
+ *              slab_size MB, but at least SLAB_MIN_OBJECTS objects, so the objects of a class
+ *              larger than half a slab are still reused instead of carving a slab for each. No
+ *              slab is larger than an even share of memory between the classes, so a small
+ *              memory gets fewer objects per slab.
+ *
+ * Parameters:
+ *  config                  I/P     const SlabConfig (&)    The slab settings.
+ *  size_class              I/P     int                     The size class.
+ *  slab_objects_per_slab   O/P     int                     The number of objects in a slab.
+ *************************************************************************************************/
+int slab_objects_per_slab(const SlabConfig &config, int size_class){
+    int class_size = config.class_sizes[size_class];            // The size of one object.
+    int objects = max(SLAB_MIN_OBJECTS, config.slab_size / class_size);
+    int share = config.memory_units / max(1, config.class_count);  // Every class must fit a slab.
+    return max(1, min(objects, share / class_size));
+}
+
+/**************************************************************************************************
+ * void slab_link(SlabMemory &memory, int id)
+ *
+ * Author: Nolan Davenport
+ * Description: Puts a slab that has a free object at the front of the free list of its class.
+ *
+ * Parameters:
+ *  memory      I/O     SlabMemory (&)      The slab memory.
+ *  id          I/P     int                 The id of the slab.
+ *************************************************************************************************/
+void slab_link(SlabMemory &memory, int id){
+    Slab &slab = memory.slabs[id];
+    int &first = memory.free_slabs[slab.size_class];            // The front of the list.
+    slab.prev_free = -1;
+    slab.next_free = first;
+    if(first != -1){
+        memory.slabs[first].prev_free = id;
+    }
+    first = id;
+}
+
+/**************************************************************************************************
+ * void slab_unlink(SlabMemory &memory, int id)
+ *
+ * Author: Nolan Davenport
+ * Description: Takes a slab off the free list of its class, once it is full or released.
+ *
+ * Parameters:
+ *  memory      I/O     SlabMemory (&)      The slab memory.
+ *  id          I/P     int                 The id of the slab. It must be on the list.
+ *************************************************************************************************/
+void slab_unlink(SlabMemory &memory, int id){
+    Slab &slab = memory.slabs[id];
+    if(slab.prev_free == -1){                                   // The slab before it, or the front of the
+        memory.free_slabs[slab.size_class] = slab.next_free;    // list, skips over it.
+    }else{
+        memory.slabs[slab.prev_free].next_free = slab.next_free;
+    }
+    if(slab.next_free != -1){
+        memory.slabs[slab.next_free].prev_free = slab.prev_free;
+    }
+    slab.next_free = slab.prev_free = -1;
+}
+
+/**************************************************************************************************
+ * int slab_carve(const SlabConfig &config, SlabMemory &memory, int size_class, int size,
+ *                MemoryMetrics &metrics, SlabStats* stats)
+ *
+ * Author: Nolan Davenport
+ * Description: Carves a new slab for a size class out of the first free region it fits in, and
+ *              puts it on the free list of the class. A slab for large data holds one object of
+ *              the size of the data.
+ *
+ * Parameters:
+ *  config      I/P     const SlabConfig (&)    The slab settings.
+ *  memory      I/O     SlabMemory (&)          The slab memory.
+ *  size_class  I/P     int                     The class of the slab.
+ *  size        I/P     int                     The size of the data, for large data.
+ *  metrics     I/O     MemoryMetrics (&)       The memory metrics of the experiment.
+ *  stats       I/O     SlabStats*              The allocator statistics.
+ *  slab_carve  O/P     int                     The id of the slab, or -1 if no region is big enough.
+ *************************************************************************************************/
+int slab_carve(const SlabConfig &config, SlabMemory &memory, int size_class, int size, MemoryMetrics &metrics,
+               SlabStats* stats){
+    Slab slab;                                                      // Size the slab.
+    slab.size_class = size_class;
+    if(size_class < config.class_count){                            // Fill the slab with objects of the class,
+        slab.objects = slab_objects_per_slab(config, size_class);
+        slab.size = slab.objects * config.class_sizes[size_class];
+    }else{                                                          // or give large data its own.
+        slab.objects = 1;
+        slab.size = size;
+    }
+    slab.in_use = 0;
+    slab.next_free = slab.prev_free = -1;
+
+    list<FreeRegion>::iterator region = memory.free_regions.begin();   // First fit on the free regions.
+    while(region != memory.free_regions.end() && region->size < slab.size){
+        region++;
+    }
+    if(region == memory.free_regions.end()){                        // If no region is big enough:
+        return -1;                                                  // The class has to wait or rebalance.
+    }
+
+    slab.start = region->start;                                     // The slab takes the start of the region,
+    metrics_remove_hole(metrics, region->size);                     // leaving the rest of it.
+    region->start += slab.size;
+    region->size -= slab.size;
+    metrics_add_hole(metrics, region->size);
+    if(region->size == 0){
+        memory.free_regions.erase(region);
+    }
+
+    int id;                                                         // Reuse the id of a released slab.
+    if(memory.released_ids.empty()){
+        id = memory.slabs.size();
+        memory.slabs.push_back(slab);
+    }else{
+        id = memory.released_ids.back();
+        memory.released_ids.pop_back();
+        memory.slabs[id] = slab;
+    }
+    if(size_class < config.class_count){                            // Every object of the slab is free.
+        slab_link(memory, id);
+        memory.empty_count[size_class]++;
+    }
+    memory.slab_count[size_class]++;
+    memory.slab_memory += slab.size;
+    stats->slabs_carved++;
+    return id;
+}
+
+/**************************************************************************************************
+ * int slab_release(const SlabConfig &config, SlabMemory &memory, int id, MemoryMetrics &metrics)
+ *
+ * Author: Nolan Davenport
+ * Description: Returns an empty slab to free memory, merging it with the free regions on either
+ *              side, and takes it off the free list of its class. A released slab has no
+ *              objects.
+ *
+ * Parameters:
+ *  config          I/P     const SlabConfig (&)    The slab settings.
+ *  memory          I/O     SlabMemory (&)          The slab memory.
+ *  id              I/P     int                     The id of the slab. It must be empty.
+ *  metrics         I/O     MemoryMetrics (&)       The memory metrics of the experiment.
+ *  slab_release    O/P     int                     The size of the free region it is now part of.
+ *************************************************************************************************/
+int slab_release(const SlabConfig &config, SlabMemory &memory, int id, MemoryMetrics &metrics){
+    Slab &slab = memory.slabs[id];                                  // The slab to release.
+    if(slab.size_class < config.class_count){                       // Its objects are no longer free. Large
+        slab_unlink(memory, id);                                    // data is never on a free list.
+        memory.empty_count[slab.size_class]--;
+    }
+
+    list<FreeRegion>::iterator next = memory.free_regions.begin();     // Find the regions on either side.
+    while(next != memory.free_regions.end() && next->start < slab.start){
+        next++;
+    }
+    FreeRegion region = {slab.start, slab.size};                    // The region the slab leaves.
+    if(next != memory.free_regions.begin() && prev(next)->start + prev(next)->size == region.start){
+        metrics_remove_hole(metrics, prev(next)->size);             // Merge with the region before it.
+        region.start = prev(next)->start;
+        region.size += prev(next)->size;
+        memory.free_regions.erase(prev(next));
+    }
+    if(next != memory.free_regions.end() && region.start + region.size == next->start){
+        metrics_remove_hole(metrics, next->size);                   // Merge with the region after it.
+        region.size += next->size;
+        next = memory.free_regions.erase(next);
+    }
+    memory.free_regions.insert(next, region);
+    metrics_add_hole(metrics, region.size);
+
+    memory.slab_count[slab.size_class]--;
+    memory.slab_memory -= slab.size;
+    slab.objects = 0;                                               // Mark the id as released,
+    memory.released_ids.push_back(id);                              // so it can be reused.
+    return region.size;
+}
+
+/**************************************************************************************************
+ * int slab_rebalance(const SlabConfig &config, SlabMemory &memory, int size_class, int size,
+ *                    MemoryMetrics &metrics, SlabStats* stats)
+ *
+ * Author: Nolan Davenport
+ * Description: Releases the empty slabs of the other size classes, oldest id first, until a
+ *              free region is big enough for a slab of a class that ran dry, then carves it.
+ *              Slabs holding data are never moved. Each class keeps SLAB_KEPT_EMPTY empty slabs,
+ *              so memory doesn't bounce between two classes that take turns running dry. Those
+ *              are only released when no data is in memory, since nothing else can free any.
+ *
+ * Parameters:
+ *  config          I/P     const SlabConfig (&)    The slab settings.
+ *  memory          I/O     SlabMemory (&)          The slab memory.
+ *  size_class      I/P     int                     The class that ran dry.
+ *  size            I/P     int                     The size of the data, for large data.
+ *  metrics         I/O     MemoryMetrics (&)       The memory metrics of the experiment.
+ *  stats           I/O     SlabStats*              The allocator statistics.
+ *  slab_rebalance  O/P     int                     The id of the new slab, or -1 if there still
+ *                                                  isn't room.
+ *************************************************************************************************/
+int slab_rebalance(const SlabConfig &config, SlabMemory &memory, int size_class, int size, MemoryMetrics &metrics,
+                   SlabStats* stats){
+    int needed = (size_class < config.class_count) ?                // The size of the slab to carve.
+        slab_objects_per_slab(config, size_class) * config.class_sizes[size_class] : size;
+    int kept = (memory.objects_in_use == 0) ? 0 : SLAB_KEPT_EMPTY;  // The empty slabs each class keeps.
+
+    int released = 0;                                               // The slabs released so far.
+    for(int id = 0; id < (int)memory.slabs.size(); id++){           // Look for empty slabs of other classes.
+        Slab &slab = memory.slabs[id];
+        if(slab.in_use != 0 || slab.size_class == size_class || slab.objects == 0 ||
+            (slab.size_class < config.class_count && memory.empty_count[slab.size_class] <= kept)){
+            continue;
+        }
+        released++;
+        if(slab_release(config, memory, id, metrics) >= needed){    // Free it, and stop once the new slab fits.
+            break;
+        }
+    }
+    if(released == 0){                                              // Nothing could be freed.
+        return -1;
+    }
+    stats->rebalances++;
+    stats->slabs_rebalanced += released;
+    return slab_carve(config, memory, size_class, size, metrics, stats);
+}
+
+/**************************************************************************************************
+ * int slab_allocate(const SlabConfig &config, SlabMemory &memory, int size_class, int size,
+ *                   MemoryMetrics &metrics, SlabStats* stats)
+ *
+ * Author: Nolan Davenport
+ * Description: Allocates an object for data from its size class, from the first slab on the
+ *              free list of the class. If there is none, a new slab is carved, rebalancing memory
+ *              from the other classes if no free region is big enough.
+ *
+ * Parameters:
+ *  config          I/P     const SlabConfig (&)    The slab settings.
+ *  memory          I/O     SlabMemory (&)          The slab memory.
+ *  size_class      I/P     int                     The class of the data.
+ *  size            I/P     int                     The size of the data, for large data.
+ *  metrics         I/O     MemoryMetrics (&)       The memory metrics of the experiment.
+ *  stats           I/O     SlabStats*              The allocator statistics.
+ *  slab_allocate   O/P     int                     The id of the slab holding the object, or -1 if
+ *                                                  there isn't room.
+ *************************************************************************************************/
+int slab_allocate(const SlabConfig &config, SlabMemory &memory, int size_class, int size, MemoryMetrics &metrics,
+                  SlabStats* stats){
+    bool large = size_class == config.class_count;                  // Large data gets a slab of its own.
+    int id;
+    if(!large && memory.free_slabs[size_class] != -1){              // If the class has a free object:
+        stats->free_list_hits++;                                    // Take it.
+    }else{
+        id = slab_carve(config, memory, size_class, size, metrics, stats);     // Otherwise carve a slab,
+        if(id == -1){
+            id = slab_rebalance(config, memory, size_class, size, metrics, stats);    // taking memory from the
+        }                                                                           // other classes if needed.
+        if(id == -1){
+            return -1;
+        }
+    }
+
+    if(large){                                                      // Take the object.
+        memory.slabs[id].in_use = 1;
+    }else{
+        id = memory.free_slabs[size_class];                         // From the first slab with one free.
+        Slab &slab = memory.slabs[id];
+        if(slab.in_use++ == 0){                                     // It is no longer empty,
+            memory.empty_count[size_class]--;
+        }
+        if(slab.in_use == slab.objects){                            // and once full it has none free.
+            slab_unlink(memory, id);
+        }
+    }
+    memory.objects_in_use++;
+    stats->allocations++;
+    stats->demand[size_class] += large ? size : config.class_sizes[size_class];    // Remember the demand
+                                                                                // for the next prefill.
+    return id;
+}
+
+/**************************************************************************************************
+ * void slab_free(const SlabConfig &config, SlabMemory &memory, int id, MemoryMetrics &metrics)
+ *
+ * Author: Nolan Davenport
+ * Description: Returns the object of data to its slab, which goes back on the free list of its
+ *              class if it was full. An empty slab stays with its class until rebalancing needs
+ *              its memory. The slab of large data is released right away.
+ *
+ * Parameters:
+ *  config      I/P     const SlabConfig (&)    The slab settings.
+ *  memory      I/O     SlabMemory (&)          The slab memory.
+ *  id          I/P     int                     The id of the slab holding the object.
+ *  metrics     I/O     MemoryMetrics (&)       The memory metrics of the experiment.
+ *************************************************************************************************/
+void slab_free(const SlabConfig &config, SlabMemory &memory, int id, MemoryMetrics &metrics){
+    Slab &slab = memory.slabs[id];
+    memory.objects_in_use--;
+    if(slab.size_class == config.class_count){                      // Large data has no class to go back to.
+        slab.in_use--;
+        slab_release(config, memory, id, metrics);
+        return;
+    }
+    if(slab.in_use-- == slab.objects){                              // The object can be reused, so a full
+        slab_link(memory, id);                                      // slab has one free again.
+    }
+    if(slab.in_use == 0){
+        memory.empty_count[slab.size_class]++;
+    }
+}
+
+/**************************************************************************************************
+ * void slab_prefill(const SlabConfig &config, SlabMemory &memory, MemoryMetrics &metrics,
+ *                   SlabStats* stats)
+ *
+ * Author: Nolan Davenport
+ * Description: Carves the slabs each size class is expected to need before the experiment
+ *              starts. Each class gets whole slabs for its share of the memory demanded in the
+ *              earlier experiments, so the first data of each class finds a free object. The
+ *              share of large data is left free. The first experiment has no demand to go on.
+ *
+ * Parameters:
+ *  config      I/P     const SlabConfig (&)    The slab settings.
+ *  memory      I/O     SlabMemory (&)          The slab memory, with nothing carved yet.
+ *  metrics     I/O     MemoryMetrics (&)       The memory metrics of the experiment.
+ *  stats       I/O     SlabStats*              The allocator statistics.
+ *************************************************************************************************/
+void slab_prefill(const SlabConfig &config, SlabMemory &memory, MemoryMetrics &metrics, SlabStats* stats){
+    long long total_demand = 0;                                     // The memory demanded by every class.
+    for(int size_class = 0; size_class <= config.class_count; size_class++){
+        total_demand += stats->demand[size_class];
+    }
+    if(total_demand == 0){                                          // Nothing is known yet.
+        return;
+    }
+
+    for(int size_class = 0; size_class < config.class_count; size_class++){    // Carve each class its share.
+        int slab_size = slab_objects_per_slab(config, size_class) * config.class_sizes[size_class];
+        int slabs = stats->demand[size_class] * metrics.memory_size / total_demand / slab_size;
+        for(int slab = 0; slab < slabs; slab++){
+            if(slab_carve(config, memory, size_class, 0, metrics, stats) == -1){
+                break;                                              // Memory is full.
+            }
+            stats->slabs_prefilled++;
+        }
+    }
+}
+
+/**************************************************************************************************
+ * void slab_partitioning(Data data[], int number_of_samples, const SlabConfig &config,
+ *                        Results* slab, SlabStats* stats)
+ *
+ * Author: Nolan Davenport
+ * Description: Performs the slab allocator experiment. Data is admitted in queue order like the
+ *              dynamic style, each item taking an object of its size class. Objects are only
+ *              wasted up to the next class size, and freeing one is a push onto the free list of
+ *              its class, so nothing is ever compacted. Memory moves between classes only as
+ *              whole empty slabs. The processor gives each resident data member one quantum in
+ *              turn. Memory starts out carved by the demand of the earlier experiments.
+ *
+ * Parameters:
+ *  data                I/P     Data[]                  The data to be used in this experiment.
+ *  number_of_samples   I/P     int                     The number of samples in this experiment.
+ *  config              I/P     const SlabConfig (&)    The slab settings.
+ *  slab                O/P     Results*                Pointer to the structure that holds the
+ *                                                      results of this experiment.
+ *  stats               I/O     SlabStats*              The allocator statistics.
+ *************************************************************************************************/
+void slab_partitioning(Data data[], int number_of_samples, const SlabConfig &config, Results* slab,
+                       SlabStats* stats){
+    vector<int> left(number_of_samples);            // Only the time left changes during the experiment.
+    for(int i = 0; i < number_of_samples; i++){     // Loop through each sample.
+        left[i] = data[i].left;                     // Copy the time left.
+    }
+
+    MemoryMetrics metrics;                          // The memory metrics for this experiment.
+    metrics.memory_size = config.memory_units;
+    SlabMemory memory;                              // Memory starts as a single free region.
+    fill(begin(memory.free_slabs), end(memory.free_slabs), -1);     // No class has a slab yet.
+    memory.free_regions.push_back({0, metrics.memory_size});
+    metrics_add_hole(metrics, metrics.memory_size);
+    memory.slab_of.resize(number_of_samples);
+    slab_prefill(config, memory, metrics, stats);
+
+    list<int> resident;                             // The data in memory, in rotation order.
+    int next_data = 0;                              // The front of the queue.
+    int number_of_failures = 0;                     // Initialize the number of failures to zero.
+    int clock = 0;                                  // Initialize the clock to zero.
+    float average_num_data_members_in_partition_table = 0;  // Cumulative value used for the average.
+
+    auto admit = [&](){                                             // Admit data from the front of the queue
+        while(next_data != number_of_samples){                      // until it doesn't fit.
+            int size = data[next_data].size;
+            int size_class = slab_class_for_size(config, size);
+            if(size > metrics.memory_size){                         // Data larger than memory waits for it to
+                if(!resident.empty()){                              // empty, then takes all of it and fails.
+                    break;
+                }
+                size = metrics.memory_size;
+            }
+            int id = slab_allocate(config, memory, size_class, size, metrics, stats);
+            if(id == -1){                                           // The front of the queue waits.
+                break;
+            }
+            if(size != data[next_data].size){
+                number_of_failures++;
+            }
+
+            int object_size = (size_class < config.class_count) ? config.class_sizes[size_class] : size;
+            metrics_admit(metrics, object_size, data[next_data].size);     // The rest of the object is wasted.
+            memory.slab_of[next_data] = id;
+            resident.push_back(next_data);                          // It joins the rotation.
+            next_data++;                                            // Move to the next item in the queue.
+        }
+    };
+    admit();
+
+    list<int>::iterator it = resident.begin();      // The data the processor is at.
+    for(;;){                                                        // Clock loop.
+        int index = *it;                                            // The data at the processor.
+        if(--left[index] == 0){                                     // Work for one quantum. If the data is finished:
+            int turn_around_time = clock - data[index].time_start;  // Calculate the turnaround time.
+            slab->turn_around_time += turn_around_time;             // Add it to the cumulative turnaround time.
+            slab->relative_turn_around_time +=                      // Add the relative turnaround time.
+                (float)turn_around_time / data[index].time;
+            record_completion(index, clock);                        // Record when it finished.
+            histogram_record(slab->turn_around_histogram, turn_around_time);    // Record both for the percentiles.
+            record_relative_turn_around(slab->relative_turn_around_histogram,
+                turn_around_time, data[index].time);
+
+            int id = memory.slab_of[index];                         // Give its object back.
+            int object_size = (memory.slabs[id].size_class < config.class_count) ?
+                config.class_sizes[memory.slabs[id].size_class] : memory.slabs[id].size;
+            metrics_release(metrics, object_size, data[index].size);
+            slab_free(config, memory, id, metrics);
+            it = resident.erase(it);                                // It leaves the rotation.
+
+            bool was_empty = resident.empty();                      // Admit what now fits.
+            admit();
+
+            if(resident.empty()){                                   // If memory is empty:
+                break;                                              // The experiment is done.
+            }else if(was_empty){                                    // Start the rotation over with the new data.
+                it = resident.begin();
+            }
+        }else{
+            it++;                                                   // Move to the next data.
+        }
+
+        if(it == resident.end()){                                   // Wrap around the rotation.
+            it = resident.begin();
+        }
+
+        clock++;                                                    // Increment the clock.
+        average_num_data_members_in_partition_table += resident.size();
+        metrics_tick(metrics, slab);                                // Add the memory metrics for this tick.
+        stats->slack_ticks += memory.slab_memory -                  // And the free objects in slabs.
+            (metrics.used_memory + metrics.internal_fragmentation);
+        if(next_data != number_of_samples){                         // The front of the queue is still waiting.
+            stats->blocked_ticks++;
+        }
+    }
+
+    average_num_data_members_in_partition_table /= clock;           // Calculate the average for this experiment.
+    slab->average_num_data_members_in_partition_table += average_num_data_members_in_partition_table;
+    slab->number_of_failures += number_of_failures;                 // Add the failures to the cumulative variable.
+    metrics_finish_experiment(metrics, slab, clock);                // Add the memory metrics to the cumulative values.
+
+    stats->experiments++;
+    stats->ticks += clock;
+}
+
+/**************************************************************************************************
+ * void report_slab_results(Results* slab, const SlabConfig &config, const SlabStats &stats)
+ *
+ * Author: Nolan Davenport
+ * Description: Prints the results of the slab allocator experiment in the same form as the
+ *              dynamic style, then how the allocator behaved. Like report_results, the
+ *              cumulative values are turned into averages in place.
+ *
+ * Parameters:
+ *  slab        I/O     Results*                The results of the slab experiments.
+ *  config      I/P     const SlabConfig (&)    The slab settings.
+ *  stats       I/P     const SlabStats (&)     The allocator statistics.
+ *************************************************************************************************/
+void report_slab_results(Results* slab, const SlabConfig &config, const SlabStats &stats){
+    if(stats.experiments == 0){                     // Nothing to report.
+        return;
+    }
+    double experiments = stats.experiments;         // Averages are per experiment,
+    slab->number_of_failures /= experiments;
+    slab->turn_around_time /= experiments * NUMBER_OF_SAMPLES;                  // or per data item.
+    slab->relative_turn_around_time /= experiments * NUMBER_OF_SAMPLES;
+    slab->average_num_data_members_in_partition_table /= experiments;
+    slab->average_memory_utilization /= experiments;
+    slab->average_internal_fragmentation /= experiments;
+    slab->average_hole_count /= experiments;
+    slab->average_largest_hole /= experiments;
+
+    cout << "slab average number_of_failures: " << slab->number_of_failures << endl;
+    cout << "slab average turn_around_time: " << slab->turn_around_time << endl;
+    cout << "slab average relative_turn_around_time: " << slab->relative_turn_around_time << endl;
+    cout << "slab average number of data members in slabs: " <<
+        slab->average_num_data_members_in_partition_table << endl;
+    cout << "slab average memory utilization: " << slab->average_memory_utilization << endl;
+    cout << "slab average internal fragmentation: " << slab->average_internal_fragmentation << endl;
+    cout << "slab average hole count: " << slab->average_hole_count << endl;
+    cout << "slab average largest hole: " << slab->average_largest_hole << endl;
+    cout << "slab average free objects in slabs: " << (double)stats.slack_ticks / stats.ticks << " MB" << endl;
+    cout << "slab throughput: " << experiments * NUMBER_OF_SAMPLES / stats.ticks << " data per tick" << endl;
+
+    long long total_demand = 0;                                     // The memory demanded by every class.
+    for(int size_class = 0; size_class <= config.class_count; size_class++){
+        total_demand += stats.demand[size_class];
+    }
+    cout << "slab classes (MB, share of demand):";
+    for(int size_class = 0; size_class <= config.class_count; size_class++){
+        cout << " ";
+        if(size_class < config.class_count){
+            cout << config.class_sizes[size_class];
+        }else{
+            cout << "large";
+        }
+        cout << " " << 100.0 * stats.demand[size_class] / max(1LL, total_demand) << "%";
+    }
+    cout << endl;
+    cout << "slab " << config.slab_size << " MB slabs, free list hits: " <<
+        100.0 * stats.free_list_hits / max(1LL, stats.allocations) << "%, slabs carved per experiment: " <<
+        stats.slabs_carved / experiments << " (" << stats.slabs_prefilled / experiments << " prefilled)" << endl;
+    cout << "slab rebalances per experiment: " << stats.rebalances / experiments << ", releasing " <<
+        stats.slabs_rebalanced / experiments << " slabs" << endl;
+    cout << "slab average time the front of the queue waited for memory: " <<
+        stats.blocked_ticks / experiments << " ticks" << endl;
+    report_percentiles("slab", slab, cout);             // Print the turnaround time percentiles.
+    cout << endl;
+
+    write_time_series(&slab->memory_utilization_over_time, "slab_utilization.csv");
+}
\ No newline at end of file
@@ -0,0 +1,128 @@
+/**************************************************************************************************
+ * File: slab.h
+ * Author: Nolan Davenport
+ * Procedures:
+ *
+ * tune_slab_classes            - Picks the size classes from quantiles of the data size
+ *                                distribution.
+ *
+ * slab_class_for_size          - Gets the size class data of a size is allocated from.
+ *
+ * slab_objects_per_slab        - Gets the number of objects in a slab of a size class.
+ *
+ * slab_link                    - Puts a slab with free objects on the free list of its class.
+ *
+ * slab_unlink                  - Takes a slab off the free list of its class.
+ *
+ * slab_carve                   - Carves a new slab for a size class out of free memory.
+ *
+ * slab_release                 - Returns an empty slab to free memory.
+ *
+ * slab_rebalance               - Releases the empty slabs of the other size classes so a class
+ *                                that ran dry can carve a slab.
+ *
+ * slab_allocate                - Allocates an object for data from its size class.
+ *
+ * slab_free                    - Returns the object of data to its size class.
+ *
+ * slab_prefill                 - Carves the slabs each size class is expected to need, from the
+ *                                demand of the earlier experiments.
+ *
+ * slab_partitioning            - Performs the slab allocator experiment.
+ *
+ * report_slab_results          - Prints the results of the slab allocator experiment next to the
+ *                                other styles.
+ *************************************************************************************************/
+
+#pragma once
+
+#include<iostream>
+#include<random>
+#include<queue>
+#include<list>
+#include<vector>
+
+#include"main.h"
+#include"metrics.h"
+
+using namespace std;
+
+#define SLAB_MAX_CLASSES 8              // The most size classes, not counting large data.
+#define SLAB_CLASS_QUANTILES {0.25, 0.5, 0.75, 0.9, 0.99}  // The quantiles of the data size that become classes.
+#define SLAB_MIN_OBJECTS 4              // The fewest objects in a slab of a class, if memory allows.
+#define SLAB_KEPT_EMPTY 1               // The empty slabs each class keeps through rebalancing.
+
+// Structure that holds the settings of the slab allocator. Each size class gets slabs of about
+// slab_size MB of the memory_units MB of memory, each cut into objects of the class size, but
+// never fewer than SLAB_MIN_OBJECTS objects unless memory is too small to share between the
+// classes. Data larger than the largest class is large, and gets a slab of its own exact size.
+typedef struct {
+    int slab_size = 16;                         // The target size of a slab in MB.
+    int memory_units = MEMORY_END + 1;          // The size of memory in MB.
+    int class_count = 0;                        // The number of size classes.
+    int class_sizes[SLAB_MAX_CLASSES] = {};     // The object size of each class in MB, smallest first.
+} SlabConfig;
+
+// Structure that holds one slab: a contiguous run of memory cut into objects of one class.
+typedef struct {
+    int start;                          // The first MB of the slab.
+    int size;                           // The size of the slab in MB.
+    int size_class;                     // The class of its objects, or class_count for large data.
+    int objects;                        // The number of objects in the slab, or zero once released.
+    int in_use;                         // The number of objects holding data.
+    int next_free;                      // The next and previous slab on the free list of its class,
+    int prev_free;                      // or -1.
+} Slab;
+
+// Structure that holds a run of memory no slab is using.
+typedef struct {
+    int start;                          // The first MB of the run.
+    int size;                           // The size of the run in MB.
+} FreeRegion;
+
+// Structure that holds the memory of the slab experiment. The slabs of a class that have a free
+// object are linked through the slabs themselves into the free list of the class, so allocating
+// an object, freeing one and releasing a slab never search.
+typedef struct {
+    vector<Slab> slabs;                             // The slabs, by id. Released ids are reused.
+    vector<int> released_ids;                       // The ids of released slabs.
+    int free_slabs[SLAB_MAX_CLASSES];               // The first slab on the free list of each class, or -1.
+    list<FreeRegion> free_regions;                  // The memory not in slabs, in address order.
+    vector<int> slab_of;                            // The slab of each data item in memory.
+    int slab_count[SLAB_MAX_CLASSES + 1] = {};      // The slabs of each class and of large data.
+    int empty_count[SLAB_MAX_CLASSES] = {};         // The empty slabs of each class.
+    int objects_in_use = 0;                         // The objects holding data, in every slab.
+    int slab_memory = 0;                            // The memory in slabs, in MB.
+} SlabMemory;
+
+// Structure that holds the allocator statistics of the slab experiment. The demand of each class
+// also decides the slabs carved at the start of the next experiment.
+typedef struct {
+    long long experiments = 0;                      // The number of experiments.
+    long long ticks = 0;                            // The clock ticks of every experiment.
+    long long allocations = 0;                      // The objects allocated.
+    long long free_list_hits = 0;                   // The allocations served by a free list.
+    long long slabs_carved = 0;                     // The slabs carved, prefilled or not.
+    long long slabs_prefilled = 0;                  // The slabs carved at the start of an experiment.
+    long long rebalances = 0;                       // The times a dry class took memory from others.
+    long long slabs_rebalanced = 0;                 // The slabs released by rebalancing.
+    long long blocked_ticks = 0;                    // The ticks the front of the queue waited for memory.
+    long long slack_ticks = 0;                      // The MB of free objects in slabs, summed every tick.
+    long long demand[SLAB_MAX_CLASSES + 1] = {};    // The MB of objects allocated from each class and as
+                                                    // large data.
+} SlabStats;
+
+// Function prototypes
+void tune_slab_classes(SlabConfig &config, double mean);
+int slab_class_for_size(const SlabConfig &config, int size);
+int slab_objects_per_slab(const SlabConfig &config, int size_class);
+void slab_link(SlabMemory &memory, int id);
+void slab_unlink(SlabMemory &memory, int id);
+int slab_carve(const SlabConfig &config, SlabMemory &memory, int size_class, int size, MemoryMetrics &metrics, SlabStats* stats);
+int slab_release(const SlabConfig &config, SlabMemory &memory, int id, MemoryMetrics &metrics);
+int slab_rebalance(const SlabConfig &config, SlabMemory &memory, int size_class, int size, MemoryMetrics &metrics, SlabStats* stats);
+int slab_allocate(const SlabConfig &config, SlabMemory &memory, int size_class, int size, MemoryMetrics &metrics, SlabStats* stats);
+void slab_free(const SlabConfig &config, SlabMemory &memory, int id, MemoryMetrics &metrics);
+void slab_prefill(const SlabConfig &config, SlabMemory &memory, MemoryMetrics &metrics, SlabStats* stats);
+void slab_partitioning(Data data[], int number_of_samples, const SlabConfig &config, Results* slab, SlabStats* stats);
+void report_slab_results(Results* slab, const SlabConfig &config, const SlabStats &stats);
\ No newline at end of file
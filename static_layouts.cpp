@@ -0,0 +1,586 @@
+/**************************************************************************************************
+ * File: static_layouts.cpp
+ * Author: Nolan Davenport
+ * Procedures:
+ *
+ * equal_partitioning_generic               - Performs the equal partitioning experiment for a
+ *                                            layout configured at runtime.
+ *
+ * one_queue_fill_generic                   - Fills the partitions of a runtime layout from the
+ *                                            single queue.
+ *
+ * one_queue_partitioning_generic           - Performs the one queue experiment for a layout
+ *                                            configured at runtime.
+ *
+ * multiple_queues_assign_generic           - Puts every sample in the queue of the partition it
+ *                                            goes to in the multiple queues style.
+ *
+ * multiple_queues_partitioning_generic     - Performs the multiple queues experiment for a layout
+ *                                            configured at runtime.
+ *
+ * layout_matches                           - Checks whether a runtime layout is the same as a
+ *                                            compile time layout.
+ *
+ * equal_static_partitioning                - Runs the equal experiment on the fixed engine when
+ *                                            the layout matches one, otherwise the generic one.
+ *
+ * one_queue_static_partitioning            - Runs the one queue experiment on the fixed engine
+ *                                            when the layout matches one, otherwise the generic one.
+ *
+ * multiple_queues_static_partitioning      - Runs the multiple queues experiment on the fixed
+ *                                            engine when the layout matches one, otherwise the
+ *                                            generic one.
+ *
+ * batch_static_partitioning                - Runs a batch of static partitioning experiments, each
+ *                                            on the engine for its layout.
+ *************************************************************************************************/
+
+#include<iostream>
+#include<random>
+#include<queue>
+#include<list>
+#include<vector>
+
+#include"main.h"
+#include"histogram.h"
+#include"static_layouts.h"
+
+using namespace std;
+
+/**************************************************************************************************
+ * void equal_partitioning_generic(Data data[NUMBER_OF_SAMPLES], int number_of_samples,
+ *                                 int partition_size, int partition_count, Results* equal)
+ *
+ * Author: Nolan Davenport
+ * Description: Performs the equal partitioning experiment for a layout configured at runtime.
+ *              Follows the same rules as equal_partitioning, but doesn't record the memory
+ *              metrics.
+ *
+ * Parameters:
+ *  data                I/P     Data[NUMBER_OF_SAMPLES]     The data to be used in this experiment.
+ *  number_of_samples   I/P     int                         The number of samples in this experiment.
+ *  partition_size      I/P     int                         The size of every partition.
+ *  partition_count     I/P     int                         The number of partitions.
+ *  equal               O/P     Results*                    Pointer to the structure that holds the
+ *                                                          results of this experiment.
+ *************************************************************************************************/
+void equal_partitioning_generic(Data data[NUMBER_OF_SAMPLES], int number_of_samples,
+                                int partition_size, int partition_count, Results* equal){
+    vector<int> left(number_of_samples);            // Only the time left changes during the experiment.
+    for(int i = 0; i < number_of_samples; i++){     // Loop through each sample.
+        left[i] = data[i].left;                     // Copy the time left.
+    }
+
+    int number_of_failures = 0;                     // Initialize number of failures to zero.
+
+    int active = min(partition_count, number_of_samples);   // Number of partitions that get used.
+
+    vector<StaticPartition> partitions(active);     // Create the static partitions.
+    for(int i = 0; i < active; i++){                // Loop through the partitions.
+        partitions[i].size = partition_size;        // Set the size of the partition.
+        partitions[i].data_index = i;               // Initially assign the first tasks/data.
+        if(data[i].size > partition_size){          // If the size of the data is greater than the partition:
+            number_of_failures++;                   // Count it as a failure.
+        }
+    }
+
+    int num_data_members_in_partition_table = active;   // Every partition starts full.
+    int next_data = active;                             // The next data element in the queue.
+    int curr_partition = 0;                             // Initialize the current partition to zero.
+    int clock = 0;                                      // Initialize the clock to zero.
+
+    float average_num_data_members_in_partition_table = 0;  // Cumulative value used for the average.
+
+    for(;;){                                                    // Clock loop.
+        int index = partitions[curr_partition].data_index;      // The data in the current partition.
+        if(index == -1){                                        // If the partition is empty:
+            curr_partition = (curr_partition + 1) % active;     // Move on without incrementing the clock.
+            continue;
+        }
+
+        if(--left[index] == 0){                                 // Work for one quantum. If the data is finished:
+            int turn_around_time = clock - data[index].time_start;  // Calculate the turnaround time.
+
+            equal->turn_around_time += turn_around_time;        // Add it to the cumulative turnaround time.
+            float relative_turn_around_time =                           // Calculate the relative turnaround time.
+                (float)turn_around_time / data[index].time;
+            equal->relative_turn_around_time += relative_turn_around_time;    // Add it to the cumulative value.
+            record_completion(index, clock);                                     // Record when it finished.
+            histogram_record(equal->turn_around_histogram, turn_around_time);    // Record both for the percentiles.
+            record_relative_turn_around(equal->relative_turn_around_histogram,
+                turn_around_time, data[index].time);
+
+            if(next_data != number_of_samples){                     // If the queue isn't empty:
+                partitions[curr_partition].data_index = next_data;  // Move the front of the queue into the partition.
+                if(data[next_data].size > partition_size){          // If it doesn't fit in the partition:
+                    number_of_failures++;                           // Count it as a failure.
+                }
+                next_data++;                                        // Move to the next item in the queue.
+            }else{
+                partitions[curr_partition].data_index = -1;     // Otherwise set the partition to empty.
+                num_data_members_in_partition_table--;          // Decrement the number of data members.
+                if(num_data_members_in_partition_table == 0){   // If the partition table is empty:
+                    break;                                      // The experiment is done.
+                }
+            }
+        }
+
+        curr_partition = (curr_partition + 1) % active;         // Move to the next partition.
+        clock++;                                                // Increment the clock.
+        average_num_data_members_in_partition_table +=          // Add to the cumulative average variable.
+            num_data_members_in_partition_table;
+    }
+
+    average_num_data_members_in_partition_table /= clock;       // Calculate the average for this experiment.
+
+    equal->average_num_data_members_in_partition_table +=       // Add it to the cumulative variable.
+        average_num_data_members_in_partition_table;
+    equal->number_of_failures += number_of_failures;            // Add the failures to the cumulative variable.
+}
+
+/**************************************************************************************************
+ * void one_queue_fill_generic(Data data[NUMBER_OF_SAMPLES], int number_of_samples, int &next_data,
+ *                             int &number_of_failures, vector<StaticPartition> &partitions,
+ *                             int &num_data_members_in_partition_table, vector<int>* filled)
+ *
+ * Author: Nolan Davenport
+ * Description: Fills the partitions of a runtime layout from the single queue. The first empty
+ *              partition that the data fits in is used and the last partition takes anything.
+ *
+ * Parameters:
+ *  data                                    I/P     Data[NUMBER_OF_SAMPLES]     The data being processed.
+ *  number_of_samples                       I/P     int                         The number of samples.
+ *  next_data                               I/O     int (&)                     The head of the queue.
+ *  number_of_failures                      O/P     int (&)                     The number of failures.
+ *  partitions                              I/O     vector<StaticPartition> (&) The partition table.
+ *  num_data_members_in_partition_table     O/P     int (&)                     The number of data
+ *                                                                              members in the table.
+ *  filled                                  O/P     vector<int>*                If not null, every
+ *                                                                              partition filled is
+ *                                                                              added to it.
+ *************************************************************************************************/
+void one_queue_fill_generic(Data data[NUMBER_OF_SAMPLES], int number_of_samples, int &next_data,
+                            int &number_of_failures, vector<StaticPartition> &partitions,
+                            int &num_data_members_in_partition_table, vector<int>* filled){
+    int last = partitions.size() - 1;                               // The partition that takes anything.
+
+    while(next_data != number_of_samples){                          // Fill as many partitions as possible.
+        int next_data_size = data[next_data].size;                  // Size of the item at the head of the queue.
+
+        int chosen = -1;                                            // The partition the item goes into.
+        for(int i = 0; i <= last; i++){                             // Loop through the partitions in order.
+            if(partitions[i].data_index == -1 &&                    // If the partition is empty and either the
+                (i == last || next_data_size <= partitions[i].size)){   // item fits or this is the last partition:
+                chosen = i;                                         // Use this partition.
+                break;
+            }
+        }
+
+        if(chosen == -1){                                           // The head of the queue is blocked.
+            break;
+        }
+
+        partitions[chosen].data_index = next_data;                  // Put the item into the partition.
+        if(chosen == last && next_data_size > partitions[last].size){   // If it is larger than the last partition:
+            number_of_failures++;                                   // Count it as a failure.
+        }
+
+        if(filled != nullptr){                                      // If the caller wants to know:
+            filled->push_back(chosen);                              // Report the partition.
+        }
+
+        num_data_members_in_partition_table++;                      // One more data member in the table.
+        next_data++;                                                // Move to the next item in the queue.
+    }
+}
+
+/**************************************************************************************************
+ * void one_queue_partitioning_generic(Data data[NUMBER_OF_SAMPLES], int number_of_samples,
+ *                                     const int* sizes, int partition_count,
+ *                                     Results* one_queue_unequal)
+ *
+ * Author: Nolan Davenport
+ * Description: Performs the one queue experiment for a layout configured at runtime. Follows the
+ *              same rules as one_queue_unequal_partitioning. The memory metrics are not recorded.
+ *
+ * Parameters:
+ *  data                    I/P     Data[NUMBER_OF_SAMPLES]     The data to be used in this experiment.
+ *  number_of_samples       I/P     int                         The number of samples in this experiment.
+ *  sizes                   I/P     const int*                  The size of each partition, smallest first.
+ *  partition_count         I/P     int                         The number of partitions.
+ *  one_queue_unequal       O/P     Results*                    Pointer to the structure that holds
+ *                                                              the results of this experiment.
+ *************************************************************************************************/
+void one_queue_partitioning_generic(Data data[NUMBER_OF_SAMPLES], int number_of_samples,
+                                    const int* sizes, int partition_count, Results* one_queue_unequal){
+    vector<int> left(number_of_samples);            // Only the time left changes during the experiment.
+    for(int i = 0; i < number_of_samples; i++){     // Loop through each sample.
+        left[i] = data[i].left;                     // Copy the time left.
+    }
+
+    int number_of_failures = 0;                     // Initialize the number of failures to zero.
+
+    vector<StaticPartition> partitions(partition_count);    // Create the partitions.
+    for(int i = 0; i < partition_count; i++){               // Loop through the partitions.
+        partitions[i].size = sizes[i];                      // Set the size from the layout.
+        partitions[i].data_index = -1;                      // Mark the partition as empty.
+    }
+
+    int next_data = 0;                              // The head of the queue.
+    int num_data_members_in_partition_table = 0;    // The number of data members in the partition table.
+    one_queue_fill_generic(data, number_of_samples, next_data,          // Put the initial data into the table.
+        number_of_failures, partitions, num_data_members_in_partition_table);
+
+    int curr_partition = 0;                         // Initialize the current partition to zero.
+    int clock = 0;                                  // Initialize the clock to zero.
+
+    float average_num_data_members_in_partition_table = 0;  // Cumulative value used for the average.
+
+    for(;;){                                                        // Start the clock loop.
+        int index = partitions[curr_partition].data_index;          // The data in the current partition.
+        if(index == -1){                                            // If the partition is empty, skip it
+            curr_partition = (curr_partition + 1) % partition_count;    // without incrementing the clock.
+            continue;
+        }
+
+        if(--left[index] == 0){                                     // Work for one quantum. If the data is finished:
+            int turn_around_time = clock - data[index].time_start;  // Calculate the turnaround time.
+
+            one_queue_unequal->turn_around_time += turn_around_time;    // Add it to the cumulative turnaround time.
+            float relative_turn_around_time =                           // Calculate the relative turnaround time.
+                (float)turn_around_time / data[index].time;
+            one_queue_unequal->relative_turn_around_time += relative_turn_around_time;    // Add it to the cumulative value.
+            record_completion(index, clock);                                                 // Record when it finished.
+            histogram_record(one_queue_unequal->turn_around_histogram, turn_around_time);    // Record both for the percentiles.
+            record_relative_turn_around(one_queue_unequal->relative_turn_around_histogram,
+                turn_around_time, data[index].time);
+
+            partitions[curr_partition].data_index = -1;             // Clear this partition.
+            num_data_members_in_partition_table--;                  // Decrement the number of data members.
+
+            if(next_data != number_of_samples){                     // As long as there is more data in the queue:
+                one_queue_fill_generic(data, number_of_samples,     // Fill the partitions from the queue.
+                    next_data, number_of_failures, partitions,
+                    num_data_members_in_partition_table);
+            }else if(num_data_members_in_partition_table == 0){     // If the queue and the table are empty:
+                break;                                              // End this experiment.
+            }
+        }
+
+        curr_partition = (curr_partition + 1) % partition_count;    // Move to the next partition.
+        clock++;                                                    // Increment the clock.
+        average_num_data_members_in_partition_table +=              // Add to the cumulative average variable.
+            num_data_members_in_partition_table;
+    }
+
+    average_num_data_members_in_partition_table /= clock;           // Calculate the average for this experiment.
+
+    one_queue_unequal->average_num_data_members_in_partition_table +=   // Add it to the cumulative variable.
+        average_num_data_members_in_partition_table;
+    one_queue_unequal->number_of_failures += number_of_failures;        // Add the failures to the cumulative variable.
+}
+
+/**************************************************************************************************
+ * int multiple_queues_assign_generic(Data data[NUMBER_OF_SAMPLES], int number_of_samples,
+ *                                    const int* sizes, int partition_count,
+ *                                    vector<queue<int>> &queues)
+ *
+ * Author: Nolan Davenport
+ * Description: Puts every sample in the queue of the first partition it fits in, alternating
+ *              between partitions of the same size. Anything too large goes to the last
+ *              partition and counts as a failure.
+ *
+ * Parameters:
+ *  data                            I/P     Data[NUMBER_OF_SAMPLES]     The data to be used in this
+ *                                                                      experiment.
+ *  number_of_samples               I/P     int                         The number of samples.
+ *  sizes                           I/P     const int*                  The size of each partition,
+ *                                                                      smallest first.
+ *  partition_count                 I/P     int                         The number of partitions.
+ *  queues                          O/P     vector<queue<int>> (&)      The queue of each partition,
+ *                                                                      holding data indexes.
+ *  multiple_queues_assign_generic  O/P     int                         The number of failures.
+ *************************************************************************************************/
+int multiple_queues_assign_generic(Data data[NUMBER_OF_SAMPLES], int number_of_samples,
+                                   const int* sizes, int partition_count, vector<queue<int>> &queues){
+    int last = partition_count - 1;                 // The partition that takes anything.
+    int number_of_failures = 0;                     // Initialize the number of failures to zero.
+
+    vector<int> group_starts(partition_count);      // The first partition of each run of equal sizes.
+    vector<int> rotation(partition_count);          // The next partition to use within each run.
+    for(int i = 0; i < partition_count; i++){       // Loop through the partitions.
+        if(i > 0 && sizes[i] == sizes[i-1]){        // If it is the same size as the one before:
+            group_starts[i] = group_starts[i-1];    // It belongs to the same run.
+        }else{
+            group_starts[i] = i;                    // Otherwise it starts a new run.
+        }
+        rotation[i] = group_starts[i];              // Each run starts with its first partition.
+    }
+
+    for(int i = 0; i < number_of_samples; i++){     // Loop through all samples.
+        int group = group_starts[last];             // Anything that fits nowhere else goes in the last run.
+        for(int p = 0; p < partition_count; p++){   // Loop through the partitions in order.
+            if(data[i].size <= sizes[p]){           // If the data fits in this partition:
+                group = group_starts[p];            // Use its run.
+                break;
+            }
+        }
+        if(group == group_starts[last] && data[i].size > sizes[last]){  // If it is larger than the last partition:
+            number_of_failures++;                   // Count it as a failure.
+        }
+
+        int queue_index = rotation[group];          // Alternate between the partitions of the run.
+        rotation[group] = (queue_index + 1 < partition_count && sizes[queue_index + 1] == sizes[group]) ?
+            queue_index + 1 : group;
+
+        queues[queue_index].push(i);                // Put it in the queue.
+    }
+
+    return number_of_failures;
+}
+
+/**************************************************************************************************
+ * void multiple_queues_partitioning_generic(Data data[NUMBER_OF_SAMPLES], int number_of_samples,
+ *                                           const int* sizes, int partition_count,
+ *                                           Results* multiple_queues_unequal)
+ *
+ * Author: Nolan Davenport
+ * Description: Performs the multiple queues experiment for a layout configured at runtime.
+ *              Follows the same rules as multiple_queues_unequal_partitioning: each sample goes
+ *              to the queue of the first partition it fits in, alternating between partitions
+ *              of the same size, and anything too large goes to the last partition. The memory
+ *              metrics are not recorded.
+ *
+ * Parameters:
+ *  data                        I/P     Data[NUMBER_OF_SAMPLES]     The data to be used in this
+ *                                                                  experiment.
+ *  number_of_samples           I/P     int                         The number of samples in this
+ *                                                                  experiment.
+ *  sizes                       I/P     const int*                  The size of each partition,
+ *                                                                  smallest first.
+ *  partition_count             I/P     int                         The number of partitions.
+ *  multiple_queues_unequal     O/P     Results*                    Pointer to the structure that holds
+ *                                                                  the results of this experiment.
+ *************************************************************************************************/
+void multiple_queues_partitioning_generic(Data data[NUMBER_OF_SAMPLES], int number_of_samples,
+                                          const int* sizes, int partition_count,
+                                          Results* multiple_queues_unequal){
+    vector<int> left(number_of_samples);            // Only the time left changes during the experiment.
+    for(int i = 0; i < number_of_samples; i++){     // Loop through all samples.
+        left[i] = data[i].left;                     // Copy the time left.
+    }
+
+    vector<queue<int>> queues(partition_count);     // The multiple queues, holding data indexes.
+    int number_of_failures = multiple_queues_assign_generic(data,   // Put every sample in its queue.
+        number_of_samples, sizes, partition_count, queues);
+
+    vector<StaticPartition> partitions(partition_count);    // Create the partitions.
+    int num_data_members_in_partition_table = 0;            // The number of data members in the partition table.
+    for(int i = 0; i < partition_count; i++){               // Loop through the partitions.
+        partitions[i].size = sizes[i];                      // Set the size from the layout.
+        partitions[i].data_index = -1;                      // Start with the partition empty.
+        if(!queues[i].empty()){                             // As long as the queue for the partition isn't empty:
+            partitions[i].data_index = queues[i].front();   // Take the front of the queue.
+            queues[i].pop();
+            num_data_members_in_partition_table++;
+        }
+    }
+
+    int curr_partition = 0;                         // Initialize the current partition to zero.
+    int clock = 0;                                  // Initialize the clock to zero.
+
+    float average_num_data_members_in_partition_table = 0;  // Cumulative value used for the average.
+
+    for(;;){                                                        // Clock loop.
+        int index = partitions[curr_partition].data_index;          // The data in the current partition.
+        if(index == -1){                                            // If the current partition is empty:
+            curr_partition = (curr_partition + 1) % partition_count;    // Move on without incrementing the clock.
+            continue;
+        }
+
+        if(--left[index] == 0){                                     // Work for one quantum. If the data is finished:
+            int turn_around_time = clock - data[index].time_start;  // Calculate the turnaround time.
+
+            multiple_queues_unequal->turn_around_time += turn_around_time;  // Add it to the cumulative turnaround time.
+            float relative_turn_around_time =                           // Calculate the relative turnaround time.
+                (float)turn_around_time / data[index].time;
+            multiple_queues_unequal->relative_turn_around_time += relative_turn_around_time;    // Add it to the cumulative value.
+            record_completion(index, clock);                                                       // Record when it finished.
+            histogram_record(multiple_queues_unequal->turn_around_histogram, turn_around_time);    // Record both for the percentiles.
+            record_relative_turn_around(multiple_queues_unequal->relative_turn_around_histogram,
+                turn_around_time, data[index].time);
+
+            partitions[curr_partition].data_index = -1;             // Clear this partition.
+            num_data_members_in_partition_table--;                  // Decrement the number of data members.
+
+            if(!queues[curr_partition].empty()){                    // If the queue for this partition isn't empty:
+                partitions[curr_partition].data_index =             // Take the item at the front of the queue.
+                    queues[curr_partition].front();
+                queues[curr_partition].pop();
+                num_data_members_in_partition_table++;
+            }else if(num_data_members_in_partition_table == 0){     // If there's no more data to process:
+                break;                                              // End this experiment.
+            }
+        }
+
+        curr_partition = (curr_partition + 1) % partition_count;    // Move to the next partition.
+        clock++;                                                    // Increment the clock.
+        average_num_data_members_in_partition_table +=              // Add to the cumulative average variable.
+            num_data_members_in_partition_table;
+    }
+
+    average_num_data_members_in_partition_table /= clock;           // Calculate the average for this experiment.
+
+    multiple_queues_unequal->average_num_data_members_in_partition_table += // Add it to the cumulative variable.
+        average_num_data_members_in_partition_table;
+    multiple_queues_unequal->number_of_failures += number_of_failures;      // Add the failures to the cumulative variable.
+}
+
+/**************************************************************************************************
+ * bool layout_matches(const int* sizes, int partition_count)
+ *
+ * Author: Nolan Davenport
+ * Description: Checks whether a runtime layout is the same as a compile time layout.
+ *
+ * Parameters:
+ *  sizes               I/P     const int*      The size of each partition.
+ *  partition_count     I/P     int             The number of partitions.
+ *  layout_matches      O/P     bool            True if the layouts are the same.
+ *************************************************************************************************/
+template<typename Layout>
+static bool layout_matches(const int* sizes, int partition_count){
+    if(partition_count != Layout::count){           // The partition counts must match.
+        return false;
+    }
+    for(int i = 0; i < Layout::count; i++){         // Loop through the partitions.
+        if(sizes[i] != Layout::sizes[i]){           // Every size must match.
+            return false;
+        }
+    }
+    return true;
+}
+
+/**************************************************************************************************
+ * void equal_static_partitioning(Data data[NUMBER_OF_SAMPLES], int number_of_samples,
+ *                                int partition_size, int partition_count, Results* equal)
+ *
+ * Author: Nolan Davenport
+ * Description: Runs the equal experiment on the fixed engine when the layout matches one,
+ *              otherwise on the generic engine.
+ *
+ * Parameters:
+ *  data                I/P     Data[NUMBER_OF_SAMPLES]     The data to be used in this experiment.
+ *  number_of_samples   I/P     int                         The number of samples in this experiment.
+ *  partition_size      I/P     int                         The size of every partition.
+ *  partition_count     I/P     int                         The number of partitions.
+ *  equal               O/P     Results*                    Pointer to the structure that holds the
+ *                                                          results of this experiment.
+ *************************************************************************************************/
+void equal_static_partitioning(Data data[NUMBER_OF_SAMPLES], int number_of_samples,
+                               int partition_size, int partition_count, Results* equal){
+    if(partition_size == EqualLayout::sizes[0] && partition_count == EqualLayout::count &&
+        number_of_samples >= EqualLayout::count){                               // If this is the equal layout:
+        equal_partitioning_fixed<EqualLayout>(data, number_of_samples, equal);  // Use the fixed engine.
+    }else{                                                                      // Otherwise:
+        equal_partitioning_generic(data, number_of_samples,                     // Use the generic engine.
+            partition_size, partition_count, equal);
+    }
+}
+
+/**************************************************************************************************
+ * void one_queue_static_partitioning(Data data[NUMBER_OF_SAMPLES], int number_of_samples,
+ *                                    const int* sizes, int partition_count,
+ *                                    Results* one_queue_unequal)
+ *
+ * Author: Nolan Davenport
+ * Description: Runs the one queue experiment on the fixed engine when the layout matches one,
+ *              otherwise on the generic engine.
+ *
+ * Parameters:
+ *  data                    I/P     Data[NUMBER_OF_SAMPLES]     The data to be used in this experiment.
+ *  number_of_samples       I/P     int                         The number of samples in this experiment.
+ *  sizes                   I/P     const int*                  The size of each partition.
+ *  partition_count         I/P     int                         The number of partitions.
+ *  one_queue_unequal       O/P     Results*                    Pointer to the structure that holds
+ *                                                              the results of this experiment.
+ *************************************************************************************************/
+void one_queue_static_partitioning(Data data[NUMBER_OF_SAMPLES], int number_of_samples,
+                                   const int* sizes, int partition_count, Results* one_queue_unequal){
+    if(layout_matches<UnequalLayout>(sizes, partition_count)){      // If this is the unequal layout:
+        one_queue_partitioning_fixed<UnequalLayout>(data,           // Use the fixed engine.
+            number_of_samples, one_queue_unequal);
+    }else{                                                          // Otherwise:
+        one_queue_partitioning_generic(data, number_of_samples,     // Use the generic engine.
+            sizes, partition_count, one_queue_unequal);
+    }
+}
+
+/**************************************************************************************************
+ * void multiple_queues_static_partitioning(Data data[NUMBER_OF_SAMPLES], int number_of_samples,
+ *                                          const int* sizes, int partition_count,
+ *                                          Results* multiple_queues_unequal)
+ *
+ * Author: Nolan Davenport
+ * Description: Runs the multiple queues experiment on the fixed engine when the layout matches
+ *              one, otherwise on the generic engine.
+ *
+ * Parameters:
+ *  data                        I/P     Data[NUMBER_OF_SAMPLES]     The data to be used in this
+ *                                                                  experiment.
+ *  number_of_samples           I/P     int                         The number of samples in this
+ *                                                                  experiment.
+ *  sizes                       I/P     const int*                  The size of each partition.
+ *  partition_count             I/P     int                         The number of partitions.
+ *  multiple_queues_unequal     O/P     Results*                    Pointer to the structure that holds
+ *                                                                  the results of this experiment.
+ *************************************************************************************************/
+void multiple_queues_static_partitioning(Data data[NUMBER_OF_SAMPLES], int number_of_samples,
+                                         const int* sizes, int partition_count,
+                                         Results* multiple_queues_unequal){
+    if(layout_matches<UnequalLayout>(sizes, partition_count)){          // If this is the unequal layout:
+        multiple_queues_partitioning_fixed<UnequalLayout>(data,         // Use the fixed engine.
+            number_of_samples, multiple_queues_unequal);
+    }else{                                                              // Otherwise:
+        multiple_queues_partitioning_generic(data, number_of_samples,   // Use the generic engine.
+            sizes, partition_count, multiple_queues_unequal);
+    }
+}
+
+/**************************************************************************************************
+ * void batch_static_partitioning(const Data* const workloads[], const int sample_counts[],
+ *                                int number_of_workloads, StaticStyle style, const int* sizes,
+ *                                int partition_count, Results* results)
+ *
+ * Author: Nolan Davenport
+ * Description: Runs a batch of static partitioning experiments one at a time, each on the fixed
+ *              engine when the layout matches one, otherwise on the generic one. The workloads
+ *              are not changed.
+ *
+ * Parameters:
+ *  workloads               I/P     const Data* const[]     The data of each experiment.
+ *  sample_counts           I/P     const int[]             The number of samples of each experiment.
+ *  number_of_workloads     I/P     int                     The number of experiments.
+ *  style                   I/P     StaticStyle             The partitioning style.
+ *  sizes                   I/P     const int*              The size of each partition in MB.
+ *  partition_count         I/P     int                     The number of partitions.
+ *  results                 O/P     Results*                Pointer to the structure that holds
+ *                                                          the results of the batch.
+ *************************************************************************************************/
+void batch_static_partitioning(const Data* const workloads[], const int sample_counts[],
+                               int number_of_workloads, StaticStyle style, const int* sizes,
+                               int partition_count, Results* results){
+    vector<Data> data;                                          // The engines change the data, so they
+    for(int experiment = 0; experiment < number_of_workloads; experiment++){   // run on a copy.
+        data.assign(workloads[experiment], workloads[experiment] + sample_counts[experiment]);
+        if(data.empty()){                                       // Experiments without data add nothing.
+            continue;
+        }
+        if(style == EQUAL_STYLE){
+            equal_static_partitioning(data.data(), data.size(), sizes[0], partition_count, results);
+        }else if(style == ONE_QUEUE_STYLE){
+            one_queue_static_partitioning(data.data(), data.size(), sizes, partition_count, results);
+        }else{
+            multiple_queues_static_partitioning(data.data(), data.size(), sizes, partition_count, results);
+        }
+    }
+}
\ No newline at end of file
@@ -0,0 +1,483 @@
+/**************************************************************************************************
+ * File: static_layouts.h
+ * Author: Nolan Davenport
+ * Procedures:
+ *
+ * layout_group_starts                      - Finds the first partition of each run of equally
+ *                                            sized partitions in a compile time layout.
+ *
+ * equal_partitioning_fixed                 - Performs the equal partitioning experiment for a
+ *                                            layout known at compile time.
+ *
+ * one_queue_fill_fixed                     - Fills the partitions of a compile time layout from
+ *                                            the single queue.
+ *
+ * one_queue_partitioning_fixed             - Performs the one queue experiment for a layout known
+ *                                            at compile time.
+ *
+ * multiple_queues_partitioning_fixed       - Performs the multiple queues experiment for a layout
+ *                                            known at compile time.
+ *
+ * equal_partitioning_generic               - Performs the equal partitioning experiment for a
+ *                                            layout configured at runtime.
+ *
+ * one_queue_partitioning_generic           - Performs the one queue experiment for a layout
+ *                                            configured at runtime.
+ *
+ * one_queue_fill_generic                   - Fills the partitions of a runtime layout from the
+ *                                            single queue.
+ *
+ * multiple_queues_assign_generic           - Puts every sample in the queue of the partition it
+ *                                            goes to in the multiple queues style.
+ *
+ * multiple_queues_partitioning_generic     - Performs the multiple queues experiment for a layout
+ *                                            configured at runtime.
+ *
+ * equal_static_partitioning                - Runs the equal experiment on the fixed engine when
+ *                                            the layout matches one, otherwise the generic one.
+ *
+ * one_queue_static_partitioning            - Runs the one queue experiment on the fixed engine
+ *                                            when the layout matches one, otherwise the generic one.
+ *
+ * multiple_queues_static_partitioning      - Runs the multiple queues experiment on the fixed
+ *                                            engine when the layout matches one, otherwise the
+ *                                            generic one.
+ *
+ * batch_static_partitioning                - Runs a batch of static partitioning experiments, each
+ *                                            on the engine for its layout.
+ *************************************************************************************************/
+
+#pragma once
+
+#include<iostream>
+#include<random>
+#include<queue>
+#include<list>
+#include<array>
+#include<vector>
+
+#include"main.h"
+#include"histogram.h"
+#include"scheduling.h"
+
+// Compile time description of the equal layout used by equal_partitioning.
+struct EqualLayout{
+    static constexpr int count = 7;                                 // Number of partitions.
+    static constexpr int sizes[count] = {8, 8, 8, 8, 8, 8, 8};      // Size of each partition in MB.
+};
+
+// Compile time description of the unequal layout made by setup_unequal_static_partitions.
+struct UnequalLayout{
+    static constexpr int count = 7;                                 // Number of partitions.
+    static constexpr int sizes[count] = {2, 4, 6, 8, 8, 12, 16};    // Size of each partition in MB.
+};
+
+/**************************************************************************************************
+ * constexpr array<int, Layout::count> layout_group_starts()
+ *
+ * Author: Nolan Davenport
+ * Description: Finds, for every partition of a layout, the first partition of the run of equally
+ *              sized partitions it belongs to. The multiple queues style alternates between the
+ *              partitions of such a run (like the two 8MB partitions).
+ *
+ * Parameters:
+ *  layout_group_starts     O/P     array<int, Layout::count>   The first partition of each run.
+ *************************************************************************************************/
+template<typename Layout>
+constexpr std::array<int, Layout::count> layout_group_starts(){
+    std::array<int, Layout::count> starts{};                        // The first partition of each run.
+    for(int i = 0; i < Layout::count; i++){                         // Loop through the partitions.
+        if(i > 0 && Layout::sizes[i] == Layout::sizes[i-1]){        // If this partition is the same size as the one before:
+            starts[i] = starts[i-1];                                // It belongs to the same run.
+        }else{                                                      // Otherwise:
+            starts[i] = i;                                          // It starts a new run.
+        }
+    }
+    return starts;                                                  // Return the table.
+}
+
+/**************************************************************************************************
+ * template<typename Layout>
+ * void equal_partitioning_fixed(Data data[NUMBER_OF_SAMPLES], int number_of_samples, Results* equal)
+ *
+ * Author: Nolan Davenport
+ * Description: Performs the equal partitioning experiment for a layout known at compile time.
+ *              Produces exactly the same results as equal_partitioning. Only the time left is
+ *              copied and the partition count is a constant, so the rotation needs no division.
+ *              The memory metrics are not recorded, so the results have no utilization,
+ *              fragmentation or hole data; equal_partitioning has them.
+ *
+ * Parameters:
+ *  data                I/P     Data[NUMBER_OF_SAMPLES]     The data to be used in this experiment.
+ *  number_of_samples   I/P     int                         The number of samples in this experiment.
+ *  equal               O/P     Results*                    Pointer to the structure that holds the
+ *                                                          results of this experiment.
+ *************************************************************************************************/
+template<typename Layout>
+void equal_partitioning_fixed(Data data[NUMBER_OF_SAMPLES], int number_of_samples, Results* equal){
+    constexpr int count = Layout::count;            // Number of partitions.
+    constexpr int size = Layout::sizes[0];          // Every partition has the same size.
+
+    std::vector<int> left(number_of_samples);       // Only the time left changes during the experiment.
+    for(int i = 0; i < number_of_samples; i++){     // Loop through each sample.
+        left[i] = data[i].left;                     // Copy the time left.
+    }
+
+    int number_of_failures = 0;                     // Initialize number of failures to zero.
+
+    int active = std::min(count, number_of_samples); // Partitions that start with data.
+
+    std::array<StaticPartition, count> partitions;  // Create the array of static partitions.
+    for(int i = 0; i < count; i++){                 // Loop through the partitions.
+        partitions[i].size = size;                  // Set the size of the partition.
+        partitions[i].data_index = (i < active) ? i : -1;   // Initially assign the first tasks/data.
+        if(i < active && data[i].size > size){      // If the size of the data is greater than the partition:
+            number_of_failures++;                   // Count it as a failure.
+        }
+    }
+
+    int num_data_members_in_partition_table = active;   // Every partition with data starts full.
+    int next_data = active;                             // The next data element in the queue.
+    int curr_partition = 0;                             // Initialize the current partition to zero.
+    int clock = 0;                                      // Initialize the clock to zero.
+
+    float average_num_data_members_in_partition_table = 0;  // Cumulative value used for the average.
+
+    for(;;){                                                    // Clock loop.
+        int index = partitions[curr_partition].data_index;      // The data in the current partition.
+        if(index == -1){                                        // If the partition is empty:
+            curr_partition = (curr_partition + 1 == count) ?    // Move to the next partition without
+                0 : curr_partition + 1;                         // incrementing the clock.
+            continue;
+        }
+
+        if(--left[index] == 0){                                 // Work for one quantum. If the data is finished:
+            int turn_around_time = clock - data[index].time_start;  // Calculate the turnaround time.
+
+            equal->turn_around_time += turn_around_time;        // Add it to the cumulative turnaround time.
+            float relative_turn_around_time =                           // Calculate the relative turnaround time.
+                (float)turn_around_time / data[index].time;
+            equal->relative_turn_around_time += relative_turn_around_time;    // Add it to the cumulative value.
+            record_completion(index, clock);                                     // Record when it finished.
+            histogram_record(equal->turn_around_histogram, turn_around_time);    // Record both for the percentiles.
+            record_relative_turn_around(equal->relative_turn_around_histogram,
+                turn_around_time, data[index].time);
+
+            if(next_data != number_of_samples){                     // If the queue isn't empty:
+                partitions[curr_partition].data_index = next_data;  // Move the front of the queue into the partition.
+                if(data[next_data].size > size){                    // If it doesn't fit in the partition:
+                    number_of_failures++;                           // Count it as a failure.
+                }
+                next_data++;                                        // Move to the next item in the queue.
+            }else{
+                partitions[curr_partition].data_index = -1;     // Otherwise set the partition to empty.
+                num_data_members_in_partition_table--;          // Decrement the number of data members.
+                if(num_data_members_in_partition_table == 0){   // If the partition table is empty:
+                    break;                                      // The experiment is done.
+                }
+            }
+        }
+
+        curr_partition = (curr_partition + 1 == count) ?        // Move to the next partition.
+            0 : curr_partition + 1;
+        clock++;                                                // Increment the clock.
+        average_num_data_members_in_partition_table +=          // Add to the cumulative average variable.
+            num_data_members_in_partition_table;
+    }
+
+    average_num_data_members_in_partition_table /= clock;       // Calculate the average for this experiment.
+
+    equal->average_num_data_members_in_partition_table +=       // Add it to the cumulative variable.
+        average_num_data_members_in_partition_table;
+    equal->number_of_failures += number_of_failures;            // Add the failures to the cumulative variable.
+}
+
+/**************************************************************************************************
+ * template<typename Layout>
+ * void one_queue_fill_fixed(Data data[NUMBER_OF_SAMPLES], int number_of_samples, int &next_data,
+ *                           int &number_of_failures, array<StaticPartition, Layout::count> &partitions,
+ *                           int &num_data_members_in_partition_table)
+ *
+ * Author: Nolan Davenport
+ * Description: Fills the partitions of a compile time layout from the single queue. Mirrors
+ *              one_queue_fill_unequal_partitions: the smallest empty partition that the data fits
+ *              in is used and the last partition takes anything. The size checks are constants.
+ *
+ * Parameters:
+ *  data                                    I/P     Data[NUMBER_OF_SAMPLES]     The data being processed.
+ *  number_of_samples                       I/P     int                         The number of samples.
+ *  next_data                               I/O     int (&)                     The head of the queue.
+ *  number_of_failures                      O/P     int (&)                     The number of failures.
+ *  partitions                              I/O     array<StaticPartition> (&)  The partition table.
+ *  num_data_members_in_partition_table     O/P     int (&)                     The number of data
+ *                                                                              members in the table.
+ *************************************************************************************************/
+template<typename Layout>
+inline void one_queue_fill_fixed(Data data[NUMBER_OF_SAMPLES], int number_of_samples, int &next_data,
+                                 int &number_of_failures, std::array<StaticPartition, Layout::count> &partitions,
+                                 int &num_data_members_in_partition_table){
+    constexpr int last = Layout::count - 1;                         // The partition that takes anything.
+
+    while(next_data != number_of_samples){                          // Fill as many partitions as possible.
+        int next_data_size = data[next_data].size;                  // Size of the item at the head of the queue.
+
+        int chosen = -1;                                            // The partition the item goes into.
+        for(int i = 0; i < Layout::count; i++){                     // Loop through the partitions, smallest first.
+            if(partitions[i].data_index == -1 &&                    // If the partition is empty and either the
+                (i == last || next_data_size <= Layout::sizes[i])){ // item fits or this is the last partition:
+                chosen = i;                                         // Use this partition.
+                break;
+            }
+        }
+
+        if(chosen == -1){                                           // The head of the queue is blocked.
+            break;
+        }
+
+        partitions[chosen].data_index = next_data;                  // Put the item into the partition.
+        if(chosen == last && next_data_size > Layout::sizes[last]){ // If it is larger than the largest partition:
+            number_of_failures++;                                   // Count it as a failure.
+        }
+
+        num_data_members_in_partition_table++;                      // One more data member in the table.
+        next_data++;                                                // Move to the next item in the queue.
+    }
+}
+
+/**************************************************************************************************
+ * template<typename Layout>
+ * void one_queue_partitioning_fixed(Data data[NUMBER_OF_SAMPLES], int number_of_samples,
+ *                                   Results* one_queue_unequal)
+ *
+ * Author: Nolan Davenport
+ * Description: Performs the one queue experiment for a layout known at compile time. Produces
+ *              exactly the same results as one_queue_unequal_partitioning for UnequalLayout,
+ *              except for the memory metrics, which it doesn't record.
+ *
+ * Parameters:
+ *  data                    I/P     Data[NUMBER_OF_SAMPLES]     The data to be used in this experiment.
+ *  number_of_samples       I/P     int                         The number of samples in this experiment.
+ *  one_queue_unequal       O/P     Results*                    Pointer to the structure that holds
+ *                                                              the results of this experiment.
+ *************************************************************************************************/
+template<typename Layout>
+void one_queue_partitioning_fixed(Data data[NUMBER_OF_SAMPLES], int number_of_samples,
+                                  Results* one_queue_unequal){
+    constexpr int count = Layout::count;            // Number of partitions.
+
+    std::vector<int> left(number_of_samples);       // Only the time left changes during the experiment.
+    for(int i = 0; i < number_of_samples; i++){     // Loop through each sample.
+        left[i] = data[i].left;                     // Copy the time left.
+    }
+
+    int number_of_failures = 0;                     // Initialize the number of failures to zero.
+
+    std::array<StaticPartition, count> partitions;  // Create the array of partitions.
+    for(int i = 0; i < count; i++){                 // Loop through the partitions.
+        partitions[i].size = Layout::sizes[i];      // Set the size from the layout.
+        partitions[i].data_index = -1;              // Mark the partition as empty.
+    }
+
+    int next_data = 0;                              // The head of the queue.
+    int num_data_members_in_partition_table = 0;    // The number of data members in the partition table.
+    one_queue_fill_fixed<Layout>(data, number_of_samples, next_data,    // Put the initial data into the table.
+        number_of_failures, partitions, num_data_members_in_partition_table);
+
+    int curr_partition = 0;                         // Initialize the current partition to zero.
+    int clock = 0;                                  // Initialize the clock to zero.
+
+    float average_num_data_members_in_partition_table = 0;  // Cumulative value used for the average.
+
+    for(;;){                                                    // Start the clock loop.
+        int index = partitions[curr_partition].data_index;      // The data in the current partition.
+        if(index == -1){                                        // If the partition is empty, skip it without
+            curr_partition = (curr_partition + 1 == count) ?    // incrementing the clock.
+                0 : curr_partition + 1;
+            continue;
+        }
+
+        if(--left[index] == 0){                                 // Work for one quantum. If the data is finished:
+            int turn_around_time = clock - data[index].time_start;  // Calculate the turnaround time.
+
+            one_queue_unequal->turn_around_time += turn_around_time;    // Add it to the cumulative turnaround time.
+            float relative_turn_around_time =                           // Calculate the relative turnaround time.
+                (float)turn_around_time / data[index].time;
+            one_queue_unequal->relative_turn_around_time += relative_turn_around_time;    // Add it to the cumulative value.
+            record_completion(index, clock);                                                 // Record when it finished.
+            histogram_record(one_queue_unequal->turn_around_histogram, turn_around_time);    // Record both for the percentiles.
+            record_relative_turn_around(one_queue_unequal->relative_turn_around_histogram,
+                turn_around_time, data[index].time);
+
+            partitions[curr_partition].data_index = -1;         // Clear this partition.
+            num_data_members_in_partition_table--;              // Decrement the number of data members.
+
+            if(next_data != number_of_samples){                 // As long as there is more data in the queue:
+                one_queue_fill_fixed<Layout>(data,              // Fill the partitions from the queue.
+                    number_of_samples, next_data, number_of_failures,
+                    partitions, num_data_members_in_partition_table);
+            }else if(num_data_members_in_partition_table == 0){ // If the queue and the table are empty:
+                break;                                          // End this experiment.
+            }
+        }
+
+        curr_partition = (curr_partition + 1 == count) ?        // Move to the next partition.
+            0 : curr_partition + 1;
+        clock++;                                                // Increment the clock.
+        average_num_data_members_in_partition_table +=          // Add to the cumulative average variable.
+            num_data_members_in_partition_table;
+    }
+
+    average_num_data_members_in_partition_table /= clock;       // Calculate the average for this experiment.
+
+    one_queue_unequal->average_num_data_members_in_partition_table +=   // Add it to the cumulative variable.
+        average_num_data_members_in_partition_table;
+    one_queue_unequal->number_of_failures += number_of_failures;        // Add the failures to the cumulative variable.
+}
+
+/**************************************************************************************************
+ * template<typename Layout>
+ * void multiple_queues_partitioning_fixed(Data data[NUMBER_OF_SAMPLES], int number_of_samples,
+ *                                         Results* multiple_queues_unequal)
+ *
+ * Author: Nolan Davenport
+ * Description: Performs the multiple queues experiment for a layout known at compile time.
+ *              Produces exactly the same results as multiple_queues_unequal_partitioning for
+ *              UnequalLayout. The queues are index ranges of one array instead of queue<Data>.
+ *              No memory metrics are recorded.
+ *
+ * Parameters:
+ *  data                        I/P     Data[NUMBER_OF_SAMPLES]     The data to be used in this
+ *                                                                  experiment.
+ *  number_of_samples           I/P     int                         The number of samples in this
+ *                                                                  experiment.
+ *  multiple_queues_unequal     O/P     Results*                    Pointer to the structure that holds
+ *                                                                  the results of this experiment.
+ *************************************************************************************************/
+template<typename Layout>
+void multiple_queues_partitioning_fixed(Data data[NUMBER_OF_SAMPLES], int number_of_samples,
+                                        Results* multiple_queues_unequal){
+    constexpr int count = Layout::count;                                    // Number of partitions.
+    constexpr int last = count - 1;                                         // The partition that takes anything.
+    constexpr std::array<int, count> group_starts = layout_group_starts<Layout>(); // First partition of each run.
+
+    std::vector<int> left(number_of_samples);       // Only the time left changes during the experiment.
+    std::vector<int> queue_of(number_of_samples);   // The queue each sample was placed in.
+    int number_of_failures = 0;                     // Initialize the number of failures to zero.
+
+    std::array<int, count> rotation;                // The next partition to use within each run.
+    for(int i = 0; i < count; i++){                 // Loop through the partitions.
+        rotation[i] = group_starts[i];              // Each run starts with its first partition.
+    }
+
+    std::array<int, count + 1> queue_start{};       // Where each queue starts in the ordered array.
+    for(int i = 0; i < number_of_samples; i++){     // Loop through all samples.
+        left[i] = data[i].left;                     // Copy the time left.
+
+        int group = group_starts[last];             // Anything that fits nowhere else goes in the last run.
+        for(int p = 0; p < count; p++){             // Loop through the partitions, smallest first.
+            if(data[i].size <= Layout::sizes[p]){   // If the data fits in this partition:
+                group = group_starts[p];            // Use its run.
+                break;
+            }
+        }
+        if(group == group_starts[last] &&           // If the data is larger than the largest partition:
+            data[i].size > Layout::sizes[last]){
+            number_of_failures++;                   // Count it as a failure.
+        }
+
+        int queue = rotation[group];                // Alternate between the partitions of the run.
+        rotation[group] = (queue + 1 < count && Layout::sizes[queue + 1] == Layout::sizes[group]) ?
+            queue + 1 : group;
+
+        queue_of[i] = queue;                        // Remember the queue.
+        queue_start[queue + 1]++;                   // Count the members of the queue.
+    }
+
+    for(int i = 0; i < count; i++){                 // Turn the counts into starting positions.
+        queue_start[i + 1] += queue_start[i];
+    }
+
+    std::vector<int> queues(number_of_samples);     // The queues stored back to back.
+    std::array<int, count> queue_head;              // The front of each queue.
+    std::array<int, count> queue_tail;              // One past the back of each queue.
+    for(int i = 0; i < count; i++){                 // Loop through the queues.
+        queue_head[i] = queue_start[i];
+        queue_tail[i] = queue_start[i];
+    }
+    for(int i = 0; i < number_of_samples; i++){     // Place every sample in its queue, keeping the order.
+        queues[queue_tail[queue_of[i]]++] = i;
+    }
+
+    std::array<StaticPartition, count> partitions;  // Create an array of static partitions.
+    int num_data_members_in_partition_table = 0;    // The number of data members in the partition table.
+    for(int i = 0; i < count; i++){                 // Loop through the partitions.
+        partitions[i].size = Layout::sizes[i];      // Set the size from the layout.
+        if(queue_head[i] != queue_tail[i]){         // As long as the queue for the partition isn't empty:
+            partitions[i].data_index = queues[queue_head[i]++];     // Take the front of the queue.
+            num_data_members_in_partition_table++;
+        }else{
+            partitions[i].data_index = -1;          // Otherwise the partition is empty.
+        }
+    }
+
+    int curr_partition = 0;                         // Initialize the current partition to zero.
+    int clock = 0;                                  // Initialize the clock to zero.
+
+    float average_num_data_members_in_partition_table = 0;  // Cumulative value used for the average.
+
+    for(;;){                                                    // Clock loop.
+        int index = partitions[curr_partition].data_index;      // The data in the current partition.
+        if(index == -1){                                        // If the current partition is empty:
+            curr_partition = (curr_partition + 1 == count) ?    // Go to the next partition without
+                0 : curr_partition + 1;                         // incrementing the clock.
+            continue;
+        }
+
+        if(--left[index] == 0){                                 // Work for one quantum. If the data is finished:
+            int turn_around_time = clock - data[index].time_start;  // Calculate the turnaround time.
+
+            multiple_queues_unequal->turn_around_time += turn_around_time;  // Add it to the cumulative turnaround time.
+            float relative_turn_around_time =                           // Calculate the relative turnaround time.
+                (float)turn_around_time / data[index].time;
+            multiple_queues_unequal->relative_turn_around_time += relative_turn_around_time;    // Add it to the cumulative value.
+            record_completion(index, clock);                                                       // Record when it finished.
+            histogram_record(multiple_queues_unequal->turn_around_histogram, turn_around_time);    // Record both for the percentiles.
+            record_relative_turn_around(multiple_queues_unequal->relative_turn_around_histogram,
+                turn_around_time, data[index].time);
+
+            partitions[curr_partition].data_index = -1;         // Clear this partition.
+            num_data_members_in_partition_table--;              // Decrement the number of data members.
+
+            if(queue_head[curr_partition] != queue_tail[curr_partition]){   // If the queue for this partition isn't empty:
+                partitions[curr_partition].data_index =                     // Take the item at the front of the queue.
+                    queues[queue_head[curr_partition]++];
+                num_data_members_in_partition_table++;
+            }else if(num_data_members_in_partition_table == 0){ // If there's no more data to process:
+                break;                                          // End this experiment.
+            }
+        }
+
+        curr_partition = (curr_partition + 1 == count) ?        // Move to the next partition.
+            0 : curr_partition + 1;
+        clock++;                                                // Increment the clock.
+        average_num_data_members_in_partition_table +=          // Add to the cumulative average variable.
+            num_data_members_in_partition_table;
+    }
+
+    average_num_data_members_in_partition_table /= clock;       // Calculate the average for this experiment.
+
+    multiple_queues_unequal->average_num_data_members_in_partition_table += // Add it to the cumulative variable.
+        average_num_data_members_in_partition_table;
+    multiple_queues_unequal->number_of_failures += number_of_failures;      // Add the failures to the cumulative variable.
+}
+
+// Function prototypes
+void equal_partitioning_generic(Data e[NUMBER_OF_SAMPLES], int number_of_samples, int partition_size, int partition_count, Results* equal);
+void one_queue_partitioning_generic(Data e[NUMBER_OF_SAMPLES], int number_of_samples, const int* sizes, int partition_count, Results* one_queue_unequal);
+void one_queue_fill_generic(Data e[NUMBER_OF_SAMPLES], int number_of_samples, int &next_data, int &number_of_failures, std::vector<StaticPartition> &partitions, int &num_data_members_in_partition_table, std::vector<int>* filled = nullptr);
+int multiple_queues_assign_generic(Data e[NUMBER_OF_SAMPLES], int number_of_samples, const int* sizes, int partition_count, std::vector<std::queue<int>> &queues);
+void multiple_queues_partitioning_generic(Data e[NUMBER_OF_SAMPLES], int number_of_samples, const int* sizes, int partition_count, Results* multiple_queues_unequal);
+void equal_static_partitioning(Data e[NUMBER_OF_SAMPLES], int number_of_samples, int partition_size, int partition_count, Results* equal);
+void one_queue_static_partitioning(Data e[NUMBER_OF_SAMPLES], int number_of_samples, const int* sizes, int partition_count, Results* one_queue_unequal);
+void multiple_queues_static_partitioning(Data e[NUMBER_OF_SAMPLES], int number_of_samples, const int* sizes, int partition_count, Results* multiple_queues_unequal);
+void batch_static_partitioning(const Data* const workloads[], const int sample_counts[], int number_of_workloads, StaticStyle style, const int* sizes, int partition_count, Results* results);
\ No newline at end of file
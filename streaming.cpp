@@ -0,0 +1,611 @@
+/**************************************************************************************************
+ * File: streaming.cpp
+ * Author: Nolan Davenport
+ * Procedures:
+ *
+ * produce_jobs                         - Generates the jobs of a job stream in chunks. This runs
+ *                                        on the producer thread.
+ *
+ * job_stream_start                     - Starts the producer thread of a job stream.
+ *
+ * job_stream_peek                      - Gets the job at the head of a job stream.
+ *
+ * job_stream_pop                       - Removes the job at the head of a job stream.
+ *
+ * job_stream_stop                      - Stops the producer thread of a job stream.
+ *
+ * equal_partitioning_streamed          - Performs the equal partitioning experiment on jobs from
+ *                                        a job stream.
+ *
+ * one_queue_fill_streamed              - Fills the partitions from the head of a job stream.
+ *
+ * one_queue_partitioning_streamed      - Performs the one queue experiment on jobs from a job
+ *                                        stream.
+ *
+ * dynamic_fill_streamed                - Places jobs from the head of a job stream with first fit.
+ *
+ * dynamic_partitioning_streamed        - Performs the dynamic partitioning experiment on jobs from
+ *                                        a job stream.
+ *
+ * report_streamed_results              - Reports the results of one streamed experiment.
+ *
+ * run_streamed_experiments             - Runs the streamed experiments and reports their results.
+ *************************************************************************************************/
+
+#include<iostream>
+#include<random>
+#include<queue>
+#include<list>
+#include<vector>
+#include<atomic>
+#include<thread>
+#include<chrono>
+
+#include"main.h"
+#include"histogram.h"
+#include"static_layouts.h"
+#include"partition_pool.h"
+#include"streaming.h"
+
+using namespace std;
+
+/**************************************************************************************************
+ * static void produce_jobs(JobStream* stream)
+ *
+ * Author: Nolan Davenport
+ * Description: Generates the jobs of a job stream in chunks. This runs on the producer thread.
+ *              The jobs come from the same distributions, drawn in the same order, as
+ *              generate_experiment_data, so a stream of NUMBER_OF_SAMPLES jobs holds the same
+ *              workload that generate_experiment_data makes from the same seed.
+ *
+ * Parameters:
+ *  stream      I/O     JobStream*      The stream to fill.
+ *************************************************************************************************/
+static void produce_jobs(JobStream* stream){
+    default_random_engine gen;                          // The random engine to generate random numbers.
+    gen.seed(stream->seed);                             // Seed it for this stream.
+    poisson_distribution<int> poisson_dist(8);          // Same size distribution as main.
+    uniform_int_distribution<int> uniform_dist(1,10);   // Same time distribution as main.
+
+    long long generated = 0;                                        // The number of jobs generated so far.
+    for(long long chunk = 0; generated < stream->total_jobs; chunk++){  // Loop through the chunks.
+        while(chunk - stream->consumed.load(memory_order_acquire) == JOB_STREAM_CHUNKS){    // Wait for the
+            if(stream->stopping.load(memory_order_relaxed)){        // consumer to free a chunk, unless
+                return;                                             // the stream is being stopped.
+            }
+            this_thread::yield();
+        }
+
+        JobChunk &next_chunk = stream->chunks[chunk % JOB_STREAM_CHUNKS];   // The chunk to fill.
+        next_chunk.count = (int)min<long long>(JOB_STREAM_CHUNK_SIZE,       // Fill it, or as much as is left.
+            stream->total_jobs - generated);
+        for(int i = 0; i < next_chunk.count; i++){                  // Loop through the jobs in the chunk.
+            Data &job = next_chunk.jobs[i];                         // The job to generate.
+            job.size = max(1, poisson_dist(gen));                   // Set the size from the poisson distribution.
+            job.time = uniform_dist(gen);                           // Set the time from the uniform distribution.
+            job.index = (int)(generated + i);                       // Its position in the stream.
+            job.left = job.time;                                    // Initiate the time left to the time.
+            job.time_start = 0;                                     // Same start time as generated data.
+            job.failure = false;
+        }
+        generated += next_chunk.count;                              // Count the jobs in the chunk.
+
+        stream->produced.store(chunk + 1, memory_order_release);    // Hand the chunk to the consumer.
+    }
+}
+
+/**************************************************************************************************
+ * void job_stream_start(JobStream &stream, long long total_jobs, unsigned seed)
+ *
+ * Author: Nolan Davenport
+ * Description: Starts the producer thread of a job stream.
+ *
+ * Parameters:
+ *  stream      O/P     JobStream (&)   The stream to start.
+ *  total_jobs  I/P     long long       The number of jobs in the stream.
+ *  seed        I/P     unsigned        The seed the jobs are generated from.
+ *************************************************************************************************/
+void job_stream_start(JobStream &stream, long long total_jobs, unsigned seed){
+    stream.produced.store(0);                           // Nothing has been produced
+    stream.consumed.store(0);                           // or consumed yet.
+    stream.stopping.store(false);
+    stream.total_jobs = total_jobs;                     // Remember the size of the stream
+    stream.seed = seed;                                 // and where it comes from.
+    stream.jobs_read = 0;                               // The head is at the first job.
+    stream.read_position = 0;
+    stream.producer = thread(produce_jobs, &stream);    // Start generating.
+}
+
+/**************************************************************************************************
+ * Data* job_stream_peek(JobStream &stream)
+ *
+ * Author: Nolan Davenport
+ * Description: Gets the job at the head of a job stream, waiting for the producer if it has not
+ *              been generated yet. Must only be called from the consumer thread.
+ *
+ * Parameters:
+ *  stream              I/O     JobStream (&)   The stream.
+ *  job_stream_peek     O/P     Data*           The job at the head, or nullptr if the stream is
+ *                                              empty. It stays valid until job_stream_pop.
+ *************************************************************************************************/
+Data* job_stream_peek(JobStream &stream){
+    if(stream.jobs_read == stream.total_jobs){                      // If every job has been taken:
+        return nullptr;                                             // The stream is empty.
+    }
+
+    long long chunk = stream.consumed.load(memory_order_relaxed);   // The chunk the head is in.
+    while(stream.produced.load(memory_order_acquire) <= chunk){     // Wait for it to be produced.
+        this_thread::yield();
+    }
+    return &stream.chunks[chunk % JOB_STREAM_CHUNKS].jobs[stream.read_position];
+}
+
+/**************************************************************************************************
+ * void job_stream_pop(JobStream &stream)
+ *
+ * Author: Nolan Davenport
+ * Description: Removes the job at the head of a job stream. The head must have been fetched
+ *              with job_stream_peek first. Must only be called from the consumer thread.
+ *
+ * Parameters:
+ *  stream      I/O     JobStream (&)   The stream.
+ *************************************************************************************************/
+void job_stream_pop(JobStream &stream){
+    stream.jobs_read++;                                             // One more job taken.
+
+    long long chunk = stream.consumed.load(memory_order_relaxed);   // The chunk the head is in.
+    if(++stream.read_position == stream.chunks[chunk % JOB_STREAM_CHUNKS].count){  // If that was its last job:
+        stream.read_position = 0;                                   // Move to the start of the next chunk
+        stream.consumed.store(chunk + 1, memory_order_release);     // and give this one back to the producer.
+    }
+}
+
+/**************************************************************************************************
+ * void job_stream_stop(JobStream &stream)
+ *
+ * Author: Nolan Davenport
+ * Description: Stops the producer thread of a job stream and waits for it to finish.
+ *
+ * Parameters:
+ *  stream      I/O     JobStream (&)   The stream to stop.
+ *************************************************************************************************/
+void job_stream_stop(JobStream &stream){
+    stream.stopping.store(true, memory_order_relaxed);  // Tell the producer not to wait for room.
+    if(stream.producer.joinable()){                     // If it is still running:
+        stream.producer.join();                         // Wait for it.
+    }
+}
+
+/**************************************************************************************************
+ * void equal_partitioning_streamed(JobStream &stream, int partition_size, int partition_count,
+ *                                  StreamedResults* equal)
+ *
+ * Author: Nolan Davenport
+ * Description: Performs the equal partitioning experiment on jobs from a job stream. Follows the
+ *              same rules as equal_partitioning_generic, but each job is taken from the stream
+ *              when it is admitted and kept in its partition, so memory use does not grow with
+ *              the number of jobs.
+ *
+ * Parameters:
+ *  stream              I/O     JobStream (&)       The stream of jobs.
+ *  partition_size      I/P     int                 The size of every partition.
+ *  partition_count     I/P     int                 The number of partitions.
+ *  equal               O/P     StreamedResults*    The results of this experiment.
+ *************************************************************************************************/
+void equal_partitioning_streamed(JobStream &stream, int partition_size, int partition_count,
+                                 StreamedResults* equal){
+    long long number_of_failures = 0;               // Initialize number of failures to zero.
+
+    vector<StreamedPartition> partitions;           // Create the static partitions.
+    Data* job;                                      // The job at the head of the stream.
+    while((int)partitions.size() < partition_count && (job = job_stream_peek(stream)) != nullptr){
+        partitions.push_back({partition_size, true, job->time, job->left, job->time_start});
+        if(job->size > partition_size){             // If the size of the job is greater than the partition:
+            number_of_failures++;                   // Count it as a failure.
+        }
+        job_stream_pop(stream);                     // Take it from the stream.
+    }
+
+    int active = partitions.size();                 // Number of partitions that get used.
+    if(active == 0){                                // If the stream was empty:
+        return;                                     // There is nothing to do.
+    }
+
+    int num_data_members_in_partition_table = active;   // Every partition starts full.
+    int curr_partition = 0;                             // Initialize the current partition to zero.
+    long long clock = 0;                                // Initialize the clock to zero.
+
+    double average_num_data_members_in_partition_table = 0; // Cumulative value used for the average.
+
+    for(;;){                                                    // Clock loop.
+        StreamedPartition &partition = partitions[curr_partition];  // The current partition.
+        if(!partition.full){                                    // If the partition is empty:
+            curr_partition = (curr_partition + 1 == active) ? 0 : curr_partition + 1;  // Move on without
+            continue;                                           // incrementing the clock.
+        }
+
+        if(--partition.left == 0){                              // Work for one quantum. If the job is finished:
+            long long turn_around_time = clock - partition.time_start;  // Calculate the turnaround time.
+
+            equal->turn_around_time += turn_around_time;        // Add it to the cumulative turnaround time.
+            double relative_turn_around_time =                          // Calculate the relative turnaround time.
+                (double)turn_around_time / partition.time;
+            equal->relative_turn_around_time += relative_turn_around_time;    // Add it to the cumulative value.
+            histogram_record(equal->turn_around_histogram, turn_around_time);    // Record both for the percentiles.
+            record_relative_turn_around(equal->relative_turn_around_histogram,
+                turn_around_time, partition.time);
+            equal->jobs++;                                      // Count the job.
+
+            if((job = job_stream_peek(stream)) != nullptr){     // If the stream isn't empty:
+                partition.time = job->time;                     // Move the head of the stream into the partition.
+                partition.left = job->left;
+                partition.time_start = job->time_start;
+                if(job->size > partition_size){                 // If it doesn't fit in the partition:
+                    number_of_failures++;                       // Count it as a failure.
+                }
+                job_stream_pop(stream);                         // Take it from the stream.
+            }else{
+                partition.full = false;                         // Otherwise set the partition to empty.
+                num_data_members_in_partition_table--;          // Decrement the number of data members.
+                if(num_data_members_in_partition_table == 0){   // If the partition table is empty:
+                    break;                                      // The experiment is done.
+                }
+            }
+        }
+
+        curr_partition = (curr_partition + 1 == active) ? 0 : curr_partition + 1;  // Move to the next partition.
+        clock++;                                                // Increment the clock.
+        average_num_data_members_in_partition_table +=          // Add to the cumulative average variable.
+            num_data_members_in_partition_table;
+    }
+
+    if(clock > 0){                                              // Calculate the average for this experiment.
+        equal->average_num_data_members_in_partition_table = average_num_data_members_in_partition_table / clock;
+    }
+    equal->number_of_failures += number_of_failures;            // Add the failures.
+    equal->clock = clock;                                       // Remember how long it ran.
+}
+
+/**************************************************************************************************
+ * static void one_queue_fill_streamed(JobStream &stream, long long &number_of_failures,
+ *                                     vector<StreamedPartition> &partitions,
+ *                                     int &num_data_members_in_partition_table)
+ *
+ * Author: Nolan Davenport
+ * Description: Fills the partitions from the head of a job stream, following the same rules as
+ *              one_queue_fill_generic.
+ *
+ * Parameters:
+ *  stream                              I/O     JobStream (&)                   The stream of jobs.
+ *  number_of_failures                  O/P     long long (&)                   The number of failures.
+ *  partitions                          I/O     vector<StreamedPartition> (&)   The partitions.
+ *  num_data_members_in_partition_table O/P     int (&)                         The number of data
+ *                                                                              members in the table.
+ *************************************************************************************************/
+static void one_queue_fill_streamed(JobStream &stream, long long &number_of_failures,
+                                    vector<StreamedPartition> &partitions,
+                                    int &num_data_members_in_partition_table){
+    int last = partitions.size() - 1;                               // The partition that takes anything.
+
+    Data* job;                                                      // The job at the head of the stream.
+    while((job = job_stream_peek(stream)) != nullptr){              // Fill as many partitions as possible.
+        int chosen = -1;                                            // The partition the job goes into.
+        for(int i = 0; i <= last; i++){                             // Loop through the partitions in order.
+            if(!partitions[i].full &&                               // If the partition is empty and either the
+                (i == last || job->size <= partitions[i].size)){    // job fits or this is the last partition:
+                chosen = i;                                         // Use this partition.
+                break;
+            }
+        }
+
+        if(chosen == -1){                                           // The head of the stream is blocked.
+            break;
+        }
+
+        partitions[chosen].full = true;                             // Put the job into the partition.
+        partitions[chosen].time = job->time;
+        partitions[chosen].left = job->left;
+        partitions[chosen].time_start = job->time_start;
+        if(chosen == last && job->size > partitions[last].size){    // If it is larger than the last partition:
+            number_of_failures++;                                   // Count it as a failure.
+        }
+
+        num_data_members_in_partition_table++;                      // One more data member in the table.
+        job_stream_pop(stream);                                     // Take it from the stream.
+    }
+}
+
+/**************************************************************************************************
+ * void one_queue_partitioning_streamed(JobStream &stream, const int* sizes, int partition_count,
+ *                                      StreamedResults* one_queue_unequal)
+ *
+ * Author: Nolan Davenport
+ * Description: Performs the one queue experiment on jobs from a job stream. Follows the same
+ *              rules as one_queue_partitioning_generic, but each job is taken from the stream
+ *              when it is admitted and kept in its partition.
+ *
+ * Parameters:
+ *  stream              I/O     JobStream (&)       The stream of jobs.
+ *  sizes               I/P     const int*          The size of each partition, smallest first.
+ *  partition_count     I/P     int                 The number of partitions.
+ *  one_queue_unequal   O/P     StreamedResults*    The results of this experiment.
+ *************************************************************************************************/
+void one_queue_partitioning_streamed(JobStream &stream, const int* sizes, int partition_count,
+                                     StreamedResults* one_queue_unequal){
+    long long number_of_failures = 0;               // Initialize the number of failures to zero.
+
+    vector<StreamedPartition> partitions(partition_count);  // Create the partitions.
+    for(int i = 0; i < partition_count; i++){               // Loop through the partitions.
+        partitions[i].size = sizes[i];                      // Set the size from the layout.
+        partitions[i].full = false;                         // Mark the partition as empty.
+    }
+
+    int num_data_members_in_partition_table = 0;    // The number of data members in the partition table.
+    one_queue_fill_streamed(stream, number_of_failures,         // Put the initial jobs into the table.
+        partitions, num_data_members_in_partition_table);
+    if(num_data_members_in_partition_table == 0){   // If the stream was empty:
+        return;                                     // There is nothing to do.
+    }
+
+    int curr_partition = 0;                         // Initialize the current partition to zero.
+    long long clock = 0;                            // Initialize the clock to zero.
+
+    double average_num_data_members_in_partition_table = 0; // Cumulative value used for the average.
+
+    for(;;){                                                        // Start the clock loop.
+        StreamedPartition &partition = partitions[curr_partition];  // The current partition.
+        if(!partition.full){                                        // If the partition is empty, skip it
+            curr_partition = (curr_partition + 1 == partition_count) ? 0 : curr_partition + 1;
+            continue;                                               // without incrementing the clock.
+        }
+
+        if(--partition.left == 0){                                  // Work for one quantum. If the job is finished:
+            long long turn_around_time = clock - partition.time_start;  // Calculate the turnaround time.
+
+            one_queue_unequal->turn_around_time += turn_around_time;    // Add it to the cumulative turnaround time.
+            double relative_turn_around_time =                          // Calculate the relative turnaround time.
+                (double)turn_around_time / partition.time;
+            one_queue_unequal->relative_turn_around_time += relative_turn_around_time;    // Add it to the cumulative value.
+            histogram_record(one_queue_unequal->turn_around_histogram, turn_around_time);    // Record both for the percentiles.
+            record_relative_turn_around(one_queue_unequal->relative_turn_around_histogram,
+                turn_around_time, partition.time);
+            one_queue_unequal->jobs++;                                  // Count the job.
+
+            partition.full = false;                                 // Clear this partition.
+            num_data_members_in_partition_table--;                  // Decrement the number of data members.
+
+            if(job_stream_peek(stream) != nullptr){                 // As long as there are more jobs:
+                one_queue_fill_streamed(stream, number_of_failures, // Fill the partitions from the stream.
+                    partitions, num_data_members_in_partition_table);
+            }else if(num_data_members_in_partition_table == 0){     // If the stream and the table are empty:
+                break;                                              // End this experiment.
+            }
+        }
+
+        curr_partition = (curr_partition + 1 == partition_count) ? 0 : curr_partition + 1;
+        clock++;                                                    // Increment the clock.
+        average_num_data_members_in_partition_table +=              // Add to the cumulative average variable.
+            num_data_members_in_partition_table;
+    }
+
+    if(clock > 0){                                                  // Calculate the average for this experiment.
+        one_queue_unequal->average_num_data_members_in_partition_table =
+            average_num_data_members_in_partition_table / clock;
+    }
+    one_queue_unequal->number_of_failures += number_of_failures;    // Add the failures.
+    one_queue_unequal->clock = clock;                               // Remember how long it ran.
+}
+
+/**************************************************************************************************
+ * static void dynamic_fill_streamed(JobStream &stream, StreamedDynamicPartitionList &partitions,
+ *                                   long long &number_of_failures,
+ *                                   int &num_data_members_in_partition_table, int memory_units)
+ *
+ * Author: Nolan Davenport
+ * Description: Places jobs from the head of a job stream with first fit, following the same rules
+ *              as perform_first_fit_algorithm: a job goes into the first hole larger than it, or
+ *              the hole at the end if it fits. If neither fits but the free memory does, memory
+ *              is compacted first. Empty memory takes any job, failing it if it is larger than
+ *              memory.
+ *
+ * Parameters:
+ *  stream                              I/O     JobStream (&)                       The stream of jobs.
+ *  partitions                          I/O     StreamedDynamicPartitionList (&)    The partitions.
+ *  number_of_failures                  O/P     long long (&)                       The number of failures.
+ *  num_data_members_in_partition_table O/P     int (&)                             The number of data
+ *                                                                                  members in the table.
+ *  memory_units                        I/P     int                                 The size of memory in MB.
+ *************************************************************************************************/
+static void dynamic_fill_streamed(JobStream &stream, StreamedDynamicPartitionList &partitions,
+                                  long long &number_of_failures,
+                                  int &num_data_members_in_partition_table, int memory_units){
+    Data* job;                                                      // The job at the head of the stream.
+    while((job = job_stream_peek(stream)) != nullptr){              // Place as many jobs as possible.
+        StreamedDynamicPartitionList::iterator it = partitions.begin();    // The partition it goes before.
+        int start = 0;                                              // Where the hole before it starts.
+        int used = 0;                                               // The memory used before the hole.
+        if(!partitions.empty()){                                    // Empty memory takes anything.
+            for(; it != partitions.end(); ++it){                    // Find the first hole larger than the job.
+                if(it->start_location - start > job->size){
+                    break;
+                }
+                start = it->start_location + it->size;
+                used += it->size;
+            }
+            if(it == partitions.end() && memory_units - start < job->size){    // If the hole at the end is
+                if(memory_units - used < job->size){                // too small too, and so is the free memory:
+                    break;                                          // The head of the stream is blocked.
+                }
+                start = 0;                                          // Otherwise compact memory, which merges
+                for(StreamedDynamicPartition &p : partitions){      // every hole into one at the end, and
+                    p.start_location = start;                       // try again.
+                    start += p.size;
+                }
+                continue;
+            }
+        }else if(job->size > memory_units){                         // If it is larger than memory:
+            number_of_failures++;                                   // Count it as a failure.
+        }
+
+        partitions.insert(it, {start, job->size, job->time, job->left, job->time_start});   // Place the job.
+        num_data_members_in_partition_table++;                      // One more data member in the table.
+        job_stream_pop(stream);                                     // Take it from the stream.
+    }
+}
+
+/**************************************************************************************************
+ * void dynamic_partitioning_streamed(JobStream &stream, int memory_units,
+ *                                    StreamedResults* first_fit)
+ *
+ * Author: Nolan Davenport
+ * Description: Performs the dynamic partitioning experiment on jobs from a job stream. Follows
+ *              the same rules as dynamic_partitioning_in_memory, but each job is taken from the
+ *              stream when it is placed and kept in its partition, and the memory metrics aren't
+ *              recorded.
+ *
+ * Parameters:
+ *  stream          I/O     JobStream (&)       The stream of jobs.
+ *  memory_units    I/P     int                 The size of memory in MB.
+ *  first_fit       O/P     StreamedResults*    The results of this experiment.
+ *************************************************************************************************/
+void dynamic_partitioning_streamed(JobStream &stream, int memory_units, StreamedResults* first_fit){
+    long long number_of_failures = 0;               // Initialize the number of failures to zero.
+
+    reset_dynamic_partition_pool();                 // Start this experiment with a fresh pool of list nodes.
+    StreamedDynamicPartitionList partitions(        // Create the list of partitions. Its nodes come from
+        dynamic_partition_resource());              // the pool instead of the heap.
+
+    int num_data_members_in_partition_table = 0;    // The number of data members in the partition table.
+    dynamic_fill_streamed(stream, partitions, number_of_failures,  // Place the initial jobs.
+        num_data_members_in_partition_table, memory_units);
+    if(num_data_members_in_partition_table == 0){   // If the stream was empty:
+        return;                                     // There is nothing to do.
+    }
+
+    StreamedDynamicPartitionList::iterator it = partitions.begin();    // The partition the processor is at.
+    long long clock = 0;                            // Initialize the clock to zero.
+
+    double average_num_data_members_in_partition_table = 0; // Cumulative value used for the average.
+
+    for(;;){                                                        // Clock loop.
+        bool just_erased_a_partition = false;                       // Whether the iterator has already moved on.
+
+        if(--it->left == 0){                                        // Work for one quantum. If the job is finished:
+            long long turn_around_time = clock - it->time_start;    // Calculate the turnaround time.
+
+            first_fit->turn_around_time += turn_around_time;        // Add it to the cumulative turnaround time.
+            double relative_turn_around_time =                      // Calculate the relative turnaround time.
+                (double)turn_around_time / it->time;
+            first_fit->relative_turn_around_time += relative_turn_around_time;    // Add it to the cumulative value.
+            histogram_record(first_fit->turn_around_histogram, turn_around_time);    // Record both for the percentiles.
+            record_relative_turn_around(first_fit->relative_turn_around_histogram,
+                turn_around_time, it->time);
+            first_fit->jobs++;                                      // Count the job.
+
+            it = partitions.erase(it);                              // Remove it from memory and move on.
+            just_erased_a_partition = true;
+            num_data_members_in_partition_table--;                  // Decrement the number of data members.
+
+            dynamic_fill_streamed(stream, partitions, number_of_failures,  // Place jobs in the hole it left.
+                num_data_members_in_partition_table, memory_units);
+            if(num_data_members_in_partition_table == 0){           // If the stream and memory are empty:
+                break;                                              // End this experiment.
+            }
+        }
+
+        if(!just_erased_a_partition){                               // If nothing was erased, move on.
+            it++;
+        }
+
+        if(it == partitions.end()){                                 // If the end of memory was reached:
+            it = partitions.begin();                                // Go back to the start.
+        }
+
+        clock++;                                                    // Increment the clock.
+        average_num_data_members_in_partition_table +=              // Add to the cumulative average variable.
+            num_data_members_in_partition_table;
+    }
+
+    if(clock > 0){                                                  // Calculate the average for this experiment.
+        first_fit->average_num_data_members_in_partition_table =
+            average_num_data_members_in_partition_table / clock;
+    }
+    first_fit->number_of_failures += number_of_failures;            // Add the failures.
+    first_fit->clock = clock;                                       // Remember how long it ran.
+}
+
+/**************************************************************************************************
+ * static void report_streamed_results(const char* name, StreamedResults* results, double seconds)
+ *
+ * Author: Nolan Davenport
+ * Description: Reports the results of one streamed experiment.
+ *
+ * Parameters:
+ *  name        I/P     const char*         The name of the partitioning style.
+ *  results     I/P     StreamedResults*    The results of the experiment.
+ *  seconds     I/P     double              How long the experiment took.
+ *************************************************************************************************/
+static void report_streamed_results(const char* name, StreamedResults* results, double seconds){
+    long long jobs = max(results->jobs, 1LL);       // Avoid dividing by zero for an empty stream.
+
+    cout << name << " streamed jobs: " << results->jobs << endl;
+    cout << name << " streamed number_of_failures: " << results->number_of_failures << endl;
+    cout << name << " streamed average turn_around_time: " << results->turn_around_time / jobs << endl;
+    cout << name << " streamed average relative_turn_around_time: " <<
+        results->relative_turn_around_time / jobs << endl;
+    cout << name << " streamed average number of data members in partition table: " <<
+        results->average_num_data_members_in_partition_table << endl;
+    report_histogram((string(name) + " streamed turn_around_time").c_str(), results->turn_around_histogram, 1, cout);
+    report_histogram((string(name) + " streamed relative_turn_around_time").c_str(),
+        results->relative_turn_around_histogram, RELATIVE_TURN_AROUND_SCALE, cout);
+    cout << name << " streamed throughput: " << results->jobs / seconds / 1e6 << " million jobs/s" << endl;
+    cout << endl;
+}
+
+/**************************************************************************************************
+ * void run_streamed_experiments(long long total_jobs, unsigned seed)
+ *
+ * Author: Nolan Davenport
+ * Description: Runs the equal, one queue and dynamic experiments on a stream of jobs and reports
+ *              their results. Each experiment gets its own stream of the same jobs. Memory use
+ *              stays at the size of the stream buffer no matter how many jobs there are. The
+ *              multiple queues style isn't streamed: every job joins the queue of its partition
+ *              as soon as it arrives, so it would have to hold the whole stream.
+ *
+ * Parameters:
+ *  total_jobs  I/P     long long   The number of jobs in each stream.
+ *  seed        I/P     unsigned    The seed the jobs are generated from.
+ *************************************************************************************************/
+void run_streamed_experiments(long long total_jobs, unsigned seed){
+    cout << "stream buffer: " << sizeof(JobStream) << " bytes" << endl << endl;
+
+    JobStream* stream = new JobStream();                    // The stream is too large for the stack.
+
+    StreamedResults equal;                                  // Results of the equal experiment.
+    job_stream_start(*stream, total_jobs, seed);            // Start generating the jobs.
+    auto start = chrono::steady_clock::now();               // Start the timer.
+    equal_partitioning_streamed(*stream, EqualLayout::sizes[0], EqualLayout::count, &equal);
+    auto end = chrono::steady_clock::now();                 // Stop the timer.
+    job_stream_stop(*stream);                               // Wait for the producer.
+    report_streamed_results("equal", &equal, chrono::duration<double>(end - start).count());
+
+    StreamedResults one_queue_unequal;                      // Results of the one queue experiment.
+    job_stream_start(*stream, total_jobs, seed);            // Generate the same jobs again.
+    start = chrono::steady_clock::now();                    // Start the timer.
+    one_queue_partitioning_streamed(*stream, UnequalLayout::sizes, UnequalLayout::count, &one_queue_unequal);
+    end = chrono::steady_clock::now();                      // Stop the timer.
+    job_stream_stop(*stream);                               // Wait for the producer.
+    report_streamed_results("one_queue", &one_queue_unequal, chrono::duration<double>(end - start).count());
+
+    StreamedResults first_fit;                              // Results of the dynamic experiment.
+    job_stream_start(*stream, total_jobs, seed);            // Generate the same jobs again.
+    start = chrono::steady_clock::now();                    // Start the timer.
+    dynamic_partitioning_streamed(*stream, MEMORY_END+1, &first_fit);
+    end = chrono::steady_clock::now();                      // Stop the timer.
+    job_stream_stop(*stream);                               // Wait for the producer.
+    report_streamed_results("dynamic", &first_fit, chrono::duration<double>(end - start).count());
+
+    cout << "multiple_queues is not streamed: its queues would have to hold every job." << endl;
+
+    delete stream;                                          // Delete the stream.
+}
\ No newline at end of file
@@ -0,0 +1,108 @@
+/**************************************************************************************************
+ * File: streaming.h
+ * Author: Nolan Davenport
+ * Procedures:
+ *
+ * job_stream_start                     - Starts the producer thread of a job stream.
+ *
+ * job_stream_peek                      - Gets the job at the head of a job stream.
+ *
+ * job_stream_pop                       - Removes the job at the head of a job stream.
+ *
+ * job_stream_stop                      - Stops the producer thread of a job stream.
+ *
+ * equal_partitioning_streamed          - Performs the equal partitioning experiment on jobs from
+ *                                        a job stream.
+ *
+ * one_queue_partitioning_streamed      - Performs the one queue experiment on jobs from a job
+ *                                        stream.
+ *
+ * dynamic_partitioning_streamed        - Performs the dynamic partitioning experiment on jobs from
+ *                                        a job stream.
+ *
+ * run_streamed_experiments             - Runs the streamed experiments and reports their results.
+ *************************************************************************************************/
+
+#pragma once
+
+#include<iostream>
+#include<random>
+#include<queue>
+#include<list>
+#include<atomic>
+#include<thread>
+#include<memory_resource>
+
+#include"main.h"
+#include"partition_pool.h"
+
+using namespace std;
+
+#define JOB_STREAM_CHUNK_SIZE 4096      // The number of jobs generated at a time.
+#define JOB_STREAM_CHUNKS 8             // The number of chunks the buffer holds.
+
+// Structure that holds one chunk of generated jobs.
+typedef struct {
+    Data jobs[JOB_STREAM_CHUNK_SIZE];   // The jobs.
+    int count;                          // The number of jobs in this chunk.
+} JobChunk;
+
+// Structure that holds a stream of jobs. A producer thread generates the jobs in chunks into a
+// ring buffer and a single consumer reads them in order. The ring is lock free: the producer only
+// writes produced and the consumer only writes consumed.
+typedef struct {
+    JobChunk chunks[JOB_STREAM_CHUNKS];     // The ring buffer of chunks.
+    atomic<long long> produced;             // The number of chunks the producer has filled.
+    atomic<long long> consumed;             // The number of chunks the consumer has finished with.
+    atomic<bool> stopping;                  // Set to make the producer give up early.
+    long long total_jobs;                   // The number of jobs in the stream.
+    unsigned seed;                          // The seed the jobs are generated from.
+    long long jobs_read;                    // The number of jobs the consumer has taken.
+    int read_position;                      // The position of the head in the current chunk.
+    thread producer;                        // The producer thread.
+} JobStream;
+
+// Structure that holds the results of a streamed experiment. The sums are kept in double
+// precision since a stream can hold far more jobs than an experiment.
+typedef struct {
+    long long jobs = 0;                                     // The number of jobs completed.
+    double turn_around_time = 0;                            // The total turnaround time.
+    double relative_turn_around_time = 0;                   // The total relative turnaround time.
+    long long number_of_failures = 0;                       // The number of failures.
+    double average_num_data_members_in_partition_table = 0; // The average number of data members.
+    long long clock = 0;                                    // The clock when the experiment ended.
+    Histogram turn_around_histogram;                        // The turnaround times.
+    Histogram relative_turn_around_histogram;               // The relative turnaround times, in thousandths.
+} StreamedResults;
+
+// Structure that holds a static partition along with the job in it, since a streamed job is
+// gone from the stream once it is taken.
+typedef struct {
+    int size;           // The size of the partition.
+    bool full;          // Whether a job is in the partition.
+    int time;           // The total time of the job.
+    int left;           // The time the job has left.
+    int time_start;     // The time the job started.
+} StreamedPartition;
+
+// Structure that holds a dynamic partition along with the job in it.
+typedef struct {
+    int start_location; // Where the partition starts.
+    int size;           // The size of the partition, which is the size of the job.
+    int time;           // The total time of the job.
+    int left;           // The time the job has left.
+    int time_start;     // The time the job started.
+} StreamedDynamicPartition;
+
+// The list of streamed dynamic partitions. Its nodes come from the dynamic partition pool.
+typedef pmr::list<StreamedDynamicPartition> StreamedDynamicPartitionList;
+
+// Function prototypes
+void job_stream_start(JobStream &stream, long long total_jobs, unsigned seed);
+Data* job_stream_peek(JobStream &stream);
+void job_stream_pop(JobStream &stream);
+void job_stream_stop(JobStream &stream);
+void equal_partitioning_streamed(JobStream &stream, int partition_size, int partition_count, StreamedResults* equal);
+void one_queue_partitioning_streamed(JobStream &stream, const int* sizes, int partition_count, StreamedResults* one_queue_unequal);
+void dynamic_partitioning_streamed(JobStream &stream, int memory_units, StreamedResults* first_fit);
+void run_streamed_experiments(long long total_jobs, unsigned seed);
\ No newline at end of file
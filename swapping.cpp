@@ -0,0 +1,551 @@
+/**************************************************************************************************
+ * File: swapping.cpp
+ * Author: Nolan Davenport
+ * Procedures:
+ *
+ * parse_swap_victim_policy         - Reads a victim selection policy from its name.
+ *
+ * better_swap_victim               - Checks whether one resident data item is a better victim
+ *                                    than another.
+ *
+ * one_queue_swapping_partitioning  - Performs the one queue experiment with data swapped out to
+ *                                    admit blocked data.
+ *
+ * dynamic_swapping_partitioning    - Performs the dynamic partitioning experiment on a bitmap
+ *                                    memory with data swapped out to admit blocked data.
+ *
+ * report_swap_stats                - Prints the swapping statistics of a partitioning style.
+ *************************************************************************************************/
+
+#include<iostream>
+#include<random>
+#include<queue>
+#include<list>
+#include<vector>
+#include<string>
+
+#include"main.h"
+#include"histogram.h"
+#include"metrics.h"
+#include"bitmap_memory.h"
+#include"partition_pool.h"
+#include"swapping.h"
+
+using namespace std;
+
+/**************************************************************************************************
+ * bool parse_swap_victim_policy(const string &name, SwapVictimPolicy &policy)
+ *
+ * Author: Nolan Davenport
+ * Description: Reads a victim selection policy from its name on the command line: longest,
+ *              largest or oldest.
+ *
+ * Parameters:
+ *  name                        I/P     const string (&)        The name of the policy.
+ *  policy                      O/P     SwapVictimPolicy (&)    The policy.
+ *  parse_swap_victim_policy    O/P     bool                    False if the name is unknown.
+ *************************************************************************************************/
+bool parse_swap_victim_policy(const string &name, SwapVictimPolicy &policy){
+    if(name == "longest"){                          // The most time left.
+        policy = SWAP_LONGEST_REMAINING;
+    }else if(name == "largest"){                    // The most memory.
+        policy = SWAP_LARGEST;
+    }else if(name == "oldest"){                     // In memory the longest.
+        policy = SWAP_OLDEST;
+    }else{                                          // Anything else is a mistake.
+        return false;
+    }
+    return true;
+}
+
+/**************************************************************************************************
+ * bool better_swap_victim(SwapVictimPolicy policy, int left, int size, int admitted_at,
+ *                         int best_left, int best_size, int best_admitted_at)
+ *
+ * Author: Nolan Davenport
+ * Description: Checks whether a resident data item is a better victim than the best one found
+ *              so far. On a tie the one found first stays the best.
+ *
+ * Parameters:
+ *  policy              I/P     SwapVictimPolicy    How the victim is chosen.
+ *  left                I/P     int                 The time the data has left.
+ *  size                I/P     int                 Its size in MB.
+ *  admitted_at         I/P     int                 The tick it came into memory.
+ *  best_left           I/P     int                 The same for the best victim so far.
+ *  best_size           I/P     int
+ *  best_admitted_at    I/P     int
+ *  better_swap_victim  O/P     bool                True if the data is the better victim.
+ *************************************************************************************************/
+bool better_swap_victim(SwapVictimPolicy policy, int left, int size, int admitted_at,
+                        int best_left, int best_size, int best_admitted_at){
+    switch(policy){
+        case SWAP_LONGEST_REMAINING: return left > best_left;           // More time left.
+        case SWAP_LARGEST: return size > best_size;                     // More memory.
+        case SWAP_OLDEST: return admitted_at < best_admitted_at;        // In memory longer.
+        default: return false;
+    }
+}
+
+/**************************************************************************************************
+ * void one_queue_swapping_partitioning(Data data[NUMBER_OF_SAMPLES], int number_of_samples,
+ *                                      const int* sizes, int partition_count,
+ *                                      const SwapConfig &config, Results* results,
+ *                                      SwapStats* stats)
+ *
+ * Author: Nolan Davenport
+ * Description: Performs the one queue experiment for a runtime layout with a swapping model.
+ *              Data swapped out waits in a backing store and is admitted again before the
+ *              queue, in the order it left. When the data waiting to be admitted is blocked, a
+ *              resident data item in a partition it could use is swapped out for it, if one has
+ *              more time left and has been in memory long enough. Each transfer stalls the
+ *              processor. With SWAP_NEVER it follows the same rules as
+ *              one_queue_partitioning_generic.
+ *
+ * Parameters:
+ *  data                I/P     Data[NUMBER_OF_SAMPLES]     The data to be used in this experiment.
+ *  number_of_samples   I/P     int                         The number of samples in this experiment.
+ *  sizes               I/P     const int*                  The size of each partition, smallest first.
+ *  partition_count     I/P     int                         The number of partitions.
+ *  config              I/P     const SwapConfig (&)        The swapping settings.
+ *  results             O/P     Results*                    Pointer to the structure that holds the
+ *                                                          results of this experiment.
+ *  stats               O/P     SwapStats*                  The swapping statistics.
+ *************************************************************************************************/
+void one_queue_swapping_partitioning(Data data[NUMBER_OF_SAMPLES], int number_of_samples, const int* sizes,
+                                     int partition_count, const SwapConfig &config, Results* results,
+                                     SwapStats* stats){
+    int last = partition_count - 1;                 // The partition that takes anything.
+
+    vector<int> left(number_of_samples);            // Only the time left changes during the experiment.
+    vector<int> admitted_at(number_of_samples);     // The tick each data item came into memory.
+    for(int i = 0; i < number_of_samples; i++){     // Loop through each sample.
+        left[i] = data[i].left;                     // Copy the time left.
+    }
+
+    vector<StaticPartition> partitions(partition_count);    // Create the partitions.
+    for(int i = 0; i < partition_count; i++){               // Loop through the partitions.
+        partitions[i].size = sizes[i];                      // Set the size from the layout.
+        partitions[i].data_index = -1;                      // Mark the partition as empty.
+    }
+
+    queue<int> swapped;                             // The backing store, in the order data left memory.
+    int next_data = 0;                              // The head of the queue.
+    int number_of_failures = 0;                     // Initialize the number of failures to zero.
+    int num_data_members_in_partition_table = 0;    // The number of data members in the partition table.
+    int clock = 0;                                  // Initialize the clock to zero.
+    float average_num_data_members_in_partition_table = 0;  // Cumulative value used for the average.
+    MemoryMetrics metrics;                          // The memory metrics for this experiment.
+
+    // Stalls the processor while data is moved to or from the backing store.
+    auto transfer = [&](int size){
+        int ticks = size * config.ticks_per_mb;                 // The time the transfer takes.
+        stats->io_mb += size;                                   // Count the I/O.
+        stats->io_ticks += ticks;
+        for(int tick = 0; tick < ticks; tick++){                // Nothing runs while it happens.
+            clock++;
+            average_num_data_members_in_partition_table += num_data_members_in_partition_table;
+            metrics_tick(metrics, results);
+        }
+    };
+
+    // Admits data from the backing store, then from the queue, swapping out victims if blocked.
+    auto admit = [&](){
+        for(;;){
+            bool from_backing_store = !swapped.empty();         // Swapped out data goes first.
+            if(!from_backing_store && next_data == number_of_samples){  // If nothing is waiting:
+                break;                                          // Stop.
+            }
+            int index = from_backing_store ? swapped.front() : next_data;  // The data waiting.
+            int size = data[index].size;                        // Its size.
+
+            int chosen = -1;                                    // The partition it goes into.
+            for(int p = 0; p <= last; p++){                     // The first empty partition it fits in,
+                if(partitions[p].data_index == -1 && (p == last || size <= partitions[p].size)){    // or the
+                    chosen = p;                                 // last partition, which takes anything.
+                    break;
+                }
+            }
+
+            if(chosen == -1 && config.victim != SWAP_NEVER){    // If it is blocked, look for a victim.
+                for(int p = 0; p <= last; p++){                 // Any partition it could use.
+                    int resident = partitions[p].data_index;
+                    if(resident == -1 || (p != last && size > partitions[p].size)){ // It doesn't fit in this one.
+                        continue;
+                    }
+                    if(left[resident] <= left[index] ||         // Only swap out data with more time left
+                        clock - admitted_at[resident] < config.min_residency){  // that has been in long enough.
+                        continue;
+                    }
+                    int best = (chosen == -1) ? -1 : partitions[chosen].data_index;
+                    if(best == -1 || better_swap_victim(config.victim, left[resident], data[resident].size,
+                        admitted_at[resident], left[best], data[best].size, admitted_at[best])){
+                        chosen = p;                             // The best victim so far.
+                    }
+                }
+
+                if(chosen != -1){                               // Swap the victim out.
+                    int victim = partitions[chosen].data_index;
+                    partitions[chosen].data_index = -1;
+                    num_data_members_in_partition_table--;
+                    metrics_release(metrics, partitions[chosen].size, data[victim].size);
+                    swapped.push(victim);                       // It waits behind the rest of the store.
+                    stats->swap_outs++;
+                    transfer(data[victim].size);                // Write it to the backing store.
+                }
+            }
+
+            if(chosen == -1){                                   // The data waiting is blocked.
+                break;
+            }
+
+            partitions[chosen].data_index = index;              // Put it into the partition.
+            admitted_at[index] = clock;
+            num_data_members_in_partition_table++;
+            metrics_admit(metrics, partitions[chosen].size, size);
+            if(from_backing_store){                             // If it came from the backing store:
+                swapped.pop();
+                stats->swap_ins++;
+                transfer(size);                                 // Read it back in.
+            }else{                                              // If it came from the queue:
+                if(chosen == last && size > partitions[last].size){   // If it is larger than the last partition:
+                    number_of_failures++;                       // Count it as a failure.
+                }
+                next_data++;                                    // Move to the next item in the queue.
+            }
+        }
+    };
+
+    admit();                                        // Put the initial data into the table.
+
+    int curr_partition = 0;                         // Initialize the current partition to zero.
+    for(;;){                                                        // Start the clock loop.
+        int index = partitions[curr_partition].data_index;          // The data in the current partition.
+        if(index == -1){                                            // If the partition is empty, skip it
+            curr_partition = (curr_partition + 1) % partition_count;    // without incrementing the clock.
+            continue;
+        }
+
+        if(--left[index] == 0){                                     // Work for one quantum. If the data is finished:
+            int turn_around_time = clock - data[index].time_start;  // Calculate the turnaround time.
+
+            results->turn_around_time += turn_around_time;          // Add it to the cumulative turnaround time.
+            stats->turn_around_time += turn_around_time;            // Add it and the time it waited to the
+            stats->wait_time += turn_around_time - data[index].time;    // swapping statistics.
+            float relative_turn_around_time =                       // Calculate the relative turnaround time.
+                (float)turn_around_time / data[index].time;
+            results->relative_turn_around_time += relative_turn_around_time;  // Add it to the cumulative value.
+            record_completion(index, clock);                                   // Record when it finished.
+            histogram_record(results->turn_around_histogram, turn_around_time);    // Record both for the percentiles.
+            record_relative_turn_around(results->relative_turn_around_histogram,
+                turn_around_time, data[index].time);
+
+            partitions[curr_partition].data_index = -1;             // Clear this partition.
+            num_data_members_in_partition_table--;                  // Decrement the number of data members.
+            metrics_release(metrics, partitions[curr_partition].size, data[index].size);
+
+            admit();                                                // Admit whatever is waiting.
+            if(num_data_members_in_partition_table == 0){           // If nothing is left anywhere:
+                break;                                              // End this experiment.
+            }
+        }
+
+        curr_partition = (curr_partition + 1) % partition_count;    // Move to the next partition.
+        clock++;                                                    // Increment the clock.
+        average_num_data_members_in_partition_table +=              // Add to the cumulative average variable.
+            num_data_members_in_partition_table;
+        metrics_tick(metrics, results);                             // Add the memory metrics for this tick.
+    }
+
+    average_num_data_members_in_partition_table /= clock;           // Calculate the average for this experiment.
+
+    results->average_num_data_members_in_partition_table +=         // Add it to the cumulative variable.
+        average_num_data_members_in_partition_table;
+    results->number_of_failures += number_of_failures;              // Add the failures to the cumulative variable.
+    metrics_finish_experiment(metrics, results, clock);             // Add the memory metrics to the cumulative values.
+
+    stats->experiments++;                           // Add this experiment to the statistics.
+    stats->jobs += number_of_samples;
+    stats->failures += number_of_failures;
+    stats->ticks += clock;
+}
+
+/**************************************************************************************************
+ * void dynamic_swapping_partitioning(Data data[NUMBER_OF_SAMPLES], int number_of_samples,
+ *                                    int memory_units, int blocks_per_unit,
+ *                                    const SwapConfig &config, Results* results, SwapStats* stats)
+ *
+ * Author: Nolan Davenport
+ * Description: Performs the dynamic partitioning experiment on a bitmap memory with a swapping
+ *              model. Data swapped out waits in a backing store and is admitted again before the
+ *              queue, in the order it left. When the data waiting to be admitted is blocked,
+ *              victims with more time left that have been in memory long enough are swapped out
+ *              until there is enough free memory, which compaction then turns into one hole.
+ *              Nothing is swapped out unless that frees enough memory. Each transfer stalls the
+ *              processor. With SWAP_NEVER it follows the same rules as dynamic_bitmap_partitioning.
+ *
+ * Parameters:
+ *  data                I/P     Data[NUMBER_OF_SAMPLES]     The data to be used in this experiment.
+ *  number_of_samples   I/P     int                         The number of samples in this experiment.
+ *  memory_units        I/P     int                         The size of memory in MB.
+ *  blocks_per_unit     I/P     int                         The number of blocks in one MB.
+ *  config              I/P     const SwapConfig (&)        The swapping settings.
+ *  results             O/P     Results*                    Pointer to the structure that holds the
+ *                                                          results of this experiment.
+ *  stats               O/P     SwapStats*                  The swapping statistics.
+ *************************************************************************************************/
+void dynamic_swapping_partitioning(Data data[NUMBER_OF_SAMPLES], int number_of_samples, int memory_units,
+                                   int blocks_per_unit, const SwapConfig &config, Results* results,
+                                   SwapStats* stats){
+    vector<int> left(number_of_samples);            // Only the time left changes during the experiment.
+    vector<int> admitted_at(number_of_samples);     // The tick each data item came into memory.
+    for(int i = 0; i < number_of_samples; i++){     // Loop through each sample.
+        left[i] = data[i].left;                     // Copy the time left.
+    }
+
+    reset_dynamic_partition_pool();                 // Start this experiment with a fresh pool of nodes.
+
+    BitmapPartitions partitions{                    // Set up an empty memory.
+        BitmapMemory(), ResidentMap(dynamic_partition_resource()), vector<int>(number_of_samples),
+        vector<int>(number_of_samples), memory_units, blocks_per_unit, 0};
+    bitmap_init(partitions.memory, memory_units * blocks_per_unit);
+
+    MemoryMetrics metrics;                          // The memory metrics for this experiment.
+    metrics.memory_size = memory_units;             // Utilization is relative to this memory.
+    bitmap_add_hole(partitions, 0, memory_units * blocks_per_unit, metrics);   // Memory starts as a single hole.
+
+    queue<int> swapped;                             // The backing store, in the order data left memory.
+    int next_data = 0;                              // The head of the queue.
+    int number_of_failures = 0;                     // Initialize the number of failures to zero.
+    int num_data_members_in_partition_table = 0;    // The number of data members in memory.
+    int clock = 0;                                  // Initialize the clock to zero.
+    float average_num_data_members_in_partition_table = 0;  // Cumulative value used for the average.
+
+    ResidentMap::iterator it = partitions.resident.end();   // The data the processor works on.
+
+    // Stalls the processor while data is moved to or from the backing store.
+    auto transfer = [&](int size){
+        int ticks = size * config.ticks_per_mb;                 // The time the transfer takes.
+        stats->io_mb += size;                                   // Count the I/O.
+        stats->io_ticks += ticks;
+        for(int tick = 0; tick < ticks; tick++){                // Nothing runs while it happens.
+            clock++;
+            average_num_data_members_in_partition_table += num_data_members_in_partition_table;
+            metrics_tick(metrics, results);
+        }
+    };
+
+    // Removes a data item from memory, keeping the processor on the data after it.
+    auto remove = [&](ResidentMap::iterator entry){
+        int index = entry->index;                               // The data leaving memory.
+        int size = data[index].size;
+        bitmap_clear_range(partitions.memory, entry->start, partitions.block_count[index]);
+        partitions.used_units -= size;                          // Free its memory.
+        bitmap_merge_holes(partitions, entry, metrics);
+        metrics_release(metrics, min(size, memory_units), size);
+        num_data_members_in_partition_table--;
+        if(entry == it){                                        // If the processor was on it:
+            it = partitions.resident.erase(entry);              // Move on to the next one.
+        }else{
+            partitions.resident.erase(entry);
+        }
+    };
+
+    // Swaps out victims until the waiting data would fit. Returns false, swapping nothing, if
+    // there aren't enough victims.
+    auto swap_out_for = [&](int index){
+        int size = data[index].size;                            // The memory the waiting data needs.
+        if(config.victim == SWAP_NEVER || size > memory_units){ // Data larger than memory only goes into
+            return false;                                       // an empty memory.
+        }
+
+        vector<ResidentMap::iterator> victims;                  // The data that may be swapped out.
+        int reclaimable = memory_units - partitions.used_units; // The memory that could be freed.
+        for(auto entry = partitions.resident.begin(); entry != partitions.resident.end(); entry++){
+            int resident = entry->index;
+            if(left[resident] > left[index] && clock - admitted_at[resident] >= config.min_residency){
+                victims.push_back(entry);
+                reclaimable += data[resident].size;
+            }
+        }
+        if(reclaimable < size){                                 // Swapping out every victim wouldn't be enough.
+            return false;
+        }
+
+        while(memory_units - partitions.used_units < size){     // Swap out the best victims until it fits.
+            size_t best = 0;
+            for(size_t v = 1; v < victims.size(); v++){         // Find the best victim left.
+                int candidate = victims[v]->index, chosen = victims[best]->index;
+                if(better_swap_victim(config.victim, left[candidate], data[candidate].size,
+                    admitted_at[candidate], left[chosen], data[chosen].size, admitted_at[chosen])){
+                    best = v;
+                }
+            }
+            int victim = victims[best]->index;
+            remove(victims[best]);                              // Take it out of memory.
+            victims.erase(victims.begin() + best);
+            swapped.push(victim);                               // It waits behind the rest of the store.
+            stats->swap_outs++;
+            transfer(data[victim].size);                        // Write it to the backing store.
+        }
+        return true;
+    };
+
+    // Admits data from the backing store, then from the queue, the same way as
+    // bitmap_first_fit_algorithm.
+    auto admit = [&](){
+        for(;;){
+            bool from_backing_store = !swapped.empty();         // Swapped out data goes first.
+            if(!from_backing_store && next_data == number_of_samples){  // If nothing is waiting:
+                break;                                          // Stop.
+            }
+            int index = from_backing_store ? swapped.front() : next_data;  // The data waiting.
+            int size = data[index].size;                        // Its size.
+            int start = -1;                                     // The block it gets placed at.
+
+            for(;;){                                            // Find room for this data. Victims go to the
+                if(partitions.resident.empty()){                // back of the store, so it stays the one waiting.
+                    start = 0;                                  // In an empty memory it goes at the start, even
+                    if(!from_backing_store && size > memory_units){ // if it is too large. If it is larger than
+                        number_of_failures++;                   // all of memory, count it as a failure.
+                    }
+                    break;
+                }
+                start = (partitions.used_units > memory_units) ? -1 :   // Data larger than memory leaves
+                    bitmap_find_hole(partitions, size * blocks_per_unit);   // no hole at all.
+                if(start != -1){                                // If there is a hole, use it.
+                    break;
+                }
+                if(partitions.used_units <= memory_units &&
+                    memory_units - partitions.used_units >= size){  // If there is enough free memory
+                    bitmap_compact(partitions, metrics);        // in total, compact it into one hole
+                    continue;                                   // and try again.
+                }
+                if(!swap_out_for(index)){                       // Otherwise make room if possible
+                    break;                                      // and try again.
+                }
+            }
+            if(start == -1){                                    // The data waiting is blocked.
+                break;
+            }
+
+            int blocks = min(size, memory_units) * blocks_per_unit;     // Blocks it occupies.
+            bitmap_set_range(partitions.memory, start, blocks); // Mark them as used.
+            ResidentMap::iterator entry =                       // Add it to memory in address order.
+                partitions.resident.emplace(start, index);
+            partitions.start_block[index] = start;              // Remember where it is
+            partitions.block_count[index] = blocks;             // and how much of it there is.
+            partitions.used_units += size;                      // Count the memory it holds.
+            bitmap_fill_hole(partitions, entry, metrics);
+            metrics_admit(metrics, min(size, memory_units), size);
+            admitted_at[index] = clock;
+            num_data_members_in_partition_table++;              // One more data member in memory.
+
+            if(from_backing_store){                             // If it came from the backing store:
+                swapped.pop();
+                stats->swap_ins++;
+                transfer(size);                                 // Read it back in.
+            }else{
+                next_data++;                                    // Move to the next item in the queue.
+            }
+        }
+    };
+
+    admit();                                                // Place the initial data.
+    it = partitions.resident.begin();                       // Start at the lowest address.
+
+    for(;;){                                                // Clock loop.
+        int index = it->index;                              // The data the processor is on.
+        bool just_erased_a_partition = false;               // Whether the iterator has already moved on.
+
+        if(--left[index] == 0){                             // Work for one quantum. If the data is finished:
+            int turn_around_time = clock - data[index].time_start;  // Calculate the turnaround time.
+
+            results->turn_around_time += turn_around_time;          // Add it to the cumulative turnaround time.
+            stats->turn_around_time += turn_around_time;            // Add it and the time it waited to the
+            stats->wait_time += turn_around_time - data[index].time;    // swapping statistics.
+            float relative_turn_around_time =                       // Calculate the relative turnaround time.
+                (float)turn_around_time / data[index].time;
+            results->relative_turn_around_time += relative_turn_around_time;  // Add it to the cumulative value.
+            record_completion(index, clock);                                   // Record when it finished.
+            histogram_record(results->turn_around_histogram, turn_around_time);    // Record both for the percentiles.
+            record_relative_turn_around(results->relative_turn_around_histogram,
+                turn_around_time, data[index].time);
+
+            remove(it);                                     // Remove it from memory and move on.
+            just_erased_a_partition = true;
+
+            bool was_empty = partitions.resident.empty();   // Whether memory was empty before placing more.
+            admit();                                        // Admit whatever is waiting.
+
+            if(num_data_members_in_partition_table == 0){   // If nothing is left anywhere:
+                break;                                      // The experiment is done.
+            }else if(was_empty){                            // If memory was empty, start from the beginning.
+                it = partitions.resident.begin();
+            }
+        }
+
+        if(!just_erased_a_partition){                       // If nothing was erased, move on.
+            it++;
+        }
+
+        if(it == partitions.resident.end()){                // If the end of memory was reached:
+            it = partitions.resident.begin();               // Go back to the start.
+        }
+
+        clock++;                                            // Increment the clock.
+        average_num_data_members_in_partition_table +=      // Add to the cumulative average variable.
+            num_data_members_in_partition_table;
+        metrics_tick(metrics, results);                     // Add the memory metrics for this tick.
+    }
+
+    average_num_data_members_in_partition_table /= clock;   // Calculate the average for this experiment.
+
+    results->average_num_data_members_in_partition_table += // Add it to the cumulative variable.
+        average_num_data_members_in_partition_table;
+    results->number_of_failures += number_of_failures;      // Add the failures to the cumulative variable.
+    metrics_finish_experiment(metrics, results, clock);     // Add the memory metrics to the cumulative values.
+
+    stats->experiments++;                           // Add this experiment to the statistics.
+    stats->jobs += number_of_samples;
+    stats->failures += number_of_failures;
+    stats->ticks += clock;
+}
+
+/**************************************************************************************************
+ * void report_swap_stats(const char* name, const SwapStats &swapping, const SwapStats &blocking)
+ *
+ * Author: Nolan Davenport
+ * Description: Prints the swapping statistics of a partitioning style: the average swapping and
+ *              I/O per experiment, and how the turnaround, the wait and the failures change from
+ *              the same workloads when the queue just blocks. The throughput isn't compared, the
+ *              processor does the same work either way.
+ *
+ * Parameters:
+ *  name        I/P     const char*         The name of the partitioning style.
+ *  swapping    I/P     const SwapStats (&) The statistics with swapping.
+ *  blocking    I/P     const SwapStats (&) The statistics of the same workloads without swapping.
+ *************************************************************************************************/
+void report_swap_stats(const char* name, const SwapStats &swapping, const SwapStats &blocking){
+    if(swapping.experiments == 0 || blocking.experiments == 0){    // Nothing to report.
+        return;
+    }
+    double experiments = swapping.experiments;                     // Averages are per experiment,
+    double finished = max(swapping.jobs - swapping.failures, 1LL); // or per finished data member.
+    double finished_blocking = max(blocking.jobs - blocking.failures, 1LL);
+    double turn_around = swapping.turn_around_time / finished;
+    double turn_around_blocking = blocking.turn_around_time / finished_blocking;
+    double wait = swapping.wait_time / finished;
+    double wait_blocking = blocking.wait_time / finished_blocking;
+    cout << name << " average swap outs: " << swapping.swap_outs / experiments <<
+        " swap ins: " << swapping.swap_ins / experiments << endl;
+    cout << name << " average swap I/O: " << swapping.io_mb / experiments << " MB, " <<
+        swapping.io_ticks / experiments << " ticks" << endl;
+    cout << name << " average turnaround: " << turn_around << " with swapping, " <<
+        turn_around_blocking << " without (" << showpos << turn_around - turn_around_blocking <<
+        noshowpos << ")" << endl;
+    cout << name << " average wait: " << wait << " with swapping, " << wait_blocking <<
+        " without (" << showpos << wait - wait_blocking << noshowpos << ")" << endl;
+    cout << name << " average failures: " << swapping.failures / experiments << " with swapping, " <<
+        blocking.failures / experiments << " without (" << showpos <<
+        (swapping.failures - blocking.failures) / experiments << noshowpos << ")" << endl;
+}
\ No newline at end of file
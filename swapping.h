@@ -0,0 +1,69 @@
+/**************************************************************************************************
+ * File: swapping.h
+ * Author: Nolan Davenport
+ * Procedures:
+ *
+ * parse_swap_victim_policy         - Reads a victim selection policy from its name.
+ *
+ * better_swap_victim               - Checks whether one resident data item is a better victim
+ *                                    than another.
+ *
+ * one_queue_swapping_partitioning  - Performs the one queue experiment with data swapped out to
+ *                                    admit blocked data.
+ *
+ * dynamic_swapping_partitioning    - Performs the dynamic partitioning experiment on a bitmap
+ *                                    memory with data swapped out to admit blocked data.
+ *
+ * report_swap_stats                - Prints the swapping statistics of a partitioning style.
+ *************************************************************************************************/
+
+#pragma once
+
+#include<iostream>
+#include<random>
+#include<queue>
+#include<list>
+#include<vector>
+#include<string>
+
+#include"main.h"
+
+using namespace std;
+
+// How the data to swap out is chosen among the resident data that may be swapped out.
+typedef enum {
+    SWAP_NEVER,                 // Nothing is swapped. The queue blocks like the reference experiments.
+    SWAP_LONGEST_REMAINING,     // The data with the most time left.
+    SWAP_LARGEST,               // The data holding the most memory.
+    SWAP_OLDEST                 // The data that has been in memory the longest.
+} SwapVictimPolicy;
+
+// Structure that holds the settings of the swapping model. Resident data can only be swapped out
+// for data with less time left, and only after it has been in memory for min_residency ticks.
+// Moving data to or from the backing store stalls the processor for ticks_per_mb ticks per MB.
+typedef struct {
+    SwapVictimPolicy victim = SWAP_LONGEST_REMAINING;   // How the victim is chosen.
+    int ticks_per_mb = 1;                               // The cost of moving one MB to or from the backing store.
+    int min_residency = 8;                              // The ticks data stays in memory before it can be swapped out.
+} SwapConfig;
+
+// Structure that holds the cumulative swapping statistics of a partitioning style.
+typedef struct {
+    long long experiments = 0;      // The number of experiments.
+    long long jobs = 0;             // The data members that finished.
+    long long failures = 0;         // The data members that never fit.
+    long long turn_around_time = 0; // Cumulative turnaround time of the finished data.
+    long long wait_time = 0;        // Cumulative time the finished data spent not being worked on.
+    long long ticks = 0;            // The ticks the experiments took, including swapping.
+    long long swap_outs = 0;        // The data moved to the backing store.
+    long long swap_ins = 0;         // The data moved back into memory.
+    long long io_mb = 0;            // The MB moved in either direction.
+    long long io_ticks = 0;         // The ticks the processor stalled for swapping.
+} SwapStats;
+
+// Function prototypes
+bool parse_swap_victim_policy(const string &name, SwapVictimPolicy &policy);
+bool better_swap_victim(SwapVictimPolicy policy, int left, int size, int admitted_at, int best_left, int best_size, int best_admitted_at);
+void one_queue_swapping_partitioning(Data data[NUMBER_OF_SAMPLES], int number_of_samples, const int* sizes, int partition_count, const SwapConfig &config, Results* results, SwapStats* stats);
+void dynamic_swapping_partitioning(Data data[NUMBER_OF_SAMPLES], int number_of_samples, int memory_units, int blocks_per_unit, const SwapConfig &config, Results* results, SwapStats* stats);
+void report_swap_stats(const char* name, const SwapStats &swapping, const SwapStats &blocking);
\ No newline at end of file
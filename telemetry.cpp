@@ -0,0 +1,235 @@
+/**************************************************************************************************
+ * File: telemetry.cpp
+ * Author: Nolan Davenport
+ * Procedures:
+ *
+ * telemetry_record             - Publishes the progress and running means of a style after one
+ *                                of its experiments.
+ *
+ * write_telemetry_file         - Writes the current telemetry in the Prometheus text format.
+ *
+ * telemetry_writer             - Rewrites the telemetry file periodically in the background.
+ *
+ * start_telemetry              - Starts the telemetry writer thread.
+ *
+ * finish_telemetry             - Writes the final telemetry and stops the writer thread.
+ *************************************************************************************************/
+
+#include<iostream>
+#include<random>
+#include<queue>
+#include<list>
+#include<string>
+#include<fstream>
+#include<cstdio>
+
+#include"main.h"
+#include"telemetry.h"
+
+using namespace std;
+
+// The name and help text of each running mean, in the order of TelemetryCounters::means.
+static const char* const telemetry_mean_names[TELEMETRY_MEANS][2] = {
+    {"turn_around_time", "Average turnaround time of the data so far."},
+    {"relative_turn_around_time", "Average turnaround time relative to the time needed so far."},
+    {"number_of_failures", "Average failures per experiment so far."},
+    {"data_members_in_memory", "Average data members in memory per experiment so far."},
+    {"memory_utilization", "Average memory utilization per experiment so far."},
+    {"internal_fragmentation", "Average internal fragmentation per experiment so far."},
+    {"hole_count", "Average hole count per experiment so far."},
+    {"largest_hole", "Average largest hole per experiment so far."}};
+
+/**************************************************************************************************
+ * void telemetry_record(Telemetry* telemetry, int style, const Data data[], int number_of_samples,
+ *                       const Results* results)
+ *
+ * Author: Nolan Davenport
+ * Description: Publishes the progress and running means of a style after one of its
+ *              experiments. It is called by the thread running the style, which is the only one
+ *              that writes its counters or its results, so relaxed stores are enough. The work
+ *              simulated is the time the data needed.
+ *
+ * Parameters:
+ *  telemetry           I/O     Telemetry*      The telemetry of the run.
+ *  style               I/P     int             The index of the style.
+ *  data                I/P     const Data[]    The data of the experiment.
+ *  number_of_samples   I/P     int             The number of samples in the experiment.
+ *  results             I/P     const Results*  The results of the style so far.
+ *************************************************************************************************/
+void telemetry_record(Telemetry* telemetry, int style, const Data data[], int number_of_samples,
+                      const Results* results){
+    TelemetryCounters &counters = telemetry->counters[style];
+    long long quanta = 0;                                           // The work in this experiment.
+    for(int i = 0; i < number_of_samples; i++){
+        quanta += data[i].time;
+    }
+    long long experiments = counters.experiments.load(memory_order_relaxed) + 1;
+    double samples = (double)experiments * number_of_samples;      // The data run so far.
+
+    double means[TELEMETRY_MEANS] = {results->turn_around_time / samples,   // Average the sums the same
+        results->relative_turn_around_time / samples,                       // way report_results does.
+        results->number_of_failures / experiments,
+        results->average_num_data_members_in_partition_table / experiments,
+        results->average_memory_utilization / experiments,
+        results->average_internal_fragmentation / experiments,
+        results->average_hole_count / experiments,
+        results->average_largest_hole / experiments};
+    for(int field = 0; field < TELEMETRY_MEANS; field++){
+        counters.means[field].store(means[field], memory_order_relaxed);
+    }
+    counters.jobs.store(counters.jobs.load(memory_order_relaxed) + number_of_samples, memory_order_relaxed);
+    counters.quanta.store(counters.quanta.load(memory_order_relaxed) + quanta, memory_order_relaxed);
+    counters.experiments.store(experiments, memory_order_relaxed);
+}
+
+/**************************************************************************************************
+ * bool write_telemetry_file(Telemetry* telemetry, long long (&last_jobs)[TELEMETRY_STYLES],
+ *                           long long &last_quanta, chrono::steady_clock::time_point &last_time)
+ *
+ * Author: Nolan Davenport
+ * Description: Writes the current telemetry in the Prometheus text format, to a temporary file
+ *              that is renamed over the old one so a collector never reads part of a file. The
+ *              rates cover the time since the last file, and the estimated time left assumes
+ *              the slowest style keeps its pace since the start.
+ *
+ * Parameters:
+ *  telemetry               I/P     Telemetry*                          The telemetry of the run.
+ *  last_jobs               I/O     long long (&)[TELEMETRY_STYLES]     The jobs of each style at
+ *                                                                      the last file.
+ *  last_quanta             I/O     long long (&)                       The quanta at the last file.
+ *  last_time               I/O     steady_clock::time_point (&)        When the last file was written.
+ *  write_telemetry_file    O/P     bool                                Whether it was written.
+ *************************************************************************************************/
+bool write_telemetry_file(Telemetry* telemetry, long long (&last_jobs)[TELEMETRY_STYLES], long long &last_quanta,
+                          chrono::steady_clock::time_point &last_time){
+    chrono::steady_clock::time_point now = chrono::steady_clock::now();
+    double seconds = max(1e-9, chrono::duration<double>(now - last_time).count());
+    double elapsed = max(1e-9, chrono::duration<double>(now - telemetry->started).count());
+
+    long long experiments[TELEMETRY_STYLES], jobs[TELEMETRY_STYLES];   // Read every counter once.
+    long long quanta = 0;
+    long long slowest = telemetry->total_experiments;               // The experiments every style has done.
+    for(int style = 0; style < TELEMETRY_STYLES; style++){
+        experiments[style] = telemetry->counters[style].experiments.load(memory_order_relaxed);
+        jobs[style] = telemetry->counters[style].jobs.load(memory_order_relaxed);
+        quanta += telemetry->counters[style].quanta.load(memory_order_relaxed);
+        slowest = min(slowest, experiments[style]);
+    }
+    double rate = (slowest - telemetry->first_experiment) / elapsed;   // Experiments per second so far.
+    double eta = (slowest >= telemetry->total_experiments) ? 0 :
+        (rate > 0) ? (telemetry->total_experiments - slowest) / rate : -1;
+
+    string temporary = telemetry->file_name + ".tmp";
+    ofstream file(temporary);
+    file << "# HELP memsim_experiments_planned Experiments in the run.\n";
+    file << "# TYPE memsim_experiments_planned gauge\n";
+    file << "memsim_experiments_planned " << telemetry->total_experiments << "\n";
+    file << "# HELP memsim_experiments_completed_total Experiments done by each style, including resumed ones.\n";
+    file << "# TYPE memsim_experiments_completed_total counter\n";
+    for(int style = 0; style < TELEMETRY_STYLES; style++){
+        file << "memsim_experiments_completed_total{style=\"" << telemetry->style_names[style] << "\"} " <<
+            experiments[style] << "\n";
+    }
+    file << "# HELP memsim_jobs_per_second Data items run per second by each style since the last update.\n";
+    file << "# TYPE memsim_jobs_per_second gauge\n";
+    for(int style = 0; style < TELEMETRY_STYLES; style++){
+        file << "memsim_jobs_per_second{style=\"" << telemetry->style_names[style] << "\"} " <<
+            (jobs[style] - last_jobs[style]) / seconds << "\n";
+    }
+    file << "# HELP memsim_simulated_ticks_per_second Quanta of work simulated per second by every style since the last update.\n";
+    file << "# TYPE memsim_simulated_ticks_per_second gauge\n";
+    file << "memsim_simulated_ticks_per_second " << (quanta - last_quanta) / seconds << "\n";
+    file << "# HELP memsim_eta_seconds Estimated seconds until every style finishes, or -1 if unknown.\n";
+    file << "# TYPE memsim_eta_seconds gauge\n";
+    file << "memsim_eta_seconds " << eta << "\n";
+    for(int field = 0; field < TELEMETRY_MEANS; field++){
+        file << "# HELP memsim_mean_" << telemetry_mean_names[field][0] << " " << telemetry_mean_names[field][1] << "\n";
+        file << "# TYPE memsim_mean_" << telemetry_mean_names[field][0] << " gauge\n";
+        for(int style = 0; style < TELEMETRY_STYLES; style++){
+            file << "memsim_mean_" << telemetry_mean_names[field][0] << "{style=\"" <<
+                telemetry->style_names[style] << "\"} " <<
+                telemetry->counters[style].means[field].load(memory_order_relaxed) << "\n";
+        }
+    }
+    file.close();
+    if(!file || rename(temporary.c_str(), telemetry->file_name.c_str()) != 0){
+        remove(temporary.c_str());
+        return false;
+    }
+
+    for(int style = 0; style < TELEMETRY_STYLES; style++){          // The next rates start from here.
+        last_jobs[style] = jobs[style];
+    }
+    last_quanta = quanta;
+    last_time = now;
+    return true;
+}
+
+/**************************************************************************************************
+ * void telemetry_writer(Telemetry* telemetry)
+ *
+ * Author: Nolan Davenport
+ * Description: Rewrites the telemetry file every interval until the run finishes, then writes it
+ *              once more with the final counts.
+ *
+ * Parameters:
+ *  telemetry   I/O     Telemetry*      The telemetry of the run.
+ *************************************************************************************************/
+void telemetry_writer(Telemetry* telemetry){
+    long long last_jobs[TELEMETRY_STYLES] = {};                     // The counts of the last file.
+    long long last_quanta = 0;
+    chrono::steady_clock::time_point last_time = telemetry->started;
+
+    unique_lock<mutex> guard(telemetry->lock);
+    for(;;){
+        bool stopping = telemetry->wake.wait_for(guard, chrono::seconds(telemetry->interval),
+            [&]{ return telemetry->stopping; });
+        guard.unlock();                                             // The file is written without the lock.
+        if(!write_telemetry_file(telemetry, last_jobs, last_quanta, last_time)){
+            telemetry->failed++;
+        }
+        if(stopping){
+            return;
+        }
+        guard.lock();
+    }
+}
+
+/**************************************************************************************************
+ * void start_telemetry(Telemetry* telemetry)
+ *
+ * Author: Nolan Davenport
+ * Description: Starts the telemetry writer thread. The file, interval and first experiment must
+ *              be set first.
+ *
+ * Parameters:
+ *  telemetry   I/O     Telemetry*      The telemetry of the run.
+ *************************************************************************************************/
+void start_telemetry(Telemetry* telemetry){
+    for(int style = 0; style < TELEMETRY_STYLES; style++){          // Resumed experiments count as done.
+        telemetry->counters[style].experiments.store(telemetry->first_experiment, memory_order_relaxed);
+    }
+    telemetry->started = chrono::steady_clock::now();
+    telemetry->writer = thread(telemetry_writer, telemetry);
+}
+
+/**************************************************************************************************
+ * void finish_telemetry(Telemetry* telemetry)
+ *
+ * Author: Nolan Davenport
+ * Description: Writes the final telemetry and stops the writer thread.
+ *
+ * Parameters:
+ *  telemetry   I/O     Telemetry*      The telemetry of the run.
+ *************************************************************************************************/
+void finish_telemetry(Telemetry* telemetry){
+    {
+        lock_guard<mutex> guard(telemetry->lock);
+        telemetry->stopping = true;
+        telemetry->wake.notify_one();
+    }
+    telemetry->writer.join();
+    if(telemetry->failed > 0){
+        cerr << telemetry->failed << " telemetry files couldn't be written to " << telemetry->file_name << endl;
+    }
+}
\ No newline at end of file
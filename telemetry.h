@@ -0,0 +1,70 @@
+/**************************************************************************************************
+ * File: telemetry.h
+ * Author: Nolan Davenport
+ * Procedures:
+ *
+ * telemetry_record             - Publishes the progress and running means of a style after one
+ *                                of its experiments.
+ *
+ * write_telemetry_file         - Writes the current telemetry in the Prometheus text format.
+ *
+ * telemetry_writer             - Rewrites the telemetry file periodically in the background.
+ *
+ * start_telemetry              - Starts the telemetry writer thread.
+ *
+ * finish_telemetry             - Writes the final telemetry and stops the writer thread.
+ *************************************************************************************************/
+
+#pragma once
+
+#include<iostream>
+#include<random>
+#include<queue>
+#include<list>
+#include<string>
+#include<atomic>
+#include<mutex>
+#include<thread>
+#include<chrono>
+#include<condition_variable>
+
+#include"main.h"
+
+using namespace std;
+
+#define TELEMETRY_INTERVAL 5            // The seconds between telemetry files by default.
+#define TELEMETRY_STYLES 4              // One set of counters for each partitioning style.
+#define TELEMETRY_MEANS 8               // The Results fields published as running means.
+
+// The counters of one partitioning style. Only the thread running the style writes them, with
+// relaxed stores after each experiment, so the experiments never take a lock. Each style has its
+// own cache line so the threads don't slow each other down.
+typedef struct alignas(64) {
+    atomic<long long> experiments{0};           // The experiments done, including resumed ones.
+    atomic<long long> jobs{0};                  // The data items run in this process.
+    atomic<long long> quanta{0};                // The quanta of work simulated in this process.
+    atomic<double> means[TELEMETRY_MEANS] = {}; // The running mean of each Results field.
+} TelemetryCounters;
+
+// Structure that holds the telemetry of a run and the thread that writes it out.
+typedef struct {
+    string file_name;                                   // The Prometheus text file.
+    int interval = TELEMETRY_INTERVAL;                  // The seconds between files.
+    int total_experiments = NUMBER_OF_EXPERIMENTS;      // The experiments in the run.
+    int first_experiment = 0;                           // The experiments done before this process.
+    const char* style_names[TELEMETRY_STYLES] = {"equal", "one_queue", "multiple_queue", "dynamic"};
+    TelemetryCounters counters[TELEMETRY_STYLES];       // The counters of every style.
+    chrono::steady_clock::time_point started;           // When this process started the experiments.
+    mutex lock;                                         // Guards stopping.
+    condition_variable wake;                            // Signals the writer to stop.
+    bool stopping = false;                              // Whether the writer should finish.
+    long long failed = 0;                               // The files that couldn't be written.
+    thread writer;                                      // The writer thread.
+} Telemetry;
+
+// Function prototypes
+void telemetry_record(Telemetry* telemetry, int style, const Data data[], int number_of_samples, const Results* results);
+bool write_telemetry_file(Telemetry* telemetry, long long (&last_jobs)[TELEMETRY_STYLES], long long &last_quanta, chrono::steady_clock::time_point &last_time);
+void telemetry_writer(Telemetry* telemetry);
+void start_telemetry(Telemetry* telemetry);
+void finish_telemetry(Telemetry* telemetry);
\ No newline at end of file